@@ -1,5 +1,6 @@
 #include "aer/application.h"
 #include "aer/core/events.h"
+#include "aer/core/job_system.h"
 #include "aer/platform/window.h"
 
 /* -------------------------------------------------------------------------- */
@@ -70,6 +71,7 @@ bool Application::presetup(bool use_xr, AppData_t app_data) {
   {
     Logger::Initialize();
     Events::Initialize();
+    utils::JobSystem::Initialize();
   }
 
   LOGD("--- Framework Setup ---");
@@ -356,6 +358,7 @@ void Application::shutdown() {
   }
 
   LOGD("> Singletons");
+  utils::JobSystem::Deinitialize();
   Events::Deinitialize();
   Logger::Deinitialize();
 }
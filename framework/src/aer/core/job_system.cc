@@ -0,0 +1,136 @@
+#include "aer/core/job_system.h"
+
+/* -------------------------------------------------------------------------- */
+
+namespace utils {
+
+namespace {
+
+thread_local int32_t tWorkerIndex{-1};
+
+} // namespace ""
+
+// ----------------------------------------------------------------------------
+
+JobSystem::JobSystem(uint32_t worker_count) {
+  if (worker_count == 0u) {
+    // Keep a core for the calling (main) thread, which runs its own tasks and chunks.
+    uint32_t const hw_count = std::thread::hardware_concurrency();
+    worker_count = std::max(hw_count, 2u) - 1u;
+  }
+
+  queues_ = std::make_unique<WorkQueue[]>(worker_count);
+
+  workers_.reserve(worker_count);
+  for (uint32_t i = 0u; i < worker_count; ++i) {
+    workers_.emplace_back(&JobSystem::worker_loop, this, i);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+JobSystem::~JobSystem() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    stop_.store(true, std::memory_order_release);
+  }
+  sleep_cv_.notify_all();
+
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void JobSystem::submit(Job job) {
+  // Workers push to their own deque, others are spread round-robin.
+  int32_t const worker_index = tWorkerIndex;
+  uint32_t const queue_index = (worker_index >= 0)
+    ? static_cast<uint32_t>(worker_index)
+    : next_queue_.fetch_add(1u, std::memory_order_relaxed) % worker_count()
+    ;
+
+  // Counted before being published, so a thief never decrements it first.
+  pending_count_.fetch_add(1u, std::memory_order_release);
+  {
+    auto& queue = queues_[queue_index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.jobs.push_back(std::move(job));
+  }
+
+  // Synchronize with sleeping workers to avoid a lost wake-up.
+  { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+  sleep_cv_.notify_one();
+}
+
+// ----------------------------------------------------------------------------
+
+int32_t JobSystem::WorkerIndex() noexcept {
+  return tWorkerIndex;
+}
+
+// ----------------------------------------------------------------------------
+
+void JobSystem::worker_loop(uint32_t worker_index) {
+  tWorkerIndex = static_cast<int32_t>(worker_index);
+
+  for (;;) {
+    if (Job job = pop_job(tWorkerIndex); job) {
+      job();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    sleep_cv_.wait(lock, [this] {
+      return stop_.load(std::memory_order_acquire)
+          || (pending_count_.load(std::memory_order_acquire) > 0u);
+    });
+
+    // Drain remaining jobs before leaving.
+    if (stop_.load(std::memory_order_acquire)
+     && (pending_count_.load(std::memory_order_acquire) == 0u)) {
+      break;
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+JobSystem::Job JobSystem::pop_job(int32_t worker_index) {
+  if (pending_count_.load(std::memory_order_acquire) == 0u) {
+    return {};
+  }
+
+  uint32_t const count = worker_count();
+  uint32_t const first = (worker_index >= 0) ? static_cast<uint32_t>(worker_index) : 0u;
+
+  for (uint32_t i = 0u; i < count; ++i) {
+    uint32_t const queue_index = (first + i) % count;
+    bool const is_own_queue = (static_cast<int32_t>(queue_index) == worker_index);
+
+    auto& queue = queues_[queue_index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty()) {
+      continue;
+    }
+
+    // Own jobs are taken LIFO for locality, stolen jobs FIFO.
+    Job job{};
+    if (is_own_queue) {
+      job = std::move(queue.jobs.back());
+      queue.jobs.pop_back();
+    } else {
+      job = std::move(queue.jobs.front());
+      queue.jobs.pop_front();
+    }
+    pending_count_.fetch_sub(1u, std::memory_order_acq_rel);
+    return job;
+  }
+
+  return {};
+}
+
+/* -------------------------------------------------------------------------- */
+
+} // namespace "utils"
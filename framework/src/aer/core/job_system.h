@@ -0,0 +1,316 @@
+#ifndef AER_CORE_JOB_SYSTEM_H_
+#define AER_CORE_JOB_SYSTEM_H_
+
+/* -------------------------------------------------------------------------- */
+//
+//    job_system.h
+//
+//  Fixed pool of worker threads with per-worker deques and work stealing.
+//
+//  Workers push and pop their own jobs LIFO and steal others' FIFO, jobs
+//  submitted from outside the pool are spread round-robin across deques.
+//
+//  Waiting never executes unrelated jobs : a Task not started yet is run
+//  inline by its waiter, otherwise the waiter blocks until it completes.
+//  As a job only waits on jobs submitted before it, tasks can safely wait
+//  on other tasks, and a waiting thread is never stalled by a foreign job
+//  (eg. the render thread by a scene load).
+//
+/* -------------------------------------------------------------------------- */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "aer/core/singleton.h"
+
+namespace utils {
+
+/* -------------------------------------------------------------------------- */
+
+template<typename T> class Task;
+
+// ----------------------------------------------------------------------------
+
+class JobSystem final : public Singleton<JobSystem> {
+  friend class Singleton<JobSystem>;
+
+ public:
+  // Type erased, move-only, callable.
+  class Job {
+   public:
+    Job() = default;
+
+    template<typename Fn>
+    requires (!std::is_same_v<std::decay_t<Fn>, Job>)
+    Job(Fn&& fn)
+      : self_(std::make_unique<Model<std::decay_t<Fn>>>(std::forward<Fn>(fn)))
+    {}
+
+    void operator()() {
+      self_->run();
+    }
+
+    explicit operator bool() const noexcept {
+      return self_ != nullptr;
+    }
+
+   private:
+    struct Concept {
+      virtual ~Concept() = default;
+      virtual void run() = 0;
+    };
+
+    template<typename Fn>
+    struct Model final : Concept {
+      explicit Model(Fn&& _fn) : fn(std::move(_fn)) {}
+      explicit Model(Fn const& _fn) : fn(_fn) {}
+      void run() final { fn(); }
+      Fn fn;
+    };
+
+    std::unique_ptr<Concept> self_{};
+  };
+
+  /* Job shared by its queue entry and its waiters, run by whichever claims it first. */
+  class ClaimableJob {
+   public:
+    explicit ClaimableJob(Job job)
+      : job_(std::move(job))
+    {}
+
+    /* Run the job unless already claimed, return false when it was. */
+    bool try_run() {
+      if (claimed_.exchange(true, std::memory_order_acq_rel)) {
+        return false;
+      }
+      Job job{ std::move(job_) };
+      job();
+      return true;
+    }
+
+   private:
+    std::atomic<bool> claimed_{false};
+    Job job_{};
+  };
+
+ public:
+  ~JobSystem();
+
+  /* Submit a fire-and-forget job. */
+  void submit(Job job);
+
+  /* Submit a job and retrieve its result, or its exception, as a Task. */
+  template<typename Fn, typename R = std::invoke_result_t<std::decay_t<Fn>>>
+  Task<R> async(Fn&& fn) {
+    std::promise<R> promise{};
+    std::future<R> future{ promise.get_future() };
+    auto claimable = std::make_shared<ClaimableJob>(
+      Job([promise = std::move(promise), fn = std::forward<Fn>(fn)]() mutable {
+        try {
+          if constexpr (std::is_void_v<R>) {
+            fn();
+            promise.set_value();
+          } else {
+            promise.set_value(fn());
+          }
+        } catch (...) {
+          promise.set_exception(std::current_exception());
+        }
+      })
+    );
+    submit([claimable] { claimable->try_run(); });
+    return Task<R>(std::move(future), std::move(claimable));
+  }
+
+  /**
+   * Call fn(index) for every index in [begin, end), split in chunks of at
+   * least 'grain' indices across the pool, and return once all are done.
+   *
+   * Chunks are claimed from a shared counter : the caller only runs chunks
+   * of this loop, then blocks on the ones still running elsewhere. The first
+   * exception thrown by 'fn' is rethrown to the caller once all are done.
+   **/
+  template<typename Fn>
+  void parallel_for(uint32_t begin, uint32_t end, Fn&& fn, uint32_t grain = 1u) {
+    if (begin >= end) {
+      return;
+    }
+    uint32_t const count = end - begin;
+    uint32_t const target_chunks = 4u * worker_count();
+    uint32_t const chunk_size = std::max(std::max(grain, 1u), (count + target_chunks - 1u) / target_chunks);
+    uint32_t const chunk_count = (count + chunk_size - 1u) / chunk_size;
+
+    // Shared with the helper jobs, which might only be dequeued once the
+    // loop returned : they then find no chunk left and never touch 'fn'.
+    struct Loop {
+      std::atomic<uint32_t> next_chunk{0u};
+      std::atomic<uint32_t> remaining{0u};
+      std::mutex exception_mutex{};
+      std::exception_ptr exception{};
+    };
+    auto loop = std::make_shared<Loop>();
+    loop->remaining.store(chunk_count, std::memory_order_relaxed);
+
+    auto run_chunks{[begin, end, chunk_size, chunk_count, fn_ptr = &fn](Loop& l) {
+      for (;;) {
+        uint32_t const chunk = l.next_chunk.fetch_add(1u, std::memory_order_acq_rel);
+        if (chunk >= chunk_count) {
+          return;
+        }
+        uint32_t const first = begin + chunk * chunk_size;
+        uint32_t const last = std::min(first + chunk_size, end);
+        try {
+          for (uint32_t i = first; i < last; ++i) {
+            (*fn_ptr)(i);
+          }
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(l.exception_mutex);
+          if (!l.exception) {
+            l.exception = std::current_exception();
+          }
+        }
+        if (l.remaining.fetch_sub(1u, std::memory_order_acq_rel) == 1u) {
+          l.remaining.notify_all();
+        }
+      }
+    }};
+
+    // The calling thread takes chunks too, so one helper less is needed.
+    uint32_t const helper_count = std::min(chunk_count, worker_count() + 1u) - 1u;
+    for (uint32_t i = 0u; i < helper_count; ++i) {
+      submit([loop, run_chunks] { run_chunks(*loop); });
+    }
+    run_chunks(*loop);
+
+    for (uint32_t r = loop->remaining.load(std::memory_order_acquire); r > 0u;
+         r = loop->remaining.load(std::memory_order_acquire)) {
+      loop->remaining.wait(r, std::memory_order_acquire);
+    }
+    if (loop->exception) {
+      std::rethrow_exception(loop->exception);
+    }
+  }
+
+  [[nodiscard]]
+  uint32_t worker_count() const noexcept {
+    return static_cast<uint32_t>(workers_.size());
+  }
+
+  /* Return the index of the calling worker, or -1 outside the pool. */
+  [[nodiscard]]
+  static int32_t WorkerIndex() noexcept;
+
+ private:
+  // Use 0 to match the hardware concurrency.
+  explicit JobSystem(uint32_t worker_count = 0u);
+
+  struct alignas(64) WorkQueue {
+    std::mutex mutex{};
+    std::deque<Job> jobs{};
+  };
+
+  void worker_loop(uint32_t worker_index);
+
+  Job pop_job(int32_t worker_index);
+
+ private:
+  std::vector<std::thread> workers_{};
+  std::unique_ptr<WorkQueue[]> queues_{};
+
+  std::atomic<uint32_t> pending_count_{0u};
+  std::atomic<uint32_t> next_queue_{0u};
+  std::atomic<bool> stop_{false};
+
+  std::mutex sleep_mutex_{};
+  std::condition_variable sleep_cv_{};
+};
+
+// ----------------------------------------------------------------------------
+
+/**
+ * Pending result of an async job.
+ *
+ * Waiting on it runs the job inline when no worker started it yet, so a job
+ * can wait on another without holding a worker idle nor running other jobs.
+ * Without a job (std::async fallback) it only wraps its future.
+ **/
+template<typename T>
+class Task {
+ public:
+  Task() = default;
+
+  explicit Task(
+    std::future<T> future,
+    std::shared_ptr<JobSystem::ClaimableJob> job = {}
+  ) : future_(std::move(future))
+    , job_(std::move(job))
+  {}
+
+  [[nodiscard]]
+  bool valid() const noexcept {
+    return future_.valid();
+  }
+
+  template<typename Rep, typename Period>
+  std::future_status wait_for(std::chrono::duration<Rep, Period> const& duration) const {
+    return future_.wait_for(duration);
+  }
+
+  void wait() {
+    run_if_pending();
+    future_.wait();
+  }
+
+  T get() {
+    run_if_pending();
+    return future_.get();
+  }
+
+ private:
+  void run_if_pending() {
+    if (job_) {
+      job_->try_run();
+      job_.reset();
+    }
+  }
+
+  std::future<T> future_{};
+  std::shared_ptr<JobSystem::ClaimableJob> job_{};
+};
+
+// ----------------------------------------------------------------------------
+
+/* Retrieve a task result, running it inline when it was not started yet. */
+template<typename T>
+T WaitTask(Task<T>& task) {
+  return task.get();
+}
+
+/* Parallel loop over [begin, end), serial when the job system is not running. */
+template<typename Fn>
+void ParallelFor(uint32_t begin, uint32_t end, Fn&& fn, uint32_t grain = 1u) {
+  if (JobSystem::IsInitialized()) {
+    JobSystem::Get().parallel_for(begin, end, std::forward<Fn>(fn), grain);
+  } else {
+    for (uint32_t i = begin; i < end; ++i) {
+      fn(i);
+    }
+  }
+}
+
+/* -------------------------------------------------------------------------- */
+
+} // namespace "utils"
+
+#endif // AER_CORE_JOB_SYSTEM_H_
@@ -0,0 +1,191 @@
+#include "aer/core/mapped_file.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "aer/core/logger.h"
+#include "aer/core/utils.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif !defined(ANDROID)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+namespace utils {
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    close();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0u);
+#if defined(_WIN32)
+    file_handle_ = std::exchange(other.file_handle_, nullptr);
+    mapping_handle_ = std::exchange(other.mapping_handle_, nullptr);
+#endif
+    // (moving a vector keeps its storage, so data_ stays valid)
+    fallback_ = std::move(other.fallback_);
+  }
+  return *this;
+}
+
+// ----------------------------------------------------------------------------
+
+bool MappedFile::open(std::string_view filename, AccessHint hint) {
+  close();
+
+  // (string_view are not guaranteed to be null-terminated)
+  std::string const path(filename);
+
+#if defined(ANDROID)
+  // APK assets cannot be mapped directly, read them instead.
+  if (!FileReader::Read(path, fallback_) || fallback_.empty()) {
+    fallback_.clear();
+    return false;
+  }
+  data_ = fallback_.data();
+  size_ = fallback_.size();
+
+#elif defined(_WIN32)
+  HANDLE file = CreateFileA(
+    path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr
+  );
+  if (file == INVALID_HANDLE_VALUE) {
+    LOGW("MappedFile: \"{}\" not found.", path);
+    return false;
+  }
+
+  LARGE_INTEGER filesize{};
+  if (!GetFileSizeEx(file, &filesize) || (filesize.QuadPart == 0)) {
+    LOGW("MappedFile: \"{}\" is empty or its size is unknown.", path);
+    CloseHandle(file);
+    return false;
+  }
+
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  void const* ptr = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+  if (!ptr) {
+    LOGE("MappedFile: failed to map \"{}\".", path);
+    if (mapping) {
+      CloseHandle(mapping);
+    }
+    CloseHandle(file);
+    return false;
+  }
+
+  file_handle_ = file;
+  mapping_handle_ = mapping;
+  data_ = static_cast<uint8_t const*>(ptr);
+  size_ = static_cast<size_t>(filesize.QuadPart);
+
+#else
+  int const fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    LOGW("MappedFile: \"{}\" not found.", path);
+    return false;
+  }
+
+  struct stat st{};
+  if ((::fstat(fd, &st) != 0) || (st.st_size <= 0)) {
+    LOGW("MappedFile: \"{}\" is empty or its size is unknown.", path);
+    ::close(fd);
+    return false;
+  }
+
+  size_t const filesize = static_cast<size_t>(st.st_size);
+  void *ptr = ::mmap(nullptr, filesize, PROT_READ, MAP_PRIVATE, fd, 0);
+
+  // The mapping stays valid once the descriptor is closed.
+  ::close(fd);
+
+  if (ptr == MAP_FAILED) {
+    LOGE("MappedFile: failed to map \"{}\".", path);
+    return false;
+  }
+
+  data_ = static_cast<uint8_t const*>(ptr);
+  size_ = filesize;
+#endif
+
+  if (hint != AccessHint::Normal) {
+    advise(hint);
+  }
+
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+void MappedFile::close() {
+  if (!data_) {
+    return;
+  }
+
+#if defined(ANDROID)
+  fallback_.clear();
+  fallback_.shrink_to_fit();
+#elif defined(_WIN32)
+  UnmapViewOfFile(data_);
+  CloseHandle(static_cast<HANDLE>(mapping_handle_));
+  CloseHandle(static_cast<HANDLE>(file_handle_));
+  mapping_handle_ = nullptr;
+  file_handle_ = nullptr;
+#else
+  ::munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+
+  data_ = nullptr;
+  size_ = 0u;
+}
+
+// ----------------------------------------------------------------------------
+
+void MappedFile::advise(AccessHint hint, size_t offset, size_t length) const {
+  if (!data_ || (offset >= size_)) {
+    return;
+  }
+  length = std::min(length, size_ - offset);
+
+#if defined(ANDROID)
+  // (already resident in memory)
+#elif defined(_WIN32)
+  if (hint == AccessHint::WillNeed || hint == AccessHint::Sequential) {
+    WIN32_MEMORY_RANGE_ENTRY range{
+      .VirtualAddress = const_cast<uint8_t*>(data_ + offset),
+      .NumberOfBytes = length,
+    };
+    PrefetchVirtualMemory(GetCurrentProcess(), 1u, &range, 0u);
+  }
+#else
+  int advice = MADV_NORMAL;
+  switch (hint) {
+    case AccessHint::Sequential:  advice = MADV_SEQUENTIAL;  break;
+    case AccessHint::Random:      advice = MADV_RANDOM;      break;
+    case AccessHint::WillNeed:    advice = MADV_WILLNEED;    break;
+    default:                                                 break;
+  }
+
+  // madvise expects a page aligned address.
+  static size_t const kPageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  size_t const aligned_offset = offset & ~(kPageSize - 1u);
+  length += offset - aligned_offset;
+
+  if (::madvise(const_cast<uint8_t*>(data_ + aligned_offset), length, advice) != 0) {
+    LOGD("MappedFile: madvise failed.");
+  }
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+} // namespace "utils"
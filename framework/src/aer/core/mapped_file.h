@@ -0,0 +1,103 @@
+#ifndef AER_CORE_MAPPED_FILE_H_
+#define AER_CORE_MAPPED_FILE_H_
+
+/* -------------------------------------------------------------------------- */
+//
+//    mapped_file.h
+//
+//  Read-only memory mapping of a whole file.
+//
+/* -------------------------------------------------------------------------- */
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace utils {
+
+/* -------------------------------------------------------------------------- */
+
+class MappedFile {
+ public:
+  /* Expected access pattern, forwarded to the kernel as a paging hint. */
+  enum class AccessHint {
+    Normal,
+    Sequential,
+    Random,
+    WillNeed,
+  };
+
+ public:
+  MappedFile() = default;
+
+  explicit MappedFile(std::string_view filename, AccessHint hint = AccessHint::Normal) {
+    open(filename, hint);
+  }
+
+  ~MappedFile() {
+    close();
+  }
+
+  MappedFile(MappedFile const&) = delete;
+  MappedFile& operator=(MappedFile const&) = delete;
+
+  MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+  }
+
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  /* Map the whole file in memory, return false on failure. */
+  bool open(std::string_view filename, AccessHint hint = AccessHint::Normal);
+
+  /* Unmap the file, invalidating every pointer into it. */
+  void close();
+
+  /* Hint the access pattern of the whole file, or of a byte range. */
+  void advise(AccessHint hint) const {
+    advise(hint, 0u, size_);
+  }
+
+  void advise(AccessHint hint, size_t offset, size_t length) const;
+
+  [[nodiscard]]
+  bool is_open() const noexcept {
+    return data_ != nullptr;
+  }
+
+  [[nodiscard]]
+  uint8_t const* data() const noexcept {
+    return data_;
+  }
+
+  [[nodiscard]]
+  size_t size() const noexcept {
+    return size_;
+  }
+
+  [[nodiscard]]
+  std::span<uint8_t const> bytes() const noexcept {
+    return { data_, size_ };
+  }
+
+ private:
+  uint8_t const* data_{};
+  size_t size_{};
+
+#if defined(_WIN32)
+  void* file_handle_{};
+  void* mapping_handle_{};
+#endif
+
+  // Fallback storage when the platform cannot map the file (eg. Android assets).
+  std::vector<uint8_t> fallback_{};
+};
+
+/* -------------------------------------------------------------------------- */
+
+} // namespace "utils"
+
+#endif // AER_CORE_MAPPED_FILE_H_
@@ -25,6 +25,11 @@ class Singleton // : public non_copyable<Singleton<T>>
     }
   }
 
+  static
+  bool IsInitialized() {
+    return sInstance != nullptr;
+  }
+
   static
   T& Get() {
     assert(sInstance != nullptr);
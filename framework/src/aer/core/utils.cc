@@ -24,10 +24,7 @@ bool FileReader::Read(std::string_view filename, std::vector<uint8_t>& out) {
   }
 
   std::size_t filesize = file.tellg();
-  if (filesize > kMaxReadFileSize) {
-    std::cerr << "[WARNING] Read size exceed for \"" << filename << "\"." << std::endl;
-    return false;
-  } else if (filesize == static_cast<std::size_t>(-1)) {
+  if (filesize == static_cast<std::size_t>(-1)) {
     std::cerr << "[ERROR] Unable to determine file size for \"" << filename << "\"." << std::endl;
     return false;
   }
@@ -18,15 +18,16 @@
 #include <future>
 #include <functional>
 
+#include "aer/core/job_system.h"
+
 /* -------------------------------------------------------------------------- */
 
 namespace utils {
 
 // --- structs ---
 
+// (prefer utils::MappedFile for large read-only files)
 struct FileReader {
-  static constexpr std::size_t kMaxReadFileSize = 4 << 27; // ~512Mib
-
   FileReader() = default;
 
   static
@@ -60,9 +61,13 @@ size_t HashCombine(size_t seed, auto const& value) {
   return seed ^ (std::hash<std::decay_t<decltype(value)>>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2));
 }
 
+// Run on the job system when initialized, otherwise on a dedicated thread.
 template <typename T>
-inline auto RunTaskGeneric = [](auto&& fn) -> std::future<T> {
-  return std::async(std::launch::async, std::forward<decltype(fn)>(fn));
+inline auto RunTaskGeneric = [](auto&& fn) -> Task<T> {
+  if (JobSystem::IsInitialized()) {
+    return JobSystem::Get().async(std::forward<decltype(fn)>(fn));
+  }
+  return Task<T>(std::async(std::launch::async, std::forward<decltype(fn)>(fn)));
 };
 
 template<typename T>
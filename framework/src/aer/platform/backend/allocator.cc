@@ -41,7 +41,8 @@ backend::Buffer ResourceAllocator::create_buffer(
   VkDeviceSize size,
   VkBufferUsageFlags2KHR usage,
   VmaMemoryUsage memory_usage,
-  VmaAllocationCreateFlags flags
+  VmaAllocationCreateFlags flags,
+  VkMemoryPropertyFlags required_flags
 ) const {
   backend::Buffer buffer{};
 
@@ -69,6 +70,7 @@ backend::Buffer ResourceAllocator::create_buffer(
   VmaAllocationCreateInfo alloc_create_info{
     .flags = flags,
     .usage = memory_usage,
+    .requiredFlags = required_flags,
   };
   VmaAllocationInfo result_alloc_info{};
   CHECK_VK(vmaCreateBuffer(
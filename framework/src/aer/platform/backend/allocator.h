@@ -30,7 +30,8 @@ class ResourceAllocator {
     VkDeviceSize const size,
     VkBufferUsageFlags2KHR const usage,   // !! require maintenance5 !!
     VmaMemoryUsage const memory_usage = VMA_MEMORY_USAGE_AUTO,
-    VmaAllocationCreateFlags const flags = {}
+    VmaAllocationCreateFlags const flags = {},
+    VkMemoryPropertyFlags const required_flags = {}
   ) const;
 
   // [should return a std::unique_ptr !!]
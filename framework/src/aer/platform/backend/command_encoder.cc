@@ -10,7 +10,8 @@ void GenericCommandEncoder::bind_descriptor_set(
   VkDescriptorSet descriptor_set,
   VkPipelineLayout pipeline_layout,
   VkShaderStageFlags stage_flags,
-  uint32_t first_set
+  uint32_t first_set,
+  std::vector<uint32_t> const& dynamic_offsets
 ) const {
   if (vkCmdBindDescriptorSets2KHR)
   {
@@ -22,6 +23,8 @@ void GenericCommandEncoder::bind_descriptor_set(
       .firstSet = first_set,
       .descriptorSetCount = 1u, //
       .pDescriptorSets = &descriptor_set,
+      .dynamicOffsetCount = static_cast<uint32_t>(dynamic_offsets.size()),
+      .pDynamicOffsets = dynamic_offsets.data(),
     };
     vkCmdBindDescriptorSets2KHR(command_buffer_, &bind_desc_sets_info);
   }
@@ -34,8 +37,8 @@ void GenericCommandEncoder::bind_descriptor_set(
       first_set,
       1,
       &descriptor_set,
-      0,
-      nullptr
+      static_cast<uint32_t>(dynamic_offsets.size()),
+      dynamic_offsets.data()
     );
   }
 }
@@ -135,13 +138,21 @@ size_t CommandEncoder::copy_buffer(backend::Buffer const& src, size_t src_offset
 // ----------------------------------------------------------------------------
 
 void CommandEncoder::transition_images_layout(std::vector<backend::Image> const& images, VkImageLayout const src_layout, VkImageLayout const dst_layout) const {
-  /// [devnote] This is an helper method to transition multiple 2d single layer,
-  //      single level images, using the default VkImageMemoryBarrier2 params
-  //      as defined in 'GenericCommandEncoder::pipeline_image_barriers'.
+  /// [devnote] This is an helper method to transition multiple 2d single layer
+  //      color images with all their mip levels, using the default
+  //      VkImageMemoryBarrier2 params as defined in
+  //      'GenericCommandEncoder::pipeline_image_barriers'.
 
   VkImageMemoryBarrier2 const barrier2{
     .oldLayout = src_layout,
     .newLayout = dst_layout,
+    .subresourceRange = {
+      .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+      .baseMipLevel = 0u,
+      .levelCount = VK_REMAINING_MIP_LEVELS,
+      .baseArrayLayer = 0u,
+      .layerCount = 1u,
+    },
   };
   std::vector<VkImageMemoryBarrier2> barriers(images.size(), barrier2);
   for (size_t i = 0u; i < images.size(); ++i) {
@@ -233,6 +244,63 @@ void CommandEncoder::blit(PostFxInterface const& fx_src, backend::RTInterface co
 
 // ----------------------------------------------------------------------------
 
+void CommandEncoder::generate_mipmaps(backend::Image const& image, VkExtent2D const& extent, uint32_t const level_count) const {
+  auto level_barrier{[&image](uint32_t level) {
+    return VkImageMemoryBarrier2{
+      .oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+      .newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+      .image = image.image,
+      .subresourceRange = {
+        .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+        .baseMipLevel = level,
+        .levelCount = 1u,
+        .baseArrayLayer = 0u,
+        .layerCount = 1u,
+      },
+    };
+  }};
+
+  int32_t width = static_cast<int32_t>(extent.width);
+  int32_t height = static_cast<int32_t>(extent.height);
+  for (uint32_t level = 1u; level < level_count; ++level) {
+    int32_t const next_width = std::max(width / 2, 1);
+    int32_t const next_height = std::max(height / 2, 1);
+
+    // (each level is read once the previous blit has written it)
+    pipeline_image_barriers({ level_barrier(level - 1u) });
+
+    VkImageBlit const blit_region{
+      .srcSubresource = {
+        .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+        .mipLevel = level - 1u,
+        .baseArrayLayer = 0u,
+        .layerCount = 1u,
+      },
+      .srcOffsets = { {0, 0, 0}, {width, height, 1} },
+      .dstSubresource = {
+        .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+        .mipLevel = level,
+        .baseArrayLayer = 0u,
+        .layerCount = 1u,
+      },
+      .dstOffsets = { {0, 0, 0}, {next_width, next_height, 1} },
+    };
+    vkCmdBlitImage(
+      command_buffer_,
+      image.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+      image.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+      1u, &blit_region,
+      VK_FILTER_LINEAR
+    );
+
+    width = next_width;
+    height = next_height;
+  }
+  pipeline_image_barriers({ level_barrier(level_count - 1u) });
+}
+
+// ----------------------------------------------------------------------------
+
 void CommandEncoder::transfer_host_to_device(
   void const* host_data,
   size_t const host_data_size,
@@ -483,16 +551,7 @@ void RenderPassEncoder::draw(
   backend::Buffer const& index_buffer
 ) const {
   // Vertex Input.
-  {
-    auto const& vi{desc.vertexInput};
-
-    // (shoud be disabled when vertex input is not dynamic)
-    set_vertex_input(vi);
-
-    for (size_t i = 0; i < vi.bindings.size(); ++i) {
-      bind_vertex_buffer(vertex_buffer, vi.bindings[i].binding, vi.vertexBufferOffsets[i]);
-    }
-  }
+  bind_vertex_input(desc, vertex_buffer);
 
   // Topology.
   // set_primitive_topology(desc.topology);
@@ -506,4 +565,55 @@ void RenderPassEncoder::draw(
   }
 }
 
+// ----------------------------------------------------------------------------
+
+void RenderPassEncoder::draw_index_range(
+  DrawDescriptor const& desc,
+  backend::Buffer const& vertex_buffer,
+  backend::Buffer const& index_buffer,
+  uint64_t const index_offset,
+  uint32_t const index_count
+) const {
+  LOG_CHECK(desc.indexCount > 0u);
+
+  bind_vertex_input(desc, vertex_buffer);
+  bind_index_buffer(index_buffer, desc.indexType, index_offset);
+  draw_indexed(index_count, desc.instanceCount);
+}
+
+// ----------------------------------------------------------------------------
+
+void RenderPassEncoder::draw_indirect_count(
+  DrawDescriptor const& desc,
+  backend::Buffer const& vertex_buffer,
+  backend::Buffer const& index_buffer,
+  backend::Buffer const& indirect_buffer,
+  uint64_t const indirect_offset,
+  backend::Buffer const& count_buffer,
+  uint64_t const count_offset,
+  uint32_t const max_draw_count
+) const {
+  LOG_CHECK(desc.indexCount > 0u);
+
+  bind_vertex_input(desc, vertex_buffer);
+  bind_index_buffer(index_buffer, desc.indexType, desc.indexOffset);
+  draw_indexed_indirect_count(indirect_buffer, indirect_offset, count_buffer, count_offset, max_draw_count);
+}
+
+// ----------------------------------------------------------------------------
+
+void RenderPassEncoder::bind_vertex_input(
+  DrawDescriptor const& desc,
+  backend::Buffer const& vertex_buffer
+) const {
+  auto const& vi{desc.vertexInput};
+
+  // (shoud be disabled when vertex input is not dynamic)
+  set_vertex_input(vi);
+
+  for (size_t i = 0; i < vi.bindings.size(); ++i) {
+    bind_vertex_buffer(vertex_buffer, vi.bindings[i].binding, vi.vertexBufferOffsets[i]);
+  }
+}
+
 /* -------------------------------------------------------------------------- */
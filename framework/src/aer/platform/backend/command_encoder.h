@@ -53,7 +53,8 @@ class GenericCommandEncoder {
     VkDescriptorSet descriptor_set,
     VkPipelineLayout pipeline_layout,
     VkShaderStageFlags stage_flags,
-    uint32_t first_set = 0u
+    uint32_t first_set = 0u,
+    std::vector<uint32_t> const& dynamic_offsets = {}
   ) const;
 
   void bind_descriptor_set(
@@ -285,6 +286,17 @@ class CommandEncoder : public GenericCommandEncoder {
     backend::RTInterface const& rt_dst
   ) const;
 
+  /**
+   * Fill the levels [1, level_count) of a 2d image by successive linear
+   * blits from its base level. Every level is expected in the transfer dst
+   * layout, and is left in the transfer src one.
+   **/
+  void generate_mipmaps(
+    backend::Image const& image,
+    VkExtent2D const& extent,
+    uint32_t level_count
+  ) const;
+
   // --- Rendering ---
 
   /* Dynamic rendering. */
@@ -354,6 +366,8 @@ class CommandEncoder : public GenericCommandEncoder {
  public:
   friend class Context;
   friend class Renderer;
+  friend class SceneStreamer;
+  friend class TransferContext;
 };
 
 /* -------------------------------------------------------------------------- */
@@ -428,10 +442,53 @@ class RenderPassEncoder : public GenericCommandEncoder {
     vkCmdDrawIndexed(command_buffer_, index_count, instance_count, first_index, vertex_offset, first_instance);
   }
 
+  void draw_indexed_indirect_count(
+    backend::Buffer const& buffer,
+    uint64_t const offset,
+    backend::Buffer const& count_buffer,
+    uint64_t const count_offset,
+    uint32_t const max_draw_count,
+    uint32_t const stride = sizeof(VkDrawIndexedIndirectCommand)
+  ) const {
+    // VK_KHR_draw_indirect_count or VK_VERSION_1_2 (see Context::has_draw_indirect_count)
+    vkCmdDrawIndexedIndirectCountKHR(
+      command_buffer_,
+      buffer.buffer, offset,
+      count_buffer.buffer, count_offset,
+      max_draw_count, stride
+    );
+  }
+
   // [WIP]
   void draw(DrawDescriptor const& desc, backend::Buffer const& vertex_buffer, backend::Buffer const& index_buffer) const;
 
+  /* Draw another range of the index buffer with the descriptor vertices (eg. a LOD level). */
+  void draw_index_range(
+    DrawDescriptor const& desc,
+    backend::Buffer const& vertex_buffer,
+    backend::Buffer const& index_buffer,
+    uint64_t index_offset,
+    uint32_t index_count
+  ) const;
+
+  /**
+   * Draw an indexed descriptor with device generated commands, whose firstIndex
+   * are relative to the descriptor index offset.
+   **/
+  void draw_indirect_count(
+    DrawDescriptor const& desc,
+    backend::Buffer const& vertex_buffer,
+    backend::Buffer const& index_buffer,
+    backend::Buffer const& indirect_buffer,
+    uint64_t indirect_offset,
+    backend::Buffer const& count_buffer,
+    uint64_t count_offset,
+    uint32_t max_draw_count
+  ) const;
+
  private:
+  void bind_vertex_input(DrawDescriptor const& desc, backend::Buffer const& vertex_buffer) const;
+
   RenderPassEncoder(VkCommandBuffer const command_buffer, uint32_t target_queue_index)
     : GenericCommandEncoder(command_buffer, target_queue_index)
   {}
@@ -46,6 +46,14 @@ bool Context::init(
     .instance = instance_,
   });
 
+  transfer_context_ = std::make_unique<TransferContext>();
+  transfer_context_->init(
+    device_,
+    resource_allocator_.get(),
+    queue(TargetQueue::Transfer),
+    queue(TargetQueue::Main)
+  );
+
   LOGD("--------------------------------------------\n");
 
   return true;
@@ -56,6 +64,7 @@ bool Context::init(
 void Context::deinit() {
   vkDeviceWaitIdle(device_);
 
+  transfer_context_->release();
   resource_allocator_->deinit();
   for (auto &pool : transient_command_pools_) {
     vkDestroyCommandPool(device_, pool, nullptr); //
@@ -79,9 +88,7 @@ backend::Image Context::create_image_2d(
 ) const {
   LOG_CHECK( width > 0 && height > 0 );
   LOG_CHECK( array_layers > 0 );
-
-  // [todo]
-  LOG_CHECK(levels == 1u);
+  LOG_CHECK( levels > 0 );
 
   VkImageUsageFlags usage{
       VK_IMAGE_USAGE_SAMPLED_BIT
@@ -226,20 +233,42 @@ CommandEncoder Context::create_transient_command_encoder(Context::TargetQueue co
 // ----------------------------------------------------------------------------
 
 void Context::finish_transient_command_encoder(CommandEncoder const& encoder) const {
-  encoder.end();
-
   VkFenceCreateInfo const fence_info{
     .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
   };
   VkFence fence;
   CHECK_VK( vkCreateFence(device_, &fence_info, nullptr, &fence) );
 
+  submit_transient_command_encoder(encoder, fence);
+
+  CHECK_VK( vkWaitForFences(device_, 1u, &fence, VK_TRUE, UINT64_MAX) );
+  vkDestroyFence(device_, fence, nullptr);
+
+  release_transient_command_encoder(encoder);
+}
+
+// ----------------------------------------------------------------------------
+
+void Context::submit_transient_command_encoder(CommandEncoder const& encoder, VkFence fence) const {
+  encoder.end();
+
+  // Chain after the transfers already flushed, while they are still pending.
+  uint64_t const transfer_value{ transfer_context_->last_value() };
+  bool const wait_transfers{
+    (transfer_value > 0u) && !transfer_context_->completed(transfer_value)
+  };
+  VkSemaphoreSubmitInfo const transfer_wait_info{
+    transfer_context_->wait_semaphore_info(VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT)
+  };
+
   VkCommandBufferSubmitInfo const cb_submit_info{
     .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
     .commandBuffer = encoder.command_buffer_,
   };
   VkSubmitInfo2 const submit_info_2{
     .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+    .waitSemaphoreInfoCount = wait_transfers ? 1u : 0u,
+    .pWaitSemaphoreInfos = &transfer_wait_info,
     .commandBufferInfoCount = 1u,
     .pCommandBufferInfos = &cb_submit_info,
   };
@@ -249,10 +278,14 @@ void Context::finish_transient_command_encoder(CommandEncoder const& encoder) co
   };
 
   CHECK_VK( vkQueueSubmit2(queue(target_queue).queue, 1u, &submit_info_2, fence) );
+}
 
-  CHECK_VK( vkWaitForFences(device_, 1u, &fence, VK_TRUE, UINT64_MAX) );
-  vkDestroyFence(device_, fence, nullptr);
+// ----------------------------------------------------------------------------
 
+void Context::release_transient_command_encoder(CommandEncoder const& encoder) const {
+  auto const target_queue{
+    static_cast<TargetQueue>(encoder.target_queue_index())
+  };
   vkFreeCommandBuffers(device_, transient_command_pools_[target_queue], 1u, &encoder.command_buffer_);
 }
 
@@ -263,9 +296,8 @@ void Context::transition_images_layout(
   VkImageLayout const src_layout,
   VkImageLayout const dst_layout
 ) const {
-  auto cmd{ create_transient_command_encoder(TargetQueue::Transfer) };
-  cmd.transition_images_layout(images, src_layout, dst_layout);
-  finish_transient_command_encoder(cmd);
+  transfer_context_->transition_images_layout(images, src_layout, dst_layout);
+  transfer_context_->wait(transfer_context_->flush());
 }
 
 // ----------------------------------------------------------------------------
@@ -277,11 +309,19 @@ backend::Buffer Context::create_buffer_and_upload(
   size_t device_buffer_offset,
   size_t const device_buffer_size
 ) const {
-  auto cmd{ create_transient_command_encoder(TargetQueue::Transfer) };
-  backend::Buffer buffer{
-    cmd.create_buffer_and_upload(host_data, host_data_size, usage, device_buffer_offset, device_buffer_size)
-  };
-  finish_transient_command_encoder(cmd);
+  LOG_CHECK(host_data != nullptr);
+  LOG_CHECK(host_data_size > 0u);
+
+  size_t const buffer_bytesize = (device_buffer_size > 0) ? device_buffer_size : host_data_size;
+  LOG_CHECK(host_data_size <= buffer_bytesize);
+
+  backend::Buffer buffer{resource_allocator_->create_buffer(
+    static_cast<VkDeviceSize>(buffer_bytesize),
+    usage | VK_BUFFER_USAGE_2_TRANSFER_DST_BIT_KHR,
+    VMA_MEMORY_USAGE_GPU_ONLY
+  )};
+  transfer_context_->upload(host_data, host_data_size, buffer, device_buffer_offset);
+  transfer_context_->wait(transfer_context_->flush());
   return buffer;
 }
 
@@ -293,9 +333,8 @@ void Context::transfer_host_to_device(
   backend::Buffer const& device_buffer,
   size_t const device_buffer_offset
 ) const {
-  auto cmd{ create_transient_command_encoder(TargetQueue::Transfer) };
-  cmd.transfer_host_to_device(host_data, host_data_size, device_buffer, device_buffer_offset);
-  finish_transient_command_encoder(cmd);
+  transfer_context_->upload(host_data, host_data_size, device_buffer, device_buffer_offset);
+  transfer_context_->wait(transfer_context_->flush());
 }
 
 // ----------------------------------------------------------------------------
@@ -305,9 +344,8 @@ void Context::copy_buffer(
   backend::Buffer const& dst,
   size_t const buffersize
 ) const {
-  auto cmd{ create_transient_command_encoder(Context::TargetQueue::Transfer) };
-  cmd.copy_buffer(src, dst, buffersize);
-  finish_transient_command_encoder(cmd);
+  transfer_context_->copy_buffer(src, dst, buffersize);
+  transfer_context_->wait(transfer_context_->flush());
 }
 
 // ----------------------------------------------------------------------------
@@ -525,6 +563,16 @@ bool Context::init_device() {
   // }
 #endif
 
+  /* Optional device extensions, without features. */
+  draw_indirect_count_ = has_extension(
+    VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME, available_device_extensions_
+  );
+  if (draw_indirect_count_) {
+    device_extension_names_.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+  } else {
+    LOGI("[Vulkan] Extension \"{:s}\" is not available.\n", VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+  }
+
   /* Vulkan GPU features. */
   {
     add_device_feature(
@@ -533,6 +581,12 @@ bool Context::init_device() {
       VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTIVIEW_FEATURES
     );
 
+    add_device_feature(
+      VK_KHR_SHADER_DRAW_PARAMETERS_EXTENSION_NAME,
+      feature_.shader_draw_parameters,
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_DRAW_PARAMETERS_FEATURES
+    );
+
     add_device_feature(
       VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME,
       feature_.buffer_device_address,
@@ -657,6 +711,8 @@ bool Context::init_device() {
   enable_feature(feature_.descriptor_indexing.runtimeDescriptorArray);
   enable_feature(feature_.descriptor_indexing.shaderSampledImageArrayNonUniformIndexing);
   enable_feature(feature_.vertex_input_dynamic_state.vertexInputDynamicState);
+  enable_feature(feature_.shader_draw_parameters.shaderDrawParameters);
+  enable_feature(feature_.image_view_min_lod.minLod);
 
 #if !defined(ANDROID)
   enable_feature(feature_.ray_tracing_pipeline.rayTracingPipeline);
@@ -755,6 +811,7 @@ bool Context::init_device() {
   {
     auto bind_func{ [](auto & f1, auto & f2) { if (!f1) { f1 = f2; } } };
     bind_func(         vkWaitSemaphores, vkWaitSemaphoresKHR);
+    bind_func(vkGetSemaphoreCounterValue, vkGetSemaphoreCounterValueKHR);
     bind_func(    vkCmdPipelineBarrier2, vkCmdPipelineBarrier2KHR);
     bind_func(           vkQueueSubmit2, vkQueueSubmit2KHR);
     bind_func(      vkCmdBeginRendering, vkCmdBeginRenderingKHR);
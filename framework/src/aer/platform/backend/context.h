@@ -6,6 +6,7 @@
 #include "aer/platform/backend/types.h"
 #include "aer/platform/backend/command_encoder.h"
 #include "aer/platform/backend/allocator.h"
+#include "aer/platform/backend/transfer_context.h"
 
 #include "aer/platform/openxr/xr_vulkan_interface.h" //
 
@@ -57,6 +58,24 @@ class Context {
     return properties_;
   }
 
+  /* True when shaders can read gl_DrawID, as used by the GPU-driven draws. */
+  [[nodiscard]]
+  bool has_draw_parameters() const noexcept {
+    return feature_.shader_draw_parameters.shaderDrawParameters == VK_TRUE;
+  }
+
+  /* True when draws can read their count from a buffer, as used by the meshlet and draw culling. */
+  [[nodiscard]]
+  bool has_draw_indirect_count() const noexcept {
+    return draw_indirect_count_;
+  }
+
+  /* True when image views can clamp their sampled levels, as used by the texture streaming. */
+  [[nodiscard]]
+  bool has_image_view_min_lod() const noexcept {
+    return feature_.image_view_min_lod.minLod == VK_TRUE;
+  }
+
   [[nodiscard]]
   ResourceAllocator* allocator_ptr() noexcept {
     return resource_allocator_.get();
@@ -77,7 +96,19 @@ class Context {
     return *resource_allocator_;
   }
 
+  /* Batched transfers, to record deferred uploads, copies and transitions into. */
+  [[nodiscard]]
+  TransferContext& transfer_context() noexcept {
+    return *transfer_context_;
+  }
+
+  [[nodiscard]]
+  TransferContext const& transfer_context() const noexcept {
+    return *transfer_context_;
+  }
+
   void device_wait_idle() const {
+    transfer_context_->flush();
     CHECK_VK(vkDeviceWaitIdle(device_));
   }
 
@@ -137,7 +168,25 @@ class Context {
 
   void finish_transient_command_encoder(CommandEncoder const& encoder) const;
 
+  /**
+   * Submit a transient command encoder without waiting, 'fence' signaling its
+   * completion, after which it must be released. The submission waits on
+   * the transfers already flushed, when they are still pending.
+   *
+   * Transient pools are not synchronized: like the blocking version, this
+   * must be called from the thread recording the frames.
+   **/
+  void submit_transient_command_encoder(CommandEncoder const& encoder, VkFence fence) const;
+
+  void release_transient_command_encoder(CommandEncoder const& encoder) const;
+
   // --- Transient Command Encoder Wrappers ---
+  // [Blocking : flushed with the transfer context batch then waited for, the
+  //  written resources being owned by the Main queue family on return.
+  //  The deferred variants are the transfer_context() ones, submitted by its
+  //  next flush (at the latest when the frame ends, the frame submission
+  //  waiting on it) : prefer them for bulk data, keeping these for results
+  //  used straight away.]
 
   void transition_images_layout(
     std::vector<backend::Image> const& images,
@@ -257,6 +306,7 @@ class Context {
 
   // -----------------------------------------------
   std::vector<VkExtensionProperties> available_device_extensions_{};
+  bool draw_indirect_count_{};   // (VK_KHR_draw_indirect_count, optional)
 
   std::vector<char const*> instance_layer_names_{};
 
@@ -296,6 +346,7 @@ class Context {
     VkPhysicalDeviceImageViewMinLodFeaturesEXT image_view_min_lod{};
     VkPhysicalDevice16BitStorageFeaturesKHR storage_16bit{};
     VkPhysicalDeviceMultiviewFeaturesKHR multiview{};
+    VkPhysicalDeviceShaderDrawParametersFeatures shader_draw_parameters{};
     // VkPhysicalDeviceSwapchainMaintenance1FeaturesKHR swapchain_maintenance1{}; 
 
     // VK_VERSION_1_2
@@ -330,6 +381,7 @@ class Context {
   EnumArray<VkCommandPool, TargetQueue> transient_command_pools_{};
 
   std::unique_ptr<ResourceAllocator> resource_allocator_{}; //
+  std::unique_ptr<TransferContext> transfer_context_{};
 };
 
 /* -------------------------------------------------------------------------- */
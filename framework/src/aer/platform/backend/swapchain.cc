@@ -257,7 +257,11 @@ bool Swapchain::acquireNextImage() {
 
 // ----------------------------------------------------------------------------
 
-bool Swapchain::submitFrame(VkQueue queue, VkCommandBuffer command_buffer) {
+bool Swapchain::submitFrame(
+  VkQueue queue,
+  VkCommandBuffer command_buffer,
+  std::vector<VkSemaphoreSubmitInfo> const& extra_wait_semaphores
+) {
   LOG_CHECK(handle_ != VK_NULL_HANDLE);
 
   VkPipelineStageFlags2 constexpr kStageMask{
@@ -269,14 +273,20 @@ bool Swapchain::submitFrame(VkQueue queue, VkCommandBuffer command_buffer) {
   *signal_index += static_cast<uint64_t>(imageCount());
 
   // Semaphore(s) to wait for:
-  //    - Image available.
-  std::vector<VkSemaphoreSubmitInfo> const wait_semaphores{
+  //    - Image available,
+  //    - Caller ones (eg. pending transfers).
+  std::vector<VkSemaphoreSubmitInfo> wait_semaphores{
     {
       .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
       .semaphore = wait_image_semaphore(),
       .stageMask = kStageMask,
     },
   };
+  wait_semaphores.insert(
+    wait_semaphores.end(),
+    extra_wait_semaphores.cbegin(),
+    extra_wait_semaphores.cend()
+  );
 
   // Array of command buffers to submit (here, just one).
   std::vector<VkCommandBufferSubmitInfo> const cb_submit_infos{
@@ -43,7 +43,11 @@ class Swapchain : public SwapchainInterface {
   bool acquireNextImage() final;
 
   [[nodiscard]]
-  bool submitFrame(VkQueue queue, VkCommandBuffer command_buffer) final;
+  bool submitFrame(
+    VkQueue queue,
+    VkCommandBuffer command_buffer,
+    std::vector<VkSemaphoreSubmitInfo> const& wait_semaphores
+  ) final;
 
   [[nodiscard]]
   bool finishFrame(VkQueue queue) final;
@@ -0,0 +1,425 @@
+#include "aer/platform/backend/transfer_context.h"
+
+#include "aer/platform/backend/context.h"
+#include "aer/platform/backend/allocator.h"
+
+/* -------------------------------------------------------------------------- */
+
+void TransferContext::init(
+  VkDevice device,
+  ResourceAllocator* allocator_ptr,
+  backend::Queue const& transfer_queue,
+  backend::Queue const& main_queue
+) {
+  device_ = device;
+  allocator_ptr_ = allocator_ptr;
+  transfer_queue_ = transfer_queue;
+  main_queue_ = main_queue;
+
+  VkCommandPoolCreateInfo command_pool_create_info{
+    .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+    .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+  };
+  command_pool_create_info.queueFamilyIndex = transfer_queue_.family_index;
+  CHECK_VK(vkCreateCommandPool(device_, &command_pool_create_info, nullptr, &transfer_pool_));
+  command_pool_create_info.queueFamilyIndex = main_queue_.family_index;
+  CHECK_VK(vkCreateCommandPool(device_, &command_pool_create_info, nullptr, &main_pool_));
+
+  VkSemaphoreTypeCreateInfo const semaphore_type_create_info{
+    .sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+    .semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+    .initialValue = 0u,
+  };
+  VkSemaphoreCreateInfo const semaphore_create_info{
+    .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+    .pNext = &semaphore_type_create_info,
+  };
+  CHECK_VK(vkCreateSemaphore(device_, &semaphore_create_info, nullptr, &timeline_));
+  value_ = 0u;
+}
+
+// ----------------------------------------------------------------------------
+
+void TransferContext::release() {
+  if (device_ == VK_NULL_HANDLE) {
+    return;
+  }
+  wait_idle();
+  LOG_CHECK(batches_.empty());
+
+  vkDestroySemaphore(device_, timeline_, nullptr);
+  vkDestroyCommandPool(device_, main_pool_, nullptr);
+  vkDestroyCommandPool(device_, transfer_pool_, nullptr);
+  timeline_ = VK_NULL_HANDLE;
+  main_pool_ = VK_NULL_HANDLE;
+  transfer_pool_ = VK_NULL_HANDLE;
+  device_ = VK_NULL_HANDLE;
+}
+
+// ----------------------------------------------------------------------------
+
+CommandEncoder const& TransferContext::encoder() {
+  if (!recording_) {
+    encoder_ = CommandEncoder(
+      allocate_command_buffer(transfer_pool_),
+      static_cast<uint32_t>(Context::TargetQueue::Transfer),
+      device_,
+      allocator_ptr_
+    );
+    encoder_.begin();
+    recording_ = true;
+  }
+  return encoder_;
+}
+
+// ----------------------------------------------------------------------------
+
+CommandEncoder const& TransferContext::main_encoder() {
+  if (!main_recording_) {
+    main_encoder_ = CommandEncoder(
+      allocate_command_buffer(main_pool_),
+      static_cast<uint32_t>(Context::TargetQueue::Main),
+      device_,
+      allocator_ptr_
+    );
+    main_encoder_.begin();
+    main_recording_ = true;
+  }
+  return main_encoder_;
+}
+
+// ----------------------------------------------------------------------------
+
+backend::Buffer TransferContext::create_staging_buffer(uint64_t size) {
+  auto const staging_buffer{ allocator_ptr_->create_staging_buffer(size) };
+  staging_buffers_.push_back(staging_buffer);
+  return staging_buffer;
+}
+
+// ----------------------------------------------------------------------------
+
+void TransferContext::upload(
+  void const* host_data,
+  uint64_t host_data_size,
+  backend::Buffer const& device_buffer,
+  uint64_t device_buffer_offset
+) {
+  LOG_CHECK(host_data != nullptr);
+  LOG_CHECK(host_data_size > 0u);
+
+  auto const& cmd = encoder();
+
+  // (vkCmdUpdateBuffer requires an offset and a size multiple of 4)
+  bool const inline_upload{
+    (host_data_size < kInlineUploadSize)
+    && (((device_buffer_offset | host_data_size) % 4u) == 0u)
+  };
+
+  if (inline_upload) {
+    vkCmdUpdateBuffer(
+      cmd.handle(),
+      device_buffer.buffer,
+      device_buffer_offset,
+      host_data_size,
+      host_data
+    );
+  } else {
+    // Kept with the batch until it completes.
+    auto const staging_buffer{allocator_ptr_->create_buffer(
+      host_data_size,
+      VK_BUFFER_USAGE_2_TRANSFER_SRC_BIT_KHR,
+      VMA_MEMORY_USAGE_CPU_TO_GPU,
+      VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT
+    )};
+    allocator_ptr_->write_buffer(staging_buffer, 0u, host_data, 0u, host_data_size);
+    staging_buffers_.push_back(staging_buffer);
+
+    cmd.copy_buffer(staging_buffer, 0u, device_buffer, device_buffer_offset, host_data_size);
+  }
+
+  release_to_main(device_buffer.buffer);
+}
+
+// ----------------------------------------------------------------------------
+
+void TransferContext::copy_buffer(
+  backend::Buffer const& src,
+  backend::Buffer const& dst,
+  uint64_t size
+) {
+  encoder().copy_buffer(src, 0u, dst, 0u, size);
+  release_to_main(dst.buffer);
+}
+
+// ----------------------------------------------------------------------------
+
+void TransferContext::transition_images_layout(
+  std::vector<backend::Image> const& images,
+  VkImageLayout src_layout,
+  VkImageLayout dst_layout
+) {
+  transitions_.push_back({
+    .images = images,
+    .src_layout = src_layout,
+    .dst_layout = dst_layout,
+  });
+}
+
+// ----------------------------------------------------------------------------
+
+void TransferContext::release_to_main(VkBuffer buffer) {
+  if (!needs_ownership_transfer()) {
+    return;
+  }
+  auto const it = std::find_if(buffer_releases_.cbegin(), buffer_releases_.cend(),
+    [buffer](auto const& barrier) { return barrier.buffer == buffer; }
+  );
+  if (it != buffer_releases_.cend()) {
+    return;
+  }
+  buffer_releases_.push_back({
+    .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
+    .srcStageMask = VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT,
+    .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+    .srcQueueFamilyIndex = transfer_queue_.family_index,
+    .dstQueueFamilyIndex = main_queue_.family_index,
+    .buffer = buffer,
+    .offset = 0u,
+    .size = VK_WHOLE_SIZE,
+  });
+}
+
+// ----------------------------------------------------------------------------
+
+void TransferContext::release_to_main(
+  VkImage image,
+  VkImageLayout layout,
+  VkImageSubresourceRange const& range
+) {
+  if (!needs_ownership_transfer()) {
+    return;
+  }
+  image_releases_.push_back({
+    .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+    .srcStageMask = VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT,
+    .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+    .oldLayout = layout,
+    .newLayout = layout,
+    .srcQueueFamilyIndex = transfer_queue_.family_index,
+    .dstQueueFamilyIndex = main_queue_.family_index,
+    .image = image,
+    .subresourceRange = range,
+  });
+}
+
+// ----------------------------------------------------------------------------
+
+uint64_t TransferContext::flush() {
+  // (an empty batch is not submitted, its value being the last one)
+  if (!recording_ && !main_recording_ && transitions_.empty()) {
+    return value_;
+  }
+
+  Batch batch{};
+  std::vector<VkSemaphoreSubmitInfo> main_wait_semaphores{};
+
+  /* Transfer queue : copies, then release of the written resources. */
+  batch.staging_buffers = std::move(staging_buffers_);
+  staging_buffers_.clear();
+
+  if (recording_) {
+    if (!buffer_releases_.empty() || !image_releases_.empty()) {
+      VkDependencyInfo const release_dependency{
+        .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+        .bufferMemoryBarrierCount = static_cast<uint32_t>(buffer_releases_.size()),
+        .pBufferMemoryBarriers = buffer_releases_.data(),
+        .imageMemoryBarrierCount = static_cast<uint32_t>(image_releases_.size()),
+        .pImageMemoryBarriers = image_releases_.data(),
+      };
+      vkCmdPipelineBarrier2(encoder_.handle(), &release_dependency);
+    }
+    encoder_.end();
+    recording_ = false;
+
+    batch.transfer_command_buffer = encoder_.handle();
+    submit(transfer_queue_, { batch.transfer_command_buffer }, {});
+    main_wait_semaphores.push_back(
+      wait_semaphore_info(VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT)
+    );
+  }
+
+  /* Main queue : acquire of the written resources, the layout transitions, then the Main encoder commands. */
+  {
+    batch.main_command_buffers.push_back(allocate_command_buffer(main_pool_));
+    auto const cmd = CommandEncoder(
+      batch.main_command_buffers.front(),
+      static_cast<uint32_t>(Context::TargetQueue::Main),
+      device_,
+      allocator_ptr_
+    );
+    cmd.begin();
+
+    // Matching acquire barriers, and a global dependency for the resources
+    // not needing an ownership transfer (same family or concurrent sharing).
+    std::vector<VkBufferMemoryBarrier2> buffer_acquires(buffer_releases_);
+    for (auto& barrier : buffer_acquires) {
+      barrier.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+      barrier.srcAccessMask = VK_ACCESS_2_NONE;
+      barrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+      barrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
+    }
+    std::vector<VkImageMemoryBarrier2> image_acquires(image_releases_);
+    for (auto& barrier : image_acquires) {
+      barrier.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+      barrier.srcAccessMask = VK_ACCESS_2_NONE;
+      barrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+      barrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
+    }
+    VkMemoryBarrier2 const memory_barrier{
+      .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+      .srcStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+      .srcAccessMask = VK_ACCESS_2_MEMORY_WRITE_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+      .dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT,
+    };
+    VkDependencyInfo const acquire_dependency{
+      .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+      .memoryBarrierCount = 1u,
+      .pMemoryBarriers = &memory_barrier,
+      .bufferMemoryBarrierCount = static_cast<uint32_t>(buffer_acquires.size()),
+      .pBufferMemoryBarriers = buffer_acquires.data(),
+      .imageMemoryBarrierCount = static_cast<uint32_t>(image_acquires.size()),
+      .pImageMemoryBarriers = image_acquires.data(),
+    };
+    vkCmdPipelineBarrier2(cmd.handle(), &acquire_dependency);
+
+    for (auto const& transition : transitions_) {
+      cmd.transition_images_layout(
+        transition.images, transition.src_layout, transition.dst_layout
+      );
+    }
+    cmd.end();
+
+    if (main_recording_) {
+      main_encoder_.end();
+      main_recording_ = false;
+      batch.main_command_buffers.push_back(main_encoder_.handle());
+    }
+
+    submit(main_queue_, batch.main_command_buffers, main_wait_semaphores);
+  }
+
+  buffer_releases_.clear();
+  image_releases_.clear();
+  transitions_.clear();
+
+  batch.value = value_;
+  batches_.push_back(std::move(batch));
+
+  collect();
+
+  return value_;
+}
+
+// ----------------------------------------------------------------------------
+
+bool TransferContext::completed(uint64_t value) const {
+  uint64_t counter{};
+  CHECK_VK( vkGetSemaphoreCounterValue(device_, timeline_, &counter) );
+  return counter >= value;
+}
+
+// ----------------------------------------------------------------------------
+
+void TransferContext::wait(uint64_t value) {
+  LOG_CHECK(value <= value_);
+
+  VkSemaphoreWaitInfo const semaphore_wait_info{
+    .sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+    .semaphoreCount = 1u,
+    .pSemaphores = &timeline_,
+    .pValues = &value,
+  };
+  CHECK_VK( vkWaitSemaphores(device_, &semaphore_wait_info, UINT64_MAX) );
+
+  collect();
+}
+
+// ----------------------------------------------------------------------------
+
+void TransferContext::collect() {
+  if (batches_.empty()) {
+    return;
+  }
+
+  uint64_t counter{};
+  CHECK_VK( vkGetSemaphoreCounterValue(device_, timeline_, &counter) );
+
+  while (!batches_.empty() && (batches_.front().value <= counter)) {
+    auto const& batch = batches_.front();
+    if (batch.transfer_command_buffer != VK_NULL_HANDLE) {
+      vkFreeCommandBuffers(device_, transfer_pool_, 1u, &batch.transfer_command_buffer);
+    }
+    vkFreeCommandBuffers(
+      device_,
+      main_pool_,
+      static_cast<uint32_t>(batch.main_command_buffers.size()),
+      batch.main_command_buffers.data()
+    );
+    for (auto const& staging_buffer : batch.staging_buffers) {
+      allocator_ptr_->destroy_buffer(staging_buffer);
+    }
+    batches_.pop_front();
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+VkCommandBuffer TransferContext::allocate_command_buffer(VkCommandPool pool) const {
+  VkCommandBufferAllocateInfo const alloc_info{
+    .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+    .commandPool = pool,
+    .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+    .commandBufferCount = 1u,
+  };
+  VkCommandBuffer command_buffer{};
+  CHECK_VK(vkAllocateCommandBuffers(device_, &alloc_info, &command_buffer));
+  return command_buffer;
+}
+
+// ----------------------------------------------------------------------------
+
+void TransferContext::submit(
+  backend::Queue const& queue,
+  std::vector<VkCommandBuffer> const& command_buffers,
+  std::vector<VkSemaphoreSubmitInfo> const& wait_semaphores
+) const {
+  // Each submission signals the next timeline value.
+  value_ += 1u;
+
+  std::vector<VkCommandBufferSubmitInfo> cb_submit_infos(command_buffers.size());
+  for (size_t i = 0u; i < command_buffers.size(); ++i) {
+    cb_submit_infos[i] = {
+      .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
+      .commandBuffer = command_buffers[i],
+    };
+  }
+  VkSemaphoreSubmitInfo const signal_semaphore_info{
+    .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+    .semaphore = timeline_,
+    .value = value_,
+    .stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+  };
+  VkSubmitInfo2 const submit_info_2{
+    .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+    .waitSemaphoreInfoCount = static_cast<uint32_t>(wait_semaphores.size()),
+    .pWaitSemaphoreInfos = wait_semaphores.data(),
+    .commandBufferInfoCount = static_cast<uint32_t>(cb_submit_infos.size()),
+    .pCommandBufferInfos = cb_submit_infos.data(),
+    .signalSemaphoreInfoCount = 1u,
+    .pSignalSemaphoreInfos = &signal_semaphore_info,
+  };
+  CHECK_VK( vkQueueSubmit2(queue.queue, 1u, &submit_info_2, VK_NULL_HANDLE) );
+}
+
+/* -------------------------------------------------------------------------- */
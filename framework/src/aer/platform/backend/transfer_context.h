@@ -0,0 +1,201 @@
+#ifndef AER_PLATFORM_BACKEND_TRANSFER_CONTEXT_H_
+#define AER_PLATFORM_BACKEND_TRANSFER_CONTEXT_H_
+
+#include <deque>
+
+#include "aer/core/common.h"
+#include "aer/platform/backend/types.h"
+#include "aer/platform/backend/command_encoder.h"
+
+class ResourceAllocator;
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Batched asynchronous transfers.
+ *
+ * Uploads and copies are recorded into an open batch instead of being
+ * submitted one by one. A flush submits the batch on the Transfer queue, then
+ * a small command buffer on the Main queue which acquires the written
+ * resources and applies the pending layout transitions, followed by the
+ * commands recorded on the batch Main encoder (eg. mipmaps blits).
+ *
+ * Each flush signals a value of a timeline semaphore, reached once its
+ * resources are usable on the Main queue : later Main queue submissions are
+ * ordered after it, other queues can wait on the semaphore, and the host only
+ * blocks when explicitly calling wait.
+ *
+ * When the Transfer and Main queues belong to different families, the
+ * exclusive resources written by a batch are released by the Transfer queue
+ * and acquired by the Main queue (queue family ownership transfer).
+ *
+ * Resources of a batch must be kept alive until its value is reached. Like the
+ * transient command pools, it must be used from the thread submitting the
+ * frames.
+ **/
+class TransferContext {
+ public:
+  // Smaller uploads, 4 bytes aligned, are recorded inline with vkCmdUpdateBuffer.
+  static constexpr uint64_t kInlineUploadSize{ 65536u };
+
+ public:
+  TransferContext() = default;
+
+  ~TransferContext() {
+    LOG_CHECK( device_ == VK_NULL_HANDLE );
+  }
+
+  void init(
+    VkDevice device,
+    ResourceAllocator* allocator_ptr,
+    backend::Queue const& transfer_queue,
+    backend::Queue const& main_queue
+  );
+
+  /* Flush and wait for the pending batches, then release the context. */
+  void release();
+
+  // --- Recording ---
+
+  /**
+   * Encoder of the open batch on the Transfer queue, for custom copies.
+   * The resources it writes must be passed to release_to_main.
+   **/
+  [[nodiscard]]
+  CommandEncoder const& encoder();
+
+  /* Encoder of the open batch on the Main queue, executed after the acquires and transitions. */
+  [[nodiscard]]
+  CommandEncoder const& main_encoder();
+
+  /* Staging buffer released with the open batch, once it completed. */
+  [[nodiscard]]
+  backend::Buffer create_staging_buffer(uint64_t size);
+
+  /* Copy host data to a device buffer, staged when it is not small enough to be inlined. */
+  void upload(
+    void const* host_data,
+    uint64_t host_data_size,
+    backend::Buffer const& device_buffer,
+    uint64_t device_buffer_offset = 0u
+  );
+
+  void copy_buffer(
+    backend::Buffer const& src,
+    backend::Buffer const& dst,
+    uint64_t size
+  );
+
+  /* Transition the images on the Main queue, after the batch copies. */
+  void transition_images_layout(
+    std::vector<backend::Image> const& images,
+    VkImageLayout src_layout,
+    VkImageLayout dst_layout
+  );
+
+  /* Hand a resource written by the batch over to the Main queue family, when it differs. */
+  void release_to_main(VkBuffer buffer);
+
+  void release_to_main(
+    VkImage image,
+    VkImageLayout layout,
+    VkImageSubresourceRange const& range
+  );
+
+  // --- Submission ---
+
+  /* Submit the open batch, returning the value signaled once it is usable (nothing is submitted when empty). */
+  uint64_t flush();
+
+  [[nodiscard]]
+  bool completed(uint64_t value) const;
+
+  /* Block the host until 'value' is reached. */
+  void wait(uint64_t value);
+
+  /* Flush then wait for every submitted batch. */
+  void wait_idle() {
+    wait(flush());
+  }
+
+  /* Release the staging buffers and command buffers of the completed batches. */
+  void collect();
+
+  [[nodiscard]]
+  VkSemaphore semaphore() const noexcept {
+    return timeline_;
+  }
+
+  /* Value of the last flushed batch, zero before any. */
+  [[nodiscard]]
+  uint64_t last_value() const noexcept {
+    return value_;
+  }
+
+  /* Wait on the last flushed batch, to chain it into another queue submission. */
+  [[nodiscard]]
+  VkSemaphoreSubmitInfo wait_semaphore_info(VkPipelineStageFlags2 stage_mask) const noexcept {
+    return {
+      .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+      .semaphore = timeline_,
+      .value = value_,
+      .stageMask = stage_mask,
+    };
+  }
+
+  [[nodiscard]]
+  bool needs_ownership_transfer() const noexcept {
+    return transfer_queue_.family_index != main_queue_.family_index;
+  }
+
+ private:
+  struct Transition {
+    std::vector<backend::Image> images{};
+    VkImageLayout src_layout{};
+    VkImageLayout dst_layout{};
+  };
+
+  struct Batch {
+    uint64_t value{};
+    VkCommandBuffer transfer_command_buffer{};
+    std::vector<VkCommandBuffer> main_command_buffers{};
+    std::vector<backend::Buffer> staging_buffers{};
+  };
+
+  VkCommandBuffer allocate_command_buffer(VkCommandPool pool) const;
+
+  void submit(
+    backend::Queue const& queue,
+    std::vector<VkCommandBuffer> const& command_buffers,
+    std::vector<VkSemaphoreSubmitInfo> const& wait_semaphores
+  ) const;
+
+ private:
+  VkDevice device_{};
+  ResourceAllocator* allocator_ptr_{};
+
+  backend::Queue transfer_queue_{};
+  backend::Queue main_queue_{};
+  VkCommandPool transfer_pool_{};
+  VkCommandPool main_pool_{};
+
+  VkSemaphore timeline_{};
+  uint64_t value_{};
+
+  // Open batch.
+  CommandEncoder encoder_{};
+  bool recording_{};
+  CommandEncoder main_encoder_{};
+  bool main_recording_{};
+  std::vector<backend::Buffer> staging_buffers_{};
+  std::vector<VkBufferMemoryBarrier2> buffer_releases_{};
+  std::vector<VkImageMemoryBarrier2> image_releases_{};
+  std::vector<Transition> transitions_{};
+
+  // Submitted batches, in signal order.
+  std::deque<Batch> batches_{};
+};
+
+/* -------------------------------------------------------------------------- */
+
+#endif // AER_PLATFORM_BACKEND_TRANSFER_CONTEXT_H_
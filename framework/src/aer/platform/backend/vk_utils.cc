@@ -3,7 +3,7 @@
 #include <filesystem>
 #include <vulkan/vk_enum_string_helper.h>
 
-#include "aer/core/utils.h"
+#include "aer/core/mapped_file.h"
 #include "aer/core/logger.h"
 
 /* -------------------------------------------------------------------------- */
@@ -30,15 +30,16 @@ VkShaderModule CreateShaderModule(
 
   std::string const filename{spirv_path.string()};
 
-  utils::FileReader reader;
-  if (!reader.read(filename)) {
+  // (mappings are page aligned, as required by pCode)
+  utils::MappedFile const spirv(filename, utils::MappedFile::AccessHint::Sequential);
+  if (!spirv.is_open()) {
     LOG_FATAL("The spirv shader \"{}\" could not be found.\n", spirv_path.string());
   }
 
   VkShaderModuleCreateInfo shader_module_info{
     .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
-    .codeSize = reader.buffer.size(),
-    .pCode = reinterpret_cast<uint32_t*>(reader.buffer.data()),
+    .codeSize = spirv.size(),
+    .pCode = reinterpret_cast<uint32_t const*>(spirv.data()),
   };
 
   VkShaderModule module{};
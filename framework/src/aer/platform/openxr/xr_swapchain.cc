@@ -18,13 +18,19 @@ bool OpenXRSwapchain::acquireNextImage() {
 
 // ----------------------------------------------------------------------------
 
-bool OpenXRSwapchain::submitFrame(VkQueue queue, VkCommandBuffer command_buffer) {
+bool OpenXRSwapchain::submitFrame(
+  VkQueue queue,
+  VkCommandBuffer command_buffer,
+  std::vector<VkSemaphoreSubmitInfo> const& wait_semaphores
+) {
   std::vector<VkCommandBufferSubmitInfo> const cb_submit_infos{{
     .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
     .commandBuffer = command_buffer,
   }};
   VkSubmitInfo2 const submit_info_2{
     .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+    .waitSemaphoreInfoCount = static_cast<uint32_t>(wait_semaphores.size()),
+    .pWaitSemaphoreInfos = wait_semaphores.data(),
     .commandBufferInfoCount = static_cast<uint32_t>(cb_submit_infos.size()),
     .pCommandBufferInfos = cb_submit_infos.data(),
   };
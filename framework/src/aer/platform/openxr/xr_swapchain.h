@@ -15,7 +15,11 @@ struct OpenXRSwapchain : public SwapchainInterface {
 
   bool acquireNextImage() final;
 
-  bool submitFrame(VkQueue queue, VkCommandBuffer command_buffer) final;
+  bool submitFrame(
+    VkQueue queue,
+    VkCommandBuffer command_buffer,
+    std::vector<VkSemaphoreSubmitInfo> const& wait_semaphores
+  ) final;
 
   bool finishFrame(VkQueue queue) final;
 
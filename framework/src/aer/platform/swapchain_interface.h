@@ -14,7 +14,12 @@ class SwapchainInterface {
   virtual bool acquireNextImage() = 0;
 
   // [todo: transform to accept a span of VkCommandBuffer]
-  virtual bool submitFrame(VkQueue queue, VkCommandBuffer command_buffer) = 0;
+  // ('wait_semaphores' are waited for on top of the swapchain own ones)
+  virtual bool submitFrame(
+    VkQueue queue,
+    VkCommandBuffer command_buffer,
+    std::vector<VkSemaphoreSubmitInfo> const& wait_semaphores
+  ) = 0;
 
   virtual bool finishFrame(VkQueue queue) = 0;
 
@@ -26,7 +26,10 @@ void DescriptorSetRegistry::release() {
     vkDestroyDescriptorSetLayout(device_, set.layout, nullptr);
     set = {};
   }
+  vkDestroyDescriptorPool(device_, frame_pool_, nullptr);
   vkDestroyDescriptorPool(device_, main_pool_, nullptr);
+  frame_pool_ = VK_NULL_HANDLE;
+  main_pool_ = VK_NULL_HANDLE;
 }
 
 // ----------------------------------------------------------------------------
@@ -84,10 +87,36 @@ void DescriptorSetRegistry::destroy_layout(VkDescriptorSetLayout &layout) const
 
 VkDescriptorSet DescriptorSetRegistry::allocate_descriptor_set(
   VkDescriptorSetLayout const layout
+) const {
+  return allocate_descriptor_set(layout, main_pool_);
+}
+
+// ----------------------------------------------------------------------------
+
+VkDescriptorSet DescriptorSetRegistry::allocate_descriptor_set(Type const type) const {
+  LOG_CHECK(type != Type::Frame); // (its pool holds a single set)
+  return allocate_descriptor_set(sets_[type].layout, main_pool_);
+}
+
+// ----------------------------------------------------------------------------
+
+void DescriptorSetRegistry::free_descriptor_set(VkDescriptorSet& set) const {
+  // (the sets were freed with their pool when released first)
+  if ((set != VK_NULL_HANDLE) && (main_pool_ != VK_NULL_HANDLE)) {
+    CHECK_VK(vkFreeDescriptorSets(device_, main_pool_, 1u, &set));
+  }
+  set = VK_NULL_HANDLE;
+}
+
+// ----------------------------------------------------------------------------
+
+VkDescriptorSet DescriptorSetRegistry::allocate_descriptor_set(
+  VkDescriptorSetLayout const layout,
+  VkDescriptorPool const pool
 ) const {
   VkDescriptorSetAllocateInfo const alloc_info{
     .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
-    .descriptorPool = main_pool_,
+    .descriptorPool = pool,
     .descriptorSetCount = 1u,
     .pSetLayouts = &layout,
   };
@@ -98,21 +127,27 @@ VkDescriptorSet DescriptorSetRegistry::allocate_descriptor_set(
 
 // ----------------------------------------------------------------------------
 
-void DescriptorSetRegistry::update_frame_ubo(backend::Buffer const& buffer) const {
+void DescriptorSetRegistry::update_frame_ubo(
+  backend::Buffer const& buffer,
+  uint64_t range
+) const {
   context_ptr_->update_descriptor_set(
     sets_[DescriptorSetRegistry::Type::Frame].set,
   {{
     .binding = material_shader_interop::kDescriptorSet_Frame_FrameUBO,
-    .type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-    .buffers = { { buffer.buffer } },
+    .type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+    .buffers = { { buffer.buffer, 0u, range } },
   }});
 }
 
 // ----------------------------------------------------------------------------
 
-void DescriptorSetRegistry::update_scene_transforms(backend::Buffer const& buffer) const {
+void DescriptorSetRegistry::update_scene_transforms(
+  VkDescriptorSet const set,
+  backend::Buffer const& buffer
+) const {
   context_ptr_->update_descriptor_set(
-    sets_[DescriptorSetRegistry::Type::Scene].set,
+    set,
   {{
     .binding = material_shader_interop::kDescriptorSet_Scene_TransformSBO,
     .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
@@ -122,9 +157,27 @@ void DescriptorSetRegistry::update_scene_transforms(backend::Buffer const& buffe
 
 // ----------------------------------------------------------------------------
 
-void DescriptorSetRegistry::update_scene_textures(std::vector<VkDescriptorImageInfo> image_infos) const {
+void DescriptorSetRegistry::update_scene_draws(
+  VkDescriptorSet const set,
+  backend::Buffer const& buffer
+) const {
   context_ptr_->update_descriptor_set(
-    sets_[DescriptorSetRegistry::Type::Scene].set,
+    set,
+  {{
+    .binding = material_shader_interop::kDescriptorSet_Scene_DrawSBO,
+    .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+    .buffers = { { buffer.buffer } },
+  }});
+}
+
+// ----------------------------------------------------------------------------
+
+void DescriptorSetRegistry::update_scene_textures(
+  VkDescriptorSet const set,
+  std::vector<VkDescriptorImageInfo> image_infos
+) const {
+  context_ptr_->update_descriptor_set(
+    set,
     {{
       .binding = material_shader_interop::kDescriptorSet_Scene_Textures,
       .type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
@@ -135,11 +188,14 @@ void DescriptorSetRegistry::update_scene_textures(std::vector<VkDescriptorImageI
 
 // ----------------------------------------------------------------------------
 
-void DescriptorSetRegistry::update_scene_ibl(Skybox const& skybox) const {
+void DescriptorSetRegistry::update_scene_ibl(
+  VkDescriptorSet const set,
+  Skybox const& skybox
+) const {
   auto const& ibl_sampler = skybox.sampler(); // ClampToEdge Linear MipMap
 
   context_ptr_->update_descriptor_set(
-    sets_[DescriptorSetRegistry::Type::Scene].set,
+    set,
     {
       {
         .binding = material_shader_interop::kDescriptorSet_Scene_IBL_Prefiltered,
@@ -180,9 +236,12 @@ void DescriptorSetRegistry::update_scene_ibl(Skybox const& skybox) const {
 
 // ----------------------------------------------------------------------------
 
-void DescriptorSetRegistry::update_ray_tracing_scene(RayTracingSceneInterface const* rt_scene) const {
+void DescriptorSetRegistry::update_ray_tracing_scene(
+  VkDescriptorSet const set,
+  RayTracingSceneInterface const* rt_scene
+) const {
   context_ptr_->update_descriptor_set(
-    sets_[DescriptorSetRegistry::Type::RayTracing].set,
+    set,
     {
       {
         .binding = material_shader_interop::kDescriptorSet_RayTracing_TLAS,
@@ -205,7 +264,7 @@ void DescriptorSetRegistry::init_descriptor_pool(uint32_t const max_sets) {
   /* Default pool, to adjust based on application needs. */
   descriptor_pool_sizes_ = {
     { VK_DESCRIPTOR_TYPE_SAMPLER, 50 },                 // standalone samplers
-    { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1024 }, // textures in materials
+    { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4096 }, // textures in materials (kMaxNumTextures per scene set)
     { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 1024 },          // sampled images
     { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 50 },           // compute shaders
     { VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER, 50 },    // texel buffers
@@ -236,6 +295,22 @@ void DescriptorSetRegistry::init_descriptor_pool(uint32_t const max_sets) {
     main_pool_
   ));
   vkutils::SetDebugObjectName(device_, main_pool_, "DescriptorSetRegistry::MainPool");
+
+  /* Pool without update after bind, for the sets of dynamic descriptors. */
+  VkDescriptorPoolSize const frame_pool_size{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1 };
+  VkDescriptorPoolCreateInfo const frame_pool_info{
+    .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+    .maxSets = 1u,
+    .poolSizeCount = 1u,
+    .pPoolSizes = &frame_pool_size,
+  };
+  CHECK_VK(vkCreateDescriptorPool(
+    device_,
+    &frame_pool_info,
+    nullptr, &
+    frame_pool_
+  ));
+  vkutils::SetDebugObjectName(device_, frame_pool_, "DescriptorSetRegistry::FramePool");
 }
 
 // ----------------------------------------------------------------------------
@@ -251,17 +326,18 @@ void DescriptorSetRegistry::init_descriptor_sets() {
     Type::Frame,
     {
       {
+        // Dynamic, its offset selecting the frame region of the upload ring
+        // (which forbids the update after bind flags, on the binding and the layout).
         .binding = material_shader_interop::kDescriptorSet_Frame_FrameUBO,
-        .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+        .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
         .descriptorCount = 1u,
         .stageFlags = VK_SHADER_STAGE_VERTEX_BIT
                     | VK_SHADER_STAGE_FRAGMENT_BIT
                     | extra_stage_flags
                     ,
-        .bindingFlags = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT,
       },
     },
-    VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
+    0u,
     "Frame"
   );
 
@@ -294,21 +370,34 @@ void DescriptorSetRegistry::init_descriptor_sets() {
         .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
         .descriptorCount = 1u,
         .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT,
-        .bindingFlags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT
+        .bindingFlags = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT
+                      | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT
       },
       {
         .binding = material_shader_interop::kDescriptorSet_Scene_IBL_Irradiance,
         .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
         .descriptorCount = 1u,
         .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT,
-        .bindingFlags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT
+        .bindingFlags = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT
+                      | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT
       },
       {
         .binding = material_shader_interop::kDescriptorSet_Scene_IBL_SpecularBRDF,
         .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
         .descriptorCount = 1u,
         .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT,
-        .bindingFlags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT
+        .bindingFlags = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT
+                      | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT
+      },
+      {
+        // (only bound when GPU-driven draws are used)
+        .binding = material_shader_interop::kDescriptorSet_Scene_DrawSBO,
+        .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+        .descriptorCount = 1u,
+        .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
+        .bindingFlags = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT
+                      | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT
+                      | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT
       },
     },
     VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
@@ -350,9 +439,14 @@ void DescriptorSetRegistry::create_main_set(
   std::string const& name
 ) {
   VkDescriptorSetLayout const layout = create_layout(layout_params, layout_flags);
+
+  // (sets which can't be updated after bind are kept out of the main pool)
+  bool const update_after_bind{
+    (layout_flags & VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT) != 0u
+  };
   sets_[type] = {
     .index = static_cast<uint32_t>(type),
-    .set = allocate_descriptor_set(layout),
+    .set = allocate_descriptor_set(layout, update_after_bind ? main_pool_ : frame_pool_),
     .layout = layout,
   };
 
@@ -19,6 +19,9 @@ class RayTracingSceneInterface;
 ///   - Scene, for scene shared resources (eg. TextureAtlas, IBL)
 ///   - RayTracing, for scene data that could change (eg. raytracing instances)
 ///
+/// Each loaded scene allocates its own Scene and RayTracing sets from their
+/// layouts, the main ones being only written by the skybox.
+///
 class DescriptorSetRegistry {
  private:
   static constexpr uint32_t kMaxNumTextures = 512u; //
@@ -66,24 +69,51 @@ class DescriptorSetRegistry {
     VkDescriptorSetLayout const layout
   ) const;
 
+  /* Allocate a set with the layout of a main set, eg. a scene own Scene set. */
+  [[nodiscard]]
+  VkDescriptorSet allocate_descriptor_set(Type type) const;
+
+  void free_descriptor_set(VkDescriptorSet& set) const;
+
  public:
   /* Methods to update shared internal descriptor sets. */
 
-  void update_frame_ubo(backend::Buffer const& buffer) const;
+  /* Bind 'range' bytes of 'buffer' as the dynamic Frame uniform buffer. */
+  void update_frame_ubo(backend::Buffer const& buffer, uint64_t range) const;
+
+  /* Dynamic offset of the current FrameData, to bind the Frame set with. */
+  void set_frame_ubo_offset(uint32_t offset) noexcept {
+    frame_ubo_offset_ = offset;
+  }
+
+  [[nodiscard]]
+  uint32_t frame_ubo_offset() const noexcept {
+    return frame_ubo_offset_;
+  }
 
-  void update_scene_transforms(backend::Buffer const& buffer) const;
+  /* The scene updates write 'set', a Scene (or RayTracing) set of a scene. */
 
-  void update_scene_textures(std::vector<VkDescriptorImageInfo> image_infos) const;
+  void update_scene_transforms(VkDescriptorSet set, backend::Buffer const& buffer) const;
 
-  void update_scene_ibl(Skybox const& skybox) const;
+  void update_scene_draws(VkDescriptorSet set, backend::Buffer const& buffer) const;
 
-  void update_ray_tracing_scene(RayTracingSceneInterface const* rt_scene) const;
+  void update_scene_textures(VkDescriptorSet set, std::vector<VkDescriptorImageInfo> image_infos) const;
+
+  void update_scene_ibl(VkDescriptorSet set, Skybox const& skybox) const;
+
+  void update_ray_tracing_scene(VkDescriptorSet set, RayTracingSceneInterface const* rt_scene) const;
 
  private:
   void init_descriptor_pool(uint32_t const max_sets);
 
   void init_descriptor_sets();
 
+  [[nodiscard]]
+  VkDescriptorSet allocate_descriptor_set(
+    VkDescriptorSetLayout const layout,
+    VkDescriptorPool const pool
+  ) const;
+
   void create_main_set(
     Type const type,
     DescriptorSetLayoutParamsBuffer const& layout_params,
@@ -97,8 +127,10 @@ class DescriptorSetRegistry {
 
   std::vector<VkDescriptorPoolSize> descriptor_pool_sizes_{};
   VkDescriptorPool main_pool_{};
+  VkDescriptorPool frame_pool_{};   // (without update after bind, for dynamic descriptors)
 
   EnumArray<DescriptorSet, Type> sets_{};
+  uint32_t frame_ubo_offset_{};
 };
 
 /* -------------------------------------------------------------------------- */
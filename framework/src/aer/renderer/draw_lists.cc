@@ -0,0 +1,273 @@
+#include "aer/renderer/draw_lists.h"
+
+#include <numeric>
+
+#include "aer/core/job_system.h"
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+// Sort keys bits, radix sorted by digits.
+uint32_t constexpr kKeyBits{ 48u };
+uint32_t constexpr kDigitBits{ 8u };
+uint32_t constexpr kDigitCount{ kKeyBits / kDigitBits };
+uint32_t constexpr kBucketCount{ 1u << kDigitBits };
+
+// Items per job of a parallel sort pass.
+uint32_t constexpr kSortChunkSize{ 16u * 1024u };
+
+// Largest quantized depth, and material index.
+uint64_t constexpr kFieldMask{ 0xFFFFu };
+
+using Histogram = std::array<uint32_t, kBucketCount>;
+
+uint32_t Digit(uint64_t const key, uint32_t const digit) {
+  return static_cast<uint32_t>(key >> (digit * kDigitBits)) & (kBucketCount - 1u);
+}
+
+/* Order of the pipelines, by alpha mode then pair. */
+bool PipelineLess(DrawLists::Pipeline const& a, DrawLists::Pipeline const& b) {
+  if (a.states.alpha_mode != b.states.alpha_mode) {
+    return a.states.alpha_mode < b.states.alpha_mode;
+  }
+  if (a.fx != b.fx) {
+    return std::less<MaterialFx const*>{}(a.fx, b.fx);
+  }
+  return a.states < b.states;
+}
+
+bool SamePipeline(DrawLists::Pipeline const& a, DrawLists::Pipeline const& b) {
+  return !PipelineLess(a, b) && !PipelineLess(b, a);
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+void DrawLists::update(
+  std::vector<std::unique_ptr<scene::Mesh>> const& meshes,
+  FxResolver const& resolve_fx,
+  std::span<mat4f const> transforms,
+  vec3 const& eye,
+  vec3 const& direction
+) {
+  stats_.sort_passes = 0u;
+
+  if (items_dirty_) {
+    rebuild(meshes, resolve_fx);
+    items_dirty_ = false;
+    order_dirty_ = true;
+  }
+
+  bool const view_moved{
+    (eye != last_eye_) || (direction != last_direction_)
+  };
+  if (!view_moved && !order_dirty_) {
+    return;
+  }
+  last_eye_ = eye;
+  last_direction_ = direction;
+  order_dirty_ = false;
+
+  if (update_keys(transforms, eye, direction)) {
+    stats_.sort_passes = RadixSort(items_, scratch_, parallel_sort);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+uint32_t DrawLists::RadixSort(
+  std::vector<DrawItem>& items,
+  std::vector<DrawItem>& scratch,
+  bool const bParallel
+) {
+  uint32_t const item_count{ static_cast<uint32_t>(items.size()) };
+  if (item_count < 2u) {
+    return 0u;
+  }
+  scratch.resize(item_count);
+
+  // Histograms of every digit, to skip those shared by every item.
+  std::array<Histogram, kDigitCount> histograms{};
+  for (auto const& item : items) {
+    for (uint32_t d = 0u; d < kDigitCount; ++d) {
+      ++histograms[d][Digit(item.key, d)];
+    }
+  }
+
+  bool const parallel{ bParallel && (item_count >= kParallelSortMinItems) };
+  uint32_t const chunk_count{
+    parallel ? (item_count + kSortChunkSize - 1u) / kSortChunkSize : 1u
+  };
+  std::vector<Histogram> chunk_offsets(chunk_count);
+
+  auto chunk_range{[item_count](uint32_t const c) {
+    return std::make_pair(c * kSortChunkSize, std::min((c + 1u) * kSortChunkSize, item_count));
+  }};
+
+  uint32_t pass_count{0u};
+  for (uint32_t d = 0u; d < kDigitCount; ++d) {
+    auto const& histogram = histograms[d];
+    if (std::ranges::any_of(histogram, [item_count](uint32_t count) { return count == item_count; })) {
+      continue;
+    }
+
+    if (chunk_count == 1u) {
+      auto& offsets = chunk_offsets[0u];
+      std::exclusive_scan(histogram.begin(), histogram.end(), offsets.begin(), 0u);
+      for (auto const& item : items) {
+        scratch[offsets[Digit(item.key, d)]++] = item;
+      }
+    } else {
+      // Count each chunk digits in the current order.
+      utils::ParallelFor(0u, chunk_count, [&](uint32_t const c) {
+        auto& counts = chunk_offsets[c];
+        counts.fill(0u);
+        auto const [begin, end] = chunk_range(c);
+        for (uint32_t i = begin; i < end; ++i) {
+          ++counts[Digit(items[i].key, d)];
+        }
+      });
+
+      // Offsets by bucket then chunk, for the scatter to stay stable.
+      uint32_t offset{0u};
+      for (uint32_t b = 0u; b < kBucketCount; ++b) {
+        for (auto& offsets : chunk_offsets) {
+          uint32_t const count{ offsets[b] };
+          offsets[b] = offset;
+          offset += count;
+        }
+      }
+
+      utils::ParallelFor(0u, chunk_count, [&](uint32_t const c) {
+        auto& offsets = chunk_offsets[c];
+        auto const [begin, end] = chunk_range(c);
+        for (uint32_t i = begin; i < end; ++i) {
+          scratch[offsets[Digit(items[i].key, d)]++] = items[i];
+        }
+      });
+    }
+
+    items.swap(scratch);
+    ++pass_count;
+  }
+
+  return pass_count;
+}
+
+// ----------------------------------------------------------------------------
+
+void DrawLists::rebuild(
+  std::vector<std::unique_ptr<scene::Mesh>> const& meshes,
+  FxResolver const& resolve_fx
+) {
+  pipelines_.clear();
+  items_.clear();
+
+  // (consecutive submeshes mostly share their material)
+  scene::MaterialRef const* last_matref{};
+  uint32_t last_pipeline{};
+
+  auto find_pipeline{[&](scene::MaterialRef const* matref, bool const bInsert) {
+    if (matref == last_matref) {
+      return last_pipeline;
+    }
+    Pipeline const pipeline{
+      .fx = resolve_fx(*matref),
+      .states = matref->states,
+    };
+    auto it = std::lower_bound(pipelines_.begin(), pipelines_.end(), pipeline, PipelineLess);
+    if (bInsert && ((it == pipelines_.end()) || !SamePipeline(pipeline, *it))) {
+      it = pipelines_.insert(it, pipeline);
+    }
+    last_matref = matref;
+    last_pipeline = static_cast<uint32_t>(std::distance(pipelines_.begin(), it));
+    return last_pipeline;
+  }};
+
+  /* Gather the pipelines first, their indices changing while inserted. */
+  size_t item_count{0u};
+  for (auto const& mesh : meshes) {
+    for (auto const& submesh : mesh->submeshes) {
+      if (submesh.material_ref) {
+        find_pipeline(submesh.material_ref, true);
+        ++item_count;
+      }
+    }
+  }
+  LOG_CHECK(pipelines_.size() <= kMaxPipelineCount);
+
+  blended_.resize(pipelines_.size());
+  for (size_t i = 0u; i < pipelines_.size(); ++i) {
+    blended_[i] = (pipelines_[i].states.alpha_mode == scene::MaterialStates::AlphaMode::Blend);
+  }
+
+  /* Then the items, unordered until their keys are set. */
+  last_matref = nullptr;
+  items_.reserve(item_count);
+  for (auto const& mesh : meshes) {
+    for (auto const& submesh : mesh->submeshes) {
+      if (auto const* matref = submesh.material_ref; matref) {
+        items_.push_back({
+          .submesh = &submesh,
+          .transform_index = mesh->transform_index,
+          .pipeline = static_cast<uint16_t>(find_pipeline(matref, false)),
+          .material = static_cast<uint16_t>(matref->material_index & kFieldMask),
+        });
+      }
+    }
+  }
+
+  stats_.item_count = static_cast<uint32_t>(items_.size());
+  stats_.pipeline_count = static_cast<uint32_t>(pipelines_.size());
+  ++stats_.rebuild_count;
+}
+
+// ----------------------------------------------------------------------------
+
+bool DrawLists::update_keys(
+  std::span<mat4f const> transforms,
+  vec3 const& eye,
+  vec3 const& direction
+) {
+  if (items_.empty()) {
+    return false;
+  }
+
+  // View depth of the items, (instanced meshes are sorted by their first instance).
+  depths_.resize(items_.size());
+  float min_depth{ std::numeric_limits<float>::max() };
+  float max_depth{ std::numeric_limits<float>::lowest() };
+  for (size_t i = 0u; i < items_.size(); ++i) {
+    mat4f const& world = transforms[items_[i].transform_index];
+    float const depth{ linalg::dot(direction, eye - lina::to_vec3(world.w)) };
+    depths_[i] = depth;
+    min_depth = std::min(min_depth, depth);
+    max_depth = std::max(max_depth, depth);
+  }
+
+  // Quantized over the depth range, inverted for blended pipelines.
+  float const scale{
+    (max_depth > min_depth) ? static_cast<float>(kFieldMask) / (max_depth - min_depth) : 0.0f
+  };
+  bool in_order{true};
+  uint64_t last_key{0u};
+  for (size_t i = 0u; i < items_.size(); ++i) {
+    auto& item = items_[i];
+    uint64_t const depth{ static_cast<uint64_t>(
+      std::min((depths_[i] - min_depth) * scale, static_cast<float>(kFieldMask))
+    ) };
+    uint64_t const low_bits{
+      blended_[item.pipeline] ? (((kFieldMask - depth) << 16u) | item.material)
+                              : ((static_cast<uint64_t>(item.material) << 16u) | depth)
+    };
+    item.key = (static_cast<uint64_t>(item.pipeline) << 32u) | low_bits;
+    in_order = in_order && (last_key <= item.key);
+    last_key = item.key;
+  }
+
+  return !in_order;
+}
+
+/* -------------------------------------------------------------------------- */
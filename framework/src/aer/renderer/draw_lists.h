@@ -0,0 +1,140 @@
+#ifndef AER_RENDERER_DRAW_LISTS_H_
+#define AER_RENDERER_DRAW_LISTS_H_
+
+#include <functional>
+
+#include "aer/core/common.h"
+#include "aer/scene/mesh.h"
+#include "aer/scene/material.h"
+
+class MaterialFx;
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Persistent draw list of the scene submeshes, as a single array of draw
+ * items ordered by a 64-bit sort key :
+ *
+ *    opaque & masked : (pipeline << 32) | (material << 16) | depth
+ *    blended         : (pipeline << 32) | (~depth << 16)   | material
+ *
+ * where pipeline indexes the <MaterialFx, MaterialStates> pairs, ordered by
+ * alpha mode, and depth is the view depth quantized to 16 bits over the
+ * scene range, so that opaque submeshes are drawn front to back and blended
+ * ones back to front within their pipeline.
+ *
+ * Items are only rebuilt once invalidated, when the mesh set, a material or
+ * its states changed. Each update where the view or the transforms moved
+ * then recomputes the depth bits and radix sorts the keys, unless they are
+ * still in order.
+ **/
+class DrawLists {
+ public:
+  using SubMesh = scene::Mesh::SubMesh;
+  using FxResolver = std::function<MaterialFx*(scene::MaterialRef const&)>;
+
+  // Items sorted on the job system from this count, when enabled.
+  static uint32_t constexpr kParallelSortMinItems{ 32u * 1024u };
+
+  static uint32_t constexpr kMaxPipelineCount{ 1u << 16u };
+
+  struct Pipeline {
+    MaterialFx* fx{};
+    scene::MaterialStates states{};
+  };
+
+  struct DrawItem {
+    uint64_t key{};
+    SubMesh const* submesh{};
+    uint32_t transform_index{};
+    uint16_t pipeline{};
+    uint16_t material{};
+  };
+
+  struct Stats {
+    uint32_t rebuild_count{};     // since creation.
+    uint32_t item_count{};
+    uint32_t pipeline_count{};
+    uint32_t sort_passes{};       // radix passes run by the last update, 0 when in order.
+  };
+
+ public:
+  DrawLists() = default;
+
+  /* Rebuild the items on next update, to call when the mesh set, a material or its states changed. */
+  void invalidate() noexcept {
+    items_dirty_ = true;
+  }
+
+  /* Recompute the items order on next update, to call when transforms changed. */
+  void invalidate_order() noexcept {
+    order_dirty_ = true;
+  }
+
+  void update(
+    std::vector<std::unique_ptr<scene::Mesh>> const& meshes,
+    FxResolver const& resolve_fx,
+    std::span<mat4f const> transforms,
+    vec3 const& eye,
+    vec3 const& direction
+  );
+
+  std::vector<Pipeline> const& pipelines() const noexcept {
+    return pipelines_;
+  }
+
+  std::vector<DrawItem> const& items() const noexcept {
+    return items_;
+  }
+
+  Stats const& stats() const noexcept {
+    return stats_;
+  }
+
+  /**
+   * Stable LSD radix sort of 'items' by their 48 low key bits, 8 bits per
+   * pass, skipping the passes over digits shared by every item.
+   * Return the passes run.
+   **/
+  static uint32_t RadixSort(
+    std::vector<DrawItem>& items,
+    std::vector<DrawItem>& scratch,
+    bool bParallel
+  );
+
+ public:
+  bool parallel_sort{true};
+
+ private:
+  void rebuild(
+    std::vector<std::unique_ptr<scene::Mesh>> const& meshes,
+    FxResolver const& resolve_fx
+  );
+
+  /* Update the items depth bits from the view, return true when their order changed. */
+  bool update_keys(
+    std::span<mat4f const> transforms,
+    vec3 const& eye,
+    vec3 const& direction
+  );
+
+ private:
+  std::vector<Pipeline> pipelines_{};
+  std::vector<uint8_t> blended_{};      // per pipeline.
+  std::vector<DrawItem> items_{};
+
+  bool items_dirty_{true};
+  bool order_dirty_{true};
+  vec3 last_eye_{};
+  vec3 last_direction_{};
+
+  // Kept between updates.
+  std::vector<float> depths_{};
+  std::vector<DrawItem> scratch_{};
+
+  Stats stats_{};
+};
+
+/* -------------------------------------------------------------------------- */
+
+#endif // AER_RENDERER_DRAW_LISTS_H_
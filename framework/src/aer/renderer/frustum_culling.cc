@@ -0,0 +1,273 @@
+#include "aer/renderer/frustum_culling.h"
+
+#include <bit>
+#include <numeric>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define AER_FRUSTUM_CULLING_AVX
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1))
+#include <xmmintrin.h>
+#define AER_FRUSTUM_CULLING_SSE
+#endif
+
+#include "aer/core/job_system.h"
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+using Frustum = FrustumCulling::Frustum;
+using Boxes = FrustumCulling::Boxes;
+
+// Half extent of the boxes always visible, kept finite for the plane tests.
+float constexpr kUnboundedExtent{ std::numeric_limits<float>::max() };
+
+/* True when box 'i' is not fully behind any plane. */
+bool BoxVisible(Frustum const& frustum, Boxes const& boxes, size_t i) {
+  for (auto const& plane : frustum.planes) {
+    float const d{
+      plane.x * boxes.center_x[i] + plane.y * boxes.center_y[i] + plane.z * boxes.center_z[i] + plane.w
+    };
+    float const r{
+      std::abs(plane.x) * boxes.extent_x[i] + std::abs(plane.y) * boxes.extent_y[i] + std::abs(plane.z) * boxes.extent_z[i]
+    };
+    if (d + r < 0.0f) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Bit mask of the visible boxes among the kBatchSize ones from 'i'. */
+uint32_t CullBatch(Frustum const& frustum, Boxes const& boxes, size_t i) {
+#if defined(AER_FRUSTUM_CULLING_AVX)
+  __m256 const cx{ _mm256_loadu_ps(boxes.center_x.data() + i) };
+  __m256 const cy{ _mm256_loadu_ps(boxes.center_y.data() + i) };
+  __m256 const cz{ _mm256_loadu_ps(boxes.center_z.data() + i) };
+  __m256 const ex{ _mm256_loadu_ps(boxes.extent_x.data() + i) };
+  __m256 const ey{ _mm256_loadu_ps(boxes.extent_y.data() + i) };
+  __m256 const ez{ _mm256_loadu_ps(boxes.extent_z.data() + i) };
+  __m256 const zero{ _mm256_setzero_ps() };
+
+  __m256 outside{ zero };
+  for (auto const& plane : frustum.planes) {
+    __m256 d{ _mm256_set1_ps(plane.w) };
+    d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(plane.x), cx));
+    d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(plane.y), cy));
+    d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(plane.z), cz));
+    __m256 r{ _mm256_mul_ps(_mm256_set1_ps(std::abs(plane.x)), ex) };
+    r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_set1_ps(std::abs(plane.y)), ey));
+    r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_set1_ps(std::abs(plane.z)), ez));
+    outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(d, r), zero, _CMP_LT_OQ));
+  }
+  return ~static_cast<uint32_t>(_mm256_movemask_ps(outside)) & 0xFFu;
+
+#elif defined(AER_FRUSTUM_CULLING_SSE)
+  // (two groups of four lanes)
+  uint32_t mask{0u};
+  for (size_t j = 0u; j < FrustumCulling::kBatchSize; j += 4u) {
+    __m128 const cx{ _mm_loadu_ps(boxes.center_x.data() + i + j) };
+    __m128 const cy{ _mm_loadu_ps(boxes.center_y.data() + i + j) };
+    __m128 const cz{ _mm_loadu_ps(boxes.center_z.data() + i + j) };
+    __m128 const ex{ _mm_loadu_ps(boxes.extent_x.data() + i + j) };
+    __m128 const ey{ _mm_loadu_ps(boxes.extent_y.data() + i + j) };
+    __m128 const ez{ _mm_loadu_ps(boxes.extent_z.data() + i + j) };
+    __m128 const zero{ _mm_setzero_ps() };
+
+    __m128 outside{ zero };
+    for (auto const& plane : frustum.planes) {
+      __m128 d{ _mm_set1_ps(plane.w) };
+      d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(plane.x), cx));
+      d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(plane.y), cy));
+      d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(plane.z), cz));
+      __m128 r{ _mm_mul_ps(_mm_set1_ps(std::abs(plane.x)), ex) };
+      r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(std::abs(plane.y)), ey));
+      r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(std::abs(plane.z)), ez));
+      outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(d, r), zero));
+    }
+    mask |= (~static_cast<uint32_t>(_mm_movemask_ps(outside)) & 0xFu) << j;
+  }
+  return mask;
+
+#else
+  uint32_t mask{0u};
+  for (size_t j = 0u; j < FrustumCulling::kBatchSize; ++j) {
+    mask |= BoxVisible(frustum, boxes, i + j) ? (1u << j) : 0u;
+  }
+  return mask;
+#endif
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+FrustumCulling::Frustum FrustumCulling::ExtractFrustum(mat4 const& viewproj) {
+  // Rows of the transposed matrix.
+  mat4 const m{ linalg::transpose(viewproj) };
+  vec4 const planes[kPlaneCount]{
+    m[3] + m[0],  // left
+    m[3] - m[0],  // right
+    m[3] + m[1],  // bottom
+    m[3] - m[1],  // top
+    m[2],         // near
+    m[3] - m[2],  // far
+  };
+  Frustum frustum{};
+  for (uint32_t i = 0u; i < kPlaneCount; ++i) {
+    frustum.planes[i] = planes[i] / linalg::length(lina::to_vec3(planes[i]));
+  }
+  return frustum;
+}
+
+// ----------------------------------------------------------------------------
+
+void FrustumCulling::TransformBox(
+  mat4 const& world,
+  vec3 const& bounds_min,
+  vec3 const& bounds_max,
+  vec3& center,
+  vec3& extent
+) {
+  vec3 const local_center{ 0.5f * (bounds_max + bounds_min) };
+  vec3 const local_extent{ 0.5f * (bounds_max - bounds_min) };
+
+  // (the extent along each world axis sums the absolute basis projections)
+  center = lina::to_vec3(linalg::mul(world, vec4(local_center, 1.0f)));
+  extent = linalg::abs(lina::to_vec3(world.x)) * local_extent.x
+         + linalg::abs(lina::to_vec3(world.y)) * local_extent.y
+         + linalg::abs(lina::to_vec3(world.z)) * local_extent.z
+         ;
+}
+
+// ----------------------------------------------------------------------------
+
+uint32_t FrustumCulling::CullBoxes(
+  Frustum const& frustum,
+  Boxes const& boxes,
+  size_t const first,
+  size_t const last,
+  uint8_t* visibility
+) {
+  uint32_t visible_count{0u};
+
+  size_t i = first;
+  for (; i + kBatchSize <= last; i += kBatchSize) {
+    uint32_t const mask{ CullBatch(frustum, boxes, i) };
+    for (uint32_t lane = 0u; lane < kBatchSize; ++lane) {
+      visibility[i + lane] = static_cast<uint8_t>((mask >> lane) & 1u);
+    }
+    visible_count += static_cast<uint32_t>(std::popcount(mask));
+  }
+  for (; i < last; ++i) {
+    bool const visible{ BoxVisible(frustum, boxes, i) };
+    visibility[i] = visible ? 1u : 0u;
+    visible_count += visible ? 1u : 0u;
+  }
+
+  return visible_count;
+}
+
+// ----------------------------------------------------------------------------
+
+uint32_t FrustumCulling::CullBoxes(
+  Frustum const& frustum,
+  Boxes const& boxes,
+  std::span<uint8_t> visibility,
+  bool const bParallel
+) {
+  LOG_CHECK(visibility.size() >= boxes.size());
+
+  size_t const box_count{ boxes.size() };
+  uint32_t const chunk_count{
+    static_cast<uint32_t>((box_count + kParallelChunkSize - 1u) / kParallelChunkSize)
+  };
+  if (!bParallel || (chunk_count < 2u)) {
+    return CullBoxes(frustum, boxes, 0u, box_count, visibility.data());
+  }
+
+  std::vector<uint32_t> visible_counts(chunk_count);
+  utils::ParallelFor(0u, chunk_count, [&](uint32_t const c) {
+    size_t const first{ c * static_cast<size_t>(kParallelChunkSize) };
+    size_t const last{ std::min(first + kParallelChunkSize, box_count) };
+    visible_counts[c] = CullBoxes(frustum, boxes, first, last, visibility.data());
+  });
+  return std::accumulate(visible_counts.begin(), visible_counts.end(), 0u);
+}
+
+// ----------------------------------------------------------------------------
+
+void FrustumCulling::update(
+  std::span<DrawLists::DrawItem const> items,
+  std::span<mat4f const> transforms,
+  mat4 const& viewproj
+) {
+  uint32_t const item_count{ static_cast<uint32_t>(items.size()) };
+  visibility_.resize(item_count);
+
+  if (!enabled) {
+    std::fill(visibility_.begin(), visibility_.end(), 1u);
+    stats_ = { .visible_count = item_count, .culled_count = 0u };
+    return;
+  }
+
+  update_boxes(items, transforms);
+
+  stats_.visible_count = CullBoxes(ExtractFrustum(viewproj), boxes_, visibility_, parallel);
+  stats_.culled_count = item_count - stats_.visible_count;
+}
+
+// ----------------------------------------------------------------------------
+
+void FrustumCulling::update_boxes(
+  std::span<DrawLists::DrawItem const> items,
+  std::span<mat4f const> transforms
+) {
+  boxes_.resize(items.size());
+
+  auto update_box{[&](size_t const i) {
+    auto const* submesh = items[i].submesh;
+    auto const* mesh = submesh->parent;
+    auto const& prim = mesh->get_primitive(static_cast<uint32_t>(submesh - mesh->submeshes.data()));
+
+    // (skinned vertices may leave their bind pose bounds)
+    if ((prim.radius <= 0.0f) || (mesh->skeleton_index != kInvalidIndexU32)) {
+      boxes_.set(i, vec3(0.0f), vec3(kUnboundedExtent));
+      return;
+    }
+
+    vec3 const bounds_min{ prim.boundsMin[0], prim.boundsMin[1], prim.boundsMin[2] };
+    vec3 const bounds_max{ prim.boundsMax[0], prim.boundsMax[1], prim.boundsMax[2] };
+
+    // Union of the instances boxes.
+    vec3 lo{ std::numeric_limits<float>::max() };
+    vec3 hi{ std::numeric_limits<float>::lowest() };
+    for (uint32_t instance = 0u; instance < mesh->instance_count; ++instance) {
+      vec3 center, extent;
+      TransformBox(transforms[items[i].transform_index + instance], bounds_min, bounds_max, center, extent);
+      lo = linalg::min(lo, center - extent);
+      hi = linalg::max(hi, center + extent);
+    }
+    boxes_.set(i, 0.5f * (hi + lo), 0.5f * (hi - lo));
+  }};
+
+  uint32_t const chunk_count{
+    static_cast<uint32_t>((items.size() + kParallelChunkSize - 1u) / kParallelChunkSize)
+  };
+  if (!parallel || (chunk_count < 2u)) {
+    for (size_t i = 0u; i < items.size(); ++i) {
+      update_box(i);
+    }
+    return;
+  }
+  utils::ParallelFor(0u, chunk_count, [&](uint32_t const c) {
+    size_t const first{ c * static_cast<size_t>(kParallelChunkSize) };
+    size_t const last{ std::min(first + kParallelChunkSize, items.size()) };
+    for (size_t i = first; i < last; ++i) {
+      update_box(i);
+    }
+  });
+}
+
+/* -------------------------------------------------------------------------- */
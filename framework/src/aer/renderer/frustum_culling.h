@@ -0,0 +1,135 @@
+#ifndef AER_RENDERER_FRUSTUM_CULLING_H_
+#define AER_RENDERER_FRUSTUM_CULLING_H_
+
+#include "aer/core/common.h"
+#include "aer/renderer/draw_lists.h"
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Frustum culling of the scene draw items on the CPU.
+ *
+ * Each update transforms the items mesh space bounding boxes to world space,
+ * as the union of their instances boxes, then tests them against the six
+ * planes of the camera frustum. Boxes are stored as structures of arrays, and
+ * tested 8 at a time with AVX when enabled at compile time, with SSE
+ * otherwise, or one at a time on other architectures.
+ *
+ * Items without bounds (a null radius) and skinned ones are always visible.
+ **/
+class FrustumCulling {
+ public:
+  static uint32_t constexpr kPlaneCount{ 6u };
+
+  // Boxes tested per iteration.
+  static uint32_t constexpr kBatchSize{ 8u };
+
+  // Boxes per job of a parallel update, a multiple of the batch size.
+  static uint32_t constexpr kParallelChunkSize{ 8u * 1024u };
+
+  /* World space planes facing inward, normalized. */
+  struct Frustum {
+    vec4 planes[kPlaneCount]{};
+  };
+
+  /* World space axis aligned boxes, as centers and half extents. */
+  struct Boxes {
+    std::vector<float> center_x{};
+    std::vector<float> center_y{};
+    std::vector<float> center_z{};
+    std::vector<float> extent_x{};
+    std::vector<float> extent_y{};
+    std::vector<float> extent_z{};
+
+    void resize(size_t count) {
+      for (auto* v : { &center_x, &center_y, &center_z, &extent_x, &extent_y, &extent_z }) {
+        v->resize(count);
+      }
+    }
+
+    size_t size() const noexcept {
+      return center_x.size();
+    }
+
+    void set(size_t i, vec3 const& center, vec3 const& extent) {
+      center_x[i] = center.x; center_y[i] = center.y; center_z[i] = center.z;
+      extent_x[i] = extent.x; extent_y[i] = extent.y; extent_z[i] = extent.z;
+    }
+  };
+
+  struct Stats {
+    uint32_t visible_count{};
+    uint32_t culled_count{};
+  };
+
+ public:
+  /* Gribb-Hartmann extraction of the planes, for a [0, 1] depth range. */
+  static Frustum ExtractFrustum(mat4 const& viewproj);
+
+  /* World space box of the mesh space box 'bounds_min' - 'bounds_max' transformed by 'world'. */
+  static void TransformBox(
+    mat4 const& world,
+    vec3 const& bounds_min,
+    vec3 const& bounds_max,
+    vec3& center,
+    vec3& extent
+  );
+
+  /**
+   * Set 'visibility' to 1 for the boxes in [first, last) intersecting the
+   * frustum, to 0 otherwise. Return the visible count.
+   **/
+  static uint32_t CullBoxes(
+    Frustum const& frustum,
+    Boxes const& boxes,
+    size_t first,
+    size_t last,
+    uint8_t* visibility
+  );
+
+  /* Cull every box, in parallel chunks when 'bParallel' is set. Return the visible count. */
+  static uint32_t CullBoxes(
+    Frustum const& frustum,
+    Boxes const& boxes,
+    std::span<uint8_t> visibility,
+    bool bParallel
+  );
+
+ public:
+  FrustumCulling() = default;
+
+  /* Update the items world boxes from 'transforms' and cull them against 'viewproj'. */
+  void update(
+    std::span<DrawLists::DrawItem const> items,
+    std::span<mat4f const> transforms,
+    mat4 const& viewproj
+  );
+
+  /* Non-zero for the visible items, in the order of the last update. */
+  std::vector<uint8_t> const& visibility() const noexcept {
+    return visibility_;
+  }
+
+  Stats const& stats() const noexcept {
+    return stats_;
+  }
+
+ public:
+  bool enabled{true};
+  bool parallel{true};
+
+ private:
+  void update_boxes(
+    std::span<DrawLists::DrawItem const> items,
+    std::span<mat4f const> transforms
+  );
+
+ private:
+  Boxes boxes_{};
+  std::vector<uint8_t> visibility_{};
+  Stats stats_{};
+};
+
+/* -------------------------------------------------------------------------- */
+
+#endif // AER_RENDERER_FRUSTUM_CULLING_H_
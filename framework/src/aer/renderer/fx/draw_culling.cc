@@ -0,0 +1,404 @@
+/* -------------------------------------------------------------------------- */
+
+#include "aer/renderer/fx/draw_culling.h"
+
+#include <map>
+
+#include "aer/core/camera.h"
+#include "aer/renderer/frustum_culling.h"
+#include "aer/renderer/fx/material/material_fx.h"
+#include "aer/renderer/render_context.h"
+#include "aer/scene/vertex_internal.h" // (for material_shader_interop)
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+namespace interop = shader_interop::draw_culling;
+
+uint32_t IndexTypeSize(VkIndexType const type) {
+  switch (type) {
+    case VK_INDEX_TYPE_UINT8:
+      return 1u;
+    case VK_INDEX_TYPE_UINT16:
+      return 2u;
+    default:
+      return 4u;
+  }
+}
+
+/* Items sharing a key are drawn by the same indirect call. */
+using VertexAttribute = std::tuple<uint32_t, VkFormat, uint32_t>;
+using BatchKey = std::tuple<
+  uint32_t,                     // pipeline
+  VkPrimitiveTopology,
+  VkIndexType,
+  uint32_t,                     // vertex stride
+  uint64_t,                     // vertex binding offset modulo the stride
+  std::vector<VertexAttribute>
+>;
+
+BatchKey MakeBatchKey(DrawLists::DrawItem const& item) {
+  auto const& desc = item.submesh->draw_descriptor;
+  auto const& binding = desc.vertexInput.bindings[0u];
+
+  std::vector<VertexAttribute> attributes{};
+  attributes.reserve(desc.vertexInput.attributes.size());
+  for (auto const& attrib : desc.vertexInput.attributes) {
+    attributes.emplace_back(attrib.location, attrib.format, attrib.offset);
+  }
+
+  return {
+    item.pipeline,
+    item.submesh->parent->vk_primitive_topology(),
+    desc.indexType,
+    binding.stride,
+    desc.vertexInput.vertexBufferOffsets[0u] % binding.stride,
+    std::move(attributes),
+  };
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+bool DrawCulling::Batchable(DrawLists::DrawItem const& item, DrawLists::Pipeline const& pipeline) {
+  auto const* submesh = item.submesh;
+  auto const& desc = submesh->draw_descriptor;
+
+  // (their vertex shader must have an indirect variant)
+  if ((pipeline.fx == nullptr) || !pipeline.fx->supportsIndirectDraws()) {
+    return false;
+  }
+  // (blended items are drawn back to front by the host)
+  if (pipeline.states.alpha_mode == scene::MaterialStates::AlphaMode::Blend) {
+    return false;
+  }
+  if ((submesh->meshlet_count > 0u) || (submesh->lods.size() > interop::kMaxLodLevels)) {
+    return false;
+  }
+  if ((desc.indexCount == 0u) || (desc.vertexInput.bindings.size() != 1u)) {
+    return false;
+  }
+  return (desc.indexOffset % IndexTypeSize(desc.indexType)) == 0u;
+}
+
+// ----------------------------------------------------------------------------
+
+void DrawCulling::init(RenderContext& context) {
+  context_ = &context;
+
+  descriptor_set_layout_ = context_->create_descriptor_set_layout({
+    {
+      .binding = interop::kDescriptorSetBinding_Records_StorageBuffer,
+      .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+      .descriptorCount = 1u,
+      .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+    },
+    {
+      .binding = interop::kDescriptorSetBinding_Transforms_StorageBuffer,
+      .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+      .descriptorCount = 1u,
+      .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+    },
+    {
+      .binding = interop::kDescriptorSetBinding_DrawCommands_StorageBuffer,
+      .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+      .descriptorCount = 1u,
+      .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+    },
+    {
+      .binding = interop::kDescriptorSetBinding_DrawCounts_StorageBuffer,
+      .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+      .descriptorCount = 1u,
+      .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+    },
+    {
+      .binding = interop::kDescriptorSetBinding_DrawData_StorageBuffer,
+      .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+      .descriptorCount = 1u,
+      .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+    },
+  });
+
+  descriptor_set_ = context_->create_descriptor_set(descriptor_set_layout_);
+
+  pipeline_layout_ = context_->create_pipeline_layout({
+    .setLayouts = { descriptor_set_layout_ },
+    .pushConstantRanges = {
+      {
+        .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+        .size = sizeof(push_constant_),
+      }
+    },
+  });
+
+  auto shader{context_->create_shader_module(FRAMEWORK_COMPILED_SHADERS_DIR "draw_culling", "cull_draws.comp.glsl")};
+  compute_pipeline_ = context_->create_compute_pipeline(pipeline_layout_, shader);
+  context_->release_shader_module(shader);
+}
+
+// ----------------------------------------------------------------------------
+
+void DrawCulling::release() {
+  if (!context_) {
+    return;
+  }
+  release_buffers();
+  context_->destroy_pipeline(compute_pipeline_);
+  context_->destroy_pipeline_layout(pipeline_layout_);
+  context_->destroy_descriptor_set_layout(descriptor_set_layout_);
+  context_ = nullptr;
+}
+
+// ----------------------------------------------------------------------------
+
+void DrawCulling::build(DrawLists const& draw_lists, backend::Buffer const& transforms) {
+  LOG_CHECK(context_ != nullptr);
+
+  built_rebuild_count_ = draw_lists.stats().rebuild_count;
+
+  auto const& pipelines = draw_lists.pipelines();
+  auto const& items = draw_lists.items();
+
+  /* Group the batchable items, ordered by pipeline. */
+  std::map<BatchKey, std::vector<uint32_t>> batch_items{};
+  for (uint32_t i = 0u; i < items.size(); ++i) {
+    if (Batchable(items[i], pipelines[items[i].pipeline])) {
+      batch_items[MakeBatchKey(items[i])].push_back(i);
+    }
+  }
+
+  /* One record per item, the batches slots being contiguous. */
+  std::vector<DrawRecord> records{};
+  batches_.clear();
+  batches_.reserve(batch_items.size());
+  for (auto const& [key, indices] : batch_items) {
+    auto const& first_desc = items[indices[0u]].submesh->draw_descriptor;
+    uint32_t const stride{ std::get<3>(key) };
+    uint64_t const base_offset{ std::get<4>(key) };
+    uint32_t const index_size{ IndexTypeSize(std::get<2>(key)) };
+
+    Batch batch{
+      .pipeline = std::get<0>(key),
+      .topology = std::get<1>(key),
+      .draw_descriptor = first_desc,
+      .first_draw = static_cast<uint32_t>(records.size()),
+      .max_draw_count = static_cast<uint32_t>(indices.size()),
+    };
+    // (vertex offsets are relative to the batch binding, indices to the buffer start)
+    batch.draw_descriptor.vertexInput.vertexBufferOffsets[0u] = base_offset;
+    batch.draw_descriptor.indexOffset = 0u;
+    batch.draw_descriptor.indexCount = 0u;
+
+    uint32_t const batch_index{ static_cast<uint32_t>(batches_.size()) };
+    for (uint32_t const item_index : indices) {
+      auto const& item = items[item_index];
+      auto const* submesh = item.submesh;
+      auto const* mesh = submesh->parent;
+      auto const& desc = submesh->draw_descriptor;
+      auto const& prim = mesh->get_primitive(static_cast<uint32_t>(submesh - mesh->submeshes.data()));
+
+      // (skinned vertices may leave their bind pose bounds)
+      bool const bounded{ (prim.radius > 0.0f) && (mesh->skeleton_index == kInvalidIndexU32) };
+
+      DrawRecord record{
+        .boundsMin = vec4(prim.boundsMin[0], prim.boundsMin[1], prim.boundsMin[2], bounded ? 1.0f : 0.0f),
+        .boundsMax = vec4(prim.boundsMax[0], prim.boundsMax[1], prim.boundsMax[2], 0.0f),
+        .sphere = vec4(prim.center[0], prim.center[1], prim.center[2], prim.radius),
+        .positionOffset = vec4(mesh->position_offset, 0.0f),
+        .positionScale = vec4(mesh->position_scale, 0.0f),
+        .indexCount = desc.indexCount,
+        .firstIndex = static_cast<uint32_t>(desc.indexOffset / index_size),
+        .vertexOffset = static_cast<int32_t>((desc.vertexInput.vertexBufferOffsets[0u] - base_offset) / stride),
+        .transformIndex = item.transform_index,
+        .instanceCount = desc.instanceCount,
+        .materialIndex = submesh->material_ref->material_index,
+        .compactVertices = mesh->has_compact_vertices() ? 1u : 0u,
+        .batchIndex = batch_index,
+        .batchOffset = batch.first_draw,
+        .lodCount = static_cast<uint32_t>(submesh->lods.size()),
+      };
+      for (uint32_t lod = 0u; lod < record.lodCount; ++lod) {
+        auto const& level = submesh->lods[lod];
+        record.lods[lod] = {
+          .firstIndex = static_cast<uint32_t>(level.index_offset / index_size),
+          .indexCount = level.index_count,
+          .error = level.error,
+        };
+      }
+      records.push_back(record);
+      batch.draw_descriptor.indexCount += desc.indexCount;
+    }
+    batches_.push_back(std::move(batch));
+  }
+
+  /* Reallocate the device buffers, which may still be in use. */
+  context_->device_wait_idle();
+  release_buffers();
+
+  push_constant_.recordCount = static_cast<uint32_t>(records.size());
+  if (records.empty()) {
+    return;
+  }
+
+  auto const& allocator = context_->allocator();
+  size_t const records_bytesize{ records.size() * sizeof(records[0]) };
+  records_buffer_ = allocator.create_buffer(
+    records_bytesize,
+    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+    VMA_MEMORY_USAGE_GPU_ONLY
+  );
+  // (deferred, the frame using it waits for the transfer)
+  context_->transfer_context().upload(records.data(), records_bytesize, records_buffer_);
+  draw_commands_buffer_ = allocator.create_buffer(
+    records.size() * sizeof(DrawIndexedCommand),
+    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+    VMA_MEMORY_USAGE_GPU_ONLY
+  );
+  draw_counts_buffer_ = allocator.create_buffer(
+    batches_.size() * sizeof(uint32_t),
+      VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+    | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT
+    | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+    VMA_MEMORY_USAGE_GPU_ONLY
+  );
+  draw_data_buffer_ = allocator.create_buffer(
+    records.size() * sizeof(material_shader_interop::DrawData),
+    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+    VMA_MEMORY_USAGE_GPU_ONLY
+  );
+
+  context_->update_descriptor_set(descriptor_set_, {
+    {
+      .binding = interop::kDescriptorSetBinding_Records_StorageBuffer,
+      .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+      .buffers = { { records_buffer_.buffer } }
+    },
+    {
+      .binding = interop::kDescriptorSetBinding_Transforms_StorageBuffer,
+      .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+      .buffers = { { transforms.buffer } }
+    },
+    {
+      .binding = interop::kDescriptorSetBinding_DrawCommands_StorageBuffer,
+      .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+      .buffers = { { draw_commands_buffer_.buffer } }
+    },
+    {
+      .binding = interop::kDescriptorSetBinding_DrawCounts_StorageBuffer,
+      .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+      .buffers = { { draw_counts_buffer_.buffer } }
+    },
+    {
+      .binding = interop::kDescriptorSetBinding_DrawData_StorageBuffer,
+      .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+      .buffers = { { draw_data_buffer_.buffer } }
+    },
+  });
+}
+
+// ----------------------------------------------------------------------------
+
+void DrawCulling::update(Camera const& camera, float const pixel_scale, float const lod_pixel_error) {
+  auto const frustum{ FrustumCulling::ExtractFrustum(camera.viewproj()) };
+  for (uint32_t i = 0u; i < interop::kFrustumPlaneCount; ++i) {
+    push_constant_.frustumPlanes[i] = frustum.planes[i];
+  }
+  push_constant_.cameraPos = camera.position();
+  push_constant_.lodErrorScale = (lod_pixel_error < 0.0f) ? -1.0f : lod_pixel_error / pixel_scale;
+}
+
+// ----------------------------------------------------------------------------
+
+void DrawCulling::execute(GenericCommandEncoder const& cmd) const {
+  if (push_constant_.recordCount == 0u) {
+    return;
+  }
+
+  uint64_t const draw_counts_size{ batches_.size() * sizeof(uint32_t) };
+
+  // (previous frame indirect and vertex shader reads)
+  cmd.pipeline_buffer_barriers({
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+      .srcAccessMask = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+      .dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+      .buffer = draw_counts_buffer_.buffer,
+      .size = draw_counts_size,
+    },
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+      .srcAccessMask = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+      .dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+      .buffer = draw_commands_buffer_.buffer,
+    },
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+      .srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+      .dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+      .buffer = draw_data_buffer_.buffer,
+    },
+  });
+
+  vkCmdFillBuffer(cmd.handle(), draw_counts_buffer_.buffer, 0u, draw_counts_size, 0u);
+
+  cmd.pipeline_buffer_barriers({
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+      .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+      .dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT
+                     | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+      .buffer = draw_counts_buffer_.buffer,
+      .size = draw_counts_size,
+    },
+  });
+
+  cmd.bind_pipeline(compute_pipeline_);
+  cmd.bind_descriptor_set(descriptor_set_, pipeline_layout_, VK_SHADER_STAGE_COMPUTE_BIT);
+  cmd.push_constant(push_constant_, pipeline_layout_, VK_SHADER_STAGE_COMPUTE_BIT);
+  cmd.dispatch<interop::kCompute_CullDraws_kernelSize_x>(push_constant_.recordCount);
+
+  cmd.pipeline_buffer_barriers({
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+      .srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+      .dstAccessMask = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+      .buffer = draw_commands_buffer_.buffer,
+    },
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+      .srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+      .dstAccessMask = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+      .buffer = draw_counts_buffer_.buffer,
+      .size = draw_counts_size,
+    },
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+      .srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+      .dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+      .buffer = draw_data_buffer_.buffer,
+    },
+  });
+}
+
+// ----------------------------------------------------------------------------
+
+void DrawCulling::release_buffers() {
+  auto const& allocator = context_->allocator();
+  for (auto* buffer : { &records_buffer_, &draw_commands_buffer_, &draw_counts_buffer_, &draw_data_buffer_ }) {
+    if (buffer->valid()) {
+      allocator.destroy_buffer(*buffer);
+    }
+    *buffer = {};
+  }
+}
+
+/* -------------------------------------------------------------------------- */
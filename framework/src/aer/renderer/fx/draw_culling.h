@@ -0,0 +1,127 @@
+#ifndef AER_RENDERER_FX_DRAW_CULLING_H_
+#define AER_RENDERER_FX_DRAW_CULLING_H_
+
+#include "aer/core/common.h"
+
+#include "aer/platform/backend/command_encoder.h"
+#include "aer/renderer/draw_lists.h"
+#include "aer/renderer/pipeline.h"
+
+namespace shader_interop::draw_culling {
+#include "aer/shaders/draw_culling/interop.h"
+}
+
+class RenderContext;
+class Camera;
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * GPU-driven drawing of the scene submeshes.
+ *
+ * The batchable draw items are stored once per rebuild of the draw lists as
+ * static records (index range, vertex offset, transform, material, bounds and
+ * LOD levels), grouped in batches sharing a pipeline and a vertex input.
+ *
+ * Each frame, a compute pass culls the records against the camera frustum,
+ * selects their LOD level and appends the visible ones to the
+ * VkDrawIndexedIndirectCommand range of their batch, along with the DrawData
+ * the material vertex shaders fetch from gl_DrawID in place of the push
+ * constants. Each batch is then drawn with one vkCmdDrawIndexedIndirectCount,
+ * its count read from the draw counts buffer at the batch index.
+ *
+ * Blended items, which must stay sorted back to front, and submeshes with
+ * meshlets or several vertex bindings are left to the host draw loop.
+ **/
+class DrawCulling {
+ public:
+  using DrawRecord = shader_interop::draw_culling::DrawRecord;
+  using DrawIndexedCommand = shader_interop::draw_culling::DrawIndexedCommand;
+
+  static_assert(sizeof(DrawIndexedCommand) == sizeof(VkDrawIndexedIndirectCommand));
+
+  /* Draw items sharing a pipeline, a topology and a vertex input. */
+  struct Batch {
+    uint32_t pipeline{};          // in the draw lists pipelines.
+    VkPrimitiveTopology topology{};
+    DrawDescriptor draw_descriptor{};
+    uint32_t first_draw{};        // in the draw commands and data buffers.
+    uint32_t max_draw_count{};    // its record count.
+  };
+
+ public:
+  /* True when the item can be drawn from the device records. */
+  static bool Batchable(DrawLists::DrawItem const& item, DrawLists::Pipeline const& pipeline);
+
+ public:
+  DrawCulling() = default;
+
+  void init(RenderContext& context);
+
+  void release();
+
+  /* Rebuild the records and batches from the draw lists items, drawn with 'transforms'. */
+  void build(DrawLists const& draw_lists, backend::Buffer const& transforms);
+
+  /* Store the camera frustum and LOD selection used by the next execute. */
+  void update(Camera const& camera, float pixel_scale, float lod_pixel_error);
+
+  /* Reset the batches counts, then cull the records into the draw buffers. */
+  void execute(GenericCommandEncoder const& cmd) const;
+
+  /* Draw lists rebuild count of the last build. */
+  [[nodiscard]]
+  uint32_t built_rebuild_count() const noexcept {
+    return built_rebuild_count_;
+  }
+
+  [[nodiscard]]
+  uint32_t record_count() const noexcept {
+    return push_constant_.recordCount;
+  }
+
+  [[nodiscard]]
+  std::vector<Batch> const& batches() const noexcept {
+    return batches_;
+  }
+
+  [[nodiscard]]
+  backend::Buffer const& draw_commands_buffer() const noexcept {
+    return draw_commands_buffer_;
+  }
+
+  [[nodiscard]]
+  backend::Buffer const& draw_counts_buffer() const noexcept {
+    return draw_counts_buffer_;
+  }
+
+  [[nodiscard]]
+  backend::Buffer const& draw_data_buffer() const noexcept {
+    return draw_data_buffer_;
+  }
+
+ private:
+  void release_buffers();
+
+ private:
+  RenderContext* context_{};
+
+  VkDescriptorSetLayout descriptor_set_layout_{};
+  VkDescriptorSet descriptor_set_{};
+  shader_interop::draw_culling::PushConstant push_constant_{};
+
+  VkPipelineLayout pipeline_layout_{};
+  Pipeline compute_pipeline_{};
+
+  std::vector<Batch> batches_{};
+  uint32_t built_rebuild_count_{ kInvalidIndexU32 };
+
+  backend::Buffer records_buffer_{};
+  backend::Buffer draw_commands_buffer_{};
+  backend::Buffer draw_counts_buffer_{};
+  backend::Buffer draw_data_buffer_{};
+};
+
+/* -------------------------------------------------------------------------- */
+
+#endif // AER_RENDERER_FX_DRAW_CULLING_H_
@@ -42,8 +42,18 @@ class PBRMetallicRoughnessFx final : public TMaterialFx<PBRMetallicRoughnessMate
     push_constant_.material_index = index;
   }
 
-  void setInstanceIndex(uint32_t index) final {
-    push_constant_.instance_index = index;
+  void setDrawOffset(uint32_t offset) final {
+    push_constant_.draw_offset = offset;
+  }
+
+  void setVertexDequantization(vec3 const& offset, vec3 const& scale, bool compact) final {
+    push_constant_.position_offset = offset;
+    push_constant_.position_scale = scale;
+    if (compact) {
+      push_constant_.dynamic_states |= pbr_metallic_roughness_shader_interop::kCompactVertexBit;
+    } else {
+      push_constant_.dynamic_states &= ~pbr_metallic_roughness_shader_interop::kCompactVertexBit;
+    }
   }
 
  private:
@@ -55,6 +65,10 @@ class PBRMetallicRoughnessFx final : public TMaterialFx<PBRMetallicRoughnessMate
     return FRAMEWORK_COMPILED_SHADERS_DIR "material/pbr_metallic_roughness/scene.vert.glsl";
   }
 
+  std::string getIndirectVertexShaderName() const final {
+    return FRAMEWORK_COMPILED_SHADERS_DIR "material/pbr_metallic_roughness/scene_indirect.vert.glsl";
+  }
+
   DescriptorSetLayoutParamsBuffer getDescriptorSetLayoutParams() const final {
     return {
       {
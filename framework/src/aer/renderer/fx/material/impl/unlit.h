@@ -36,8 +36,13 @@ class UnlitMaterialFx final : public TMaterialFx<unlit_shader_interop::Material>
     push_constant_.material_index = index;
   }
 
-  void setInstanceIndex(uint32_t index) final {
-    push_constant_.instance_index = index;
+  void setDrawOffset(uint32_t offset) final {
+    push_constant_.draw_offset = offset;
+  }
+
+  void setVertexDequantization(vec3 const& offset, vec3 const& scale, bool /*compact*/) final {
+    push_constant_.position_offset = offset;
+    push_constant_.position_scale = scale;
   }
 
  private:
@@ -49,6 +54,10 @@ class UnlitMaterialFx final : public TMaterialFx<unlit_shader_interop::Material>
     return FRAMEWORK_COMPILED_SHADERS_DIR "material/unlit/scene.vert.glsl";
   }
 
+  std::string getIndirectVertexShaderName() const final {
+    return FRAMEWORK_COMPILED_SHADERS_DIR "material/unlit/scene_indirect.vert.glsl";
+  }
+
   DescriptorSetLayoutParamsBuffer getDescriptorSetLayoutParams() const final {
     return {
       {
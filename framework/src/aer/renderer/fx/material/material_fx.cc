@@ -18,6 +18,11 @@ void MaterialFx::release() {
     for (auto [_, pipeline] : pipelines_) {
       context_ptr_->destroy_pipeline(pipeline);
     }
+    for (auto [_, pipeline] : indirect_pipelines_) {
+      context_ptr_->destroy_pipeline(pipeline);
+    }
+    pipelines_.clear();
+    indirect_pipelines_.clear();
     context_ptr_->destroy_pipeline_layout(pipeline_layout_); //
     context_ptr_->destroy_descriptor_set_layout(descriptor_set_layout_);
     pipeline_layout_ = VK_NULL_HANDLE;
@@ -27,26 +32,37 @@ void MaterialFx::release() {
 // ----------------------------------------------------------------------------
 
 void MaterialFx::createPipelines(std::vector<scene::MaterialStates> const& states) {
-  auto shaders = createShaderModules();
+  // (the indirect variants require gl_DrawID)
+  bool const with_indirect{
+    context_ptr_->has_draw_parameters() && !getIndirectVertexShaderName().empty()
+  };
 
-  // Retrieve specific descriptors.
-  std::vector<GraphicsPipelineDescriptor_t> descs{};
-  descs.reserve(states.size());
-  for (auto const& s : states) {
-    descs.push_back( getGraphicsPipelineDescriptor(shaders, s) );
-  }
+  for (bool const indirect : { false, true }) {
+    if (indirect && !with_indirect) {
+      break;
+    }
+    auto shaders = createShaderModules(indirect);
 
-  // Batch create the pipelines.
-  std::vector<Pipeline> pipelines(states.size());
-  renderer_ptr_->create_graphics_pipelines(pipeline_layout_, descs, &pipelines);
+    // Retrieve specific descriptors.
+    std::vector<GraphicsPipelineDescriptor_t> descs{};
+    descs.reserve(states.size());
+    for (auto const& s : states) {
+      descs.push_back( getGraphicsPipelineDescriptor(shaders, s) );
+    }
 
-  // Store them into the pipeline map.
-  for (size_t i = 0; i < states.size(); ++i) {
-    pipelines_[states[i]] = pipelines[i];
-  }
+    // Batch create the pipelines.
+    std::vector<Pipeline> pipelines(states.size());
+    renderer_ptr_->create_graphics_pipelines(pipeline_layout_, descs, &pipelines);
 
-  for (auto const& [_, shader] : shaders) {
-    context_ptr_->release_shader_module(shader);
+    // Store them into the pipeline map.
+    auto& pipeline_map = indirect ? indirect_pipelines_ : pipelines_;
+    for (size_t i = 0; i < states.size(); ++i) {
+      pipeline_map[states[i]] = pipelines[i];
+    }
+
+    for (auto const& [_, shader] : shaders) {
+      context_ptr_->release_shader_module(shader);
+    }
   }
 }
 
@@ -54,12 +70,29 @@ void MaterialFx::createPipelines(std::vector<scene::MaterialStates> const& state
 
 void MaterialFx::prepareDrawState(
   RenderPassEncoder const& pass,
-  scene::MaterialStates const& states
+  scene::MaterialStates const& states,
+  bool const indirect
+) {
+  bindPipeline(pass, states, indirect);
+  bindDescriptorSets(pass);
+}
+
+// ----------------------------------------------------------------------------
+
+void MaterialFx::bindPipeline(
+  RenderPassEncoder const& pass,
+  scene::MaterialStates const& states,
+  bool const indirect
 ) {
-  LOG_CHECK(pipelines_.contains(states));
+  auto& pipeline_map = indirect ? indirect_pipelines_ : pipelines_;
+  LOG_CHECK(pipeline_map.contains(states));
 
-  pass.bind_pipeline(pipelines_[states]);
+  pass.bind_pipeline(pipeline_map[states]);
+}
+
+// ----------------------------------------------------------------------------
 
+void MaterialFx::bindDescriptorSets(RenderPassEncoder const& pass) {
   // ----------------------------
   auto const& DSR = context_ptr_->descriptor_set_registry();
   VkShaderStageFlags const stage_flags{
@@ -78,11 +111,13 @@ void MaterialFx::prepareDrawState(
     DSR.descriptor(DescriptorSetRegistry::Type::Frame).set,
     pipeline_layout_,
     stage_flags,
-    material_shader_interop::kDescriptorSet_Frame
+    material_shader_interop::kDescriptorSet_Frame,
+    { DSR.frame_ubo_offset() }
   );
 
   pass.bind_descriptor_set(
-    DSR.descriptor(DescriptorSetRegistry::Type::Scene).set,
+    (scene_descriptor_set_ != VK_NULL_HANDLE) ? scene_descriptor_set_
+                                              : DSR.descriptor(DescriptorSetRegistry::Type::Scene).set,
     pipeline_layout_,
     stage_flags,
     material_shader_interop::kDescriptorSet_Scene
@@ -170,11 +205,13 @@ GraphicsPipelineDescriptor_t MaterialFx::getGraphicsPipelineDescriptor(
 
 // ----------------------------------------------------------------------------
 
-backend::ShaderMap MaterialFx::createShaderModules() const {
+backend::ShaderMap MaterialFx::createShaderModules(bool const indirect) const {
   return {
     {
       backend::ShaderStage::Vertex,
-      context_ptr_->create_shader_module(getVertexShaderName())
+      context_ptr_->create_shader_module(
+        indirect ? getIndirectVertexShaderName() : getVertexShaderName()
+      )
     },
     {
       backend::ShaderStage::Fragment,
@@ -25,10 +25,30 @@ class MaterialFx {
 
   virtual void createPipelines(std::vector<scene::MaterialStates> const& states);
 
+  /* 'indirect' selects the pipelines drawing the device culled draws. */
   virtual void prepareDrawState(
     RenderPassEncoder const& pass,
-    scene::MaterialStates const& states
+    scene::MaterialStates const& states,
+    bool indirect = false
+  );
+
+  /* Parts of prepareDrawState, the descriptor sets being shared by every states pipelines. */
+  void bindPipeline(
+    RenderPassEncoder const& pass,
+    scene::MaterialStates const& states,
+    bool indirect = false
   );
+  void bindDescriptorSets(RenderPassEncoder const& pass);
+
+  /* Scene set bound in place of the main one, from the scene owning the MaterialFx. */
+  void setSceneDescriptorSet(VkDescriptorSet set) {
+    scene_descriptor_set_ = set;
+  }
+
+  /* Check if the device culled draws can use this MaterialFx (see getIndirectVertexShaderName). */
+  bool supportsIndirectDraws() const {
+    return !indirect_pipelines_.empty();
+  }
 
   virtual void pushConstant(GenericCommandEncoder const& cmd) = 0;
 
@@ -40,9 +60,18 @@ class MaterialFx {
  protected:
   virtual std::string getVertexShaderName() const = 0;
 
+  /**
+   * Vertex shader variant fetching the per-draw data of the device culled
+   * draws at gl_DrawID, only used with shaderDrawParameters. Without one the
+   * MaterialFx draws are never culled on the device.
+   **/
+  virtual std::string getIndirectVertexShaderName() const {
+    return {};
+  }
+
   virtual std::string getShaderName() const = 0;
 
-  virtual backend::ShaderMap createShaderModules() const;
+  virtual backend::ShaderMap createShaderModules(bool indirect = false) const;
 
   virtual DescriptorSetLayoutParamsBuffer getDescriptorSetLayoutParams() const {
     return {};
@@ -71,13 +100,19 @@ class MaterialFx {
 
   virtual void setTransformIndex(uint32_t index) = 0;
   virtual void setMaterialIndex(uint32_t index) = 0;
-  virtual void setInstanceIndex(uint32_t index) = 0;
+
+  /* First DrawData of GPU-driven draws, kInvalidDrawOffset to use the push constants. */
+  virtual void setDrawOffset(uint32_t offset) = 0;
+
+  /* Positions dequantization, and octahedral normals for VertexCompact_t. */
+  virtual void setVertexDequantization(vec3 const& offset, vec3 const& scale, bool compact) = 0;
 
   // -- material utils --
 
   virtual uint32_t createMaterial(scene::MaterialProxy const& material_proxy) = 0;
 
-  virtual void pushMaterialStorageBuffer() const = 0;
+  /* Record the materials upload into the deferred 'transfer'. */
+  virtual void pushMaterialStorageBuffer(TransferContext& transfer) const = 0;
 
  protected:
   RenderContext const* context_ptr_{};
@@ -87,10 +122,12 @@ class MaterialFx {
   // ----------------
   VkDescriptorSetLayout descriptor_set_layout_{};
   VkDescriptorSet descriptor_set_{}; //
+  VkDescriptorSet scene_descriptor_set_{};
   // ----------------
   VkPipelineLayout pipeline_layout_{}; //
 
   std::map<scene::MaterialStates, Pipeline> pipelines_{};
+  std::map<scene::MaterialStates, Pipeline> indirect_pipelines_{};
   backend::Buffer material_storage_buffer_{};
 };
 
@@ -121,7 +158,7 @@ class TMaterialFx : public MaterialFx {
     return  static_cast<uint32_t>(materials_.size() - 1u);
   }
 
-  void pushMaterialStorageBuffer() const override {
+  void pushMaterialStorageBuffer(TransferContext& transfer) const override {
     LOG_CHECK(materials_.size() < kDefaultMaterialCount);
 
     if (materials_.empty()) {
@@ -135,7 +172,8 @@ class TMaterialFx : public MaterialFx {
         material_storage_buffer_
       );
     } else {
-      context_ptr_->transfer_host_to_device(
+      // (deferred, the frame using it waits for the transfer)
+      transfer.upload(
         materials_.data(),
         materials_.size() * sizeof(ShaderMaterial),
         material_storage_buffer_
@@ -73,9 +73,17 @@ void MaterialFxRegistry::setup(
 
 // ----------------------------------------------------------------------------
 
-void MaterialFxRegistry::push_material_storage_buffers() const {
+void MaterialFxRegistry::push_material_storage_buffers(TransferContext& transfer) const {
   for (auto fx : active_fx_) {
-    fx->pushMaterialStorageBuffer();
+    fx->pushMaterialStorageBuffer(transfer);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void MaterialFxRegistry::set_scene_descriptor_set(VkDescriptorSet const set) {
+  for (auto [_, fx] : fx_map_) {
+    fx->setSceneDescriptorSet(set);
   }
 }
 
@@ -10,6 +10,7 @@
 class Context;
 class Renderer;
 class MaterialFx;
+class TransferContext;
 
 /* -------------------------------------------------------------------------- */
 
@@ -30,7 +31,10 @@ class MaterialFxRegistry {
   );
 
   /* Push updated for all MaterialFx. */
-  void push_material_storage_buffers() const;
+  void push_material_storage_buffers(TransferContext& transfer) const;
+
+  /* Bind 'set' as the Scene set of all MaterialFx. */
+  void set_scene_descriptor_set(VkDescriptorSet set);
 
   /* Getters */
 
@@ -0,0 +1,191 @@
+/* -------------------------------------------------------------------------- */
+
+#include "aer/renderer/fx/meshlet_culling.h"
+
+#include "aer/core/camera.h"
+#include "aer/renderer/render_context.h"
+
+/* -------------------------------------------------------------------------- */
+
+void MeshletCulling::init(RenderContext const& context) {
+  context_ = &context;
+
+  descriptor_set_layout_ = context_->create_descriptor_set_layout({
+    {
+      .binding = shader_interop::meshlet::kDescriptorSetBinding_Meshlets_StorageBuffer,
+      .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+      .descriptorCount = 1u,
+      .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+    },
+    {
+      .binding = shader_interop::meshlet::kDescriptorSetBinding_Transforms_StorageBuffer,
+      .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+      .descriptorCount = 1u,
+      .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+    },
+    {
+      .binding = shader_interop::meshlet::kDescriptorSetBinding_DrawCommands_StorageBuffer,
+      .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+      .descriptorCount = 1u,
+      .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+    },
+    {
+      .binding = shader_interop::meshlet::kDescriptorSetBinding_DrawCounts_StorageBuffer,
+      .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+      .descriptorCount = 1u,
+      .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+    },
+  });
+
+  descriptor_set_ = context_->create_descriptor_set(descriptor_set_layout_);
+
+  pipeline_layout_ = context_->create_pipeline_layout({
+    .setLayouts = { descriptor_set_layout_ },
+    .pushConstantRanges = {
+      {
+        .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+        .size = sizeof(push_constant_),
+      }
+    },
+  });
+
+  auto shader{context_->create_shader_module(FRAMEWORK_COMPILED_SHADERS_DIR "meshlet", "cull_meshlets.comp.glsl")};
+  compute_pipeline_ = context_->create_compute_pipeline(pipeline_layout_, shader);
+  context_->release_shader_module(shader);
+}
+
+// ----------------------------------------------------------------------------
+
+void MeshletCulling::release() {
+  if (!context_) {
+    return;
+  }
+  context_->destroy_pipeline(compute_pipeline_);
+  context_->destroy_pipeline_layout(pipeline_layout_);
+  context_->destroy_descriptor_set_layout(descriptor_set_layout_);
+  context_ = nullptr;
+}
+
+// ----------------------------------------------------------------------------
+
+void MeshletCulling::setup(
+  backend::Buffer const& meshlets,
+  uint32_t const meshlet_count,
+  backend::Buffer const& transforms,
+  backend::Buffer const& draw_commands,
+  backend::Buffer const& draw_counts,
+  uint32_t const draw_count
+) {
+  LOG_CHECK(context_ != nullptr);
+
+  context_->update_descriptor_set(descriptor_set_, {
+    {
+      .binding = shader_interop::meshlet::kDescriptorSetBinding_Meshlets_StorageBuffer,
+      .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+      .buffers = { { meshlets.buffer } }
+    },
+    {
+      .binding = shader_interop::meshlet::kDescriptorSetBinding_Transforms_StorageBuffer,
+      .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+      .buffers = { { transforms.buffer } }
+    },
+    {
+      .binding = shader_interop::meshlet::kDescriptorSetBinding_DrawCommands_StorageBuffer,
+      .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+      .buffers = { { draw_commands.buffer } }
+    },
+    {
+      .binding = shader_interop::meshlet::kDescriptorSetBinding_DrawCounts_StorageBuffer,
+      .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+      .buffers = { { draw_counts.buffer } }
+    },
+  });
+
+  push_constant_.meshletCount = meshlet_count;
+  draw_commands_ = draw_commands.buffer;
+  draw_counts_ = draw_counts.buffer;
+  draw_counts_size_ = draw_count * sizeof(uint32_t);
+}
+
+// ----------------------------------------------------------------------------
+
+void MeshletCulling::update(Camera const& camera) {
+  // Gribb-Hartmann extraction of the side planes, rows of the transposed matrix.
+  mat4 const m{ linalg::transpose(camera.viewproj()) };
+  vec4 const planes[shader_interop::meshlet::kFrustumPlaneCount]{
+    m[3] + m[0],  // left
+    m[3] - m[0],  // right
+    m[3] + m[1],  // bottom
+    m[3] - m[1],  // top
+  };
+  for (uint32_t i = 0u; i < shader_interop::meshlet::kFrustumPlaneCount; ++i) {
+    push_constant_.frustumPlanes[i] = planes[i] / linalg::length(lina::to_vec3(planes[i]));
+  }
+  push_constant_.cameraPos = vec4(camera.position(), 1.0f);
+}
+
+// ----------------------------------------------------------------------------
+
+void MeshletCulling::execute(GenericCommandEncoder const& cmd) const {
+  if (push_constant_.meshletCount == 0u) {
+    return;
+  }
+
+  // (previous frame indirect reads)
+  cmd.pipeline_buffer_barriers({
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+      .srcAccessMask = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+      .dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+      .buffer = draw_counts_,
+      .size = draw_counts_size_,
+    },
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+      .srcAccessMask = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+      .dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+      .buffer = draw_commands_,
+    },
+  });
+
+  vkCmdFillBuffer(cmd.handle(), draw_counts_, 0u, draw_counts_size_, 0u);
+
+  cmd.pipeline_buffer_barriers({
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+      .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+      .dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT
+                     | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+      .buffer = draw_counts_,
+      .size = draw_counts_size_,
+    },
+  });
+
+  cmd.bind_pipeline(compute_pipeline_);
+  cmd.bind_descriptor_set(descriptor_set_, pipeline_layout_, VK_SHADER_STAGE_COMPUTE_BIT);
+  cmd.push_constant(push_constant_, pipeline_layout_, VK_SHADER_STAGE_COMPUTE_BIT);
+  cmd.dispatch<shader_interop::meshlet::kCompute_CullMeshlets_kernelSize_x>(push_constant_.meshletCount);
+
+  cmd.pipeline_buffer_barriers({
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+      .srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+      .dstAccessMask = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+      .buffer = draw_commands_,
+    },
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+      .srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+      .dstAccessMask = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+      .buffer = draw_counts_,
+      .size = draw_counts_size_,
+    },
+  });
+}
+
+/* -------------------------------------------------------------------------- */
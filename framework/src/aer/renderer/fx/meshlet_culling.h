@@ -0,0 +1,78 @@
+#ifndef AER_RENDERER_FX_MESHLET_CULLING_H_
+#define AER_RENDERER_FX_MESHLET_CULLING_H_
+
+#include "aer/core/common.h"
+
+#include "aer/platform/backend/command_encoder.h"
+#include "aer/renderer/pipeline.h"
+
+namespace shader_interop::meshlet {
+#include "aer/shaders/meshlet/interop.h"
+}
+
+class RenderContext;
+class Camera;
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Compute pass culling the scene meshlets against the camera frustum and
+ * their backface cones, for every instance of their mesh.
+ *
+ * Visible meshlets are appended to the VkDrawIndexedIndirectCommand range
+ * of their submesh, whose count is written to the draw counts buffer, to be
+ * consumed by vkCmdDrawIndexedIndirectCount.
+ **/
+class MeshletCulling {
+ public:
+  using Meshlet = shader_interop::meshlet::Meshlet;
+  using DrawIndexedCommand = shader_interop::meshlet::DrawIndexedCommand;
+
+  static_assert(sizeof(DrawIndexedCommand) == sizeof(VkDrawIndexedIndirectCommand));
+
+ public:
+  MeshletCulling() = default;
+
+  void init(RenderContext const& context);
+
+  void release();
+
+  /* Bind the scene buffers, 'draw_counts' holds one uint per submesh. */
+  void setup(
+    backend::Buffer const& meshlets,
+    uint32_t meshlet_count,
+    backend::Buffer const& transforms,
+    backend::Buffer const& draw_commands,
+    backend::Buffer const& draw_counts,
+    uint32_t draw_count
+  );
+
+  /* Store the camera frustum used by the next execute. */
+  void update(Camera const& camera);
+
+  /* Reset the draw counts, then cull the meshlets into the draw buffers. */
+  void execute(GenericCommandEncoder const& cmd) const;
+
+  [[nodiscard]]
+  uint32_t meshlet_count() const noexcept {
+    return push_constant_.meshletCount;
+  }
+
+ private:
+  RenderContext const* context_{};
+
+  VkDescriptorSetLayout descriptor_set_layout_{};
+  VkDescriptorSet descriptor_set_{};
+  shader_interop::meshlet::PushConstant push_constant_{};
+
+  VkPipelineLayout pipeline_layout_{};
+  Pipeline compute_pipeline_{};
+
+  VkBuffer draw_commands_{};
+  VkBuffer draw_counts_{};
+  uint64_t draw_counts_size_{};
+};
+
+/* -------------------------------------------------------------------------- */
+
+#endif // AER_RENDERER_FX_MESHLET_CULLING_H_
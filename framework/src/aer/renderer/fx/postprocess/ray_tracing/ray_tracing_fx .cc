@@ -29,18 +29,21 @@ void RayTracingFx::execute(CommandEncoder& cmd) const {
       DSR.descriptor(DescriptorSetRegistry::Type::Frame).set,
       pipeline_layout_,
       stage_flags,
-      material_shader_interop::kDescriptorSet_Frame
+      material_shader_interop::kDescriptorSet_Frame,
+      { DSR.frame_ubo_offset() }
     );
 
     cmd.bind_descriptor_set(
-      DSR.descriptor(DescriptorSetRegistry::Type::Scene).set,
+      (scene_descriptor_set_ != VK_NULL_HANDLE) ? scene_descriptor_set_
+                                                : DSR.descriptor(DescriptorSetRegistry::Type::Scene).set,
       pipeline_layout_,
       stage_flags,
       material_shader_interop::kDescriptorSet_Scene
     );
 
     cmd.bind_descriptor_set(
-      DSR.descriptor(DescriptorSetRegistry::Type::RayTracing).set,
+      (ray_tracing_descriptor_set_ != VK_NULL_HANDLE) ? ray_tracing_descriptor_set_
+                                                      : DSR.descriptor(DescriptorSetRegistry::Type::RayTracing).set,
       pipeline_layout_,
       stage_flags,
       material_shader_interop::kDescriptorSet_RayTracing
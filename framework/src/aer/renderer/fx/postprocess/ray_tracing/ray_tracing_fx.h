@@ -47,7 +47,16 @@ class RayTracingFx : public PostGenericFx {
 
   void execute(CommandEncoder& cmd) const override;
 
-  void buildMaterialStorageBuffer(std::vector<scene::MaterialProxy> const& proxy_materials) {
+  /* Sets of the scene traced, bound in place of the main ones. */
+  void setSceneDescriptorSets(VkDescriptorSet scene_set, VkDescriptorSet ray_tracing_set) {
+    scene_descriptor_set_ = scene_set;
+    ray_tracing_descriptor_set_ = ray_tracing_set;
+  }
+
+  void buildMaterialStorageBuffer(
+    TransferContext& transfer,
+    std::vector<scene::MaterialProxy> const& proxy_materials
+  ) {
     buildMaterials(proxy_materials);
     if (size_t bufferSize = getMaterialBufferSize(); bufferSize > 0) {
       // Setup the SSBO for rarer device-to-device transfer.
@@ -58,7 +67,8 @@ class RayTracingFx : public PostGenericFx {
         VMA_MEMORY_USAGE_GPU_ONLY
       );
 
-      context_ptr_->transfer_host_to_device(
+      // (deferred, the frame using it waits for the transfer)
+      transfer.upload(
         getMaterialBufferData(),
         bufferSize,
         material_storage_buffer_
@@ -183,6 +193,9 @@ class RayTracingFx : public PostGenericFx {
   backend::RayTracingAddressRegion region_{};
 
   backend::Buffer material_storage_buffer_{};
+
+  VkDescriptorSet scene_descriptor_set_{};
+  VkDescriptorSet ray_tracing_descriptor_set_{};
 };
 
 /* -------------------------------------------------------------------------- */
@@ -156,8 +156,9 @@ void Skybox::release(Renderer const& renderer) {
 bool Skybox::setup(std::string_view hdr_filename) {
   setuped_ = envmap_.setup(hdr_filename);
   if (setuped_) {
-    auto const& context = renderer_ptr_->context();
-    context.descriptor_set_registry().update_scene_ibl(*this);
+    // (the scenes sets are updated from their own update)
+    auto const& DSR = renderer_ptr_->context().descriptor_set_registry();
+    DSR.update_scene_ibl(DSR.descriptor(DescriptorSetRegistry::Type::Scene).set, *this);
   }
   return setuped_;
 }
@@ -11,7 +11,71 @@ using namespace scene;
 
 /* -------------------------------------------------------------------------- */
 
-GPUResources::GPUResources(Renderer const& renderer)
+namespace {
+
+VkFormat ToVkFormat(ImageData::Format const format) {
+  switch (format) {
+    case ImageData::Format::BC7_RGBA:
+      return VK_FORMAT_BC7_UNORM_BLOCK;
+
+    case ImageData::Format::BC5_RG:
+      return VK_FORMAT_BC5_UNORM_BLOCK;
+
+    case ImageData::Format::BC4_R:
+      return VK_FORMAT_BC4_UNORM_BLOCK;
+
+    case ImageData::Format::ASTC_4x4_RGBA:
+      return VK_FORMAT_ASTC_4x4_UNORM_BLOCK;
+
+    case ImageData::Format::ETC2_RGBA:
+      return VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK;
+
+    case ImageData::Format::EAC_RG11:
+      return VK_FORMAT_EAC_R11G11_UNORM_BLOCK;
+
+    case ImageData::Format::EAC_R11:
+      return VK_FORMAT_EAC_R11_UNORM_BLOCK;
+
+    default:
+      return VK_FORMAT_R8G8B8A8_UNORM;
+  }
+}
+
+/* Return 'requested' when the device samples its formats, otherwise the first supported family. */
+ImageData::BlockCompression SupportedTextureCompression(
+  VkPhysicalDevice physical_device,
+  ImageData::BlockCompression const requested
+) {
+  using BlockCompression = ImageData::BlockCompression;
+
+  auto is_supported{[physical_device](BlockCompression compression) {
+    VkFormat const format{
+        (compression == BlockCompression::BC)   ? VK_FORMAT_BC7_UNORM_BLOCK
+      : (compression == BlockCompression::ASTC) ? VK_FORMAT_ASTC_4x4_UNORM_BLOCK
+      : (compression == BlockCompression::ETC2) ? VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK
+                                                : VK_FORMAT_R8G8B8A8_UNORM
+                                                };
+    VkFormatProperties props{};
+    vkGetPhysicalDeviceFormatProperties(physical_device, format, &props);
+    return (props.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) != 0u;
+  }};
+
+  if ((requested == BlockCompression::None) || is_supported(requested)) {
+    return requested;
+  }
+  for (auto const compression : { BlockCompression::BC, BlockCompression::ASTC, BlockCompression::ETC2 }) {
+    if (is_supported(compression)) {
+      return compression;
+    }
+  }
+  return BlockCompression::None;
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+GPUResources::GPUResources(Renderer& renderer)
   : renderer_ptr_(&renderer)
   , context_ptr_(&renderer.context())
 {
@@ -19,6 +83,12 @@ GPUResources::GPUResources(Renderer const& renderer)
   rt_scene_ = std::make_unique<RayTracingScene>();
   rt_scene_->init(*context_ptr_); //
   // ---------------------------------------
+
+  auto const& DSR = context_ptr_->descriptor_set_registry();
+  scene_set_ = DSR.allocate_descriptor_set(DescriptorSetRegistry::Type::Scene);
+  if (rt_scene_) {
+    ray_tracing_set_ = DSR.allocate_descriptor_set(DescriptorSetRegistry::Type::RayTracing);
+  }
 }
 
 // ----------------------------------------------------------------------------
@@ -34,28 +104,59 @@ GPUResources::~GPUResources() {
     rt_scene_.reset();
     // ---------------------------------------
 
+    if (draw_culling_) {
+      draw_culling_->release();
+    }
+    if (meshlet_culling_) {
+      meshlet_culling_->release();
+    }
+    allocator_ptr_->destroy_buffer(meshlet_draw_counts_buffer_);
+    allocator_ptr_->destroy_buffer(meshlet_draws_buffer_);
+    allocator_ptr_->destroy_buffer(meshlet_buffer);
+
+    if (texture_streamer_) {
+      texture_streamer_->release(device_images);
+    }
     for (auto& img : device_images) {
       allocator_ptr_->destroy_image(&img);
     }
     allocator_ptr_->destroy_buffer(transforms_ssbo_);
-    allocator_ptr_->destroy_buffer(frame_ubo_);
     allocator_ptr_->destroy_buffer(index_buffer);
     allocator_ptr_->destroy_buffer(vertex_buffer);
   }
+
+  auto const& DSR = context_ptr_->descriptor_set_registry();
+  DSR.free_descriptor_set(ray_tracing_set_);
+  DSR.free_descriptor_set(scene_set_);
 }
 
 // ----------------------------------------------------------------------------
 
 bool GPUResources::load_file(std::string_view filename) {
-  if (!HostResources::load_file(filename)) {
+  if (!load_host_data(filename)) {
     return false;
   }
+  init_material_fx();
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+bool GPUResources::load_host_data(std::string_view filename) {
+  texture_compression = SupportedTextureCompression(
+    context_ptr_->physical_device(),
+    texture_compression
+  );
+  return HostResources::load_file(filename);
+}
+
+// ----------------------------------------------------------------------------
 
+void GPUResources::init_material_fx() {
   material_fx_registry_ = std::make_unique<MaterialFxRegistry>();
   material_fx_registry_->init(*renderer_ptr_);
   material_fx_registry_->setup(material_proxies, material_refs);
-
-  return true;
+  material_fx_registry_->set_scene_descriptor_set(scene_set_);
 }
 
 // ----------------------------------------------------------------------------
@@ -77,63 +178,283 @@ void GPUResources::initialize_submesh_descriptors(Mesh::AttributeLocationMap con
 // ----------------------------------------------------------------------------
 
 void GPUResources::upload_to_device(bool const bReleaseHostDataOnUpload) {
+  auto const uploads{ prepare_upload() };
+
+  if (uploads.bytesize > 0u) {
+    auto aligned_offset{[](uint64_t offset) {
+      return (offset + kUploadAlignment - 1u) & ~(kUploadAlignment - 1u);
+    }};
+
+    uint64_t staging_size{0u};
+    for (auto const& upload : uploads.buffers) {
+      staging_size = aligned_offset(staging_size) + upload.size;
+    }
+    for (auto const& upload : uploads.images) {
+      staging_size = aligned_offset(staging_size) + upload.size;
+    }
+
+    // Deferred transfers : the copies run on the Transfer queue, then the
+    // mipmaps blits and final barriers on the Main queue, which blits require.
+    auto& transfer = context_ptr_->transfer_context();
+    backend::Buffer const staging_buffer{
+      transfer.create_staging_buffer(staging_size)
+    };
+
+    auto const& cmd = transfer.encoder();
+    record_upload_begin(cmd);
+    {
+      std::byte* staging_data{};
+      allocator_ptr_->map_memory(staging_buffer, (void**)&staging_data);
+
+      uint64_t staging_offset{0u};
+      for (auto const& upload : uploads.buffers) {
+        staging_offset = aligned_offset(staging_offset);
+        memcpy(staging_data + staging_offset, upload.data, upload.size);
+        RecordUpload(cmd, staging_buffer, staging_offset, upload, 0u, upload.size);
+        transfer.release_to_main(upload.buffer);
+        staging_offset += upload.size;
+      }
+      for (auto const& upload : uploads.images) {
+        staging_offset = aligned_offset(staging_offset);
+        memcpy(staging_data + staging_offset, upload.data, upload.size);
+        RecordUpload(cmd, staging_buffer, staging_offset, upload);
+        staging_offset += upload.size;
+      }
+
+      allocator_ptr_->unmap_memory(staging_buffer);
+    }
+    if (upload_images_) {
+      for (auto const& image : device_images) {
+        transfer.release_to_main(image.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, {
+          .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+          .baseMipLevel = 0u,
+          .levelCount = VK_REMAINING_MIP_LEVELS,
+          .baseArrayLayer = 0u,
+          .layerCount = 1u,
+        });
+      }
+    }
+    record_upload_end(transfer.main_encoder());
+
+    // Submitted now, without waiting, for the structures build to chain after it.
+    transfer.flush();
+  }
+
+  finish_upload(bReleaseHostDataOnUpload);
+}
+
+// ----------------------------------------------------------------------------
+
+GPUResources::DeviceUploads GPUResources::prepare_upload() {
   if (!allocator_ptr_) {
     allocator_ptr_ = context_ptr_->allocator_ptr();
   }
 
   /* Transfer Materials */
-  material_fx_registry_->push_material_storage_buffers();
-
-  /* Create the shared Frame UBO */
-  frame_ubo_ = allocator_ptr_->create_buffer(
-    sizeof(FrameData),
-      VK_BUFFER_USAGE_2_UNIFORM_BUFFER_BIT
-    | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-      VMA_MEMORY_USAGE_AUTO,
-      VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT
-    | VMA_ALLOCATION_CREATE_MAPPED_BIT
-  );
+  material_fx_registry_->push_material_storage_buffers(context_ptr_->transfer_context());
+
+  DeviceUploads uploads{};
 
-  /* Transfer Textures */
+  /* Textures */
+  upload_images_ = false;
   if (total_image_size > 0) {
-    upload_images(*context_ptr_);
+    if (stream_textures) {
+      std::vector<VkFormat> formats{};
+      formats.reserve(host_images.size());
+      for (auto const& host_image : host_images) {
+        formats.push_back(ToVkFormat(host_image.format));
+      }
+      texture_streamer_ = std::make_unique<TextureStreamer>();
+      texture_streamer_->init(*context_ptr_, host_images, formats, texture_streaming, device_images);
+    } else {
+      prepare_images(uploads);
+    }
   }
 
-  /* Transfer Buffers */
+  /* Buffers */
   if (vertex_buffer_size > 0) {
-    upload_buffers(*context_ptr_);
+    prepare_buffers(uploads);
+  }
+
+  for (auto const& upload : uploads.buffers) {
+    uploads.bytesize += upload.size;
+  }
+  for (auto const& upload : uploads.images) {
+    uploads.bytesize += upload.size;
+  }
+
+  return uploads;
+}
+
+// ----------------------------------------------------------------------------
+
+void GPUResources::record_upload_begin(CommandEncoder const& cmd) const {
+  if (upload_images_) {
+    cmd.transition_images_layout(
+      device_images,
+      VK_IMAGE_LAYOUT_UNDEFINED,
+      VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+    );
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void GPUResources::record_upload_end(CommandEncoder const& cmd) const {
+  /* Blit the mip chains, leaving their levels in the transfer src layout. */
+  if (upload_images_) {
+    std::vector<VkImageMemoryBarrier2> barriers(device_images.size());
+    for (uint32_t i = 0u; i < device_images.size(); ++i) {
+      bool const blit_mipmaps{ blit_level_counts_[i] > 0u };
+      if (blit_mipmaps) {
+        cmd.generate_mipmaps(
+          device_images[i],
+          {
+            static_cast<uint32_t>(host_images[i].width),
+            static_cast<uint32_t>(host_images[i].height)
+          },
+          blit_level_counts_[i]
+        );
+      }
+      barriers[i] = {
+        .oldLayout = blit_mipmaps ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        .newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        .image = device_images[i].image,
+        .subresourceRange = {
+          .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+          .baseMipLevel = 0u,
+          .levelCount = VK_REMAINING_MIP_LEVELS,
+          .baseArrayLayer = 0u,
+          .layerCount = 1u,
+        },
+      };
+    }
+    cmd.pipeline_image_barriers(barriers);
+  }
+
+  if (vertex_buffer_size <= 0) {
+    return;
+  }
+
+  size_t const transforms_buffer_size{ transforms.size() * sizeof(transforms[0]) };
+  std::vector<VkBufferMemoryBarrier2> barriers{
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT,
+      .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+      .dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
+      .buffer = vertex_buffer.buffer,
+      .size = vertex_buffer_size,
+    },
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT,
+      .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, //
+      .dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
+      .buffer = transforms_ssbo_.buffer,
+      .size = transforms_buffer_size,
+    },
+  };
+  if (index_buffer_size > 0) {
+    barriers.push_back({
+      .srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT,
+      .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+      .dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
+      .buffer = index_buffer.buffer,
+      .size = index_buffer_size,
+    });
+  }
+  if (meshlet_buffer_size_ > 0) {
+    barriers.push_back({
+      .srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT,
+      .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+      .dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
+      .buffer = meshlet_buffer.buffer,
+      .size = meshlet_buffer_size_,
+    });
+  }
+  cmd.pipeline_buffer_barriers(barriers);
+}
+
+// ----------------------------------------------------------------------------
+
+bool GPUResources::record_build(CommandEncoder const& cmd) {
+  build_recorded_ = (vertex_buffer_size > 0) && (rt_scene_ != nullptr);
+  if (build_recorded_) {
+    rt_scene_->record_build(cmd, meshes, vertex_buffer, index_buffer);
+  }
+  return build_recorded_;
+}
+
+// ----------------------------------------------------------------------------
+
+void GPUResources::finish_upload(bool const bReleaseHostDataOnUpload) {
+  upload_meshlets_.clear();
+  upload_meshlets_.shrink_to_fit();
+
+  if (vertex_buffer_size > 0) {
+    /* Cull the meshlets, when any, in place of their submesh. */
+    if (meshlet_buffer.valid() && !context_ptr_->has_draw_indirect_count()) {
+      LOGW("[GPUResources] Meshlets are drawn whole, without VK_KHR_draw_indirect_count.");
+    } else if (meshlet_buffer.valid()) {
+      meshlet_culling_ = std::make_unique<MeshletCulling>();
+      meshlet_culling_->init(*context_ptr_);
+      meshlet_culling_->setup(
+        meshlet_buffer,
+        static_cast<uint32_t>(meshlet_buffer_size_ / sizeof(MeshletCulling::Meshlet)),
+        transforms_ssbo_,
+        meshlet_draws_buffer_,
+        meshlet_draw_counts_buffer_,
+        meshlet_draw_count_
+      );
+    }
+
+    /* Cull and draw the batchable items from the device, when supported. */
+    if (context_ptr_->has_draw_parameters() && context_ptr_->has_draw_indirect_count()) {
+      draw_culling_ = std::make_unique<DrawCulling>();
+      draw_culling_->init(*context_ptr_);
+    }
 
     // ---------------------------------------
-    /* Build the Raytracing acceleration structures. */
+    /* Build the Raytracing acceleration structures, unless already done by record_build. */
     if (rt_scene_) {
-      rt_scene_->build(meshes, vertex_buffer, index_buffer);
+      if (build_recorded_) {
+        rt_scene_->finish_build();
+      } else {
+        rt_scene_->build(meshes, vertex_buffer, index_buffer);
+      }
     }
     // ---------------------------------------
   }
 
-  /* Update Global Descriptor Set bindings. */
+  /* Update the scene own Descriptor Sets bindings (not bound by any frame yet). */
   {
     auto const& DSR = context_ptr_->descriptor_set_registry();
 
-    DSR.update_frame_ubo(frame_ubo_);
-
     if (total_image_size > 0) {
-      DSR.update_scene_textures(descriptor_image_infos());
+      DSR.update_scene_textures(scene_set_, descriptor_image_infos());
     }
 
-    DSR.update_scene_transforms(transforms_ssbo_);
+    DSR.update_scene_transforms(scene_set_, transforms_ssbo_);
 
     // ---------------------------------------
     if (rt_scene_) {
-      DSR.update_ray_tracing_scene(rt_scene_.get());
+      DSR.update_ray_tracing_scene(ray_tracing_set_, rt_scene_.get());
     }
     // ---------------------------------------
   }
+  update_scene_ibl();
 
   /* Clear host data once uploaded */
   if (bReleaseHostDataOnUpload) {
-    host_images.clear();
-    host_images.shrink_to_fit();
+    // (streamed levels are uploaded from the host images, which might be mapped)
+    if (!texture_streamer_) {
+      host_images.clear();
+      host_images.shrink_to_fit();
+      mapped_files_.clear();
+    }
     for (auto const& mesh : meshes) {
       mesh->clear_indices_and_vertices(); //
     }
@@ -142,6 +463,44 @@ void GPUResources::upload_to_device(bool const bReleaseHostDataOnUpload) {
 
 // ----------------------------------------------------------------------------
 
+void GPUResources::RecordUpload(
+  CommandEncoder const& cmd,
+  backend::Buffer const& staging,
+  uint64_t const staging_offset,
+  BufferUpload const& upload,
+  uint64_t const offset,
+  uint64_t const size
+) {
+  VkBufferCopy const region{
+    .srcOffset = staging_offset,
+    .dstOffset = upload.offset + offset,
+    .size = size,
+  };
+  vkCmdCopyBuffer(cmd.handle(), staging.buffer, upload.buffer, 1u, &region);
+}
+
+// ----------------------------------------------------------------------------
+
+void GPUResources::RecordUpload(
+  CommandEncoder const& cmd,
+  backend::Buffer const& staging,
+  uint64_t const staging_offset,
+  ImageUpload const& upload
+) {
+  VkBufferImageCopy region{ upload.region };
+  region.bufferOffset = staging_offset;
+  vkCmdCopyBufferToImage(
+    cmd.handle(),
+    staging.buffer,
+    upload.image,
+    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+    1u,
+    &region
+  );
+}
+
+// ----------------------------------------------------------------------------
+
 std::vector<VkDescriptorImageInfo> GPUResources::descriptor_image_infos() const {
   std::vector<VkDescriptorImageInfo> image_infos{};
 
@@ -170,83 +529,86 @@ void GPUResources::update(
   float elapsedTime
 ) {
   update_frame_data(camera, surfaceSize, elapsedTime);
+  update_scene_ibl();
+
+  float const pixel_scale = 0.5f * std::abs(camera.proj()[1][1]) * surfaceSize.height;
+
+  // Stream the textures levels requested by this frame.
+  if (texture_streamer_) {
+    texture_streamer_->begin_requests();
+    request_texture_levels(camera, pixel_scale);
+    if (texture_streamer_->update(device_images)) {
+      context_ptr_->descriptor_set_registry().update_scene_textures(
+        scene_set_, descriptor_image_infos()
+      );
+    }
+  }
+
+  meshlets_culled_ = false;
+  if (meshlet_culling_) {
+    meshlet_culling_->update(camera);
+  }
+  draws_culled_ = false;
 
   if (ray_tracing_fx_ && ray_tracing_fx_->enabled()) {
     return;
   }
 
-  /// ---------------------------------------
-  ///
-  /// + DevNotes +
-  ///
-  /// We could improve the overall sorting by using a generic 64bits sorting
-  /// key (pipeline << 32) | (material << 16) | depthBits), using a single buffer.
-  ///
-  /// The lookups_ are bins sorted by AlphaMode, to avoid collisions on possible
-  /// future MaterialStates we hash the map on <MaterialFx*, MaterialStates> pairs
-  /// instead of the sole MaterialFx*, however the resulting key not being sort
-  /// it would possible to rebind a pipeline multiple time for a given lookup bins,
-  /// which is okay for alphablend materials but could affect performance on
-  /// Opaque / AlphaMask renders.
-  /// However using std::map with MaterialFx* as the first key of the pair should
-  /// give ordered result.
-  ///
-  /// ---------------------------------------
-
-  // Retrieve submeshes associated to each MaterialFx.
-  if constexpr (true) {
-    lookups_ = {};
+  // Select each submesh LOD level from its projected error.
+  {
+    submitted_triangle_count_ = 0u;
     for (auto const& mesh : meshes) {
-      for (auto const& submesh : mesh->submeshes) {
-        if (auto matref = submesh.material_ref; matref) {
-          auto const alpha_mode = matref->states.alpha_mode;
-          auto fx = material_fx_registry_->material_fx(*matref);
-          auto hashpair = std::make_pair(fx, matref->states);
-          lookups_[alpha_mode][hashpair].emplace_back(&submesh);
-        }
-      }
+      submitted_triangle_count_ += mesh->select_lods(
+        std::span(transforms).subspan(mesh->transform_index, mesh->instance_count),
+        camera.position(),
+        pixel_scale,
+        lod_pixel_error
+      );
     }
-    //reset_scene_lookups = false;
   }
 
-  // Sort each buffer of submeshes.
-
-  using SortKey = std::pair<float, size_t>; // (depthProxy, index)
-  std::vector<SortKey> sortkeys{};
-  SubMeshBuffer swap_buffer{};
-  auto const camera_dir = camera.direction();
+  // Rebuilt only when invalidated, resorted only when the view moved.
+  draw_lists_.update(
+    meshes,
+    [this](MaterialRef const& matref) {
+      return material_fx_registry_->material_fx(matref);
+    },
+    transforms,
+    camera.position(),
+    camera.direction()
+  );
 
-  auto sort_submeshes = [&](SubMeshBuffer &submeshes, auto comp) {
-    sortkeys = {};
-    sortkeys.reserve(submeshes.size());
-    for (size_t i = 0; i < submeshes.size(); ++i) {
-      mat4 const& world = submeshes[i]->parent->world_matrix();
-      vec3 const pos = lina::to_vec3(world.w);
-      vec3 const v = camera.position() - pos;
-      float const dp = linalg::dot(camera_dir, v);
-      sortkeys.emplace_back(dp, i);
+  // (the items order may have changed)
+  frustum_culling_.enabled = frustum_culling;
+  frustum_culling_.update(draw_lists_.items(), transforms, camera.viewproj());
+
+  // Device records follow the draw items rebuilds, not their order.
+  if (draw_culling_ && gpu_driven) {
+    if (draw_culling_->built_rebuild_count() != draw_lists_.stats().rebuild_count) {
+      draw_culling_->build(draw_lists_, transforms_ssbo_);
+      if (draw_culling_->record_count() > 0u) {
+        context_ptr_->descriptor_set_registry().update_scene_draws(
+          scene_set_, draw_culling_->draw_data_buffer()
+        );
+      }
     }
-    std::ranges::sort(sortkeys, comp, &SortKey::first);
+    draw_culling_->update(camera, pixel_scale, lod_pixel_error);
+  }
+}
 
-    // final-sort on submeshes by swapping with new buffer.
-    swap_buffer.resize(submeshes.size());
-    for (size_t i = 0; i < submeshes.size(); ++i) {
-      auto [_, submesh_index] = sortkeys[i];
-      swap_buffer[i] = std::move(submeshes[submesh_index]);
-    }
-    submeshes.swap(swap_buffer);
-  };
+// ----------------------------------------------------------------------------
 
-  // Sort front to back for depth testing.
-  for (auto& [_, submeshes] : lookups_[MaterialStates::AlphaMode::Opaque]) {
-    sort_submeshes(submeshes, std::less{});
+void GPUResources::cull(GenericCommandEncoder const& cmd) {
+  if (ray_tracing_fx_ && ray_tracing_fx_->enabled()) {
+    return;
   }
-  for (auto& [_, submeshes] : lookups_[MaterialStates::AlphaMode::Mask]) {
-    sort_submeshes(submeshes, std::less{});
+  if (meshlet_culling_) {
+    meshlet_culling_->execute(cmd);
+    meshlets_culled_ = true;
   }
-  // Sort back to front for alpha blending.
-  for (auto& [_, submeshes] : lookups_[MaterialStates::AlphaMode::Blend]) {
-    sort_submeshes(submeshes, std::greater{});
+  if (draw_culling_ && gpu_driven && (draw_culling_->record_count() > 0u)) {
+    draw_culling_->execute(cmd);
+    draws_culled_ = true;
   }
 }
 
@@ -259,29 +621,135 @@ void GPUResources::render(RenderPassEncoder const& pass) {
     return;
   }
 
-  // Render each Fx.
-  uint32_t instance_index = 0u;
-  for (auto& lookup : lookups_) {
-    for (auto& [ hashpair, submeshes] : lookup) {
-      auto [fx, states] = hashpair;
+  // Render the sorted draw items, skipping the culled ones and redundant state changes.
+  render_stats_ = {};
+  auto const& pipelines = draw_lists_.pipelines();
+  auto const& items = draw_lists_.items();
+  auto const& visibility = frustum_culling_.visibility();
+  uint32_t bound_pipeline{ kInvalidIndexU32 };
+  MaterialFx* bound_fx{};
+  scene::Mesh const* pushed_mesh{};
+  uint32_t pushed_material{ kInvalidIndexU32 };
+  VkPrimitiveTopology topology{ VK_PRIMITIVE_TOPOLOGY_MAX_ENUM };
+
+  // Batches culled on the device first, their per-draw data fetched from gl_DrawID.
+  if (draws_culled_) {
+    auto const& batches = draw_culling_->batches();
+    for (uint32_t batch_index = 0u; batch_index < batches.size(); ++batch_index) {
+      auto const& batch = batches[batch_index];
+      auto const& pipeline = pipelines[batch.pipeline];
+      auto* fx = pipeline.fx;
+
+      if (batch.pipeline != bound_pipeline) {
+        if (fx != bound_fx) {
+          fx->prepareDrawState(pass, pipeline.states, true);
+          bound_fx = fx;
+          ++render_stats_.descriptor_set_binds;
+        } else {
+          fx->bindPipeline(pass, pipeline.states, true);
+        }
+        bound_pipeline = batch.pipeline;
+        ++render_stats_.pipeline_binds;
+      }
+
+      fx->setDrawOffset(batch.first_draw);
+      fx->pushConstant(pass);
+      ++render_stats_.push_constants;
 
-      // Bind pipeline & descriptor set.
-      // auto const& states = submeshes[0]->material_ref->states;
-      fx->prepareDrawState(pass, states);
+      if (batch.topology != topology) {
+        pass.set_primitive_topology(batch.topology);
+        topology = batch.topology;
+      }
+      ++render_stats_.draw_count;
+      ++render_stats_.indirect_batch_count;
+
+      pass.draw_indirect_count(
+        batch.draw_descriptor,
+        vertex_buffer,
+        index_buffer,
+        draw_culling_->draw_commands_buffer(),
+        batch.first_draw * sizeof(DrawCulling::DrawIndexedCommand),
+        draw_culling_->draw_counts_buffer(),
+        batch_index * sizeof(uint32_t),
+        batch.max_draw_count
+      );
+    }
+    // (the host draws use the non-indirect pipelines, sharing their layout)
+    bound_pipeline = kInvalidIndexU32;
+  }
 
-      // Draw submeshes.
-      for (auto submesh : submeshes) {
-        auto mesh = submesh->parent;
+  for (size_t i = 0u; i < items.size(); ++i) {
+    if (!visibility[i]) {
+      continue;
+    }
+    auto const& item = items[i];
+    auto const& pipeline = pipelines[item.pipeline];
+    auto* fx = pipeline.fx;
 
-        // Submesh's pushConstants.
-        fx->setTransformIndex(mesh->transform_index);
-        fx->setMaterialIndex(submesh->material_ref->material_index);
-        fx->setInstanceIndex(instance_index++); //
-        fx->pushConstant(pass);
+    // (already drawn from the device records)
+    if (draws_culled_ && DrawCulling::Batchable(item, pipeline)) {
+      continue;
+    }
 
-        pass.set_primitive_topology(mesh->vk_primitive_topology());
-        pass.draw(submesh->draw_descriptor, vertex_buffer, index_buffer); //
+    // Bind pipeline & descriptor sets, the later being shared by a Fx pipelines.
+    if (item.pipeline != bound_pipeline) {
+      if (fx != bound_fx) {
+        fx->prepareDrawState(pass, pipeline.states);
+        bound_fx = fx;
+        pushed_mesh = nullptr;
+        ++render_stats_.descriptor_set_binds;
+      } else {
+        fx->bindPipeline(pass, pipeline.states);
       }
+      bound_pipeline = item.pipeline;
+      ++render_stats_.pipeline_binds;
+    }
+
+    auto const* submesh = item.submesh;
+    auto const* mesh = submesh->parent;
+
+    // Submesh's pushConstants, shared by the submeshes of a mesh with the same material.
+    uint32_t const material_index{ submesh->material_ref->material_index };
+    if ((mesh != pushed_mesh) || (material_index != pushed_material)) {
+      fx->setTransformIndex(mesh->transform_index);
+      fx->setMaterialIndex(material_index);
+      fx->setDrawOffset(kInvalidDrawOffset);
+      fx->setVertexDequantization(mesh->position_offset, mesh->position_scale, mesh->has_compact_vertices());
+      fx->pushConstant(pass);
+      pushed_mesh = mesh;
+      pushed_material = material_index;
+      ++render_stats_.push_constants;
+    }
+
+    if (auto const mode = mesh->vk_primitive_topology(); mode != topology) {
+      pass.set_primitive_topology(mode);
+      topology = mode;
+    }
+    ++render_stats_.draw_count;
+
+    // (meshlets only cover the full detail level)
+    if (meshlets_culled_ && (submesh->meshlet_count > 0u) && (submesh->lod_index == 0u)) {
+      pass.draw_indirect_count(
+        submesh->draw_descriptor,
+        vertex_buffer,
+        index_buffer,
+        meshlet_draws_buffer_,
+        submesh->meshlet_draw_offset * sizeof(MeshletCulling::DrawIndexedCommand),
+        meshlet_draw_counts_buffer_,
+        submesh->meshlet_draw_index * sizeof(uint32_t),
+        submesh->meshlet_count
+      );
+    } else if (submesh->lod_index > 0u) {
+      auto const& lod = submesh->lods[submesh->lod_index - 1u];
+      pass.draw_index_range(
+        submesh->draw_descriptor,
+        vertex_buffer,
+        index_buffer,
+        lod.index_offset,
+        lod.index_count
+      );
+    } else {
+      pass.draw(submesh->draw_descriptor, vertex_buffer, index_buffer); //
     }
   }
 }
@@ -291,88 +759,123 @@ void GPUResources::render(RenderPassEncoder const& pass) {
 void GPUResources::set_ray_tracing_fx(RayTracingFx* fx) {
   LOG_CHECK(fx != nullptr);
 
-  fx->buildMaterialStorageBuffer(material_proxies); //
+  fx->buildMaterialStorageBuffer(context_ptr_->transfer_context(), material_proxies); //
+  fx->setSceneDescriptorSets(scene_set_, ray_tracing_set_);
 
   ray_tracing_fx_ = fx;
 }
 
 // ----------------------------------------------------------------------------
 
-void GPUResources::upload_images(Context const& context) {
+void GPUResources::prepare_images(DeviceUploads& uploads) {
   LOG_CHECK( total_image_size > 0 );
   LOG_CHECK( allocator_ptr_ != nullptr );
 
-  /* Create a staging buffer. */
-  backend::Buffer staging_buffer{
-    allocator_ptr_->create_staging_buffer( total_image_size ) //
-  };
-
   device_images.reserve(host_images.size()); //
 
-  std::vector<VkBufferImageCopy> copies{};
-  copies.reserve(host_images.size());
+  // Level count of images whose mip chain is blitted on the device, 0 otherwise.
+  blit_level_counts_.assign(host_images.size(), 0u);
+  bool const device_mipmaps{ mipmap_generation == MipmapGeneration::Device };
 
-  uint64_t staging_offset = 0lu;
-  for (auto const& host_image : host_images) {
-    auto const extent = VkExtent3D{
-      .width = static_cast<uint32_t>(host_image.width),
-      .height = static_cast<uint32_t>(host_image.height),
-      .depth = 1u,
-    };
-    device_images.push_back(context.create_image_2d(
-      extent.width,
-      extent.height,
-      VK_FORMAT_R8G8B8A8_UNORM, //
-      VK_IMAGE_USAGE_TRANSFER_DST_BIT
+  for (size_t i = 0u; i < host_images.size(); ++i) {
+    auto& host_image = host_images[i];
+    if (device_mipmaps && host_image.canGenerateMipmaps()) {
+      blit_level_counts_[i] = ImageData::FullLevelCount(host_image.width, host_image.height);
+    }
+    bool const blit_mipmaps{ blit_level_counts_[i] > 0u };
+    uploads.needs_main_queue |= blit_mipmaps;
+
+    device_images.push_back(context_ptr_->create_image_2d(
+      static_cast<uint32_t>(host_image.width),
+      static_cast<uint32_t>(host_image.height),
+      1u,
+      blit_mipmaps ? blit_level_counts_[i] : host_image.level_count,
+      ToVkFormat(host_image.format),
+      VK_IMAGE_USAGE_TRANSFER_DST_BIT | (blit_mipmaps ? VK_IMAGE_USAGE_TRANSFER_SRC_BIT : 0u),
+      ""
     ));
 
-    /* Upload image to staging buffer */
-    auto const img_bytesize = host_image.getBytesize();
-    allocator_ptr_->write_buffer(
-      staging_buffer, staging_offset, host_image.getPixels(), 0u, img_bytesize
-    );
-    copies.push_back({
-      .bufferOffset = staging_offset,
-      .imageSubresource = {
-        .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
-        .layerCount = 1u,
-      },
-      .imageExtent = extent,
-    });
-    staging_offset += img_bytesize;
+    /* One copy per host mip level. */
+    uint8_t const* pixels{ host_image.getPixels() };
+    auto const levels{ host_image.getMipLevels() };
+    for (uint32_t level_index = 0u; level_index < levels.size(); ++level_index) {
+      auto const& level = levels[level_index];
+      uploads.images.push_back({
+        .data = pixels + level.offset,
+        .size = level.bytesize,
+        .image = device_images.back().image,
+        .region = {
+          .imageSubresource = {
+            .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+            .mipLevel = level_index,
+            .layerCount = 1u,
+          },
+          .imageExtent = {
+            .width = static_cast<uint32_t>(level.width),
+            .height = static_cast<uint32_t>(level.height),
+            .depth = 1u,
+          },
+        },
+      });
+    }
   }
+  upload_images_ = true;
+}
 
-  auto cmd{ context.create_transient_command_encoder(Context::TargetQueue::Transfer) };
-  {
-    VkImageLayout const transfer_layout{ VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL };
+// ----------------------------------------------------------------------------
 
-    cmd.transition_images_layout(
-      device_images,
-      VK_IMAGE_LAYOUT_UNDEFINED,
-      transfer_layout
-    );
-    for (uint32_t i = 0u; i < device_images.size(); ++i) {
-      vkCmdCopyBufferToImage(
-        cmd.handle(),
-        staging_buffer.buffer,
-        device_images[i].image,
-        transfer_layout,
-        1u,
-        &copies[i]
-      );
+void GPUResources::request_texture_levels(Camera const& camera, float const pixel_scale) {
+  for (auto const& mesh : meshes) {
+    auto const world_matrices{
+      std::span(transforms).subspan(mesh->transform_index, mesh->instance_count)
+    };
+
+    for (uint32_t i = 0u; i < mesh->submeshes.size(); ++i) {
+      auto const* matref = mesh->submeshes[i].material_ref;
+      if (!matref) {
+        continue;
+      }
+      auto const& prim = mesh->get_primitive(i);
+      vec4 const center{ prim.center[0], prim.center[1], prim.center[2], 1.0f };
+
+      // Largest projected diameter of the bounding sphere over the instances, in pixels.
+      float projected_size{0.0f};
+      for (auto const& world : world_matrices) {
+        float const scale = std::max({
+          linalg::length(lina::to_vec3(world.x)),
+          linalg::length(lina::to_vec3(world.y)),
+          linalg::length(lina::to_vec3(world.z)),
+        });
+        float const radius{ prim.radius * scale };
+        vec3 const world_center{ lina::to_vec3(linalg::mul(world, center)) };
+        float const distance = linalg::length(world_center - camera.position()) - radius;
+        projected_size = (distance > 0.0f) ? std::max(projected_size, 2.0f * radius * pixel_scale / distance)
+                                           : std::numeric_limits<float>::max()
+                                           ;
+      }
+      if (projected_size <= 0.0f) {
+        continue;
+      }
+
+      auto const& bindings = material(*matref).bindings;
+      for (auto const texture_index : {
+        bindings.basecolor,
+        bindings.normal,
+        bindings.occlusion,
+        bindings.emissive,
+        bindings.roughness_metallic,
+      }) {
+        if (texture_index < textures.size()) {
+          texture_streamer_->request(textures[texture_index].channel_index(), projected_size);
+        }
+      }
     }
-    cmd.transition_images_layout(
-      device_images,
-      transfer_layout,
-      VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-    );
   }
-  context.finish_transient_command_encoder(cmd);
 }
 
 // ----------------------------------------------------------------------------
 
-void GPUResources::upload_buffers(Context const& context) {
+void GPUResources::prepare_buffers(DeviceUploads& uploads) {
   LOG_CHECK(vertex_buffer_size > 0);
   LOG_CHECK(allocator_ptr_ != nullptr);
 
@@ -422,83 +925,100 @@ void GPUResources::upload_buffers(Context const& context) {
     );
   }
 
-  /* Copy host mesh data to the staging buffer. */
-  backend::Buffer staging_buffer{
-    allocator_ptr_->create_staging_buffer(vertex_buffer_size + index_buffer_size + transforms_buffer_size)
-  };
-  {
-    size_t vertex_offset{0lu};
-    size_t index_offset{vertex_buffer_size};
+  // Meshlets culling data, and the indirect draws they are culled into.
+  upload_meshlets_ = gather_meshlets();
+  auto const& meshlets = upload_meshlets_;
+  meshlet_buffer_size_ = meshlets.size() * sizeof(meshlets[0]);
+  if (meshlet_buffer_size_ > 0) {
+    meshlet_buffer = allocator_ptr_->create_buffer(
+      meshlet_buffer_size_,
+      VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+      VMA_MEMORY_USAGE_GPU_ONLY
+    );
+    meshlet_draws_buffer_ = allocator_ptr_->create_buffer(
+      meshlets.size() * sizeof(MeshletCulling::DrawIndexedCommand),
+      VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+      VMA_MEMORY_USAGE_GPU_ONLY
+    );
+    meshlet_draw_counts_buffer_ = allocator_ptr_->create_buffer(
+      meshlet_draw_count_ * sizeof(uint32_t),
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+      | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT
+      | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+      VMA_MEMORY_USAGE_GPU_ONLY
+    );
+  }
 
-    // Transfer the attributes & indices by ranges.
-    std::byte* device_data{};
-    allocator_ptr_->map_memory(staging_buffer, (void**)&device_data);
+  /* Copy the attributes & indices by ranges, the other buffers in one go. */
+  {
+    uint64_t vertex_offset{0u};
+    uint64_t index_offset{0u};
     for (auto const& mesh : meshes) {
       auto const& vertices = mesh->get_vertices();
-      memcpy(device_data + vertex_offset, vertices.data(), vertices.size());
-      vertex_offset += vertices.size();
-
-      if (index_buffer_size > 0) {
-        auto const& indices = mesh->get_indices();
-        memcpy(device_data + index_offset, indices.data(), indices.size());
+      if (!vertices.empty()) {
+        uploads.buffers.push_back({ vertices.data(), vertices.size(), vertex_buffer.buffer, vertex_offset });
+        vertex_offset += vertices.size();
+      }
+      auto const& indices = mesh->get_indices();
+      if ((index_buffer_size > 0) && !indices.empty()) {
+        uploads.buffers.push_back({ indices.data(), indices.size(), index_buffer.buffer, index_offset });
         index_offset += indices.size();
       }
     }
-
-    // Transfer the transforms buffer in one go.
-    memcpy(
-      device_data + vertex_buffer_size + index_buffer_size,
-      transforms.data(),
-      transforms_buffer_size
-    );
-
-    allocator_ptr_->unmap_memory(staging_buffer);
   }
+  if (transforms_buffer_size > 0) {
+    uploads.buffers.push_back({ transforms.data(), transforms_buffer_size, transforms_ssbo_.buffer, 0u });
+  }
+  if (meshlet_buffer_size_ > 0) {
+    uploads.buffers.push_back({ meshlets.data(), meshlet_buffer_size_, meshlet_buffer.buffer, 0u });
+  }
+}
 
-  /* Copy device data from staging buffers to their respective buffers. */
-  auto cmd = context.create_transient_command_encoder(Context::TargetQueue::Transfer);
-  {
-    size_t src_offset{0lu};
-
-    src_offset = cmd.copy_buffer(staging_buffer, src_offset, vertex_buffer, 0u, vertex_buffer_size);
-
-    if (index_buffer_size > 0) {
-      src_offset = cmd.copy_buffer(staging_buffer, src_offset, index_buffer, 0u, index_buffer_size);
-    }
-
-    src_offset = cmd.copy_buffer(staging_buffer, src_offset, transforms_ssbo_, 0u, transforms_buffer_size);
-
-    std::vector<VkBufferMemoryBarrier2> barriers{
-      {
-        .srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT,
-        .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
-        .dstStageMask = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
-        .dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
-        .buffer = vertex_buffer.buffer,
-        .size = vertex_buffer_size,
-      },
-      {
-        .srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT,
-        .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
-        .dstStageMask = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, //
-        .dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
-        .buffer = transforms_ssbo_.buffer,
-        .size = transforms_buffer_size,
-      },
-    };
-    if (index_buffer_size > 0) {
-      barriers.push_back({
-        .srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT,
-        .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
-        .dstStageMask = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
-        .dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
-        .buffer = index_buffer.buffer,
-        .size = index_buffer_size,
-      });
+// ----------------------------------------------------------------------------
+
+std::vector<MeshletCulling::Meshlet> GPUResources::gather_meshlets() {
+  std::vector<MeshletCulling::Meshlet> meshlets{};
+  meshlet_draw_count_ = 0u;
+
+  for (auto const& mesh : meshes) {
+    for (uint32_t i = 0u; i < mesh->submeshes.size(); ++i) {
+      auto& submesh = mesh->submeshes[i];
+      auto const primitive_meshlets = mesh->get_meshlets(i);
+
+      // Blended submeshes keep their triangles order.
+      auto const* matref = submesh.material_ref;
+      if (primitive_meshlets.empty()
+       || !matref
+       || (matref->states.alpha_mode == MaterialStates::AlphaMode::Blend)) {
+        submesh.meshlet_count = 0u;
+        continue;
+      }
+      bool const double_sided = material_proxies[matref->proxy_index].double_sided;
+
+      submesh.meshlet_count = static_cast<uint32_t>(primitive_meshlets.size());
+      submesh.meshlet_draw_offset = static_cast<uint32_t>(meshlets.size());
+      submesh.meshlet_draw_index = meshlet_draw_count_++;
+
+      for (auto const& m : primitive_meshlets) {
+        meshlets.push_back({
+          .sphere = vec4(m.center[0], m.center[1], m.center[2], m.radius),
+          .coneApex = vec4(
+            m.coneApex[0], m.coneApex[1], m.coneApex[2],
+            double_sided ? shader_interop::meshlet::kDisabledConeCutoff : m.coneCutoff
+          ),
+          .coneAxis = vec4(m.coneAxis[0], m.coneAxis[1], m.coneAxis[2], 0.0f),
+          .firstIndex = m.firstIndex,
+          .indexCount = m.indexCount,
+          .transformIndex = mesh->transform_index,
+          .instanceCount = mesh->instance_count,
+          .drawIndex = submesh.meshlet_draw_index,
+          .drawOffset = submesh.meshlet_draw_offset,
+        });
+      }
     }
-    cmd.pipeline_buffer_barriers(barriers);
   }
-  context.finish_transient_command_encoder(cmd);
+
+  return meshlets;
 }
 
 // ----------------------------------------------------------------------------
@@ -519,9 +1039,24 @@ void GPUResources::update_frame_data(
     .frame = frame_index_++,
   };
 
-  context_ptr_->transfer_host_to_device(
-    &frame_data, sizeof(frame_data), frame_ubo_
-  );
+  // Written in the renderer upload ring, without staging copy nor fence wait.
+  auto const allocation{ renderer_ptr_->upload_ring().upload(frame_data) };
+  if (allocation.valid()) {
+    context_ptr_->descriptor_set_registry().set_frame_ubo_offset(
+      static_cast<uint32_t>(allocation.offset)
+    );
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void GPUResources::update_scene_ibl() {
+  auto const& skybox = renderer_ptr_->skybox();
+  if (!skybox.is_valid() || (ibl_view_ == skybox.irradiance_map().view)) {
+    return;
+  }
+  context_ptr_->descriptor_set_registry().update_scene_ibl(scene_set_, skybox);
+  ibl_view_ = skybox.irradiance_map().view;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -3,7 +3,12 @@
 
 #include "aer/scene/host_resources.h"
 
+#include "aer/renderer/draw_lists.h"
+#include "aer/renderer/frustum_culling.h"
 #include "aer/renderer/raytracing_scene.h"
+#include "aer/renderer/texture_streamer.h"
+#include "aer/renderer/fx/draw_culling.h"
+#include "aer/renderer/fx/meshlet_culling.h"
 #include "aer/renderer/fx/material/material_fx_registry.h"
 
 class RenderContext; //
@@ -20,14 +25,63 @@ struct GPUResources : scene::HostResources {
  public:
   static bool constexpr kReleaseHostDataOnUpload = true;
 
+  // Largest projected error, in pixels, of the LOD levels selected by update.
+  static float constexpr kLodPixelError = 1.0f;
+
+  // Stream the textures mip levels from their projected size, instead of
+  // uploading them whole (host images are then kept after upload).
+  static bool constexpr kStreamTextures = false;
+
+  // Alignment of each upload in a staging buffer, a multiple of every texel
+  // block size as required by vkCmdCopyBufferToImage.
+  static uint64_t constexpr kUploadAlignment = 16u;
+
+  /* Host data to copy into a device buffer. */
+  struct BufferUpload {
+    void const* data{};
+    uint64_t size{};
+    VkBuffer buffer{};
+    uint64_t offset{};
+  };
+
+  /* Host data to copy into a device image level. */
+  struct ImageUpload {
+    void const* data{};
+    uint64_t size{};
+    VkImage image{};
+    VkBufferImageCopy region{};   // its bufferOffset set when recorded.
+  };
+
+  struct RenderStats {
+    uint32_t draw_count{};            // indirect batches included.
+    uint32_t indirect_batch_count{};
+    uint32_t pipeline_binds{};
+    uint32_t descriptor_set_binds{};  // one per MaterialFx change.
+    uint32_t push_constants{};
+  };
+
+  /* Copies filling the device resources, from host data kept until finish_upload. */
+  struct DeviceUploads {
+    std::vector<BufferUpload> buffers{};
+    std::vector<ImageUpload> images{};
+    uint64_t bytesize{};
+    bool needs_main_queue{};      // (mipmaps blits)
+  };
+
  public:
-  GPUResources(Renderer const& renderer);
+  GPUResources(Renderer& renderer);
 
   ~GPUResources();
 
   /* Load a scene assets from disk to Host memory. */
   bool load_file(std::string_view filename);
 
+  /* Host part of load_file, which can run on a worker thread. */
+  bool load_host_data(std::string_view filename);
+
+  /* Device part of load_file, to run on the rendering thread. */
+  void init_material_fx();
+
   /* Bind mesh attributes to pipeline locations. */
   void initialize_submesh_descriptors(
     scene::Mesh::AttributeLocationMap const& attribute_to_location
@@ -38,6 +92,48 @@ struct GPUResources : scene::HostResources {
     bool const bReleaseHostDataOnUpload = kReleaseHostDataOnUpload
   );
 
+  /**
+   * Deferred version of upload_to_device, in steps :
+   *  - prepare_upload creates the device resources and lists their copies,
+   *  - the copies are recorded with RecordUpload, possibly over several
+   *    submissions, between record_upload_begin and record_upload_end,
+   *  - once all were executed, record_build records the ray tracing
+   *    structures build, when any, in a submission of its own,
+   *  - once it was executed, finish_upload sets up what depends on them and
+   *    binds the scene to the global descriptor sets, which the frames in
+   *    flight must not use anymore.
+   **/
+  DeviceUploads prepare_upload();
+
+  void record_upload_begin(CommandEncoder const& cmd) const;
+
+  void record_upload_end(CommandEncoder const& cmd) const;
+
+  /* Return false when there is nothing to build, and nothing was recorded. */
+  bool record_build(CommandEncoder const& cmd);
+
+  void finish_upload(
+    bool const bReleaseHostDataOnUpload = kReleaseHostDataOnUpload
+  );
+
+  /* Record the copy of [offset, offset + size) of an upload, staged at 'staging_offset'. */
+  static void RecordUpload(
+    CommandEncoder const& cmd,
+    backend::Buffer const& staging,
+    uint64_t staging_offset,
+    BufferUpload const& upload,
+    uint64_t offset,
+    uint64_t size
+  );
+
+  /* Record the copy of an image level, staged at 'staging_offset'. */
+  static void RecordUpload(
+    CommandEncoder const& cmd,
+    backend::Buffer const& staging,
+    uint64_t staging_offset,
+    ImageUpload const& upload
+  );
+
   /* Construct the image info buffer for the scene textures descriptor set. */
   std::vector<VkDescriptorImageInfo> descriptor_image_infos() const;
 
@@ -48,16 +144,66 @@ struct GPUResources : scene::HostResources {
     float elapsedTime
   );
 
-  /* Render the scene batch per MaterialFx. */
+  /**
+   * Cull the scene meshlets, and the GPU-driven draws when enabled, with the
+   * camera of the last update, to be recorded before the rendering pass.
+   * Submeshes with meshlets and batched draw items are then drawn from the
+   * culled indirect commands.
+   **/
+  void cull(GenericCommandEncoder const& cmd);
+
+  /* Render the scene draw items visible from the camera, sorted by pipeline, material and depth. */
   void render(RenderPassEncoder const& pass);
 
+  /* State changes recorded by the last render. */
+  RenderStats const& render_stats() const noexcept {
+    return render_stats_;
+  }
+
+  /* Draw items visible and culled by the last update. */
+  FrustumCulling::Stats const& culling_stats() const noexcept {
+    return frustum_culling_.stats();
+  }
+
+  /**
+   * Rebuild the draw items on next update, to call after changing the meshes,
+   * their materials or states. Moved transforms only require
+   * invalidate_draw_order.
+   *
+   * The scene data being public fields, nothing calls them automatically :
+   * without them, update keeps the cached items, only resorted when the view moves.
+   **/
+  void invalidate_draw_lists() noexcept {
+    draw_lists_.invalidate();
+  }
+
+  void invalidate_draw_order() noexcept {
+    draw_lists_.invalidate_order();
+  }
+
+  /* Streamer of the scene textures, when enabled at upload. */
+  TextureStreamer const* texture_streamer() const noexcept {
+    return texture_streamer_.get();
+  }
+
+  /* Triangles drawn with the LOD levels selected by the last update, before any culling. */
+  uint64_t submitted_triangle_count() const noexcept {
+    return submitted_triangle_count_;
+  }
+
   // -------------------------------
   void set_ray_tracing_fx(RayTracingFx* fx); //
   // -------------------------------
 
  private:
-  void upload_images(Context const& context);
-  void upload_buffers(Context const& context);
+  void prepare_images(DeviceUploads& uploads);
+  void prepare_buffers(DeviceUploads& uploads);
+
+  /* Request each textured submesh images level from its projected bounding sphere. */
+  void request_texture_levels(Camera const& camera, float pixel_scale);
+
+  /* Gather the meshlets of the submeshes that can be culled, assigning their draw slots. */
+  std::vector<MeshletCulling::Meshlet> gather_meshlets();
 
   void update_frame_data(
     Camera const& camera,
@@ -65,17 +211,56 @@ struct GPUResources : scene::HostResources {
     float elapsedTime
   );
 
+  /* Write the renderer skybox maps into the scene set, when they changed. */
+  void update_scene_ibl();
+
  public:
   /* --- Device Data --- */
 
   std::vector<backend::Image> device_images{};
   backend::Buffer vertex_buffer{};
   backend::Buffer index_buffer{};
+  backend::Buffer meshlet_buffer{};
+
+  // Negative to always draw the full detail submeshes.
+  float lod_pixel_error{kLodPixelError};
+
+  // Cull the draw items against the camera frustum before rendering them.
+  bool frustum_culling{true};
+
+  // Cull and draw the batchable items from the device, when supported.
+  bool gpu_driven{false};
+
+  // Set before upload_to_device.
+  bool stream_textures{kStreamTextures};
+  TextureStreamer::Settings texture_streaming{};
 
  protected:
-  backend::Buffer frame_ubo_{};
   backend::Buffer transforms_ssbo_{};
 
+  backend::Buffer meshlet_draws_buffer_{};
+  backend::Buffer meshlet_draw_counts_buffer_{};
+  uint64_t meshlet_buffer_size_{};
+  uint32_t meshlet_draw_count_{};
+  std::unique_ptr<MeshletCulling> meshlet_culling_{};
+  bool meshlets_culled_{};
+
+  std::unique_ptr<DrawCulling> draw_culling_{};
+  bool draws_culled_{};
+
+  // Pending uploads data, kept until finish_upload.
+  std::vector<MeshletCulling::Meshlet> upload_meshlets_{};
+  std::vector<uint32_t> blit_level_counts_{};   // per image, 0 when not blitted.
+  bool upload_images_{};
+  bool build_recorded_{};
+
+  std::unique_ptr<TextureStreamer> texture_streamer_{};
+
+  // Own Scene and RayTracing sets, written while other scenes may still render.
+  VkDescriptorSet scene_set_{};
+  VkDescriptorSet ray_tracing_set_{};
+  VkImageView ibl_view_{};      // (irradiance map last written)
+
  protected:
   std::unique_ptr<MaterialFxRegistry> material_fx_registry_{};
 
@@ -84,16 +269,17 @@ struct GPUResources : scene::HostResources {
   RayTracingFx const* ray_tracing_fx_{};
   // -------------------------------
 
-  using SubMeshBuffer = std::vector<scene::Mesh::SubMesh const*>;
-  using FxHashPair = std::pair< MaterialFx*, scene::MaterialStates >;
-  using FxHashPairToSubmeshesMap = std::map< FxHashPair, SubMeshBuffer >;
-  EnumArray<FxHashPairToSubmeshesMap, scene::MaterialStates::AlphaMode> lookups_{};
+  // Submeshes draw items, kept between frames.
+  DrawLists draw_lists_{};
+  FrustumCulling frustum_culling_{};
+  RenderStats render_stats_{};
 
  private:
-  Renderer const* renderer_ptr_{};
-  RenderContext const* context_ptr_{};
+  Renderer* renderer_ptr_{};
+  RenderContext* context_ptr_{};
   ResourceAllocator const* allocator_ptr_{};
   uint32_t frame_index_{};
+  uint64_t submitted_triangle_count_{};
 };
 
 /* -------------------------------------------------------------------------- */
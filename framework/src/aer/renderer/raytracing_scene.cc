@@ -43,6 +43,21 @@ void RayTracingScene::build(
   scene::ResourceBuffer<scene::Mesh> const& meshes,
   backend::Buffer const& vertex_buffer,
   backend::Buffer const& index_buffer
+) {
+  auto cmd = context_ptr_->create_transient_command_encoder(Context::TargetQueue::Transfer);
+  record_build(cmd, meshes, vertex_buffer, index_buffer);
+  context_ptr_->finish_transient_command_encoder(cmd);
+
+  finish_build();
+}
+
+// ----------------------------------------------------------------------------
+
+void RayTracingScene::record_build(
+  CommandEncoder const& cmd,
+  scene::ResourceBuffer<scene::Mesh> const& meshes,
+  backend::Buffer const& vertex_buffer,
+  backend::Buffer const& index_buffer
 ) {
   // Refuse the whole scene if no mesh has a proper index format.
   bool hasAnyValidIndexFormat = false;
@@ -52,9 +67,6 @@ void RayTracingScene::build(
       hasAnyValidIndexFormat |= (indexType == VK_INDEX_TYPE_UINT32)
                              || (indexType == VK_INDEX_TYPE_UINT16)
                              ;
-      if (indexType == VK_INDEX_TYPE_UINT16) {
-        LOGI("index is 16bit");
-      }
     }
   }
   if (!hasAnyValidIndexFormat) {
@@ -65,6 +77,23 @@ void RayTracingScene::build(
   vertex_address_ = vertex_buffer.address;
   index_address_ = index_buffer.address;
 
+  // Make the geometry copied by previous submissions visible to the builds.
+  {
+    VkMemoryBarrier2 barrier{
+      .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+      .srcStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+      .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+      .dstStageMask  = VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+      .dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT
+    };
+    VkDependencyInfo depInfo{
+      .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+      .memoryBarrierCount = 1,
+      .pMemoryBarriers = &barrier
+    };
+    vkCmdPipelineBarrier2(cmd.handle(), &depInfo);
+  }
+
   blas_.reserve(meshes.size()); // heuristic
   tlas_.instances.reserve(meshes.size());
 
@@ -76,8 +105,8 @@ void RayTracingScene::build(
                                                    : kInvalidIndexU32
                                                    ;
 
-      if (build_blas(submesh)) {
-        // (simply instanciate the BLAS we just built)
+      if (build_blas(cmd, submesh)) {
+        // (instanciate the BLAS we just built for each mesh instance)
         VkAccelerationStructureInstanceKHR instance{
           .instanceCustomIndex = custom_index & 0x00FFFFFF,
           .mask = 0xFF,
@@ -85,21 +114,39 @@ void RayTracingScene::build(
           .flags = VK_GEOMETRY_INSTANCE_TRIANGLE_FACING_CULL_DISABLE_BIT_KHR, //
           .accelerationStructureReference = blas_.back().accelerationStructAddress,
         };
-        ToVkTransformMatrix(mesh->world_matrix(), instance.transform);
-        tlas_.instances.push_back(instance);
+        // (compact vertices are dequantized by the instance transform)
+        mat4 const dequantization{ mesh->dequantization_matrix() };
+        for (uint32_t i = 0u; i < mesh->instance_count; ++i) {
+          ToVkTransformMatrix(linalg::mul(mesh->world_matrix(i), dequantization), instance.transform);
+          tlas_.instances.push_back(instance);
+        }
       }
     }
   }
-  build_tlas();
+  build_tlas(cmd);
+
+  build_instances_data_buffer(cmd, meshes, vertex_buffer, index_buffer); //
+}
+
+// ----------------------------------------------------------------------------
 
-  build_instances_data_buffer(meshes, vertex_buffer, index_buffer); //
+void RayTracingScene::finish_build() {
+  auto const& allocator = context_ptr_->allocator();
+
+  for (auto const& buffer : build_buffers_) {
+    allocator.destroy_buffer(buffer);
+  }
+  build_buffers_.clear();
 
-  context_ptr_->allocator().clear_staging_buffers();
+  allocator.clear_staging_buffers();
 }
 
 // ----------------------------------------------------------------------------
 
-bool RayTracingScene::build_blas(scene::Mesh::SubMesh const& submesh) {
+bool RayTracingScene::build_blas(
+  CommandEncoder const& cmd,
+  scene::Mesh::SubMesh const& submesh
+) {
   DrawDescriptor const& desc{ submesh.draw_descriptor };
 
   if ((desc.indexType != VK_INDEX_TYPE_UINT16)
@@ -199,6 +246,7 @@ bool RayTracingScene::build_blas(scene::Mesh::SubMesh const& submesh) {
   // C - Build the BLAS.
 
   build_acceleration_structure(
+    cmd,
     &blas,
     VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
     blas.build_range_info
@@ -211,7 +259,7 @@ bool RayTracingScene::build_blas(scene::Mesh::SubMesh const& submesh) {
 
 // ----------------------------------------------------------------------------
 
-void RayTracingScene::build_tlas() {
+void RayTracingScene::build_tlas(CommandEncoder const& cmd) {
   auto const& allocator = context_ptr_->allocator();
 
   if (blas_.empty()) {
@@ -291,63 +339,83 @@ void RayTracingScene::build_tlas() {
   ));
 
   build_acceleration_structure(
+    cmd,
     &tlas_,
     VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR,
     { .primitiveCount = primitiveCount }
   );
 
-  allocator.destroy_buffer(instances_buffer);
+  // (read by the build, released once it was executed)
+  build_buffers_.push_back(instances_buffer);
 }
 
 // ----------------------------------------------------------------------------
 
 void RayTracingScene::build_instances_data_buffer(
+  CommandEncoder const& cmd,
   scene::ResourceBuffer<scene::Mesh> const& meshes,
   backend::Buffer const& vertex_buffer,
   backend::Buffer const& index_buffer
 ) {
   size_t submeshes_count = 0;
   for (auto const& mesh : meshes) {
-    submeshes_count += mesh->submeshes.size();
+    submeshes_count += mesh->submeshes.size() * mesh->instance_count;
   }
 
+  // One entry per TLAS instance, as they are fetched using gl_InstanceID.
   std::vector<InstanceData> instances{};
   instances.reserve(submeshes_count);
 
   for (auto const& mesh : meshes) {
     for (auto const& submesh : mesh->submeshes) {
-      instances.push_back({
+      InstanceData const data{
         .vertex = vertex_address_ + submesh.draw_descriptor.vertexOffset,
         .index = index_address_ + submesh.draw_descriptor.indexOffset,
-      });
+        .index_16bit = (submesh.draw_descriptor.indexType == VK_INDEX_TYPE_UINT16) ? 1u : 0u,
+        .compact_vertex = mesh->has_compact_vertices() ? 1u : 0u,
+        .position_scale = vec4(mesh->position_scale, 1.0f),
+      };
+      instances.insert(instances.end(), mesh->instance_count, data);
     }
   }
-  instances_data_buffer_ = context_ptr_->create_buffer_and_upload(
+  instances_data_buffer_ = cmd.create_buffer_and_upload(
     instances,
     VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
   );
+  cmd.pipeline_buffer_barriers({
+    {
+      .srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+      .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+      .dstStageMask = VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR,
+      .dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+      .buffer = instances_data_buffer_.buffer,
+    },
+  });
 }
 
 // ----------------------------------------------------------------------------
 
 void RayTracingScene::build_acceleration_structure(
+  CommandEncoder const& cmd,
   backend::AccelerationStructure* as,
   VkPipelineStageFlags2 dstStageMask,
   VkAccelerationStructureBuildRangeInfoKHR buildRangeInfo
 ) {
   auto const& allocator = context_ptr_->allocator();
 
-  scratch_buffer_ = allocator.create_buffer(
+  // (one per build, as they are recorded without barriers in between)
+  backend::Buffer const scratch_buffer = allocator.create_buffer(
     as->build_sizes_info.buildScratchSize,
       VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
     | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
     VMA_MEMORY_USAGE_AUTO,
     VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT
   );
+  build_buffers_.push_back(scratch_buffer);
+
   as->build_geometry_info.dstAccelerationStructure = as->handle;
-  as->build_geometry_info.scratchData.deviceAddress = scratch_buffer_.address;
+  as->build_geometry_info.scratchData.deviceAddress = scratch_buffer.address;
 
-  auto cmd = context_ptr_->create_transient_command_encoder(Context::TargetQueue::Transfer);
   {
     std::vector<VkAccelerationStructureBuildRangeInfoKHR *> build_range_infos{
       &buildRangeInfo
@@ -373,9 +441,6 @@ void RayTracingScene::build_acceleration_structure(
     };
     vkCmdPipelineBarrier2(cmd.handle(), &depInfo);
   }
-  context_ptr_->finish_transient_command_encoder(cmd);
-
-  allocator.destroy_buffer(scratch_buffer_); //
 
   VkAccelerationStructureDeviceAddressInfoKHR addrInfo{
     .sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR,
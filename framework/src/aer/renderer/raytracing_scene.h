@@ -24,6 +24,17 @@ class RayTracingSceneInterface {
     backend::Buffer const& index_buffer
   ) = 0;
 
+  /* Record the build into 'cmd', its transient buffers kept until finish_build. */
+  virtual void record_build(
+    CommandEncoder const& cmd,
+    scene::ResourceBuffer<scene::Mesh> const& meshes,
+    backend::Buffer const& vertex_buffer,
+    backend::Buffer const& index_buffer
+  ) = 0;
+
+  /* Release the transient build buffers, once the recorded build was executed. */
+  virtual void finish_build() = 0;
+
   /* Return the Top Level Acceleration Structure. */
   [[nodiscard]]
   virtual backend::TLAS const& tlas() const = 0;
@@ -38,13 +49,17 @@ class RayTracingSceneInterface {
 
  protected:
   /* Build the Bottom Level Acceleration Structure. */
-  virtual bool build_blas(scene::Mesh::SubMesh const& submesh) = 0;
+  virtual bool build_blas(
+    CommandEncoder const& cmd,
+    scene::Mesh::SubMesh const& submesh
+  ) = 0;
 
   /* Build the Top Level Acceleration Structure. */
-  virtual void build_tlas() = 0;
+  virtual void build_tlas(CommandEncoder const& cmd) = 0;
 
   /* Build the Instances data buffer. */
   virtual void build_instances_data_buffer(
+    CommandEncoder const& cmd,
     scene::ResourceBuffer<scene::Mesh> const& meshes,
     backend::Buffer const& vertex_buffer,
     backend::Buffer const& index_buffer
@@ -61,6 +76,9 @@ class RayTracingScene : public RayTracingSceneInterface {
   struct InstanceData {
     VkDeviceAddress vertex{};
     VkDeviceAddress index{};
+    uint32_t index_16bit{}; // non-zero when indices are uint16.
+    uint32_t compact_vertex{}; // non-zero for VertexCompact_t vertices.
+    vec4 position_scale{}; // compact positions scale, baked in the TLAS transform.
   };
 
  public:
@@ -80,6 +98,14 @@ class RayTracingScene : public RayTracingSceneInterface {
     backend::Buffer const& index_buffer
   ) final;
 
+  void record_build(
+    CommandEncoder const& cmd,
+    scene::ResourceBuffer<scene::Mesh> const& meshes,
+    backend::Buffer const& vertex_buffer,
+    backend::Buffer const& index_buffer
+  ) final;
+
+  void finish_build() final;
 
   backend::TLAS const& tlas() const override {
     return tlas_;
@@ -90,11 +116,15 @@ class RayTracingScene : public RayTracingSceneInterface {
   }
 
  protected:
-  bool build_blas(scene::Mesh::SubMesh const& submesh) final;
+  bool build_blas(
+    CommandEncoder const& cmd,
+    scene::Mesh::SubMesh const& submesh
+  ) final;
 
-  void build_tlas() final;
+  void build_tlas(CommandEncoder const& cmd) final;
 
   void build_instances_data_buffer(
+    CommandEncoder const& cmd,
     scene::ResourceBuffer<scene::Mesh> const& meshes,
     backend::Buffer const& vertex_buffer,
     backend::Buffer const& index_buffer
@@ -102,6 +132,7 @@ class RayTracingScene : public RayTracingSceneInterface {
 
  private:
   void build_acceleration_structure(
+    CommandEncoder const& cmd,
     backend::AccelerationStructure* as,
     VkPipelineStageFlags2 dstStageMask,
     VkAccelerationStructureBuildRangeInfoKHR buildRangeInfo
@@ -115,7 +146,8 @@ class RayTracingScene : public RayTracingSceneInterface {
   std::vector<backend::BLAS> blas_{}; // one per submesh
   backend::TLAS tlas_{};
 
-  backend::Buffer scratch_buffer_{};
+  // Scratch and instances buffers of the recorded build.
+  std::vector<backend::Buffer> build_buffers_{};
   backend::Buffer instances_data_buffer_{};
 };
 
@@ -137,6 +137,11 @@ class RenderContext : public Context {
 
   // --- Descriptor Set Registry ---
 
+  [[nodiscard]]
+  DescriptorSetRegistry& descriptor_set_registry() noexcept {
+    return descriptor_set_registry_;
+  }
+
   [[nodiscard]]
   DescriptorSetRegistry const& descriptor_set_registry() const noexcept {
     return descriptor_set_registry_;
@@ -31,6 +31,8 @@ void Renderer::init(
     LOGD(" > Internal Fx");
     skybox_.init(*this);
   }
+
+  scene_streamer_.init(*this);
 }
 
 // ----------------------------------------------------------------------------
@@ -68,6 +70,13 @@ void Renderer::init_view_resources() {
       device_, &cb_alloc_info, &frame.command_buffer
     ));
   }
+
+  // Per-frame upload ring, bound as the dynamic Frame uniform buffer.
+  upload_ring_.init(*ctx_ptr_, frame_count);
+  ctx_ptr_->descriptor_set_registry().update_frame_ubo(
+    upload_ring_.buffer(),
+    sizeof(material_shader_interop::FrameData)
+  );
 }
 
 // ----------------------------------------------------------------------------
@@ -79,6 +88,7 @@ void Renderer::deinit_view_resources() {
     vkFreeCommandBuffers(device_, frame.command_pool, 1u, &frame.command_buffer);
     vkDestroyCommandPool(device_, frame.command_pool, nullptr);
   }
+  upload_ring_.release();
   allocator_ptr_->destroy_image(&depth_stencil_);
 }
 
@@ -87,6 +97,7 @@ void Renderer::deinit_view_resources() {
 void Renderer::deinit() {
   LOG_CHECK(device_ != VK_NULL_HANDLE);
 
+  scene_streamer_.release();
   skybox_.release(*this); //
   deinit_view_resources();
   // *this = {};
@@ -128,6 +139,9 @@ CommandEncoder Renderer::begin_frame() {
   }
   // -----------------------------------
 
+  // Submit the next uploads of the streamed scenes.
+  scene_streamer_.update();
+
   // Reset the frame command pool to record new command for this frame.
   auto &frame = frames_[frame_index_];
   CHECK_VK( vkResetCommandPool(device_, frame.command_pool, 0u) );
@@ -150,10 +164,21 @@ CommandEncoder Renderer::begin_frame() {
 void Renderer::end_frame() {
   cmd_.end();
 
+  // Submit the transfers recorded during the frame, the frame waiting on them
+  // while they are pending.
+  auto& transfer = ctx_ptr_->transfer_context();
+  uint64_t const transfer_value{ transfer.flush() };
+  std::vector<VkSemaphoreSubmitInfo> wait_semaphores{};
+  if ((transfer_value > 0u) && !transfer.completed(transfer_value)) {
+    wait_semaphores.push_back(
+      transfer.wait_semaphore_info(VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT)
+    );
+  }
+
   // -----------------------------------
   LOG_CHECK(swapchain_ptr_);
   auto const& queue = ctx_ptr_->queue(Context::TargetQueue::Main).queue;
-  if (!swapchain_ptr_->submitFrame(queue, cmd_.handle())) {
+  if (!swapchain_ptr_->submitFrame(queue, cmd_.handle(), wait_semaphores)) {
     LOGV("{}: Invalid swapchain, skip that frame.", __FUNCTION__);
     return; 
   }
@@ -162,6 +187,7 @@ void Renderer::end_frame() {
   // -----------------------------------
   swapchain_ptr_->finishFrame(queue);
   frame_index_ = (frame_index_ + 1u) % swapchain_ptr_->imageCount();
+  upload_ring_.next_frame();
   // -----------------------------------
 }
 
@@ -542,4 +568,19 @@ GLTFScene Renderer::load_gltf(std::string_view gltf_filename) {
   return load_gltf(gltf_filename, VertexInternal_t::GetDefaultAttributeLocationMap());
 }
 
+// ----------------------------------------------------------------------------
+
+SceneStreamer::Handle Renderer::stream_gltf(
+  std::string_view gltf_filename,
+  scene::Mesh::AttributeLocationMap const& attribute_to_location
+) {
+  return scene_streamer_.load(gltf_filename, attribute_to_location);
+}
+
+// ----------------------------------------------------------------------------
+
+SceneStreamer::Handle Renderer::stream_gltf(std::string_view gltf_filename) {
+  return stream_gltf(gltf_filename, VertexInternal_t::GetDefaultAttributeLocationMap());
+}
+
 /* -------------------------------------------------------------------------- */
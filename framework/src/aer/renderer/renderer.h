@@ -14,6 +14,8 @@
 
 #include "aer/renderer/fx/skybox.h"
 #include "aer/renderer/gpu_resources.h" // (for GLTFScene)
+#include "aer/renderer/scene_streamer.h"
+#include "aer/renderer/upload_ring.h"
 
 /* -------------------------------------------------------------------------- */
 
@@ -56,12 +58,22 @@ class Renderer : public backend::RTInterface {
   [[nodiscard]]
   RenderContext const& context() const noexcept { return *ctx_ptr_; }
 
+  [[nodiscard]]
+  RenderContext& context() noexcept { return *ctx_ptr_; }
+
   [[nodiscard]]
   Skybox const& skybox() const noexcept { return skybox_; }
 
   [[nodiscard]]
   Skybox& skybox() noexcept { return skybox_; }
 
+  /* Host-written per-frame data (eg. FrameData), released with the frame. */
+  [[nodiscard]]
+  UploadRing const& upload_ring() const noexcept { return upload_ring_; }
+
+  [[nodiscard]]
+  UploadRing& upload_ring() noexcept { return upload_ring_; }
+
   // --- Render Target (Dynamic Rendering) ---
 
   [[nodiscard]]
@@ -119,11 +131,23 @@ class Renderer : public backend::RTInterface {
   [[nodiscard]]
   GLTFScene load_gltf(std::string_view gltf_filename);
 
+  /**
+   * Load a scene progressively : parsed on a worker thread then uploaded by
+   * the next 'begin_frame' calls, within the streamer budget.
+   **/
+  [[nodiscard]]
+  SceneStreamer::Handle stream_gltf(
+    std::string_view gltf_filename,
+    scene::Mesh::AttributeLocationMap const& attribute_to_location
+  );
+
+  [[nodiscard]]
+  SceneStreamer::Handle stream_gltf(std::string_view gltf_filename);
+
+  // Resolved by a later 'begin_frame', so not to be waited on before frames are run.
   [[nodiscard]]
   std::future<GLTFScene> async_load_gltf(std::string const& filename) {
-    return utils::RunTaskGeneric<GLTFScene>([this, filename] {
-      return load_gltf(filename);
-    });
+    return stream_gltf(filename).take_future();
   }
 
  public:
@@ -241,6 +265,7 @@ class Renderer : public backend::RTInterface {
   /* Timeline frame resources */
   std::vector<FrameResources> frames_{};
   uint32_t frame_index_{};
+  UploadRing upload_ring_{};
 
   /* Miscs resources */
   VkClearValue color_clear_value_{kDefaultColorClearValue};
@@ -253,6 +278,8 @@ class Renderer : public backend::RTInterface {
   // ----------
 
   Skybox skybox_{}; //
+
+  SceneStreamer scene_streamer_{};
 };
 
 /* -------------------------------------------------------------------------- */
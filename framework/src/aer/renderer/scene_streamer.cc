@@ -0,0 +1,461 @@
+#include "aer/renderer/scene_streamer.h"
+
+#include "aer/renderer/renderer.h"
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+uint64_t AlignedOffset(uint64_t const offset) {
+  uint64_t constexpr kAlignment{ GPUResources::kUploadAlignment };
+  return (offset + kAlignment - 1u) & ~(kAlignment - 1u);
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+struct SceneStreamer::Request {
+  std::string filename{};
+  scene::Mesh::AttributeLocationMap attribute_to_location{};
+
+  // Owned by the streamer until handed over.
+  GLTFScene resources{};
+  utils::Task<bool> host_loaded{};
+
+  /* Upload queue cursor, the next buffer chunk or image level to stage. */
+  GPUResources::DeviceUploads uploads{};
+  size_t next_buffer{};
+  uint64_t next_buffer_offset{};
+  size_t next_image{};
+  bool recorded_begin{};
+  bool build_submitted{};
+  uint32_t pending_batches{};
+
+  // Set before the status, read by handles once Ready.
+  GLTFScene scene{};
+
+  std::atomic<Status> status{Status::Loading};
+  std::atomic<uint64_t> uploaded_bytes{};
+  std::atomic<uint64_t> total_bytes{};
+
+  std::promise<GLTFScene> promise{};
+  std::future<GLTFScene> future{};
+
+  bool fully_recorded() const noexcept {
+    return (next_buffer >= uploads.buffers.size())
+        && (next_image >= uploads.images.size())
+        ;
+  }
+};
+
+/* -------------------------------------------------------------------------- */
+
+SceneStreamer::Status SceneStreamer::Handle::status() const noexcept {
+  return request_ ? request_->status.load(std::memory_order_acquire)
+                  : Status::Failed
+                  ;
+}
+
+// ----------------------------------------------------------------------------
+
+float SceneStreamer::Handle::progress() const noexcept {
+  if (!request_) {
+    return 0.0f;
+  }
+  if (request_->status.load(std::memory_order_acquire) == Status::Ready) {
+    return 1.0f;
+  }
+  uint64_t const total{ request_->total_bytes.load(std::memory_order_relaxed) };
+  uint64_t const uploaded{ request_->uploaded_bytes.load(std::memory_order_relaxed) };
+  return (total > 0u) ? static_cast<float>(static_cast<double>(uploaded) / total) : 0.0f;
+}
+
+// ----------------------------------------------------------------------------
+
+GLTFScene SceneStreamer::Handle::scene() const {
+  return (status() == Status::Ready) ? request_->scene : nullptr;
+}
+
+// ----------------------------------------------------------------------------
+
+std::future<GLTFScene> SceneStreamer::Handle::take_future() {
+  return request_ ? std::move(request_->future) : std::future<GLTFScene>{};
+}
+
+/* -------------------------------------------------------------------------- */
+
+void SceneStreamer::init(Renderer& renderer, Settings const& settings) {
+  renderer_ptr_ = &renderer;
+  context_ptr_ = &renderer.context();
+  settings_ = settings;
+  settings_.upload_budget = std::max(settings_.upload_budget, GPUResources::kUploadAlignment);
+}
+
+// ----------------------------------------------------------------------------
+
+void SceneStreamer::release() {
+  if (!context_ptr_) {
+    return;
+  }
+
+  retire_batches(true);
+
+  for (auto& request : requests_) {
+    if (request->host_loaded.valid()) {
+      request->host_loaded.wait();
+    }
+    request->resources.reset();
+    request->status.store(Status::Failed, std::memory_order_release);
+    request->promise.set_value(nullptr);
+  }
+  requests_.clear();
+
+  auto const* allocator = context_ptr_->allocator_ptr();
+  for (auto const& staging : free_staging_) {
+    allocator->destroy_buffer(staging);
+  }
+  free_staging_.clear();
+
+  context_ptr_ = nullptr;
+}
+
+// ----------------------------------------------------------------------------
+
+SceneStreamer::Handle SceneStreamer::load(
+  std::string_view filename,
+  scene::Mesh::AttributeLocationMap const& attribute_to_location
+) {
+  LOG_CHECK(renderer_ptr_ != nullptr);
+
+  auto request = std::make_shared<Request>();
+  request->filename = std::string(filename);
+  request->attribute_to_location = attribute_to_location;
+  request->future = request->promise.get_future();
+
+  // (created here as it sets up device objects)
+  request->resources = std::make_shared<GPUResources>(*renderer_ptr_);
+  request->resources->setup();
+
+  request->host_loaded = utils::RunTaskGeneric<bool>(
+    [resources = request->resources, filename = request->filename] {
+      return resources->load_host_data(filename);
+    }
+  );
+
+  requests_.push_back(request);
+
+  return Handle(request);
+}
+
+// ----------------------------------------------------------------------------
+
+void SceneStreamer::update() {
+  if (!context_ptr_ || requests_.empty()) {
+    return;
+  }
+  retire_batches(false);
+  start_uploads();
+  submit_batch();
+  finish_requests();
+}
+
+// ----------------------------------------------------------------------------
+
+void SceneStreamer::start_uploads() {
+  using namespace std::chrono_literals;
+
+  for (auto& request : requests_) {
+    if ((request->status.load(std::memory_order_relaxed) != Status::Loading)
+     || (request->host_loaded.wait_for(0s) != std::future_status::ready)) {
+      continue;
+    }
+    auto& resources = *request->resources;
+
+    if (!request->host_loaded.get()) {
+      LOGW("[SceneStreamer] Failed to load \"{}\".", request->filename);
+      request->status.store(Status::Failed, std::memory_order_release);
+      continue;
+    }
+
+    resources.init_material_fx();
+    resources.initialize_submesh_descriptors(request->attribute_to_location);
+    request->uploads = resources.prepare_upload();
+
+    // A scene without copies (eg. with all its textures streamed) joins no
+    // batch : it has no begin nor end commands, and goes straight to its build.
+    if (request->fully_recorded()) {
+      LOGD("[SceneStreamer] \"{}\" has no copies.", request->filename);
+    }
+
+    request->total_bytes.store(request->uploads.bytesize, std::memory_order_relaxed);
+    request->status.store(Status::Uploading, std::memory_order_release);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+bool SceneStreamer::pack(
+  Request& request,
+  std::vector<Copy>& copies,
+  uint64_t& staging_size
+) const {
+  uint64_t const budget{ settings_.upload_budget };
+  auto const& uploads = request.uploads;
+
+  // Buffers are split in chunks filling the budget.
+  while (request.next_buffer < uploads.buffers.size()) {
+    uint64_t const staging_offset{ AlignedOffset(staging_size) };
+    if (staging_offset >= budget) {
+      return false;
+    }
+    auto const& upload = uploads.buffers[request.next_buffer];
+    uint64_t const size{
+      std::min(upload.size - request.next_buffer_offset, budget - staging_offset)
+    };
+    copies.push_back({
+      .request = &request,
+      .is_image = false,
+      .index = static_cast<uint32_t>(request.next_buffer),
+      .offset = request.next_buffer_offset,
+      .size = size,
+      .staging_offset = staging_offset,
+    });
+    staging_size = staging_offset + size;
+
+    request.next_buffer_offset += size;
+    if (request.next_buffer_offset >= upload.size) {
+      request.next_buffer_offset = 0u;
+      ++request.next_buffer;
+    }
+  }
+
+  // Image levels are copied whole, a level larger than the budget being sent alone.
+  while (request.next_image < uploads.images.size()) {
+    uint64_t const staging_offset{ AlignedOffset(staging_size) };
+    auto const& upload = uploads.images[request.next_image];
+    if (!copies.empty() && (staging_offset + upload.size > budget)) {
+      return false;
+    }
+    copies.push_back({
+      .request = &request,
+      .is_image = true,
+      .index = static_cast<uint32_t>(request.next_image),
+      .size = upload.size,
+      .staging_offset = staging_offset,
+    });
+    staging_size = staging_offset + upload.size;
+    ++request.next_image;
+  }
+
+  return staging_size < budget;
+}
+
+// ----------------------------------------------------------------------------
+
+void SceneStreamer::submit_batch() {
+  /* Pack the next copies, in load order. */
+  std::vector<Copy> copies{};
+  std::vector<std::shared_ptr<Request>> batch_requests{};
+  uint64_t staging_size{0u};
+
+  for (auto const& request : requests_) {
+    if ((request->status.load(std::memory_order_relaxed) != Status::Uploading)
+     || request->fully_recorded()) {
+      continue;
+    }
+    size_t const copy_count{ copies.size() };
+    bool const has_room{ pack(*request, copies, staging_size) };
+
+    // (only requests with copies in this batch are bracketed and counted)
+    if (copies.size() > copy_count) {
+      batch_requests.push_back(request);
+    }
+    if (!has_room) {
+      break;
+    }
+  }
+  if (copies.empty()) {
+    return;
+  }
+
+  Batch batch{
+    .staging = acquire_staging(staging_size),
+    .staging_size = staging_size,
+  };
+  batch.cmd = context_ptr_->create_transient_command_encoder(Context::TargetQueue::Main);
+
+  /* Stage and record the copies, each request bracketed by its begin and end commands. */
+  {
+    auto const* allocator = context_ptr_->allocator_ptr();
+
+    std::byte* staging_data{};
+    allocator->map_memory(batch.staging, (void**)&staging_data);
+
+    auto copy = copies.cbegin();
+    for (auto const& request : batch_requests) {
+      auto const& resources = *request->resources;
+      if (!request->recorded_begin) {
+        resources.record_upload_begin(batch.cmd);
+        request->recorded_begin = true;
+      }
+
+      uint64_t bytesize{0u};
+      for (; (copy != copies.cend()) && (copy->request == request.get()); ++copy) {
+        if (copy->is_image) {
+          auto const& upload = request->uploads.images[copy->index];
+          memcpy(staging_data + copy->staging_offset, upload.data, copy->size);
+          GPUResources::RecordUpload(batch.cmd, batch.staging, copy->staging_offset, upload);
+        } else {
+          auto const& upload = request->uploads.buffers[copy->index];
+          memcpy(
+            staging_data + copy->staging_offset,
+            static_cast<std::byte const*>(upload.data) + copy->offset,
+            copy->size
+          );
+          GPUResources::RecordUpload(batch.cmd, batch.staging, copy->staging_offset, upload, copy->offset, copy->size);
+        }
+        bytesize += copy->size;
+      }
+
+      if (request->fully_recorded()) {
+        resources.record_upload_end(batch.cmd);
+      }
+      ++request->pending_batches;
+      batch.uploaded.emplace_back(request, bytesize);
+    }
+
+    allocator->unmap_memory(batch.staging);
+  }
+
+  submit(std::move(batch));
+}
+
+// ----------------------------------------------------------------------------
+
+bool SceneStreamer::submit_build(std::shared_ptr<Request> const& request) {
+  Batch batch{};
+  batch.cmd = context_ptr_->create_transient_command_encoder(Context::TargetQueue::Main);
+
+  if (!request->resources->record_build(batch.cmd)) {
+    // (a command buffer still recording can be freed)
+    context_ptr_->release_transient_command_encoder(batch.cmd);
+    return false;
+  }
+
+  ++request->pending_batches;
+  batch.uploaded.emplace_back(request, 0u);
+  submit(std::move(batch));
+
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+void SceneStreamer::submit(Batch batch) {
+  /* Submit without waiting, the fence being polled by the next updates. */
+  VkFenceCreateInfo const fence_info{
+    .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+  };
+  CHECK_VK( vkCreateFence(context_ptr_->device(), &fence_info, nullptr, &batch.fence) );
+  context_ptr_->submit_transient_command_encoder(batch.cmd, batch.fence);
+
+  batches_.push_back(std::move(batch));
+}
+
+// ----------------------------------------------------------------------------
+
+void SceneStreamer::retire_batches(bool const bWait) {
+  VkDevice const device{ context_ptr_->device() };
+
+  while (!batches_.empty()) {
+    auto& batch = batches_.front();
+    if (bWait) {
+      CHECK_VK( vkWaitForFences(device, 1u, &batch.fence, VK_TRUE, UINT64_MAX) );
+    } else if (vkGetFenceStatus(device, batch.fence) != VK_SUCCESS) {
+      // (submissions to a single queue complete in order)
+      break;
+    }
+
+    for (auto const& [request, bytesize] : batch.uploaded) {
+      request->uploaded_bytes.fetch_add(bytesize, std::memory_order_relaxed);
+      --request->pending_batches;
+    }
+    vkDestroyFence(device, batch.fence, nullptr);
+    context_ptr_->release_transient_command_encoder(batch.cmd);
+    if (batch.staging.valid()) {
+      recycle_staging(batch.staging, batch.staging_size);
+    }
+
+    batches_.pop_front();
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void SceneStreamer::finish_requests() {
+  std::erase_if(requests_, [this](std::shared_ptr<Request> const& request) {
+    auto const status{ request->status.load(std::memory_order_relaxed) };
+
+    if (status == Status::Failed) {
+      request->resources.reset();
+      request->promise.set_value(nullptr);
+      return true;
+    }
+
+    if ((status != Status::Uploading)
+     || !request->fully_recorded()
+     || (request->pending_batches > 0u)) {
+      return false;
+    }
+
+    // The acceleration structures read the copied geometry, they are built once it was.
+    if (!request->build_submitted) {
+      request->build_submitted = true;
+      if (submit_build(request)) {
+        return false;
+      }
+    }
+
+    // (written into the scene own descriptor sets, other scenes keep rendering)
+    request->resources->finish_upload();
+    request->uploads = {};
+    request->scene = std::move(request->resources);
+    request->status.store(Status::Ready, std::memory_order_release);
+    request->promise.set_value(request->scene);
+
+    LOGI("[SceneStreamer] \"{}\" ready ({} bytes uploaded).",
+      request->filename, request->total_bytes.load(std::memory_order_relaxed)
+    );
+    return true;
+  });
+}
+
+// ----------------------------------------------------------------------------
+
+backend::Buffer SceneStreamer::acquire_staging(uint64_t const size) {
+  if ((size <= settings_.upload_budget) && !free_staging_.empty()) {
+    auto const staging{ free_staging_.back() };
+    free_staging_.pop_back();
+    return staging;
+  }
+  return context_ptr_->allocator_ptr()->create_buffer(
+    std::max(size, settings_.upload_budget),
+    VK_BUFFER_USAGE_2_TRANSFER_SRC_BIT_KHR,
+    VMA_MEMORY_USAGE_CPU_TO_GPU,
+    VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT
+  );
+}
+
+// ----------------------------------------------------------------------------
+
+void SceneStreamer::recycle_staging(backend::Buffer const& staging, uint64_t const size) {
+  // Oversized buffers, for single image levels over the budget, are not kept.
+  if (size <= settings_.upload_budget) {
+    free_staging_.push_back(staging);
+  } else {
+    context_ptr_->allocator_ptr()->destroy_buffer(staging);
+  }
+}
+
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,168 @@
+#ifndef AER_RENDERER_SCENE_STREAMER_H_
+#define AER_RENDERER_SCENE_STREAMER_H_
+
+#include <atomic>
+#include <deque>
+
+#include "aer/core/common.h"
+#include "aer/renderer/gpu_resources.h"
+
+class Renderer;
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Progressive loading of glTF scenes.
+ *
+ * Each scene file is parsed and decoded on a worker thread, then its device
+ * resources are created on the rendering thread and their copies queued.
+ * Every update drains the queue in load order within a byte budget, as a
+ * single submission signaling its own fence, so that large scenes are spread
+ * over several frames instead of stalling one.
+ *
+ * Once every submission holding its copies has completed, the ray tracing
+ * structures of a scene, when any, are built by a submission of their own.
+ * The scene is then bound to the global descriptor sets, after the frames in
+ * flight still using them have completed, and handed over.
+ *
+ * Loads are started and updated from the rendering thread, their handles can
+ * be polled from any.
+ **/
+class SceneStreamer {
+ public:
+  // Bytes of staged copies submitted by a single update.
+  static uint64_t constexpr kDefaultUploadBudget{ 32u * 1024u * 1024u };
+
+  struct Settings {
+    uint64_t upload_budget{kDefaultUploadBudget};
+  };
+
+  enum class Status : uint32_t {
+    Loading,    // parsed on a worker thread.
+    Uploading,  // copies queued or in flight.
+    Ready,
+    Failed,
+  };
+
+  struct Request;
+
+  /* Pollable state of a load, valid after its streamer is released. */
+  class Handle {
+   public:
+    Handle() = default;
+
+    bool valid() const noexcept {
+      return request_ != nullptr;
+    }
+
+    Status status() const noexcept;
+
+    /* True once the scene is either ready or has failed. */
+    bool done() const noexcept {
+      auto const s{ status() };
+      return (s == Status::Ready) || (s == Status::Failed);
+    }
+
+    /* Ratio of the scene bytes uploaded to the device, in [0, 1]. */
+    float progress() const noexcept;
+
+    /* The loaded scene once ready, null otherwise. */
+    GLTFScene scene() const;
+
+    /* Future resolved with scene() when done, to be taken at most once. */
+    std::future<GLTFScene> take_future();
+
+   private:
+    explicit Handle(std::shared_ptr<Request> request)
+      : request_(std::move(request))
+    {}
+
+    std::shared_ptr<Request> request_{};
+
+    friend class SceneStreamer;
+  };
+
+ public:
+  SceneStreamer() = default;
+
+  void init(Renderer& renderer, Settings const& settings = {});
+
+  /* Wait for the pending loads and submissions, failing unfinished scenes. */
+  void release();
+
+  /* Start loading a scene file, with its mesh attributes bound to 'attribute_to_location'. */
+  Handle load(
+    std::string_view filename,
+    scene::Mesh::AttributeLocationMap const& attribute_to_location
+  );
+
+  /**
+   * Retire the completed submissions, hand over the scenes fully uploaded,
+   * then queue the copies of the scenes parsed since the last update and
+   * submit the next ones within the budget.
+   * To be called once per frame, before its rendering.
+   **/
+  void update();
+
+  /* True when no load is pending. */
+  bool idle() const noexcept {
+    return requests_.empty();
+  }
+
+ private:
+  struct Copy {
+    Request* request{};
+    bool is_image{};
+    uint32_t index{};         // in the request buffers or images uploads.
+    uint64_t offset{};        // of the buffer chunk.
+    uint64_t size{};
+    uint64_t staging_offset{};
+  };
+
+  struct Batch {
+    VkFence fence{};
+    CommandEncoder cmd{};
+    backend::Buffer staging{};    // (none for build batches)
+    uint64_t staging_size{};
+    std::vector<std::pair<std::shared_ptr<Request>, uint64_t>> uploaded{};   // bytes per request.
+  };
+
+  /* Queue the copies of the scenes whose worker load completed. */
+  void start_uploads();
+
+  /* Pack the next copies of a request, return false once the budget is reached. */
+  bool pack(Request& request, std::vector<Copy>& copies, uint64_t& staging_size) const;
+
+  /* Stage, record and submit the next copies within the budget. */
+  void submit_batch();
+
+  /* Record the build of a request in a batch of its own, false when it has nothing to build. */
+  bool submit_build(std::shared_ptr<Request> const& request);
+
+  /* Submit a recorded batch, signaling its own fence polled by the next updates. */
+  void submit(Batch batch);
+
+  /* Release the completed submissions, waiting for all of them when 'bWait' is set. */
+  void retire_batches(bool bWait);
+
+  /* Build then hand over the scenes with all their copies completed, drop the failed ones. */
+  void finish_requests();
+
+  backend::Buffer acquire_staging(uint64_t size);
+  void recycle_staging(backend::Buffer const& staging, uint64_t size);
+
+ private:
+  Renderer* renderer_ptr_{};
+  RenderContext const* context_ptr_{};
+  Settings settings_{};
+
+  std::deque<std::shared_ptr<Request>> requests_{};
+  std::deque<Batch> batches_{};
+
+  // Budget sized staging buffers, reused between submissions.
+  std::vector<backend::Buffer> free_staging_{};
+};
+
+/* -------------------------------------------------------------------------- */
+
+#endif // AER_RENDERER_SCENE_STREAMER_H_
@@ -0,0 +1,460 @@
+#include "aer/renderer/texture_streamer.h"
+
+#include <cmath>
+
+#include "aer/platform/backend/context.h"
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+// Alignment of each image level in the staging buffer, a multiple of every
+// texel block size as required by vkCmdCopyBufferToImage.
+uint64_t constexpr kStagingLevelAlignment{ 16u };
+
+uint64_t AlignedOffset(uint64_t const offset) {
+  return (offset + kStagingLevelAlignment - 1u) & ~(kStagingLevelAlignment - 1u);
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+void TextureStreamer::init(
+  Context& context,
+  std::vector<scene::ImageData> const& host_images,
+  std::vector<VkFormat> const& formats,
+  Settings const& settings,
+  std::vector<backend::Image>& device_images
+) {
+  LOG_CHECK(host_images.size() == formats.size());
+
+  context_ptr_ = &context;
+  host_images_ = &host_images;
+  formats_ = formats;
+  settings_ = settings;
+  frame_ = 0u;
+  stats_ = {};
+
+  /* Start each image from its first level fitting the initial extent. */
+  states_.resize(host_images.size());
+  std::vector<Change> changes{};
+  changes.reserve(host_images.size());
+  for (uint32_t i = 0u; i < host_images.size(); ++i) {
+    auto const levels{ host_images[i].getMipLevels() };
+    uint32_t const level_count{ static_cast<uint32_t>(levels.size()) };
+
+    uint32_t level = 0u;
+    while ((level + 1u < level_count)
+        && (std::max(levels[level].width, levels[level].height) > settings_.initial_extent)) {
+      ++level;
+    }
+    states_[i] = {
+      .level_count = level_count,
+      .allocated_level = level,
+      .resident_level = level,
+      .requested_level = level,
+    };
+    stats_.resident_bytes += resident_bytesize(i, level);
+    changes.push_back({
+      .image_index = i,
+      .allocated_level = level,
+      .resident_level = level,
+      .reallocate = true,
+    });
+  }
+
+  device_images.resize(host_images.size());
+  stats_.uploaded_bytes = apply(changes, device_images);
+}
+
+// ----------------------------------------------------------------------------
+
+void TextureStreamer::release(std::vector<backend::Image>& device_images) {
+  if (context_ptr_ == nullptr) {
+    return;
+  }
+  release_retired(true);
+
+  auto const* allocator = context_ptr_->allocator_ptr();
+  for (auto& image : device_images) {
+    allocator->destroy_image(&image);
+  }
+  device_images.clear();
+
+  states_.clear();
+  context_ptr_ = nullptr;
+}
+
+// ----------------------------------------------------------------------------
+
+void TextureStreamer::begin_requests() {
+  for (auto& state : states_) {
+    state.requested_level = state.level_count - 1u;
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void TextureStreamer::request(uint32_t const image_index, float const projected_size) {
+  if (image_index >= states_.size()) {
+    return;
+  }
+  auto& state = states_[image_index];
+  auto const& host_image = (*host_images_)[image_index];
+
+  // Level whose texels cover about a pixel of the projected image.
+  float const extent{ static_cast<float>(std::max(host_image.width, host_image.height)) };
+  float const lod{
+    std::log2(std::max(extent / std::max(projected_size, 1.0e-3f), 1.0f)) + settings_.lod_bias
+  };
+  uint32_t const level{
+    std::min(static_cast<uint32_t>(std::max(lod, 0.0f)), state.level_count - 1u)
+  };
+
+  state.requested_level = std::min(state.requested_level, level);
+  state.last_request_frame = frame_;
+}
+
+// ----------------------------------------------------------------------------
+
+bool TextureStreamer::update(std::vector<backend::Image>& device_images) {
+  stats_.uploaded_bytes = 0u;
+  stats_.promoted_count = 0u;
+  stats_.evicted_count = 0u;
+
+  release_retired(false);
+
+  std::vector<uint32_t> new_levels(states_.size());
+  std::vector<uint32_t> new_allocated_levels(states_.size());
+  std::vector<uint32_t> candidates{};
+  std::vector<uint32_t> victims{};
+  for (uint32_t i = 0u; i < states_.size(); ++i) {
+    auto const& state = states_[i];
+    new_levels[i] = state.resident_level;
+    new_allocated_levels[i] = state.allocated_level;
+    if (state.requested_level < state.resident_level) {
+      candidates.push_back(i);
+    } else if (state.requested_level > state.resident_level) {
+      victims.push_back(i);
+    }
+  }
+  stats_.pending_count = static_cast<uint32_t>(candidates.size());
+
+  // Promote the images furthest from their request first.
+  std::ranges::stable_sort(candidates, std::greater{}, [this](uint32_t i) {
+    return states_[i].resident_level - states_[i].requested_level;
+  });
+
+  // Evict the least recently requested images first.
+  std::ranges::stable_sort(victims, std::less{}, [this](uint32_t i) {
+    return states_[i].last_request_frame;
+  });
+
+  uint64_t resident_bytes{ stats_.resident_bytes };
+  uint64_t upload_bytes{0u};
+  size_t next_victim{0u};
+
+  // Reallocate victims with their requested levels until 'target' bytes are resident.
+  // (the kept levels are uploaded again, on top of the upload budget)
+  auto evict_until{[&](uint64_t target) {
+    while ((resident_bytes > target) && (next_victim < victims.size())) {
+      uint32_t const i = victims[next_victim++];
+      auto const& state = states_[i];
+      uint64_t const kept_bytes{ resident_bytesize(i, state.requested_level) };
+      resident_bytes -= resident_bytesize(i, state.allocated_level) - kept_bytes;
+      upload_bytes += kept_bytes;
+      new_levels[i] = state.requested_level;
+      new_allocated_levels[i] = state.requested_level;
+      ++stats_.evicted_count;
+    }
+    return resident_bytes <= target;
+  }};
+
+  // Promote by a single level per update, at least one image even when over budget.
+  // (an image not allocated with that level yet gets its full mip chain)
+  for (uint32_t const i : candidates) {
+    auto const& state = states_[i];
+    uint32_t const level{ state.resident_level - 1u };
+    bool const in_place{ state.allocated_level <= level };
+    uint64_t const bytesize{
+      in_place ? resident_bytesize(i, level) - resident_bytesize(i, state.resident_level)
+               : resident_bytesize(i, level)
+    };
+    uint64_t const added_bytes{
+      in_place ? 0u
+               : resident_bytesize(i, 0u) - resident_bytesize(i, state.allocated_level)
+    };
+
+    if ((upload_bytes > 0u) && (upload_bytes + bytesize > settings_.upload_budget)) {
+      break;
+    }
+    if ((added_bytes > settings_.memory_budget)
+     || !evict_until(settings_.memory_budget - added_bytes)) {
+      break;
+    }
+    resident_bytes += added_bytes;
+    upload_bytes += bytesize;
+    new_levels[i] = level;
+    new_allocated_levels[i] = in_place ? state.allocated_level : 0u;
+    ++stats_.promoted_count;
+  }
+
+  // (the budget might have been lowered)
+  evict_until(settings_.memory_budget);
+
+  std::vector<Change> changes{};
+  for (uint32_t i = 0u; i < states_.size(); ++i) {
+    if (new_levels[i] != states_[i].resident_level) {
+      changes.push_back({
+        .image_index = i,
+        .allocated_level = new_allocated_levels[i],
+        .resident_level = new_levels[i],
+        .reallocate = (new_allocated_levels[i] != states_[i].allocated_level),
+      });
+    }
+  }
+
+  if (!changes.empty()) {
+    stats_.uploaded_bytes = apply(changes, device_images);
+  }
+  stats_.resident_bytes = resident_bytes;
+  ++frame_;
+
+  return !changes.empty();
+}
+
+// ----------------------------------------------------------------------------
+
+uint64_t TextureStreamer::resident_bytesize(uint32_t const image_index, uint32_t const base_level) const {
+  auto const levels{ (*host_images_)[image_index].getMipLevels() };
+  uint64_t bytesize{0u};
+  for (size_t i = base_level; i < levels.size(); ++i) {
+    bytesize += levels[i].bytesize;
+  }
+  return bytesize;
+}
+
+// ----------------------------------------------------------------------------
+
+uint64_t TextureStreamer::apply(
+  std::vector<Change> const& changes,
+  std::vector<backend::Image>& device_images
+) {
+  auto& context = *context_ptr_;
+  auto const* allocator = context.allocator_ptr();
+  auto& transfer = context.transfer_context();
+  auto const& host_images = *host_images_;
+
+  // Host levels to upload : every resident one of a reallocated image,
+  // the promoted one otherwise.
+  auto upload_levels{[&](Change const& change) {
+    uint32_t const last_level{
+      change.reallocate ? states_[change.image_index].level_count
+                        : change.resident_level + 1u
+    };
+    return std::make_pair(change.resident_level, last_level);
+  }};
+
+  uint64_t staging_size{0u};
+  for (auto const& change : changes) {
+    auto const levels{ host_images[change.image_index].getMipLevels() };
+    auto const [first_level, last_level] = upload_levels(change);
+    for (uint32_t level = first_level; level < last_level; ++level) {
+      staging_size = AlignedOffset(staging_size) + levels[level].bytesize;
+    }
+  }
+  // (released with the transfer batch)
+  auto const staging_buffer{ transfer.create_staging_buffer(staging_size) };
+
+  Retired retired{};
+  std::vector<VkImageMemoryBarrier2> transfer_barriers{};
+  std::vector<VkImageMemoryBarrier2> shader_read_barriers{};
+  std::vector<std::vector<VkBufferImageCopy>> copies(changes.size());
+  transfer_barriers.reserve(changes.size());
+  shader_read_barriers.reserve(changes.size());
+
+  uint64_t staging_offset{0u};
+  for (size_t c = 0u; c < changes.size(); ++c) {
+    auto const& change = changes[c];
+    uint32_t const i{ change.image_index };
+    auto const& host_image = host_images[i];
+    auto const levels{ host_image.getMipLevels() };
+    auto& image = device_images[i];
+
+    /* Replace the image, or only its view, the previous one being retired. */
+    if (change.reallocate) {
+      if (image.valid()) {
+        retired.images.push_back(image);
+      }
+      image = {};
+      VkImageCreateInfo const image_info{
+        .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+        .imageType = VK_IMAGE_TYPE_2D,
+        .format = formats_[i],
+        .extent = {
+          static_cast<uint32_t>(levels[change.allocated_level].width),
+          static_cast<uint32_t>(levels[change.allocated_level].height),
+          1u
+        },
+        .mipLevels = static_cast<uint32_t>(levels.size()) - change.allocated_level,
+        .arrayLayers = 1u,
+        .samples = VK_SAMPLE_COUNT_1_BIT,
+        .tiling = VK_IMAGE_TILING_OPTIMAL,
+        .usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+      };
+      allocator->create_image(image_info, &image);
+    } else {
+      retired.views.push_back(image.view);
+    }
+    image.view = create_view(image, change.allocated_level, change.resident_level);
+
+    // A reallocated image is transitioned as a whole, its levels finer than
+    // the resident one left undefined as they are never sampled.
+    VkImageSubresourceRange const range{
+      .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+      .baseMipLevel = change.reallocate ? 0u : change.resident_level - change.allocated_level,
+      .levelCount = change.reallocate ? VK_REMAINING_MIP_LEVELS : 1u,
+      .baseArrayLayer = 0u,
+      .layerCount = 1u,
+    };
+    transfer_barriers.push_back({
+      .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+      .newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+      .image = image.image,
+      .subresourceRange = range,
+    });
+    shader_read_barriers.push_back({
+      .oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+      .newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+      .image = image.image,
+      .subresourceRange = range,
+    });
+    transfer.release_to_main(image.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, range);
+
+    auto const [first_level, last_level] = upload_levels(change);
+    copies[c].reserve(last_level - first_level);
+    for (uint32_t level_index = first_level; level_index < last_level; ++level_index) {
+      auto const& level = levels[level_index];
+      staging_offset = AlignedOffset(staging_offset);
+      allocator->write_buffer(
+        staging_buffer, staging_offset, host_image.getPixels(), level.offset, level.bytesize
+      );
+      copies[c].push_back({
+        .bufferOffset = staging_offset,
+        .imageSubresource = {
+          .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+          .mipLevel = level_index - change.allocated_level,
+          .layerCount = 1u,
+        },
+        .imageExtent = {
+          .width = static_cast<uint32_t>(level.width),
+          .height = static_cast<uint32_t>(level.height),
+          .depth = 1u,
+        },
+      });
+      staging_offset += level.bytesize;
+    }
+
+    states_[i].allocated_level = change.allocated_level;
+    states_[i].resident_level = change.resident_level;
+  }
+
+  /* Copy on the Transfer queue, then make the levels readable on the Main queue. */
+  auto const& cmd = transfer.encoder();
+  cmd.pipeline_image_barriers(transfer_barriers);
+  for (size_t c = 0u; c < changes.size(); ++c) {
+    vkCmdCopyBufferToImage(
+      cmd.handle(),
+      staging_buffer.buffer,
+      device_images[changes[c].image_index].image,
+      VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+      static_cast<uint32_t>(copies[c].size()),
+      copies[c].data()
+    );
+  }
+  transfer.main_encoder().pipeline_image_barriers(shader_read_barriers);
+
+  /* Retire the replaced images and views once the frames already submitted completed. */
+  // (the frames submitted next use the updated descriptors, which the
+  //  scene textures binding allows to update after bind)
+  if (!retired.images.empty() || !retired.views.empty()) {
+    VkDevice const device{ context.device() };
+    VkFenceCreateInfo const fence_info{
+      .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+    };
+    CHECK_VK( vkCreateFence(device, &fence_info, nullptr, &retired.fence) );
+    // (a fence submitted alone signals once all previous submissions of its queue completed)
+    CHECK_VK( vkQueueSubmit(context.queue(Context::TargetQueue::Main).queue, 0u, nullptr, retired.fence) );
+    retired_.push_back(std::move(retired));
+  }
+
+  return staging_offset;
+}
+
+// ----------------------------------------------------------------------------
+
+VkImageView TextureStreamer::create_view(
+  backend::Image const& image,
+  uint32_t const allocated_level,
+  uint32_t const resident_level
+) const {
+  uint32_t const resident_mip{ resident_level - allocated_level };
+  bool const use_min_lod{ context_ptr_->has_image_view_min_lod() };
+
+  VkImageViewMinLodCreateInfoEXT const min_lod_info{
+    .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_MIN_LOD_CREATE_INFO_EXT,
+    .minLod = static_cast<float>(resident_mip),
+  };
+  VkImageViewCreateInfo const view_info{
+    .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+    .pNext = use_min_lod ? &min_lod_info : nullptr,
+    .image = image.image,
+    .viewType = VK_IMAGE_VIEW_TYPE_2D,
+    .format = image.format,
+    .components = {
+      VK_COMPONENT_SWIZZLE_R,
+      VK_COMPONENT_SWIZZLE_G,
+      VK_COMPONENT_SWIZZLE_B,
+      VK_COMPONENT_SWIZZLE_A,
+    },
+    .subresourceRange = {
+      .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+      .baseMipLevel = use_min_lod ? 0u : resident_mip,
+      .levelCount = VK_REMAINING_MIP_LEVELS,
+      .baseArrayLayer = 0u,
+      .layerCount = 1u,
+    },
+  };
+  VkImageView view{};
+  CHECK_VK( vkCreateImageView(context_ptr_->device(), &view_info, nullptr, &view) );
+  return view;
+}
+
+// ----------------------------------------------------------------------------
+
+void TextureStreamer::release_retired(bool const bWait) {
+  VkDevice const device{ context_ptr_->device() };
+  auto const* allocator = context_ptr_->allocator_ptr();
+
+  while (!retired_.empty()) {
+    auto& retired = retired_.front();
+    if (bWait) {
+      CHECK_VK( vkWaitForFences(device, 1u, &retired.fence, VK_TRUE, UINT64_MAX) );
+    } else if (vkGetFenceStatus(device, retired.fence) != VK_SUCCESS) {
+      break;
+    }
+    for (auto& image : retired.images) {
+      allocator->destroy_image(&image);
+    }
+    for (auto const view : retired.views) {
+      vkDestroyImageView(device, view, nullptr);
+    }
+    vkDestroyFence(device, retired.fence, nullptr);
+    retired_.pop_front();
+  }
+}
+
+/* -------------------------------------------------------------------------- */
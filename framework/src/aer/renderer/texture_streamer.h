@@ -0,0 +1,149 @@
+#ifndef AER_RENDERER_TEXTURE_STREAMER_H_
+#define AER_RENDERER_TEXTURE_STREAMER_H_
+
+#include <deque>
+
+#include "aer/core/common.h"
+#include "aer/platform/backend/types.h"
+#include "aer/scene/image_data.h"
+
+class Context;
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Progressive mip residency of the scene images.
+ *
+ * Images start with their coarse levels only, then each update promotes the
+ * most requested ones by a level, within a per-update upload budget. When the
+ * resident levels exceed the memory budget, the finer levels no longer
+ * requested are evicted, least recently requested images first.
+ *
+ * Images are created with their coarse levels only, then with their full mip
+ * chain on their first promotion. A promotion uploads its new level alone and
+ * lowers the minimum LOD of the image view, which clamps the sampled levels
+ * (or its base level without VK_EXT_image_view_min_lod). An eviction recreates
+ * the image with its requested levels, to free its memory.
+ *
+ * Uploads are deferred to the transfer context, and replaced images and views
+ * are destroyed once the frames using them retired. Levels are uploaded from
+ * the host images, which must outlive the streamer. Images with a single host
+ * level are always fully resident.
+ **/
+class TextureStreamer {
+ public:
+  // Bytes uploaded by a single update.
+  static uint64_t constexpr kDefaultUploadBudget{ 16u * 1024u * 1024u };
+
+  // Bytes of resident levels, over all images.
+  static uint64_t constexpr kDefaultMemoryBudget{ 1024u * 1024u * 1024u };
+
+  // Largest side of the finest level resident at load.
+  static int32_t constexpr kDefaultInitialExtent{ 64 };
+
+  struct Settings {
+    uint64_t upload_budget{kDefaultUploadBudget};
+    uint64_t memory_budget{kDefaultMemoryBudget};
+    int32_t initial_extent{kDefaultInitialExtent};
+
+    // Added to the requested levels, positive to favor coarser levels.
+    float lod_bias{0.0f};
+  };
+
+  struct Stats {
+    uint64_t resident_bytes{};   // allocated levels.
+    uint64_t uploaded_bytes{};   // by the last update.
+    uint32_t promoted_count{};   // by the last update.
+    uint32_t evicted_count{};    // by the last update.
+    uint32_t pending_count{};    // images resident coarser than requested.
+  };
+
+ public:
+  TextureStreamer() = default;
+
+  /* Create every device image with its coarse levels. */
+  void init(
+    Context& context,
+    std::vector<scene::ImageData> const& host_images,
+    std::vector<VkFormat> const& formats,
+    Settings const& settings,
+    std::vector<backend::Image>& device_images
+  );
+
+  void release(std::vector<backend::Image>& device_images);
+
+  /* Reset the requests, to be called before the requests of a frame. */
+  void begin_requests();
+
+  /* Request the level of 'image_index' sampled over about 'projected_size' pixels. */
+  void request(uint32_t image_index, float projected_size);
+
+  /**
+   * Promote and evict levels from the frame requests, updating the changed
+   * device images views. Return true when any did, their descriptors being stale.
+   **/
+  bool update(std::vector<backend::Image>& device_images);
+
+  [[nodiscard]]
+  Stats const& stats() const noexcept {
+    return stats_;
+  }
+
+ private:
+  struct ImageState {
+    uint32_t level_count{};         // host levels.
+    uint32_t allocated_level{};     // host level of the device image first level.
+    uint32_t resident_level{};      // finest resident level.
+    uint32_t requested_level{};     // finest level requested this frame.
+    uint64_t last_request_frame{};
+  };
+
+  struct Change {
+    uint32_t image_index{};
+    uint32_t allocated_level{};
+    uint32_t resident_level{};
+    bool reallocate{};              // when false, a single level is promoted.
+  };
+
+  /* Images and views replaced, destroyed once 'fence' signaled. */
+  struct Retired {
+    VkFence fence{};
+    std::vector<backend::Image> images{};
+    std::vector<VkImageView> views{};
+  };
+
+  /* Bytes of the host levels [base_level, level_count) of an image. */
+  uint64_t resident_bytesize(uint32_t image_index, uint32_t base_level) const;
+
+  /* Upload the changed levels, replacing the images or views, return the uploaded bytes. */
+  uint64_t apply(
+    std::vector<Change> const& changes,
+    std::vector<backend::Image>& device_images
+  );
+
+  VkImageView create_view(
+    backend::Image const& image,
+    uint32_t allocated_level,
+    uint32_t resident_level
+  ) const;
+
+  /* Destroy the retired images and views no longer in use. */
+  void release_retired(bool bWait);
+
+ private:
+  Context* context_ptr_{};
+  std::vector<scene::ImageData> const* host_images_{};
+  std::vector<VkFormat> formats_{};
+  Settings settings_{};
+
+  std::vector<ImageState> states_{};
+  uint64_t frame_{};
+
+  std::deque<Retired> retired_{};
+
+  Stats stats_{};
+};
+
+/* -------------------------------------------------------------------------- */
+
+#endif // AER_RENDERER_TEXTURE_STREAMER_H_
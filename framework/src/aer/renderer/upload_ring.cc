@@ -0,0 +1,84 @@
+#include "aer/renderer/upload_ring.h"
+
+#include "aer/core/utils.h"
+#include "aer/platform/backend/context.h"
+#include "aer/platform/backend/allocator.h"
+
+/* -------------------------------------------------------------------------- */
+
+void UploadRing::init(
+  Context const& context,
+  uint32_t frame_count,
+  uint64_t region_size
+) {
+  LOG_CHECK(frame_count > 0u);
+  allocator_ptr_ = &context.allocator();
+
+  // Dynamic offsets must be a multiple of both descriptor types alignments.
+  auto const& limits = context.gpu_properties().gpu2.properties.limits;
+  alignment_ = std::max(
+    limits.minUniformBufferOffsetAlignment,
+    limits.minStorageBufferOffsetAlignment
+  );
+  region_size_ = utils::AlignTo(region_size, alignment_);
+  region_count_ = frame_count + 1u;
+  region_index_ = 0u;
+  head_ = 0u;
+
+  buffer_ = allocator_ptr_->create_buffer(
+    region_count_ * region_size_,
+    VK_BUFFER_USAGE_2_UNIFORM_BUFFER_BIT_KHR
+  | VK_BUFFER_USAGE_2_STORAGE_BUFFER_BIT_KHR
+    ,
+    VMA_MEMORY_USAGE_AUTO,
+    VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT,
+    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+  | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+  );
+
+  // Kept mapped for the whole ring lifetime.
+  void* data{};
+  allocator_ptr_->map_memory(buffer_, &data);
+  mapped_data_ = static_cast<uint8_t*>(data);
+}
+
+// ----------------------------------------------------------------------------
+
+void UploadRing::release() {
+  if (nullptr == allocator_ptr_) {
+    return;
+  }
+  allocator_ptr_->unmap_memory(buffer_);
+  allocator_ptr_->destroy_buffer(buffer_);
+  *this = {};
+}
+
+// ----------------------------------------------------------------------------
+
+void UploadRing::next_frame() noexcept {
+  region_index_ = (region_index_ + 1u) % region_count_;
+  head_ = 0u;
+}
+
+// ----------------------------------------------------------------------------
+
+UploadRing::Allocation UploadRing::allocate(uint64_t size) {
+  LOG_CHECK(nullptr != mapped_data_);
+
+  if (head_ + size > region_size_) {
+    LOGW("{}: frame region full ({} + {} > {} bytes).", __FUNCTION__, head_, size, region_size_);
+    return {};
+  }
+
+  uint64_t const offset{ region_index_ * region_size_ + head_ };
+  head_ = utils::AlignTo(head_ + size, alignment_);
+
+  return {
+    .buffer = buffer_.buffer,
+    .offset = offset,
+    .size = size,
+    .data = mapped_data_ + offset,
+  };
+}
+
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,99 @@
+#ifndef AER_RENDERER_UPLOAD_RING_H_
+#define AER_RENDERER_UPLOAD_RING_H_
+
+#include "aer/core/common.h"
+#include "aer/platform/backend/types.h"
+
+class Context;
+class ResourceAllocator;
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Per-frame upload ring for dynamic uniform and storage data.
+ *
+ * A single host-coherent buffer, persistently mapped, split into one region
+ * per frame in flight. Each frame, allocations are linearly sub-allocated from
+ * the current region, aligned for dynamic descriptor offsets, and written
+ * directly by the host : no staging copy nor fence wait is needed.
+ *
+ * The ring has one more region than frames in flight, as the host writes
+ * the next frame data before acquiring its swapchain image : the region
+ * reused has then always been released by the swapchain wait.
+ **/
+class UploadRing {
+ public:
+  static constexpr uint64_t kDefaultRegionSize{ 256u * 1024u };
+
+  /* Sub-allocation of a region, valid until the ring wraps around. */
+  struct Allocation {
+    VkBuffer buffer{};
+    uint64_t offset{};
+    uint64_t size{};
+    void* data{};
+
+    [[nodiscard]]
+    bool valid() const noexcept {
+      return nullptr != data;
+    }
+  };
+
+ public:
+  UploadRing() = default;
+
+  ~UploadRing() {
+    LOG_CHECK( allocator_ptr_ == nullptr );
+  }
+
+  void init(
+    Context const& context,
+    uint32_t frame_count,
+    uint64_t region_size = kDefaultRegionSize
+  );
+
+  void release();
+
+  /* Switch to the region of the next frame, to call once its commands were submitted. */
+  void next_frame() noexcept;
+
+  /* Allocate 'size' bytes in the current frame region, invalid when it is full. */
+  [[nodiscard]]
+  Allocation allocate(uint64_t size);
+
+  /* Allocate and copy a value in the current frame region. */
+  template<typename T>
+  [[nodiscard]]
+  Allocation upload(T const& value) {
+    auto const allocation{ allocate(sizeof(T)) };
+    if (allocation.valid()) {
+      std::memcpy(allocation.data, &value, sizeof(T));
+    }
+    return allocation;
+  }
+
+  [[nodiscard]]
+  backend::Buffer const& buffer() const noexcept {
+    return buffer_;
+  }
+
+  [[nodiscard]]
+  uint64_t region_size() const noexcept {
+    return region_size_;
+  }
+
+ private:
+  ResourceAllocator const* allocator_ptr_{};
+
+  backend::Buffer buffer_{};
+  uint8_t* mapped_data_{};
+
+  uint64_t alignment_{};
+  uint64_t region_size_{};
+  uint32_t region_count_{};
+  uint32_t region_index_{};
+  uint64_t head_{};       // in the current region.
+};
+
+/* -------------------------------------------------------------------------- */
+
+#endif // AER_RENDERER_UPLOAD_RING_H_
@@ -1,6 +1,10 @@
 #ifndef AER_SCENE_ANIMATION_H
 #define AER_SCENE_ANIMATION_H
 
+#include <array>
+#include <string>
+#include <unordered_map>
+
 #include "aer/core/common.h"
 
 namespace scene {
@@ -10,42 +14,206 @@ namespace scene {
 template<typename T>
 using JointBuffer = std::vector<T>;
 
+/**
+ * Local transforms of a skeleton joints, as structure of arrays : each
+ * channel is stored contiguously over the joints, padded to a multiple of
+ * kJointLanes, so that joints are sampled and blended by SIMD lanes.
+ *
+ * Scales are uniform, as required for skinning.
+ **/
 struct Pose {
+  enum Channel : uint32_t {
+    RotationX,
+    RotationY,
+    RotationZ,
+    RotationW,
+    TranslationX,
+    TranslationY,
+    TranslationZ,
+    Scale,
+    kChannelCount
+  };
+
+  static uint32_t constexpr kJointLanes{ 4u };
+
   struct Transform {
     vec4f rotation = lina::qidentity<float>();
     vec3f translation = vec3f(0.0f);
     float scale = 1.0f;
   };
 
-  JointBuffer<Transform> joints{};
+  /* Joint count rounded up to the SIMD lanes. */
+  static uint32_t JointStride(uint32_t const joint_count) noexcept {
+    return (joint_count + kJointLanes - 1u) & ~(kJointLanes - 1u);
+  }
+
+  Pose() = default;
+
+  explicit Pose(uint32_t const count) {
+    resize(count);
+  }
+
+  /* Resize to 'joint_count' joints, all set to the identity. */
+  void resize(uint32_t const count) {
+    joint_count = count;
+    joint_stride = JointStride(count);
+    channels.assign(kChannelCount * joint_stride, 0.0f);
+    std::fill_n(channel(RotationW), joint_stride, 1.0f);
+    std::fill_n(channel(Scale), joint_stride, 1.0f);
+  }
+
+  float* channel(Channel const c) noexcept {
+    return channels.data() + c * joint_stride;
+  }
+
+  float const* channel(Channel const c) const noexcept {
+    return channels.data() + c * joint_stride;
+  }
+
+  Transform joint(uint32_t const j) const {
+    return {
+      .rotation = vec4f(channel(RotationX)[j], channel(RotationY)[j], channel(RotationZ)[j], channel(RotationW)[j]),
+      .translation = vec3f(channel(TranslationX)[j], channel(TranslationY)[j], channel(TranslationZ)[j]),
+      .scale = channel(Scale)[j],
+    };
+  }
+
+  void set_joint(uint32_t const j, Transform const& t) {
+    channel(RotationX)[j] = t.rotation.x;
+    channel(RotationY)[j] = t.rotation.y;
+    channel(RotationZ)[j] = t.rotation.z;
+    channel(RotationW)[j] = t.rotation.w;
+    channel(TranslationX)[j] = t.translation.x;
+    channel(TranslationY)[j] = t.translation.y;
+    channel(TranslationZ)[j] = t.translation.z;
+    channel(Scale)[j] = t.scale;
+  }
+
+  uint32_t joint_count{};
+  uint32_t joint_stride{};
+  std::vector<float> channels{};
+};
+
+// ----------------------------------------------------------------------------
+
+/**
+ * Compressed joint tracks of a clip (see private/animation_compressor.h).
+ *
+ * Constant tracks are baked into a base pose, the others keep their reduced
+ * keys with smallest-three rotations (48 bits) and range quantized
+ * translations and scales (16 bits per component).
+ **/
+struct CompressedTracks {
+  enum Type : uint32_t {
+    Rotation,
+    Translation,
+    Scale,
+    kTypeCount
+  };
+
+  struct Track {
+    uint32_t joint{};
+    uint32_t key_count{};
+    uint32_t frame_offset{};  // first key sample index in 'frames'.
+    uint32_t data_offset{};   // first quantized key component in 'data'.
+    uint32_t range_offset{};  // (min, step) per component in 'ranges'.
+  };
+
+  bool empty() const noexcept {
+    return base_pose.empty();
+  }
+
+  size_t bytesize() const noexcept {
+    size_t track_count{0u};
+    for (auto const& typed_tracks : tracks) {
+      track_count += typed_tracks.size();
+    }
+    return base_pose.size() * sizeof(float)
+         + track_count * sizeof(Track)
+         + frames.size() * sizeof(uint16_t)
+         + data.size() * sizeof(uint16_t)
+         + ranges.size() * sizeof(float)
+         ;
+  }
+
+  // Pose channels holding the constant tracks values.
+  std::vector<float> base_pose{};
+
+  // Animated tracks, per type.
+  std::array<std::vector<Track>, kTypeCount> tracks{};
+
+  std::vector<uint16_t> frames{};
+  std::vector<uint16_t> data{};
+  std::vector<float> ranges{};
 };
 
+// ----------------------------------------------------------------------------
+
+/**
+ * Uniformly resampled clip, its samples laid out as consecutive Pose channels
+ * blocks in a single buffer.
+ **/
 struct AnimationClip {
   std::string name{};
   float duration{};
   float framerate{};
-  std::vector<Pose> poses{};
+  uint32_t sample_count{};
+  uint32_t joint_count{};
+  uint32_t joint_stride{};
+  std::vector<float> samples{};
+
+  // When set, replaces the samples.
+  CompressedTracks compressed{};
 
   AnimationClip() = default;
 
-  void setup(std::string_view clip_name, size_t const sampleCount, float const clip_duration, size_t const jointCount) {
+  bool is_compressed() const noexcept {
+    return !compressed.empty();
+  }
+
+  /* Allocate the samples, each one set to 'rest_pose'. */
+  void setup(std::string_view clip_name, size_t const sampleCount, float const clip_duration, Pose const& rest_pose) {
     name = std::string(clip_name);
     duration = clip_duration;
-    framerate = static_cast<float>(sampleCount) / linalg::max(duration, lina::kTrueEpsilon);
+    sample_count = static_cast<uint32_t>(std::max(sampleCount, size_t(1u)));
+    framerate = static_cast<float>(sample_count - 1u) / linalg::max(duration, lina::kTrueEpsilon);
+    joint_count = rest_pose.joint_count;
+    joint_stride = rest_pose.joint_stride;
 
-    poses.resize(sampleCount);
-    for (auto& pose : poses) {
-      pose.joints.resize(jointCount);
+    size_t const sample_size{ rest_pose.channels.size() };
+    samples.resize(sample_count * sample_size);
+    for (uint32_t i = 0u; i < sample_count; ++i) {
+      std::copy(rest_pose.channels.begin(), rest_pose.channels.end(), samples.begin() + i * sample_size);
     }
   }
+
+  float* sample(uint32_t const index) noexcept {
+    return samples.data() + static_cast<size_t>(index) * Pose::kChannelCount * joint_stride;
+  }
+
+  float const* sample(uint32_t const index) const noexcept {
+    return samples.data() + static_cast<size_t>(index) * Pose::kChannelCount * joint_stride;
+  }
+
+  float* sample_channel(uint32_t const index, Pose::Channel const c) noexcept {
+    return sample(index) + c * joint_stride;
+  }
 };
 
+// ----------------------------------------------------------------------------
+
 struct Skeleton {
   JointBuffer<std::string> names{};
   JointBuffer<int32_t> parents{};
   JointBuffer<mat4f> inverse_bind_matrices{};
   JointBuffer<mat4f> global_bind_matrices{};
 
+  // Joints indices, each parent before its children.
+  JointBuffer<uint32_t> joint_order{};
+
+  // Local transforms of the joints nodes.
+  Pose rest_pose{};
+
   std::unordered_map<std::string, int32_t> index_map{};
   std::vector<AnimationClip*> clips{};
 
@@ -64,9 +232,34 @@ struct Skeleton {
     parents.resize(jointCount);
     inverse_bind_matrices.resize(jointCount);
     global_bind_matrices.resize(jointCount);
+    joint_order.resize(jointCount);
+    rest_pose.resize(static_cast<uint32_t>(jointCount));
     index_map.clear();
   }
 
+  /* Sort the joints parents first into joint_order, return false on a cycle. */
+  bool sort_joints() {
+    uint32_t const count{ static_cast<uint32_t>(parents.size()) };
+    joint_order.clear();
+    joint_order.reserve(count);
+
+    // (breadth first from the roots)
+    std::vector<std::vector<uint32_t>> children(count);
+    for (uint32_t j = 0u; j < count; ++j) {
+      if ((parents[j] >= 0) && (static_cast<uint32_t>(parents[j]) < count)) {
+        children[parents[j]].push_back(j);
+      } else {
+        parents[j] = -1;
+        joint_order.push_back(j);
+      }
+    }
+    for (size_t i = 0u; i < joint_order.size(); ++i) {
+      auto const& next = children[joint_order[i]];
+      joint_order.insert(joint_order.end(), next.begin(), next.end());
+    }
+    return joint_order.size() == count;
+  }
+
   void transformInverseBindMatrices(mat4f const& inv_world) {
     for (auto &inverse_bind_matrix : inverse_bind_matrices) {
       inverse_bind_matrix = linalg::mul(inverse_bind_matrix, inv_world);
@@ -74,7 +267,6 @@ struct Skeleton {
   }
 };
 
-
 /* -------------------------------------------------------------------------- */
 
 }  // namespace scene
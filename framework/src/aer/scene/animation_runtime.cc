@@ -0,0 +1,241 @@
+#include "aer/scene/animation_runtime.h"
+
+#include "aer/core/job_system.h"
+#include "aer/scene/private/animation_compressor.h"
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+using namespace internal::animation_kernels;
+
+/* Translation * Rotation * Scale matrix of a joint local transform. */
+mat4f LocalMatrix(scene::Pose const& pose, uint32_t const j) {
+  using Channel = scene::Pose::Channel;
+
+  float const x = pose.channel(Channel::RotationX)[j];
+  float const y = pose.channel(Channel::RotationY)[j];
+  float const z = pose.channel(Channel::RotationZ)[j];
+  float const w = pose.channel(Channel::RotationW)[j];
+  float const s = pose.channel(Channel::Scale)[j];
+
+  float const xx = x * x, yy = y * y, zz = z * z;
+  float const xy = x * y, xz = x * z, yz = y * z;
+  float const wx = w * x, wy = w * y, wz = w * z;
+
+  return {
+    { s * (1.0f - 2.0f * (yy + zz)), s * 2.0f * (xy + wz), s * 2.0f * (xz - wy), 0.0f },
+    { s * 2.0f * (xy - wz), s * (1.0f - 2.0f * (xx + zz)), s * 2.0f * (yz + wx), 0.0f },
+    { s * 2.0f * (xz + wy), s * 2.0f * (yz - wx), s * (1.0f - 2.0f * (xx + yy)), 0.0f },
+    {
+      pose.channel(Channel::TranslationX)[j],
+      pose.channel(Channel::TranslationY)[j],
+      pose.channel(Channel::TranslationZ)[j],
+      1.0f
+    },
+  };
+}
+
+/* Product of two affine matrices, skipping their constant last row. */
+mat4f MulAffine(mat4f const& a, mat4f const& b) {
+  auto transform_vector{[&a](vec4f const& v) {
+    return vec4f(
+      a.x.x * v.x + a.y.x * v.y + a.z.x * v.z,
+      a.x.y * v.x + a.y.y * v.y + a.z.y * v.z,
+      a.x.z * v.x + a.y.z * v.y + a.z.z * v.z,
+      0.0f
+    );
+  }};
+  vec4f const t{ transform_vector(b.w) };
+  return {
+    transform_vector(b.x),
+    transform_vector(b.y),
+    transform_vector(b.z),
+    { t.x + a.w.x, t.y + a.w.y, t.z + a.w.z, 1.0f },
+  };
+}
+
+// ----------------------------------------------------------------------------
+
+/* Per thread buffers reused across instances. */
+struct EvaluationScratch {
+  scene::Pose pose{};
+  scene::Pose layer{};
+  std::vector<mat4f> model_matrices{};
+};
+
+EvaluationScratch& GetEvaluationScratch() {
+  thread_local EvaluationScratch scratch{};
+  return scratch;
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+namespace scene {
+
+void SampleClip(
+  AnimationClip const& clip,
+  float const time,
+  Pose& pose,
+  RotationInterpolation const interpolation,
+  AnimationBackend const backend
+) {
+  if (pose.joint_count != clip.joint_count) {
+    pose.resize(clip.joint_count);
+  }
+  if (clip.sample_count == 0u) {
+    return;
+  }
+
+  // Loop the time over the clip duration, then locate its surrounding samples.
+  float local_time{ (clip.duration > 0.0f) ? std::fmod(time, clip.duration) : 0.0f };
+  if (local_time < 0.0f) {
+    local_time += clip.duration;
+  }
+  float const frame{ local_time * clip.framerate };
+  uint32_t const last{ clip.sample_count - 1u };
+  uint32_t const i0{ std::min(static_cast<uint32_t>(frame), last) };
+  uint32_t const i1{ std::min(i0 + 1u, last) };
+  float const alpha{ std::clamp(frame - static_cast<float>(i0), 0.0f, 1.0f) };
+
+  if (clip.is_compressed()) {
+    internal::animation_compressor::SampleTracks(
+      clip.compressed, std::min(frame, static_cast<float>(last)), pose.joint_stride, pose.channels.data(), backend
+    );
+    return;
+  }
+
+  InterpolatePoses(
+    clip.sample(i0), clip.sample(i1), alpha, clip.joint_stride, pose.channels.data(), interpolation, backend
+  );
+}
+
+// ----------------------------------------------------------------------------
+
+void BlendLayers(
+  std::span<AnimationLayer const> layers,
+  Pose& pose,
+  Pose& scratch,
+  RotationInterpolation const interpolation,
+  AnimationBackend const backend
+) {
+  float total_weight{0.0f};
+  AnimationLayer const* single_layer{};
+  uint32_t active_count{0u};
+  for (auto const& layer : layers) {
+    if (layer.clip && (layer.weight > 0.0f)) {
+      total_weight += layer.weight;
+      single_layer = &layer;
+      ++active_count;
+    }
+  }
+  if (active_count == 0u) {
+    return;
+  }
+  if (active_count == 1u) {
+    SampleClip(*single_layer->clip, single_layer->time, pose, interpolation, backend);
+    return;
+  }
+
+  uint32_t const joint_count{ single_layer->clip->joint_count };
+  if (pose.joint_count != joint_count) {
+    pose.resize(joint_count);
+  }
+  std::fill(pose.channels.begin(), pose.channels.end(), 0.0f);
+
+  float const inv_total_weight{ 1.0f / total_weight };
+  for (auto const& layer : layers) {
+    if (!layer.clip || (layer.weight <= 0.0f)) {
+      continue;
+    }
+    LOG_CHECK(layer.clip->joint_count == joint_count);
+    SampleClip(*layer.clip, layer.time, scratch, interpolation, backend);
+    AccumulatePose(
+      scratch.channels.data(), layer.weight * inv_total_weight, pose.joint_stride, pose.channels.data(), backend
+    );
+  }
+  NormalizeRotations(pose.channels.data(), pose.joint_stride, backend);
+}
+
+// ----------------------------------------------------------------------------
+
+void ComputeModelMatrices(
+  Skeleton const& skeleton,
+  Pose const& pose,
+  std::span<mat4f> model_matrices
+) {
+  LOG_CHECK(model_matrices.size() >= pose.joint_count);
+  LOG_CHECK(skeleton.joint_order.size() == pose.joint_count);
+
+  for (auto const j : skeleton.joint_order) {
+    int32_t const parent{ skeleton.parents[j] };
+    mat4f const local{ LocalMatrix(pose, j) };
+    model_matrices[j] = (parent < 0) ? local : MulAffine(model_matrices[parent], local);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void ComputeSkinningMatrices(
+  Skeleton const& skeleton,
+  std::span<mat4f const> model_matrices,
+  std::span<mat4f> skinning_matrices
+) {
+  size_t const joint_count{ skeleton.inverse_bind_matrices.size() };
+  LOG_CHECK(model_matrices.size() >= joint_count);
+  LOG_CHECK(skinning_matrices.size() >= joint_count);
+
+  for (size_t j = 0u; j < joint_count; ++j) {
+    skinning_matrices[j] = MulAffine(model_matrices[j], skeleton.inverse_bind_matrices[j]);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void Animator::evaluate(std::span<SkeletonInstance> instances) const {
+  auto const count{ static_cast<uint32_t>(instances.size()) };
+  if (settings_.parallel) {
+    utils::ParallelFor(0u, count, [this, instances](uint32_t i) {
+      evaluate(instances[i]);
+    }, settings_.grain);
+  } else {
+    for (auto& instance : instances) {
+      evaluate(instance);
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void Animator::evaluate(SkeletonInstance& instance) const {
+  if (!instance.skeleton) {
+    return;
+  }
+  auto const& skeleton = *instance.skeleton;
+  auto& scratch = GetEvaluationScratch();
+
+  // Joints not driven by any layer keep their rest transform.
+  auto const layers{ instance.active_layers() };
+  bool const animated{
+    std::any_of(layers.begin(), layers.end(), [](auto const& layer) {
+      return layer.clip && (layer.weight > 0.0f);
+    })
+  };
+  if (animated) {
+    BlendLayers(layers, scratch.pose, scratch.layer, settings_.interpolation, settings_.backend);
+  } else {
+    scratch.pose = skeleton.rest_pose;
+  }
+
+  size_t const joint_count{ skeleton.jointCount() };
+  scratch.model_matrices.resize(joint_count);
+  instance.skinning_matrices.resize(joint_count);
+  ComputeModelMatrices(skeleton, scratch.pose, scratch.model_matrices);
+  ComputeSkinningMatrices(skeleton, scratch.model_matrices, instance.skinning_matrices);
+}
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace scene
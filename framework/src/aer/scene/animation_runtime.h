@@ -0,0 +1,119 @@
+#ifndef AER_SCENE_ANIMATION_RUNTIME_H
+#define AER_SCENE_ANIMATION_RUNTIME_H
+
+#include "aer/core/common.h"
+#include "aer/scene/animation.h"
+#include "aer/scene/private/animation_kernels.h"
+
+namespace scene {
+
+/* -------------------------------------------------------------------------- */
+
+using AnimationBackend = internal::animation_kernels::Backend;
+using RotationInterpolation = internal::animation_kernels::Interpolation;
+
+struct AnimationLayer {
+  AnimationClip const* clip{};
+  float time{};         // in seconds, looped over the clip duration.
+  float weight{1.0f};
+};
+
+// ----------------------------------------------------------------------------
+
+/**
+ * Sample 'clip' at 'time', looped over its duration, into 'pose'.
+ * Compressed clips interpolate their rotations linearly.
+ **/
+void SampleClip(
+  AnimationClip const& clip,
+  float time,
+  Pose& pose,
+  RotationInterpolation interpolation = RotationInterpolation::NLerp,
+  AnimationBackend backend = internal::animation_kernels::BestBackend()
+);
+
+/**
+ * Blend the layers clips, sharing the same joints, by their normalized weights
+ * into 'pose'. 'scratch' holds each sampled layer.
+ **/
+void BlendLayers(
+  std::span<AnimationLayer const> layers,
+  Pose& pose,
+  Pose& scratch,
+  RotationInterpolation interpolation = RotationInterpolation::NLerp,
+  AnimationBackend backend = internal::animation_kernels::BestBackend()
+);
+
+/* Concatenate the local transforms of 'pose' along the hierarchy, parents first. */
+void ComputeModelMatrices(
+  Skeleton const& skeleton,
+  Pose const& pose,
+  std::span<mat4f> model_matrices
+);
+
+/* Joints model matrices relative to their bind pose, as consumed by skinning. */
+void ComputeSkinningMatrices(
+  Skeleton const& skeleton,
+  std::span<mat4f const> model_matrices,
+  std::span<mat4f> skinning_matrices
+);
+
+// ----------------------------------------------------------------------------
+
+/* Animated instance of a skeleton, evaluated into its skinning matrices. */
+struct SkeletonInstance {
+  static uint32_t constexpr kMaxLayers{ 4u };
+
+  Skeleton const* skeleton{};
+  std::array<AnimationLayer, kMaxLayers> layers{};
+  uint32_t layer_count{};
+
+  std::vector<mat4f> skinning_matrices{};
+
+  std::span<AnimationLayer const> active_layers() const noexcept {
+    return std::span(layers).first(std::min(layer_count, kMaxLayers));
+  }
+};
+
+/**
+ * Evaluate many skeleton instances, each one sampling and blending its
+ * layers then propagating them along its hierarchy. Instances are split
+ * across the job system workers when it runs.
+ **/
+class Animator {
+ public:
+  // Instances evaluated by a single job.
+  static uint32_t constexpr kDefaultGrain{ 16u };
+
+  struct Settings {
+    RotationInterpolation interpolation{RotationInterpolation::NLerp};
+    AnimationBackend backend{internal::animation_kernels::BestBackend()};
+    bool parallel{true};
+    uint32_t grain{kDefaultGrain};
+  };
+
+ public:
+  Animator() = default;
+
+  explicit Animator(Settings const& settings)
+    : settings_(settings)
+  {}
+
+  void evaluate(std::span<SkeletonInstance> instances) const;
+
+  /* Evaluate a single instance on the calling thread. */
+  void evaluate(SkeletonInstance& instance) const;
+
+  Settings& settings() noexcept {
+    return settings_;
+  }
+
+ private:
+  Settings settings_{};
+};
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace scene
+
+#endif // AER_SCENE_ANIMATION_RUNTIME_H
@@ -9,6 +9,7 @@
 #include <numeric>
 
 #include "mikktspace.h"
+#include "meshoptimizer.h"
 
 /* -------------------------------------------------------------------------- */
 
@@ -29,6 +30,221 @@ struct Point_t {
   std::array<float, 4> position;
 };
 
+// Cache size used to report ACMR / ATVR, as a common FIFO approximation.
+static uint32_t constexpr kVertexCacheSize = 16u;
+
+template<typename T>
+Geometry::CacheStatistics AnalyzeVertexCache(T const* indices, size_t index_count, size_t vertex_count) {
+  auto const stats = meshopt_analyzeVertexCache(indices, index_count, vertex_count, kVertexCacheSize, 0u, 0u);
+  return { .acmr = stats.acmr, .atvr = stats.atvr };
+}
+
+template<typename T>
+void OptimizeTriangleList(
+  T* indices,
+  size_t index_count,
+  std::byte* vertices,
+  size_t vertex_count,
+  size_t vertex_stride,
+  uint32_t position_offset,
+  float overdraw_threshold,
+  Geometry::CacheStatistics* before,
+  Geometry::CacheStatistics* after
+) {
+  if (before) {
+    *before = AnalyzeVertexCache(indices, index_count, vertex_count);
+  }
+
+  meshopt_optimizeVertexCache(indices, indices, index_count, vertex_count);
+
+  meshopt_optimizeOverdraw(
+    indices, indices, index_count,
+    reinterpret_cast<float const*>(vertices + position_offset), vertex_count, vertex_stride,
+    overdraw_threshold
+  );
+
+  // (vertices not referenced by any triangle are left at the end of the range)
+  std::vector<std::byte> const source(vertices, vertices + vertex_count * vertex_stride);
+  size_t const fetched_count = meshopt_optimizeVertexFetch(
+    vertices, indices, index_count, source.data(), vertex_count, vertex_stride
+  );
+  if (fetched_count < vertex_count) {
+    std::memset(vertices + fetched_count * vertex_stride, 0, (vertex_count - fetched_count) * vertex_stride);
+  }
+
+  if (after) {
+    *after = AnalyzeVertexCache(indices, index_count, vertex_count);
+  }
+}
+
+/**
+ * Cluster a triangle list into meshlets, rewriting its indices in meshlet
+ * order. Return the number of indices written, which only differs from
+ * 'index_count' when degenerate triangles were discarded.
+ **/
+template<typename T>
+uint32_t BuildTriangleListMeshlets(
+  T* indices,
+  size_t index_count,
+  std::byte const* vertices,
+  size_t vertex_count,
+  size_t vertex_stride,
+  uint32_t position_offset,
+  size_t max_vertices,
+  size_t max_triangles,
+  float cone_weight,
+  std::vector<Geometry::Meshlet>& meshlets
+) {
+  std::vector<uint32_t> const source(indices, indices + index_count);
+  float const* positions = reinterpret_cast<float const*>(vertices + position_offset);
+
+  size_t const max_meshlets = meshopt_buildMeshletsBound(index_count, max_vertices, max_triangles);
+  std::vector<meshopt_Meshlet> clusters(max_meshlets);
+  std::vector<uint32_t> cluster_vertices(max_meshlets * max_vertices);
+  std::vector<uint8_t> cluster_triangles(max_meshlets * max_triangles * 3u);
+
+  size_t const cluster_count = meshopt_buildMeshlets(
+    clusters.data(), cluster_vertices.data(), cluster_triangles.data(),
+    source.data(), index_count,
+    positions, vertex_count, vertex_stride,
+    max_vertices, max_triangles, cone_weight
+  );
+
+  meshlets.reserve(meshlets.size() + cluster_count);
+
+  uint32_t first_index{0u};
+  for (size_t i = 0u; i < cluster_count; ++i) {
+    auto const& cluster = clusters[i];
+    uint32_t* local_vertices = cluster_vertices.data() + cluster.vertex_offset;
+    uint8_t* local_triangles = cluster_triangles.data() + cluster.triangle_offset;
+
+    meshopt_optimizeMeshlet(local_vertices, local_triangles, cluster.triangle_count, cluster.vertex_count);
+
+    auto const bounds = meshopt_computeMeshletBounds(
+      local_vertices, local_triangles, cluster.triangle_count,
+      positions, vertex_count, vertex_stride
+    );
+
+    uint32_t const cluster_index_count = 3u * cluster.triangle_count;
+    for (uint32_t j = 0u; j < cluster_index_count; ++j) {
+      indices[first_index + j] = static_cast<T>(local_vertices[local_triangles[j]]);
+    }
+
+    Geometry::Meshlet meshlet{
+      .firstIndex = first_index,
+      .indexCount = cluster_index_count,
+      .radius = bounds.radius,
+      .coneCutoff = bounds.cone_cutoff,
+    };
+    std::copy_n(bounds.center, 3u, meshlet.center);
+    std::copy_n(bounds.cone_apex, 3u, meshlet.coneApex);
+    std::copy_n(bounds.cone_axis, 3u, meshlet.coneAxis);
+    meshlets.push_back(meshlet);
+
+    first_index += cluster_index_count;
+  }
+
+  return first_index;
+}
+
+// ----------------------------------------------------------------------------
+
+/* Bounding box of the vertices, and bounding sphere centered on it. */
+void ComputeBounds(
+  std::byte const* vertices,
+  size_t vertex_count,
+  size_t vertex_stride,
+  uint32_t position_offset,
+  float bounds_min[3],
+  float bounds_max[3],
+  float center[3],
+  float& radius
+) {
+  auto position{[&](size_t i) {
+    return reinterpret_cast<float const*>(vertices + i * vertex_stride + position_offset);
+  }};
+
+  std::copy_n(position(0u), 3u, bounds_min);
+  std::copy_n(position(0u), 3u, bounds_max);
+  for (size_t i = 1u; i < vertex_count; ++i) {
+    float const* p = position(i);
+    for (uint32_t k = 0u; k < 3u; ++k) {
+      bounds_min[k] = std::min(bounds_min[k], p[k]);
+      bounds_max[k] = std::max(bounds_max[k], p[k]);
+    }
+  }
+  for (uint32_t k = 0u; k < 3u; ++k) {
+    center[k] = 0.5f * (bounds_min[k] + bounds_max[k]);
+  }
+
+  float radius_squared{0.0f};
+  for (size_t i = 0u; i < vertex_count; ++i) {
+    float const* p = position(i);
+    float const dx = p[0] - center[0];
+    float const dy = p[1] - center[1];
+    float const dz = p[2] - center[2];
+    radius_squared = std::max(radius_squared, dx*dx + dy*dy + dz*dz);
+  }
+  radius = std::sqrt(radius_squared);
+}
+
+/**
+ * Simplify a triangle list into a chain of levels, each one from the
+ * previous, so their errors accumulate. Every level is reordered for the
+ * vertex cache and returned with its mesh space error.
+ **/
+template<typename T>
+std::vector<std::pair<std::vector<T>, float>> BuildTriangleListLods(
+  T const* indices,
+  size_t index_count,
+  std::byte const* vertices,
+  size_t vertex_count,
+  size_t vertex_stride,
+  uint32_t position_offset,
+  uint32_t max_levels,
+  float reduction,
+  float target_error
+) {
+  // A level must remove at least this fraction of the previous one triangles.
+  float constexpr kMinReduction{ 0.15f };
+  // Below this, drawing a level costs about as much as drawing the previous one.
+  size_t constexpr kMinIndexCount{ 3u * 32u };
+
+  float const* positions = reinterpret_cast<float const*>(vertices + position_offset);
+  float const error_scale = meshopt_simplifyScale(positions, vertex_count, vertex_stride);
+
+  std::vector<std::pair<std::vector<T>, float>> levels{};
+  std::vector<uint32_t> source(indices, indices + index_count);
+  std::vector<uint32_t> lod(index_count);
+  float error{0.0f};
+
+  for (uint32_t level = 0u; level < max_levels; ++level) {
+    size_t const target_index_count = (static_cast<size_t>(source.size() * reduction) / 3u) * 3u;
+    if (target_index_count < kMinIndexCount) {
+      break;
+    }
+
+    float level_error{0.0f};
+    size_t const lod_index_count = meshopt_simplify(
+      lod.data(), source.data(), source.size(),
+      positions, vertex_count, vertex_stride,
+      target_index_count, target_error, meshopt_SimplifyLockBorder, &level_error
+    );
+    if ((lod_index_count == 0u)
+     || (lod_index_count > static_cast<size_t>((1.0f - kMinReduction) * source.size()))) {
+      break;
+    }
+
+    meshopt_optimizeVertexCache(lod.data(), lod.data(), lod_index_count, vertex_count);
+    error += level_error * error_scale;
+
+    levels.emplace_back(std::vector<T>(lod.begin(), lod.begin() + lod_index_count), error);
+    source.assign(lod.begin(), lod.begin() + lod_index_count);
+  }
+
+  return levels;
+}
+
 }
 
 /* -------------------------------------------------------------------------- */
@@ -572,6 +788,7 @@ uint64_t Geometry::add_vertices_data(std::span<const std::byte> data) {
 uint64_t Geometry::add_indices_data(std::span<const std::byte> data) {
   uint64_t const offset = indices_.size();
   indices_.insert(indices_.cend(), data.begin(), data.end());
+  indices_.resize((indices_.size() + 3u) & ~size_t(3u), std::byte{0});
   return offset;
 }
 
@@ -579,6 +796,20 @@ void Geometry::add_attribute(AttributeType const type, AttributeInfo const& info
   attributes_[type] = info;
 }
 
+void Geometry::replace_vertices_data(std::vector<std::byte>&& data, AttributeInfoMap const& attributes) {
+  uint64_t const src_stride = get_stride(AttributeType::Position);
+  uint64_t const dst_stride = attributes.at(AttributeType::Position).stride;
+  assert( vertices_.size() / src_stride == data.size() / dst_stride );
+
+  for (auto& prim : primitives_) {
+    for (auto& [_, offset] : prim.bufferOffsets) {
+      offset = (offset / src_stride) * dst_stride;
+    }
+  }
+  attributes_ = attributes;
+  vertices_ = std::move(data);
+}
+
 void Geometry::clear_indices_and_vertices() {
   indices_.clear();
   vertices_.clear();
@@ -609,7 +840,9 @@ bool Geometry::recalculate_tangents() {
       auto const* indices = geo->indices_.data() + prim->indexOffset;
       uint32_t index = 0u;
 
-      if (geo->index_format_ == Geometry::IndexFormat::U16) {
+      auto const format = (prim->indexFormat != Geometry::IndexFormat::kUnknown) ? prim->indexFormat
+                                                                                : geo->index_format_;
+      if (format == Geometry::IndexFormat::U16) {
         index = reinterpret_cast<uint16_t const*>(indices)[index_id];
       } else {
         index = reinterpret_cast<uint32_t const*>(indices)[index_id];
@@ -704,4 +937,222 @@ bool Geometry::recalculate_tangents() {
   return true;
 }
 
+// ----------------------------------------------------------------------------
+
+bool Geometry::optimize_primitive(
+  uint32_t const primitive_index,
+  float const overdraw_threshold,
+  CacheStatistics* before,
+  CacheStatistics* after
+) {
+  auto const& prim = primitives_.at(primitive_index);
+
+  Topology const topology = (prim.topology != Topology::kUnknown) ? prim.topology : topology_;
+  if ((topology != Topology::TriangleList)
+   || (prim.indexCount < 3u)
+   || (prim.vertexCount == 0u)
+   || !has_attribute(AttributeType::Position)) {
+    return false;
+  }
+
+  // Every attribute must be interleaved in a single buffer.
+  auto const& position = attributes_.at(AttributeType::Position);
+  uint64_t const vertex_offset = prim.bufferOffsets.at(AttributeType::Position);
+  for (auto const& [type, offset] : prim.bufferOffsets) {
+    auto const it = attributes_.find(type);
+    if ((offset != vertex_offset) || (it == attributes_.end()) || (it->second.stride != position.stride)) {
+      return false;
+    }
+  }
+  if ((position.format != AttributeFormat::RGB_F32) && (position.format != AttributeFormat::RGBA_F32)) {
+    return false;
+  }
+
+  std::byte* vertices = vertices_.data() + vertex_offset;
+  std::byte* indices = indices_.data() + prim.indexOffset;
+
+  switch (get_index_format(primitive_index)) {
+    case IndexFormat::U16:
+      OptimizeTriangleList(
+        reinterpret_cast<uint16_t*>(indices), prim.indexCount,
+        vertices, prim.vertexCount, position.stride, position.offset,
+        overdraw_threshold, before, after
+      );
+    return true;
+
+    case IndexFormat::U32:
+      OptimizeTriangleList(
+        reinterpret_cast<uint32_t*>(indices), prim.indexCount,
+        vertices, prim.vertexCount, position.stride, position.offset,
+        overdraw_threshold, before, after
+      );
+    return true;
+
+    default:
+    return false;
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+uint32_t Geometry::build_meshlets(
+  uint32_t const max_vertices,
+  uint32_t const max_triangles,
+  float const cone_weight
+) {
+  if (!has_attribute(AttributeType::Position) || indices_.empty()) {
+    return 0u;
+  }
+  auto const& position = attributes_.at(AttributeType::Position);
+  if ((position.format != AttributeFormat::RGB_F32) && (position.format != AttributeFormat::RGBA_F32)) {
+    return 0u;
+  }
+
+  meshlets_.clear();
+
+  for (uint32_t primitive_index = 0u; primitive_index < primitives_.size(); ++primitive_index) {
+    auto& prim = primitives_[primitive_index];
+    prim.meshletOffset = static_cast<uint32_t>(meshlets_.size());
+    prim.meshletCount = 0u;
+
+    Topology const topology = (prim.topology != Topology::kUnknown) ? prim.topology : topology_;
+    if ((topology != Topology::TriangleList)
+     || (prim.indexCount < 3u)
+     || (prim.vertexCount == 0u)) {
+      continue;
+    }
+
+    std::byte const* vertices = vertices_.data() + prim.bufferOffsets.at(AttributeType::Position);
+    std::byte* indices = indices_.data() + prim.indexOffset;
+
+    uint32_t index_count{};
+    switch (get_index_format(primitive_index)) {
+      case IndexFormat::U16:
+        index_count = BuildTriangleListMeshlets(
+          reinterpret_cast<uint16_t*>(indices), prim.indexCount,
+          vertices, prim.vertexCount, position.stride, position.offset,
+          max_vertices, max_triangles, cone_weight, meshlets_
+        );
+      break;
+
+      case IndexFormat::U32:
+        index_count = BuildTriangleListMeshlets(
+          reinterpret_cast<uint32_t*>(indices), prim.indexCount,
+          vertices, prim.vertexCount, position.stride, position.offset,
+          max_vertices, max_triangles, cone_weight, meshlets_
+        );
+      break;
+
+      default:
+      continue;
+    }
+
+    prim.meshletCount = static_cast<uint32_t>(meshlets_.size()) - prim.meshletOffset;
+
+    // (discarded degenerate triangles are dropped from the primitive range)
+    index_count_ -= prim.indexCount - index_count;
+    prim.indexCount = index_count;
+  }
+
+  return static_cast<uint32_t>(meshlets_.size());
+}
+
+// ----------------------------------------------------------------------------
+
+void Geometry::compute_bounds() {
+  if (!has_attribute(AttributeType::Position)) {
+    return;
+  }
+  auto const& position = attributes_.at(AttributeType::Position);
+  if ((position.format != AttributeFormat::RGB_F32) && (position.format != AttributeFormat::RGBA_F32)) {
+    return;
+  }
+
+  for (auto& prim : primitives_) {
+    if ((prim.vertexCount == 0u) || !prim.bufferOffsets.contains(AttributeType::Position)) {
+      continue;
+    }
+    ComputeBounds(
+      vertices_.data() + prim.bufferOffsets.at(AttributeType::Position),
+      prim.vertexCount, position.stride, position.offset,
+      prim.boundsMin, prim.boundsMax, prim.center, prim.radius
+    );
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+uint32_t Geometry::build_lods(
+  uint32_t const max_levels,
+  float const reduction,
+  float const target_error
+) {
+  if (!has_attribute(AttributeType::Position) || indices_.empty()) {
+    return 0u;
+  }
+  auto const& position = attributes_.at(AttributeType::Position);
+  if ((position.format != AttributeFormat::RGB_F32) && (position.format != AttributeFormat::RGBA_F32)) {
+    return 0u;
+  }
+
+  lods_.clear();
+
+  for (uint32_t primitive_index = 0u; primitive_index < primitives_.size(); ++primitive_index) {
+    auto& prim = primitives_[primitive_index];
+    prim.lodOffset = static_cast<uint32_t>(lods_.size());
+    prim.lodCount = 0u;
+
+    Topology const topology = (prim.topology != Topology::kUnknown) ? prim.topology : topology_;
+    if ((topology != Topology::TriangleList)
+     || (prim.indexCount < 3u)
+     || (prim.vertexCount == 0u)) {
+      continue;
+    }
+
+    std::byte const* vertices = vertices_.data() + prim.bufferOffsets.at(AttributeType::Position);
+    std::byte const* indices = indices_.data() + prim.indexOffset;
+
+    ComputeBounds(
+      vertices, prim.vertexCount, position.stride, position.offset,
+      prim.boundsMin, prim.boundsMax, prim.center, prim.radius
+    );
+
+    // (levels are appended once all built, as appending may reallocate 'indices')
+    auto append_levels{[&](auto const& levels) {
+      for (auto const& [level_indices, error] : levels) {
+        lods_.push_back({
+          .indexOffset = add_indices_data(std::as_bytes(std::span(level_indices))),
+          .indexCount = static_cast<uint32_t>(level_indices.size()),
+          .error = error,
+        });
+      }
+    }};
+
+    switch (get_index_format(primitive_index)) {
+      case IndexFormat::U16:
+        append_levels(BuildTriangleListLods(
+          reinterpret_cast<uint16_t const*>(indices), prim.indexCount,
+          vertices, prim.vertexCount, position.stride, position.offset,
+          max_levels, reduction, target_error
+        ));
+      break;
+
+      case IndexFormat::U32:
+        append_levels(BuildTriangleListLods(
+          reinterpret_cast<uint32_t const*>(indices), prim.indexCount,
+          vertices, prim.vertexCount, position.stride, position.offset,
+          max_levels, reduction, target_error
+        ));
+      break;
+
+      default:
+      continue;
+    }
+
+    prim.lodCount = static_cast<uint32_t>(lods_.size()) - prim.lodOffset;
+  }
+
+  return static_cast<uint32_t>(lods_.size());
+}
+
 /* -------------------------------------------------------------------------- */
@@ -20,6 +20,17 @@ class Geometry {
   static constexpr float kDefaultSize = 1.0f;
   static constexpr float kDefaultRadius = 0.5f;
 
+  // Meshlets limits, sized for mesh shading and cluster culling.
+  static constexpr uint32_t kMeshletMaxVertices = 64u;
+  static constexpr uint32_t kMeshletMaxTriangles = 124u;
+  static constexpr float kMeshletConeWeight = 0.25f;
+
+  // LOD chain : each level keeps about half the triangles of the previous one,
+  // within a relative error to the primitive extent.
+  static constexpr uint32_t kLodMaxLevels = 4u;
+  static constexpr float kLodReduction = 0.5f;
+  static constexpr float kLodTargetError = 0.05f;
+
  public:
   enum class Topology {
     PointList,
@@ -46,6 +57,9 @@ class Geometry {
     RGBA_U32,
     R_U16,
     RGBA_U16,
+    RG_F16,
+    RG_SNORM16,
+    RGBA_SNORM16,
     kCount,
     kUnknown,
   };
@@ -79,12 +93,57 @@ class Geometry {
 
     uint64_t indexOffset{};
 
+    // Per primitive index format, kUnknown defaults to the geometry one.
+    IndexFormat indexFormat{IndexFormat::kUnknown};
+
     /**
      * When all attributes share the same offset their data are interleaved,
      * otherwhise buffers should be bind separately,
      * with offset depending on the number of elements and the format of attributes before them.
      */
     AttributeOffsetMap bufferOffsets{}; //
+
+    // Range in the geometry meshlets, empty when none were built.
+    uint32_t meshletOffset{};
+    uint32_t meshletCount{};
+
+    // Range in the geometry LOD levels, empty when none were built.
+    uint32_t lodOffset{};
+    uint32_t lodCount{};
+
+    // Mesh space bounding box and sphere, set by compute_bounds (or with the
+    // LOD levels), a null radius when unknown.
+    float boundsMin[3]{};
+    float boundsMax[3]{};
+    float center[3]{};
+    float radius{};
+  };
+
+  /**
+   * Cluster of triangles of a primitive, as a range of its indices, with
+   * bounds in mesh space for culling.
+   *
+   * The cluster is backfacing, from every point of view, when
+   *   dot(normalize(coneApex - eye), coneAxis) >= coneCutoff.
+   */
+  struct Meshlet {
+    uint32_t firstIndex{}; // relative to the primitive first index.
+    uint32_t indexCount{};
+    float center[3]{};
+    float radius{};
+    float coneApex[3]{};
+    float coneAxis[3]{};
+    float coneCutoff{1.0f};
+  };
+
+  /**
+   * Simplified version of a primitive, as an extra range in the geometry
+   * indices referencing the primitive vertices.
+   */
+  struct LodLevel {
+    uint64_t indexOffset{}; // bytes, in the geometry indices.
+    uint32_t indexCount{};
+    float error{};          // mesh space deviation from the primitive.
   };
 
  public:
@@ -138,6 +197,12 @@ class Geometry {
     return index_format_;
   }
 
+  [[nodiscard]]
+  IndexFormat get_index_format(uint32_t const primitive_index) const {
+    auto const format{ primitives_.at(primitive_index).indexFormat };
+    return (format != IndexFormat::kUnknown) ? format : index_format_;
+  }
+
   [[nodiscard]]
   uint32_t get_index_count() const noexcept {
     return index_count_;
@@ -183,6 +248,33 @@ class Geometry {
     return static_cast<uint32_t>(primitives_.size());
   }
 
+  [[nodiscard]]
+  std::vector<Meshlet> const& get_meshlets() const noexcept {
+    return meshlets_;
+  }
+
+  [[nodiscard]]
+  std::span<Meshlet const> get_meshlets(uint32_t const primitive_index) const {
+    auto const& prim = primitives_.at(primitive_index);
+    return std::span(meshlets_).subspan(prim.meshletOffset, prim.meshletCount);
+  }
+
+  [[nodiscard]]
+  bool has_meshlets() const noexcept {
+    return !meshlets_.empty();
+  }
+
+  std::vector<LodLevel> const& get_lods() const noexcept {
+    return lods_;
+  }
+
+  /* Coarser levels of a primitive, from the most to the least detailed. */
+  [[nodiscard]]
+  std::span<LodLevel const> get_lods(uint32_t const primitive_index) const {
+    auto const& prim = primitives_.at(primitive_index);
+    return std::span(lods_).subspan(prim.lodOffset, prim.lodCount);
+  }
+
   /* --- Setters --- */
 
   void set_attributes(AttributeInfoMap const attributes) noexcept {
@@ -197,6 +289,16 @@ class Geometry {
     index_format_ = format;
   }
 
+  /* Set the meshlets referenced by the primitives ranges (eg. when restored from a cache). */
+  void set_meshlets(std::vector<Meshlet>&& meshlets) noexcept {
+    meshlets_ = std::move(meshlets);
+  }
+
+  /* Set the LOD levels referenced by the primitives ranges (eg. when restored from a cache). */
+  void set_lods(std::vector<LodLevel>&& lods) noexcept {
+    lods_ = std::move(lods);
+  }
+
   /* --- Utils --- */
 
   [[nodiscard]]
@@ -211,13 +313,81 @@ class Geometry {
   /* Return the current bytesize of the vertex attributes buffer. */
   uint64_t add_vertices_data(std::span<const std::byte> data);
 
-  /* Return the current bytesize of the indices buffer. */
+  /**
+   * Return the current bytesize of the indices buffer.
+   * The buffer is padded to 4 bytes so that primitives with different index
+   * formats can share it.
+   **/
   uint64_t add_indices_data(std::span<const std::byte> data);
 
+  /**
+   * Replace the interleaved vertex buffer by 'data', laid out as 'attributes'
+   * with the same vertex count, rescaling the primitives buffer offsets to
+   * the new stride.
+   **/
+  void replace_vertices_data(std::vector<std::byte>&& data, AttributeInfoMap const& attributes);
+
   void clear_indices_and_vertices();
 
   bool recalculate_tangents();
 
+  /* Post-transform vertex cache statistics of a primitive. */
+  struct CacheStatistics {
+    float acmr{}; // transformed vertices per triangle.
+    float atvr{}; // transformed vertices per vertex.
+  };
+
+  /**
+   * Reorder the triangles of an indexed, interleaved, triangle list primitive
+   * for the post-transform vertex cache, then for overdraw while keeping the
+   * ACMR under 'overdraw_threshold' times the optimized one, and finally its
+   * vertices for fetch locality.
+   *
+   * The primitive must own its vertex range, distinct primitives can then be
+   * optimized concurrently. Return false when the primitive is left as is.
+   **/
+  bool optimize_primitive(
+    uint32_t primitive_index,
+    float overdraw_threshold,
+    CacheStatistics* before = nullptr,
+    CacheStatistics* after = nullptr
+  );
+
+  /**
+   * Split each indexed triangle list primitive into meshlets of at most
+   * 'max_vertices' vertices and 'max_triangles' triangles, and reorder its
+   * indices so that every meshlet is a contiguous range of them.
+   *
+   * Requires float positions, so should run before any vertex compaction.
+   * Return the number of meshlets built, primitives that cannot be split are
+   * left without meshlets.
+   **/
+  uint32_t build_meshlets(
+    uint32_t max_vertices = kMeshletMaxVertices,
+    uint32_t max_triangles = kMeshletMaxTriangles,
+    float cone_weight = kMeshletConeWeight
+  );
+
+  /**
+   * Simplify each indexed triangle list primitive into up to 'max_levels'
+   * LOD levels, each one targeting 'reduction' times the triangles of the
+   * previous one within 'target_error' of the primitive extent, and append
+   * their indices to the geometry ones. Borders are kept so that primitives
+   * split from the same source do not crack apart.
+   *
+   * Requires float positions, so should run before any vertex compaction.
+   * Return the number of levels built, the chain stops as soon as a level
+   * cannot be simplified further.
+   **/
+  uint32_t build_lods(
+    uint32_t max_levels = kLodMaxLevels,
+    float reduction = kLodReduction,
+    float target_error = kLodTargetError
+  );
+
+  /* Compute the bounding box and sphere of every primitive, from float positions. */
+  void compute_bounds();
+
  protected:
   AttributeInfoMap attributes_{};
   std::vector<Primitive> primitives_{};
@@ -230,6 +400,9 @@ class Geometry {
 
   std::vector<std::byte> indices_{};
   std::vector<std::byte> vertices_{};
+
+  std::vector<Meshlet> meshlets_{};
+  std::vector<LodLevel> lods_{};
 };
 
 /* -------------------------------------------------------------------------- */
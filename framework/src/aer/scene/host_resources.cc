@@ -1,6 +1,9 @@
 #include "aer/scene/host_resources.h"
 
+#include <chrono>
 #include <iostream>
+
+#include "aer/scene/private/baked_scene.h"
 #include "aer/scene/private/gltf_loader.h"
 
 /* -------------------------------------------------------------------------- */
@@ -41,17 +44,84 @@ bool HostResources::load_file(std::string_view filename) {
   auto const basename{ utils::ExtractBasename(filename) };
   auto const ext{ utils::ExtractExtension(filename) };
 
+  using Clock = std::chrono::steady_clock;
+  auto const start_time{ Clock::now() };
+  auto elapsed_ms{[start_time] {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start_time).count();
+  }};
+
+  bool loaded{false};
+
+  /* Prefer the baked scene when it is newer than its source. */
+  std::string const baked_filename{
+    use_baked_scene ? internal::baked_scene::GetBakedFilename(filename) : std::string()
+  };
+  if (!baked_filename.empty()) {
+    if (internal::baked_scene::IsUpToDate(filename, baked_filename)) {
+      if (loaded = load_baked_file(baked_filename); loaded) {
+        LOGI("> \"{}.{}\" loaded from its baked scene in {:.2f} ms.", basename, ext, elapsed_ms());
+      } else {
+        LOGW("> \"{}\" is invalid, fallback to the source file.", baked_filename);
+      }
+    }
+  }
+
+  if (!loaded) {
+    auto const offsets{ internal::baked_scene::ResourceOffsets::From(*this) };
+
+    if (!load_gltf_file(filename)) {
+      return false;
+    }
+    LOGI("> \"{}.{}\" loaded from glTF in {:.2f} ms.", basename, ext, elapsed_ms());
+
+    if (!baked_filename.empty()) {
+      if (internal::baked_scene::Write(baked_filename, *this, offsets)) {
+        LOGI("> baked scene saved to \"{}\".", baked_filename);
+      }
+    }
+  }
+
+  reset_internal_descriptors();
+
+#ifndef NDEBUG
+  LOGI("> \"{}.{}\" has been loaded successfully.", basename, ext);
+  // This will also display the extra data procedurally created.
+  std::cout << "┌────────────┬───── " << std::endl;
+  std::cout << "│ Images     │ " << host_images.size() << std::endl;
+  std::cout << "│ Textures   │ " << textures.size() << std::endl;
+  std::cout << "│ Materials  │ " << material_proxies.size() << std::endl;
+  std::cout << "│ Skeletons  │ " << skeletons.size() << std::endl;
+  std::cout << "│ Animations │ " << animations_map.size() << std::endl;
+  std::cout << "│ Meshes     │ " << meshes.size() << std::endl;
+  std::cerr << "└────────────┴─────" << std::endl;
+
+  // uint32_t const kMegabyte{ 1024u * 1024u };
+  // LOGI("> vertex buffer size {} Mb", vertex_buffer_size / static_cast<float>(kMegabyte));
+  // LOGI("> index buffer size {} Mb ", index_buffer_size / static_cast<float>(kMegabyte));
+  // LOGI("> total image size {} Mb ", total_image_size / static_cast<float>(kMegabyte));
+#endif
+
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+bool HostResources::load_gltf_file(std::string_view filename) {
+  auto const basename{ utils::ExtractBasename(filename) };
+
   cgltf_options options{};
   cgltf_result result{};
   cgltf_data* data{};
 
-  utils::FileReader file{};
-  if (!file.read(filename)) {
+  // For binary glTF the BIN chunk, hence accessors and embedded images, are
+  // referenced in place from the mapping, which must outlive cgltf_free.
+  utils::MappedFile file(filename, utils::MappedFile::AccessHint::Sequential);
+  if (!file.is_open()) {
     LOGE("GLTF: failed to read the file.");
     return false;
   }
 
-  if (result = cgltf_parse(&options, file.buffer.data(), file.buffer.size(), &data); cgltf_result_success != result) {
+  if (result = cgltf_parse(&options, file.data(), file.size(), &data); cgltf_result_success != result) {
     LOGE("GLTF: failed to parse file \"{}\" {}.\n", basename, (int)result);
     return false;
   }
@@ -62,6 +132,13 @@ bool HostResources::load_file(std::string_view filename) {
     return false;
   }
 
+  // (EXT_meshopt_compression views, read by every extraction below)
+  if (!internal::gltf_loader::DecodeMeshoptBuffers(data, parallel_mesh_extraction)) {
+    LOGE("GLTF: failed to decode meshopt buffers in \"{}\".\n", basename);
+    cgltf_free(data);
+    return false;
+  }
+
   /* Extract data */
   {
     using namespace internal::gltf_loader;
@@ -74,7 +151,7 @@ bool HostResources::load_file(std::string_view filename) {
     material_refs.reserve(data->materials_count + material_refs.size());
     skeletons.reserve(data->skins_count + skeletons.size());
     meshes.reserve(data->meshes_count + meshes.size());
-    transforms.reserve(data->meshes_count + transforms.size());
+    transforms.reserve(data->nodes_count + transforms.size());
     animations_map.reserve(data->animations_count);
 
     if constexpr (kUseAsyncLoad)
@@ -102,9 +179,11 @@ bool HostResources::load_file(std::string_view filename) {
       // [real bottleneck, internally images are loaded asynchronously and must be waited for at the end]
       auto taskImageData = run_task_ret([
         data,
+        compression = this->texture_compression,
+        mipmaps = (this->mipmap_generation == MipmapGeneration::Host),
         &_host_images = this->host_images
       ] {
-        return ExtractImages(data, _host_images);
+        return ExtractImages(data, compression, mipmaps, _host_images);
       });
 
       auto taskTextures = run_task_ret([
@@ -113,8 +192,8 @@ bool HostResources::load_file(std::string_view filename) {
         data,
         &_textures = this->textures
       ] {
-        auto images_indices = taskImageData.get();
-        auto samplers_lut = taskSamplers.get();
+        auto images_indices = utils::WaitTask(taskImageData);
+        auto samplers_lut = utils::WaitTask(taskSamplers);
         return ExtractTextures(data, images_indices, samplers_lut, _textures);
       });
 
@@ -125,7 +204,7 @@ bool HostResources::load_file(std::string_view filename) {
         &_material_refs = this->material_refs,
         &_default_binding = this->default_texture_binding_
       ] {
-        auto textures_indices = taskTextures.get();
+        auto textures_indices = utils::WaitTask(taskTextures);
         return ExtractMaterials(
           data,
           textures_indices,
@@ -135,14 +214,17 @@ bool HostResources::load_file(std::string_view filename) {
         );
       });
 
-      auto skeletons_indices = taskSkeletons.get();
+      auto skeletons_indices = utils::WaitTask(taskSkeletons);
 
       auto taskAnimations = run_task([
         data,
+        &basename,
         &skeletons_indices,
-        &_skeletons = this->skeletons
+        &_skeletons = this->skeletons,
+        &_animations_map = this->animations_map,
+        bCompress = this->compress_animations
       ] {
-        // ExtractAnimations(data, basename, skeletons_indices, _skeletons, animations_map);
+        ExtractAnimations(data, basename, skeletons_indices, _skeletons, _animations_map, bCompress);
       });
 
       auto taskMeshes = run_task([
@@ -152,9 +234,14 @@ bool HostResources::load_file(std::string_view filename) {
         &_material_refs = this->material_refs,
         &_skeletons = this->skeletons,
         &_meshes = this->meshes,
-        &_transforms = this->transforms
+        &_transforms = this->transforms,
+        bParallel = this->parallel_mesh_extraction,
+        bOptimize = this->optimize_meshes,
+        bCompact = this->compact_vertices,
+        bMeshlets = this->build_meshlets,
+        bLods = this->build_lods
       ] {
-        auto materials_indices = taskMaterials.get();
+        auto materials_indices = utils::WaitTask(taskMaterials);
         ExtractMeshes(
           data,
           materials_indices,
@@ -164,12 +251,18 @@ bool HostResources::load_file(std::string_view filename) {
           _meshes,
           _transforms,
           kRestructureAttribs,
-          kForce32BitsIndexing
+          kForce32BitsIndexing,
+          kSplitLargePrimitives,
+          bOptimize,
+          bMeshlets,
+          bLods,
+          bCompact,
+          bParallel
         );
       });
 
-      taskAnimations.get();
-      taskMeshes.get();
+      utils::WaitTask(taskAnimations);
+      utils::WaitTask(taskMeshes);
     }
     else
     {
@@ -177,7 +270,9 @@ bool HostResources::load_file(std::string_view filename) {
 
       auto samplers_lut       = ExtractSamplers(data, samplers);
       auto skeletons_indices  = ExtractSkeletons(data, skeletons);
-      auto images_indices     = ExtractImages(data, host_images);
+      auto images_indices     = ExtractImages(
+        data, texture_compression, (mipmap_generation == MipmapGeneration::Host), host_images
+      );
       auto textures_indices   = ExtractTextures(
         data, images_indices, samplers_lut, textures
       );
@@ -193,8 +288,15 @@ bool HostResources::load_file(std::string_view filename) {
         skeletons_indices, skeletons,
         meshes, transforms,
         kRestructureAttribs,
-        kForce32BitsIndexing
+        kForce32BitsIndexing,
+        kSplitLargePrimitives,
+        optimize_meshes,
+        build_meshlets,
+        build_lods,
+        compact_vertices,
+        parallel_mesh_extraction
       );
+      ExtractAnimations(data, basename, skeletons_indices, skeletons, animations_map, compress_animations);
     }
 
     /* Wait for the host images to finish loading before using them. */
@@ -206,26 +308,21 @@ bool HostResources::load_file(std::string_view filename) {
   /* Be sure to have finished loading all images before freeing gltf data */
   cgltf_free(data);
 
-  reset_internal_descriptors();
-
-#ifndef NDEBUG
-  LOGI("> \"{}.{}\" has been loaded successfully.", basename, ext);
-  // This will also display the extra data procedurally created.
-  std::cout << "┌────────────┬───── " << std::endl;
-  std::cout << "│ Images     │ " << host_images.size() << std::endl;
-  std::cout << "│ Textures   │ " << textures.size() << std::endl;
-  std::cout << "│ Materials  │ " << material_proxies.size() << std::endl;
-  std::cout << "│ Skeletons  │ " << skeletons.size() << std::endl;
-  std::cout << "│ Animations │ " << animations_map.size() << std::endl;
-  std::cout << "│ Meshes     │ " << meshes.size() << std::endl;
-  std::cerr << "└────────────┴─────" << std::endl;
+  return true;
+}
 
-  // uint32_t const kMegabyte{ 1024u * 1024u };
-  // LOGI("> vertex buffer size {} Mb", vertex_buffer_size / static_cast<float>(kMegabyte));
-  // LOGI("> index buffer size {} Mb ", index_buffer_size / static_cast<float>(kMegabyte));
-  // LOGI("> total image size {} Mb ", total_image_size / static_cast<float>(kMegabyte));
-#endif
+// ----------------------------------------------------------------------------
 
+bool HostResources::load_baked_file(std::string_view filename) {
+  utils::MappedFile file{};
+  if (!file.open(filename, utils::MappedFile::AccessHint::WillNeed)) {
+    return false;
+  }
+  if (!internal::baked_scene::Read(file, *this, default_texture_binding_)) {
+    return false;
+  }
+  // Keep the mapping alive as long as the host images reference it.
+  mapped_files_.push_back(std::move(file));
   return true;
 }
 
@@ -240,7 +337,8 @@ void HostResources::reset_internal_descriptors() {
 
   for (auto const& mesh : meshes) {
     // ---------
-    mesh->transform_index = transform_index++; //
+    mesh->transform_index = transform_index; //
+    transform_index += mesh->instance_count;
     mesh->set_resources_ptr(this); //
     mesh->set_buffer_info({
       .vertex_offset = vertex_buffer_size,
@@ -251,8 +349,18 @@ void HostResources::reset_internal_descriptors() {
     index_buffer_size += mesh->get_indices().size();
   }
 
+  // (mip chains generated on the device are accounted for too)
+  bool const device_mipmaps{ mipmap_generation == MipmapGeneration::Device };
   for (auto const& host_image : host_images) {
-    total_image_size += host_image.getBytesize();
+    total_image_size += (device_mipmaps && host_image.canGenerateMipmaps())
+      ? static_cast<uint32_t>(ImageData::MipChainBytesize(
+          host_image.format,
+          host_image.width,
+          host_image.height,
+          ImageData::FullLevelCount(host_image.width, host_image.height)
+        ))
+      : host_image.getBytesize()
+      ;
   }
 }
 
@@ -2,6 +2,7 @@
 #define AER_SCENE_HOST_RESOURCES_H
 
 #include "aer/core/common.h"
+#include "aer/core/mapped_file.h"
 
 #include "aer/scene/animation.h"
 #include "aer/scene/texture.h"
@@ -30,8 +31,46 @@ struct HostResources {
   // Force all loaded meshes to match VertexInternal_t structure.
   static bool constexpr kRestructureAttribs{true};
 
-  // For consistency and simplicity across shaders, even if 16bit is common.
-  static bool constexpr kForce32BitsIndexing{true};
+  // Widen every index buffer to 32bit instead of keeping the source 16bit ones.
+  static bool constexpr kForce32BitsIndexing{false};
+
+  // Split primitives with more than 65536 vertices so they fit 16bit indices.
+  static bool constexpr kSplitLargePrimitives{true};
+
+  // Reorder restructured primitives for vertex cache, overdraw and vertex fetch.
+  static bool constexpr kOptimizeMeshes{kRestructureAttribs};
+
+  // Convert restructured vertices to the quantized VertexCompact_t layout.
+  static bool constexpr kCompactVertices{false};
+
+  // Split restructured primitives into meshlets for cluster culling.
+  static bool constexpr kBuildMeshlets{false};
+
+  // Simplify restructured primitives into a chain of LOD levels.
+  static bool constexpr kBuildLods{false};
+
+  // Store animation clips as reduced and quantized joint tracks.
+  static bool constexpr kCompressAnimations{false};
+
+  // Block compression KTX2 / Basis Universal images are transcoded to,
+  // the GPU resources fall back to one supported by the device.
+#if defined(ANDROID)
+  static ImageData::BlockCompression constexpr kTextureCompression{ImageData::BlockCompression::ASTC};
+#else
+  static ImageData::BlockCompression constexpr kTextureCompression{ImageData::BlockCompression::BC};
+#endif
+
+  // Load from, and save to, a baked scene file cached in the system temporary
+  // directory (never the assets one), rebaked once older than its source.
+  static bool constexpr kUseBakedScene{true};
+
+  // Where the mip chains of single level images are generated.
+  enum class MipmapGeneration : uint8_t {
+    None,
+    Host,   // box filtered on the job threads after decoding, and baked.
+    Device, // blitted in the upload command buffer.
+  };
+  static MipmapGeneration constexpr kMipmapGeneration{MipmapGeneration::Host};
 
  public:
   HostResources() = default;
@@ -48,6 +87,34 @@ struct HostResources {
 
   /* --- Host Data --- */
 
+  // Runtime switch for the baked scene path, cleared before load_file to always parse the source.
+  // Animated or skinned scenes are always loaded from their source.
+  bool use_baked_scene{kUseBakedScene};
+
+  // Extract mesh nodes concurrently, disable to compare with a serial run.
+  bool parallel_mesh_extraction{kUseAsyncLoad};
+
+  // Run the load-time vertex cache / overdraw / fetch optimization pass.
+  bool optimize_meshes{kOptimizeMeshes};
+
+  // Store vertices as VertexCompact_t (20 bytes) instead of VertexInternal_t (64 bytes).
+  bool compact_vertices{kCompactVertices};
+
+  // Build meshlets, with their bounding spheres and normal cones, per primitive.
+  bool build_meshlets{kBuildMeshlets};
+
+  // Build LOD levels per primitive, selected at runtime from their screen-space error.
+  bool build_lods{kBuildLods};
+
+  // Compress animation clips after resampling, replacing their raw samples.
+  bool compress_animations{kCompressAnimations};
+
+  // Target of KTX2 images, uncompressed RGBA8 when set to None.
+  ImageData::BlockCompression texture_compression{kTextureCompression};
+
+  // Mip chains generation of the decoded images.
+  MipmapGeneration mipmap_generation{kMipmapGeneration};
+
   std::vector<Sampler> samplers{};
   std::vector<ImageData> host_images{}; // (not trivially moveable)
   std::vector<Texture> textures{};
@@ -55,6 +122,7 @@ struct HostResources {
   std::vector<MaterialProxy> material_proxies{};
   ResourceBuffer<MaterialRef> material_refs{}; //
 
+  // (the renderer caches its draw lists from these, see GPUResources::invalidate_draw_lists)
   ResourceBuffer<Mesh> meshes{}; //
   std::vector<mat4f> transforms{};
 
@@ -68,7 +136,16 @@ struct HostResources {
  protected:
   void reset_internal_descriptors();
 
+ private:
+  bool load_gltf_file(std::string_view filename);
+
+  bool load_baked_file(std::string_view filename);
+
+ protected:
   MaterialProxy::TextureBinding default_texture_binding_{};
+
+  // Baked scenes mapped in memory, host images may point into them.
+  std::vector<utils::MappedFile> mapped_files_{};
 };
 
 } // namespace scene
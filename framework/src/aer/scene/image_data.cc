@@ -0,0 +1,230 @@
+#include "aer/scene/image_data.h"
+
+#include <cstring>
+#include <mutex>
+
+#include "basisu_transcoder.h"
+
+#include "aer/scene/private/mipmap_generator.h"
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+using Format = scene::ImageData::Format;
+using BlockCompression = scene::ImageData::BlockCompression;
+using Channels = scene::ImageData::Channels;
+
+// KTX 2.0 file identifier.
+constexpr uint8_t kKTX2Identifier[12u]{
+  0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+};
+
+struct KTX2Header {
+  uint8_t identifier[12u];
+  uint32_t vkFormat;
+  uint32_t typeSize;
+  uint32_t pixelWidth;
+  uint32_t pixelHeight;
+  uint32_t pixelDepth;
+  uint32_t layerCount;
+  uint32_t faceCount;
+  uint32_t levelCount;
+  uint32_t supercompressionScheme;
+};
+
+// ----------------------------------------------------------------------------
+
+void InitializeTranscoder() {
+  static std::once_flag flag{};
+  std::call_once(flag, [] { basist::basisu_transcoder_init(); });
+}
+
+/* Smallest format of the compression family holding 'channels'. */
+Format SelectFormat(BlockCompression const compression, Channels const channels) {
+  switch (compression) {
+    case BlockCompression::BC:
+      return (channels == Channels::R)  ? Format::BC4_R
+           : (channels == Channels::RG) ? Format::BC5_RG
+                                        : Format::BC7_RGBA
+                                        ;
+
+    case BlockCompression::ASTC:
+      return Format::ASTC_4x4_RGBA;
+
+    case BlockCompression::ETC2:
+      return (channels == Channels::R)  ? Format::EAC_R11
+           : (channels == Channels::RG) ? Format::EAC_RG11
+                                        : Format::ETC2_RGBA
+                                        ;
+
+    default:
+      return Format::RGBA8_UNORM;
+  }
+}
+
+basist::transcoder_texture_format ToTranscoderFormat(Format const format) {
+  using basist::transcoder_texture_format;
+
+  switch (format) {
+    case Format::BC7_RGBA:
+      return transcoder_texture_format::cTFBC7_RGBA;
+
+    case Format::BC5_RG:
+      return transcoder_texture_format::cTFBC5_RG;
+
+    case Format::BC4_R:
+      return transcoder_texture_format::cTFBC4_R;
+
+    case Format::ASTC_4x4_RGBA:
+      return transcoder_texture_format::cTFASTC_4x4_RGBA;
+
+    case Format::ETC2_RGBA:
+      return transcoder_texture_format::cTFETC2_RGBA;
+
+    case Format::EAC_RG11:
+      return transcoder_texture_format::cTFETC2_EAC_RG11;
+
+    case Format::EAC_R11:
+      return transcoder_texture_format::cTFETC2_EAC_R11;
+
+    default:
+      return transcoder_texture_format::cTFRGBA32;
+  }
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+namespace scene {
+
+bool ImageData::IsKTX2(uint8_t const* buffer_data, uint32_t const buffer_size) {
+  return (buffer_data != nullptr)
+      && (buffer_size >= sizeof(KTX2Header))
+      && (std::memcmp(buffer_data, kKTX2Identifier, sizeof(kKTX2Identifier)) == 0)
+      ;
+}
+
+// ----------------------------------------------------------------------------
+
+bool ImageData::loadKTX2(
+  uint8_t const* buffer_data,
+  uint32_t const buffer_size,
+  BlockCompression const compression,
+  Channels const sampled_channels
+) {
+  InitializeTranscoder();
+
+  basist::ktx2_transcoder transcoder{};
+  if (!transcoder.init(buffer_data, buffer_size) || !transcoder.start_transcoding()) {
+    LOGW("[KTX2] invalid or unsupported Basis Universal file.");
+    return false;
+  }
+  if ((transcoder.get_layers() > 1u) || (transcoder.get_faces() > 1u)) {
+    LOGW("[KTX2] only the first layer / face of arrays and cubemaps is used.");
+  }
+
+  // Basis Universal two channels images store Y in alpha, and RG formats are
+  // transcoded from red and alpha, so RGB only images are kept as RGBA.
+  bool const has_alpha{ transcoder.get_has_alpha() };
+  bool const rg_in_alpha{ (sampled_channels == Channels::RG) && has_alpha };
+  Channels const target_channels{
+    ((sampled_channels == Channels::RG) && !has_alpha) ? Channels::RGBA : sampled_channels
+  };
+
+  Format target_format{ SelectFormat(compression, target_channels) };
+
+  // Without a two channels block format, move Y to green on uncompressed texels.
+  bool const swizzle_alpha_to_green{
+    rg_in_alpha && (target_format != Format::BC5_RG) && (target_format != Format::EAC_RG11)
+  };
+  if (swizzle_alpha_to_green) {
+    target_format = Format::RGBA8_UNORM;
+  }
+
+  width = static_cast<int32_t>(transcoder.get_width());
+  height = static_cast<int32_t>(transcoder.get_height());
+  channels = has_alpha ? 4 : 3;
+  format = target_format;
+  level_count = std::max(transcoder.get_levels(), 1u);
+
+  auto const levels{ getMipLevels() };
+  auto* data = static_cast<uint8_t*>(malloc(getBytesize()));
+  if (!data) {
+    return false;
+  }
+
+  auto const transcoder_format{ ToTranscoderFormat(format) };
+  uint32_t const block_bytesize{ BlockBytesize(format) };
+  for (uint32_t i = 0u; i < levels.size(); ++i) {
+    auto const& level = levels[i];
+    uint32_t const capacity = static_cast<uint32_t>(level.bytesize / block_bytesize);
+    if (!transcoder.transcode_image_level(i, 0u, 0u, data + level.offset, capacity, transcoder_format)) {
+      LOGW("[KTX2] failed to transcode level {}.", i);
+      free(data);
+      return false;
+    }
+  }
+
+  if (swizzle_alpha_to_green) {
+    uint64_t const texel_count{ getBytesize() / BlockBytesize(format) };
+    for (uint64_t i = 0u; i < texel_count; ++i) {
+      data[4u * i + 1u] = data[4u * i + 3u];
+      data[4u * i + 3u] = 0xFF;
+    }
+  }
+
+  pixels.reset(data);
+
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+bool ImageData::generateMipmaps(MipmapFilter const filter) {
+  using namespace internal::mipmap_generator;
+
+  if ((filter == MipmapFilter::None) || !pixels || !canGenerateMipmaps()) {
+    return pixels != nullptr;
+  }
+
+  auto const levels{ MipChain(format, width, height, FullLevelCount(width, height)) };
+  auto* data = static_cast<uint8_t*>(malloc(levels.back().offset + levels.back().bytesize));
+  if (!data) {
+    return false;
+  }
+  std::memcpy(data, pixels.get(), levels[0u].bytesize);
+
+  ColorSpace const color_space{
+    (filter == MipmapFilter::sRGB) ? ColorSpace::sRGB : ColorSpace::Linear
+  };
+  for (size_t i = 1u; i < levels.size(); ++i) {
+    auto const& src = levels[i - 1u];
+    Downsample(data + src.offset, src.width, src.height, data + levels[i].offset, color_space);
+  }
+
+  // (external pixels are not owned, so the deleter is replaced too)
+  pixels = { data, stbi_image_free };
+  level_count = static_cast<uint32_t>(levels.size());
+
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+bool ImageData::retrieveKTX2Info(uint8_t const* buffer_data, uint32_t const buffer_size) {
+  if (!IsKTX2(buffer_data, buffer_size)) {
+    return false;
+  }
+  KTX2Header header{};
+  std::memcpy(&header, buffer_data, sizeof(header));
+
+  width = static_cast<int32_t>(header.pixelWidth);
+  height = static_cast<int32_t>(header.pixelHeight);
+  return (width > 0) && (height > 0);
+}
+
+} // namespace scene
+
+/* -------------------------------------------------------------------------- */
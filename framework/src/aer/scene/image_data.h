@@ -37,6 +37,115 @@ struct ImageData {
  public:
   static constexpr int32_t kDefaultNumChannels{ STBI_rgb_alpha }; //
 
+  /* Layout of the image texels, block compressed formats use 4x4 blocks. */
+  enum class Format : uint32_t {
+    RGBA8_UNORM,
+    BC7_RGBA,
+    BC5_RG,
+    BC4_R,
+    ASTC_4x4_RGBA,
+    ETC2_RGBA,
+    EAC_RG11,
+    EAC_R11,
+    kCount
+  };
+
+  /* GPU block compression family KTX2 images are transcoded to. */
+  enum class BlockCompression : uint32_t {
+    None,
+    BC,
+    ASTC,
+    ETC2,
+    kCount
+  };
+
+  /* Channels an image is sampled for, to pick the smallest fitting format. */
+  enum class Channels : uint32_t {
+    RGBA,
+    RG,   // (eg. normal maps, Y being stored in alpha for KTX2 ones)
+    R,    // (eg. occlusion maps)
+  };
+
+  /* Host mip generation after decoding, sRGB images being filtered in linear space. */
+  enum class MipmapFilter : uint32_t {
+    None,
+    Linear,
+    sRGB,   // (eg. base color and emissive maps)
+  };
+
+  struct MipLevel {
+    uint64_t offset{}; // bytes, in the pixels buffer.
+    uint64_t bytesize{};
+    int32_t width{};
+    int32_t height{};
+  };
+
+  /* Width and height in texels of a format blocks, 1 when uncompressed. */
+  static uint32_t BlockExtent(Format const format) noexcept {
+    return (format == Format::RGBA8_UNORM) ? 1u : 4u;
+  }
+
+  /* Bytesize of a format blocks, or texels when uncompressed. */
+  static uint32_t BlockBytesize(Format const format) noexcept {
+    switch (format) {
+      case Format::BC4_R:
+      case Format::EAC_R11:
+      return 8u;
+
+      case Format::RGBA8_UNORM:
+      return 4u;
+
+      default:
+      return 16u;
+    }
+  }
+
+  static uint64_t LevelBytesize(Format const format, int32_t const w, int32_t const h) noexcept {
+    uint64_t const extent = BlockExtent(format);
+    uint64_t const blocks_x = (static_cast<uint64_t>(std::max(w, 1)) + extent - 1u) / extent;
+    uint64_t const blocks_y = (static_cast<uint64_t>(std::max(h, 1)) + extent - 1u) / extent;
+    return blocks_x * blocks_y * BlockBytesize(format);
+  }
+
+  /* Levels of a tightly packed mip chain, from the largest. */
+  static std::vector<MipLevel> MipChain(Format const format, int32_t w, int32_t h, uint32_t const level_count) {
+    std::vector<MipLevel> levels(level_count);
+    uint64_t offset{0u};
+    for (auto& level : levels) {
+      level = {
+        .offset = offset,
+        .bytesize = LevelBytesize(format, w, h),
+        .width = w,
+        .height = h,
+      };
+      offset += level.bytesize;
+      w = std::max(w / 2, 1);
+      h = std::max(h / 2, 1);
+    }
+    return levels;
+  }
+
+  /* Bytesize of a tightly packed mip chain. */
+  static uint64_t MipChainBytesize(Format const format, int32_t const w, int32_t const h, uint32_t const level_count) {
+    uint64_t bytesize{0u};
+    for (auto const& level : MipChain(format, w, h, level_count)) {
+      bytesize += level.bytesize;
+    }
+    return bytesize;
+  }
+
+  /* Number of levels of a full mip chain, down to 1x1. */
+  static uint32_t FullLevelCount(int32_t const w, int32_t const h) noexcept {
+    uint32_t count{1u};
+    for (int32_t size = std::max(w, h); size > 1; size /= 2) {
+      ++count;
+    }
+    return count;
+  }
+
+  /* True when the buffer starts with the KTX 2.0 identifier. */
+  static bool IsKTX2(uint8_t const* buffer_data, uint32_t buffer_size);
+
  public:
   ImageData() = default;
 
@@ -78,11 +187,39 @@ struct ImageData {
     return nullptr != pixels_data;
   }
 
+  /**
+   * Transcode a KTX2 / Basis Universal image, with all its levels, to the
+   * 'compression' format fitting 'sampled_channels', or to RGBA8 when there
+   * is none.
+   **/
+  bool loadKTX2(
+    uint8_t const* buffer_data,
+    uint32_t buffer_size,
+    BlockCompression compression,
+    Channels sampled_channels = Channels::RGBA
+  );
+
+  /* Reference pixels owned elsewhere (eg. a mapped baked scene). */
+  void setExternalPixels(
+    uint8_t const* data,
+    int32_t _width,
+    int32_t _height,
+    Format _format = Format::RGBA8_UNORM,
+    uint32_t _level_count = 1u
+  ) {
+    width = _width;
+    height = _height;
+    channels = kDefaultNumChannels;
+    format = _format;
+    level_count = _level_count;
+    pixels = { const_cast<uint8_t*>(data), [](void*) {} };
+  }
+
   void release() {
     pixels.reset();
   }
 
-  std::future<bool> loadAsyncFuture(stbi_uc const* buffer_data, uint32_t const buffer_size) {
+  utils::Task<bool> loadAsyncFuture(stbi_uc const* buffer_data, uint32_t const buffer_size) {
     if (retrieveImageInfo(buffer_data, buffer_size)) {
       return utils::RunTaskGeneric<bool>([this, buffer_data, buffer_size] {
         return load(buffer_data, buffer_size);
@@ -91,16 +228,48 @@ struct ImageData {
     return {};
   }
 
-  void loadAsync(stbi_uc const* buffer_data, uint32_t const buffer_size) {
+  void loadAsync(
+    stbi_uc const* buffer_data,
+    uint32_t const buffer_size,
+    MipmapFilter const mipmaps = MipmapFilter::None
+  ) {
     if (retrieveImageInfo(buffer_data, buffer_size)) {
-      async_result_ = utils::RunTaskGeneric<bool>([this, buffer_data, buffer_size] {
-        return load(buffer_data, buffer_size);
+      async_result_ = utils::RunTaskGeneric<bool>([this, buffer_data, buffer_size, mipmaps] {
+        return load(buffer_data, buffer_size)
+            && ((mipmaps == MipmapFilter::None) || generateMipmaps(mipmaps));
+      });
+    }
+  }
+
+  /**
+   * Replace the pixels of a single level RGBA8 image by its full mip chain,
+   * downsampled on the host with a 2x2 box filter.
+   **/
+  bool generateMipmaps(MipmapFilter filter);
+
+  /* True for single level RGBA8 images larger than a texel. */
+  bool canGenerateMipmaps() const noexcept {
+    return (format == Format::RGBA8_UNORM)
+        && (level_count == 1u)
+        && (FullLevelCount(width, height) > 1u)
+        ;
+  }
+
+  void loadKTX2Async(
+    uint8_t const* buffer_data,
+    uint32_t const buffer_size,
+    BlockCompression const compression,
+    Channels const sampled_channels = Channels::RGBA
+  ) {
+    if (retrieveKTX2Info(buffer_data, buffer_size)) {
+      async_result_ = utils::RunTaskGeneric<bool>([this, buffer_data, buffer_size, compression, sampled_channels] {
+        return loadKTX2(buffer_data, buffer_size, compression, sampled_channels);
       });
     }
   }
 
   bool getLoadAsyncResult() {
-    return async_result_.valid() ? async_result_.get() : false;
+    return async_result_.valid() ? utils::WaitTask(async_result_) : false;
   }
 
   uint8_t const* getPixels() const {
@@ -111,8 +280,17 @@ struct ImageData {
     return (pixels || (getLoadAsyncResult() && pixels)) ? pixels.get() : nullptr;
   }
 
+  /* Bytesize of the whole mip chain. */
   uint32_t getBytesize() const {
-    return static_cast<uint32_t>(kDefaultNumChannels * width * height);
+    return static_cast<uint32_t>(MipChainBytesize(format, width, height, level_count));
+  }
+
+  std::vector<MipLevel> getMipLevels() const {
+    return MipChain(format, width, height, level_count);
+  }
+
+  bool isBlockCompressed() const noexcept {
+    return BlockExtent(format) > 1u;
   }
 
  public:
@@ -120,6 +298,9 @@ struct ImageData {
   int32_t height{};
   int32_t channels{}; //
 
+  Format format{Format::RGBA8_UNORM};
+  uint32_t level_count{1u};
+
   std::unique_ptr<uint8_t, decltype(&stbi_image_free)> pixels{nullptr, stbi_image_free}; //
 
  private:
@@ -127,7 +308,10 @@ struct ImageData {
     return 0 < stbi_info_from_memory(buffer_data, buffer_size, &width, &height, &channels);
   }
 
-  std::future<bool> async_result_;
+  /* Read the KTX2 header, without transcoding anything. */
+  bool retrieveKTX2Info(uint8_t const* buffer_data, uint32_t buffer_size);
+
+  utils::Task<bool> async_result_;
 };
 
 /* -------------------------------------------------------------------------- */
@@ -68,7 +68,12 @@ struct MaterialProxy {
 
 // ----------------------------------------------------------------------------
 
-/* Link a material to its MaterialFx. */
+/**
+ * Link a material to its MaterialFx.
+ *
+ * Once a scene is uploaded, changing its model or states (or the material_ref
+ * of a submesh) requires GPUResources::invalidate_draw_lists.
+ **/
 struct MaterialRef {
   // Built-in model id for the material.
   MaterialModel model{}; //
@@ -3,6 +3,31 @@
 
 /* -------------------------------------------------------------------------- */
 
+namespace {
+
+VkIndexType ToVkIndexType(Geometry::IndexFormat format) {
+  switch (format) {
+
+    case Geometry::IndexFormat::U32:
+      return VK_INDEX_TYPE_UINT32;
+
+    case Geometry::IndexFormat::U16:
+      return VK_INDEX_TYPE_UINT16;
+
+    // VULKAN 1.4 or VK_KHR_index_type_uint8
+    case Geometry::IndexFormat::U8:
+      return VK_INDEX_TYPE_UINT8;
+
+    default:
+      LOGD("Unsupported IndexFormat : {}", int(format));
+      return VK_INDEX_TYPE_UINT8;
+  }
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
 namespace scene {
 
 void Mesh::initialize_submesh_descriptors(AttributeLocationMap const& attribute_to_location) {
@@ -18,14 +43,74 @@ void Mesh::initialize_submesh_descriptors(AttributeLocationMap const& attribute_
 
     submesh.draw_descriptor = {
       .vertexInput = create_vertex_input_descriptors(prim.bufferOffsets, attribute_to_location),
-      .indexType = vk_index_type(),
+      .indexType = vk_index_type(i),
       .indexOffset = buffer_info_.index_offset + prim.indexOffset, //
       .vertexOffset = buffer_info_.vertex_offset + prim.bufferOffsets.at(AttributeType::Position), //
       .indexCount = prim.indexCount,
       .vertexCount = prim.vertexCount,
-      .instanceCount = 1u, //
+      .instanceCount = instance_count,
     };
+
+    submesh.lods.clear();
+    submesh.lod_index = 0u;
+    for (auto const& level : get_lods(i)) {
+      submesh.lods.push_back({
+        .index_offset = buffer_info_.index_offset + level.indexOffset,
+        .index_count = level.indexCount,
+        .error = level.error,
+      });
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+uint64_t Mesh::select_lods(
+  std::span<mat4 const> world_matrices,
+  vec3 const& eye,
+  float const pixel_scale,
+  float const pixel_error
+) {
+  uint64_t triangle_count{0u};
+
+  for (uint32_t i = 0u; i < submeshes.size(); ++i) {
+    auto& submesh = submeshes[i];
+    submesh.lod_index = 0u;
+
+    if (!submesh.lods.empty()) {
+      auto const& prim = get_primitive(i);
+      vec4 const center{ prim.center[0], prim.center[1], prim.center[2], 1.0f };
+
+      // Smallest distance to the bounding sphere, in mesh space units.
+      float min_distance{ std::numeric_limits<float>::max() };
+      for (auto const& world : world_matrices) {
+        float const scale = std::max({
+          linalg::length(lina::to_vec3(world.x)),
+          linalg::length(lina::to_vec3(world.y)),
+          linalg::length(lina::to_vec3(world.z)),
+        });
+        vec3 const world_center{ lina::to_vec3(linalg::mul(world, center)) };
+        float const distance = linalg::length(world_center - eye) - prim.radius * scale;
+        min_distance = std::min(min_distance, std::max(distance, 0.0f) / scale);
+      }
+
+      // (errors grow along the chain)
+      float const max_error{ pixel_error * min_distance / pixel_scale };
+      for (uint32_t lod = static_cast<uint32_t>(submesh.lods.size()); lod > 0u; --lod) {
+        if (submesh.lods[lod - 1u].error <= max_error) {
+          submesh.lod_index = lod;
+          break;
+        }
+      }
+    }
+
+    uint32_t const index_count = (submesh.lod_index > 0u) ? submesh.lods[submesh.lod_index - 1u].index_count
+                                                         : submesh.draw_descriptor.indexCount
+                                                         ;
+    triangle_count += static_cast<uint64_t>(index_count / 3u) * instance_count;
   }
+
+  return triangle_count;
 }
 
 // ----------------------------------------------------------------------------
@@ -82,23 +167,11 @@ VkPrimitiveTopology Mesh::vk_primitive_topology() const {
 // ----------------------------------------------------------------------------
 
 VkIndexType Mesh::vk_index_type() const {
-  auto format = get_index_format();
-  switch (format) {
-
-    case IndexFormat::U32:
-      return VK_INDEX_TYPE_UINT32;
-
-    case IndexFormat::U16:
-      return VK_INDEX_TYPE_UINT16;
-
-    // VULKAN 1.4 or VK_KHR_index_type_uint8
-    case IndexFormat::U8:
-      return VK_INDEX_TYPE_UINT8;
+  return ToVkIndexType(get_index_format());
+}
 
-    default:
-      LOGD("Unsupported IndexFormat : {}", int(format));
-      return VK_INDEX_TYPE_UINT8;
-  }
+VkIndexType Mesh::vk_index_type(uint32_t primitive_index) const {
+  return ToVkIndexType(get_index_format(primitive_index));
 }
 
 // ----------------------------------------------------------------------------
@@ -117,6 +190,18 @@ VkFormat Mesh::vk_format(AttributeType const attrib_type) const {
       return VK_FORMAT_R32G32B32A32_SFLOAT;
     break;
 
+    case AttributeFormat::RG_F16:
+      return VK_FORMAT_R16G16_SFLOAT;
+    break;
+
+    case AttributeFormat::RG_SNORM16:
+      return VK_FORMAT_R16G16_SNORM;
+    break;
+
+    case AttributeFormat::RGBA_SNORM16:
+      return VK_FORMAT_R16G16B16A16_SNORM;
+    break;
+
     default:
       return VK_FORMAT_UNDEFINED;
   }
@@ -183,9 +268,19 @@ void Mesh::set_resources_ptr(HostResources const* R) {
 
 // ----------------------------------------------------------------------------
 
-mat4 const& Mesh::world_matrix() const {
+mat4 const& Mesh::world_matrix(uint32_t instance_index) const {
   LOG_CHECK(resources_ptr_ != nullptr);
-  return resources_ptr_->transforms[transform_index];
+  LOG_CHECK(instance_index < instance_count);
+  return resources_ptr_->transforms[transform_index + instance_index];
+}
+
+// ----------------------------------------------------------------------------
+
+mat4 Mesh::dequantization_matrix() const {
+  return linalg::mul(
+    linalg::translation_matrix(position_offset),
+    linalg::scaling_matrix(position_scale)
+  );
 }
 
 } // namespace "scene"
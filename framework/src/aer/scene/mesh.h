@@ -16,10 +16,25 @@ struct MaterialRef;
 
 struct Mesh : Geometry {
  public:
+  struct LodDraw {
+    uint64_t index_offset{}; // in the index buffer.
+    uint32_t index_count{};
+    float error{};
+  };
+
   struct SubMesh {
     Mesh const* parent{};
     DrawDescriptor draw_descriptor{};
     MaterialRef const* material_ref{};
+
+    // Meshlets draw slots, set when uploaded for culling.
+    uint32_t meshlet_count{};
+    uint32_t meshlet_draw_offset{};   // first command in the indirect draws buffer.
+    uint32_t meshlet_draw_index{};    // slot in the draw counts buffer.
+
+    // Coarser LOD levels, and the one selected for drawing.
+    std::vector<LodDraw> lods{};
+    uint32_t lod_index{};             // 0 for the full detail, lods[lod_index - 1] otherwise.
   };
 
   struct BufferInfo {
@@ -48,12 +63,49 @@ struct Mesh : Geometry {
   /* Set pointer to global resources. */
   void set_resources_ptr(HostResources const* R);
 
-  /* Return the mesh world transform. */
-  mat4 const& world_matrix() const; //
+  /* Return the world transform of one of the mesh instances. */
+  mat4 const& world_matrix(uint32_t instance_index = 0u) const; //
+
+  /* True when vertices use the quantized VertexCompact_t layout. */
+  bool has_compact_vertices() const {
+    return has_attribute(AttributeType::Position)
+        && (get_format(AttributeType::Position) == AttributeFormat::RGBA_SNORM16)
+        ;
+  }
+
+  /* Map compact positions back to the mesh space, identity otherwise. */
+  mat4 dequantization_matrix() const;
+
+  /**
+   * Select for each submesh the coarsest LOD whose error, projected from its
+   * nearest instance, stays under 'pixel_error' pixels. 'pixel_scale' is the
+   * on-screen size in pixels of a unit length at unit distance, ie.
+   * proj[1][1] * viewport height / 2.
+   *
+   * Return the number of triangles drawn with this selection, for every instance.
+   **/
+  uint64_t select_lods(
+    std::span<mat4 const> world_matrices,
+    vec3 const& eye,
+    float pixel_scale,
+    float pixel_error
+  );
 
  public:
+  // Once uploaded, adding or removing submeshes requires GPUResources::invalidate_draw_lists.
   std::vector<SubMesh> submeshes{};
+
+  // Instances transforms are contiguous, starting at transform_index.
+  // Once uploaded, moving them requires GPUResources::invalidate_draw_order.
   uint32_t transform_index{};
+  uint32_t instance_count{1u};
+
+  // Skeleton of the skinned instances, in HostResources::skeletons.
+  uint32_t skeleton_index{kInvalidIndexU32};
+
+  // Compact positions dequantization : offset + scale * snorm position.
+  vec3 position_offset{0.0f};
+  vec3 position_scale{1.0f};
 
  private:
   HostResources const* resources_ptr_{};
@@ -64,6 +116,7 @@ struct Mesh : Geometry {
  public:
   PipelineVertexBufferDescriptors pipeline_vertex_buffer_descriptors() const;
   VkIndexType vk_index_type() const;
+  VkIndexType vk_index_type(uint32_t primitive_index) const;
   VkPrimitiveTopology vk_primitive_topology() const;
   VkFormat vk_format(AttributeType const attrib_type) const;
 
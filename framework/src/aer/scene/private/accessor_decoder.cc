@@ -0,0 +1,764 @@
+#include "aer/scene/private/accessor_decoder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define AER_DECODER_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define AER_DECODER_TARGET_AVX2
+#else
+#define AER_DECODER_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define AER_DECODER_NEON 1
+#include <arm_neon.h>
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+using namespace internal::accessor_decoder;
+
+template<ComponentType T> struct ComponentTraits;
+
+template<> struct ComponentTraits<ComponentType::I8> {
+  using type = int8_t;
+  static constexpr float kNormScale{ 1.0f / 127.0f };
+};
+
+template<> struct ComponentTraits<ComponentType::U8> {
+  using type = uint8_t;
+  static constexpr float kNormScale{ 1.0f / 255.0f };
+};
+
+template<> struct ComponentTraits<ComponentType::I16> {
+  using type = int16_t;
+  static constexpr float kNormScale{ 1.0f / 32767.0f };
+};
+
+template<> struct ComponentTraits<ComponentType::U16> {
+  using type = uint16_t;
+  static constexpr float kNormScale{ 1.0f / 65535.0f };
+};
+
+template<> struct ComponentTraits<ComponentType::U32> {
+  using type = uint32_t;
+  static constexpr float kNormScale{ 1.0f / 4294967295.0f };
+};
+
+template<> struct ComponentTraits<ComponentType::F32> {
+  using type = float;
+  static constexpr float kNormScale{ 1.0f };
+};
+
+template<ComponentType T>
+constexpr uint32_t kComponentSize{ sizeof(typename ComponentTraits<T>::type) };
+
+// Bytes read by a SIMD load of N components (rounded up to a register load).
+template<ComponentType T, uint32_t N>
+constexpr uint32_t kLoadBytes{
+    (kComponentSize<T> * N <= 4u) ? 4u
+  : (kComponentSize<T> * N <= 8u) ? 8u
+  : 16u
+};
+
+// ----------------------------------------------------------------------------
+
+struct Params {
+  uint8_t const* src{};
+  size_t src_stride{};
+  size_t element_bytes{};
+  size_t count{};
+  float* dst{};
+  size_t dst_stride{};
+  float scale{};
+  float min_value{};
+};
+
+uint8_t const* SrcElement(Params const& p, size_t i) {
+  return p.src + i * p.src_stride;
+}
+
+float* DstElement(Params const& p, size_t i) {
+  return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(p.dst) + i * p.dst_stride);
+}
+
+/* Number of leading elements which can be loaded with 'load_bytes' without
+ * reading past the end of the attribute data. */
+size_t FastCount(Params const& p, size_t load_bytes) {
+  size_t const total_bytes = (p.count - 1u) * p.src_stride + p.element_bytes;
+  if (load_bytes > total_bytes) {
+    return 0u;
+  }
+  if (p.src_stride == 0u) {
+    return (load_bytes <= p.element_bytes) ? p.count : 0u;
+  }
+  return std::min(p.count, (total_bytes - load_bytes) / p.src_stride + 1u);
+}
+
+// ----------------------------------------------------------------------------
+
+struct ScalarKernel {
+  template<ComponentType T, uint32_t N>
+  static void Run(Params const& p, size_t first) {
+    using type = typename ComponentTraits<T>::type;
+
+    for (size_t i = first; i < p.count; ++i) {
+      uint8_t const* src = SrcElement(p, i);
+      float* dst = DstElement(p, i);
+      for (uint32_t c = 0u; c < N; ++c) {
+        type value;
+        std::memcpy(&value, src + c * sizeof(type), sizeof(type));
+        if constexpr (T == ComponentType::F32) {
+          dst[c] = value;
+        } else {
+          dst[c] = std::max(static_cast<float>(value) * p.scale, p.min_value);
+        }
+      }
+    }
+  }
+};
+
+// ----------------------------------------------------------------------------
+
+#if defined(AER_DECODER_X86)
+
+bool CpuHasAVX2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+  int info[4]{};
+  __cpuid(info, 1);
+  bool const os_saves_ymm = (info[2] & (1 << 27)) && ((_xgetbv(0) & 0x6u) == 0x6u);
+  __cpuidex(info, 7, 0);
+  return os_saves_ymm && (info[1] & (1 << 5));
+#else
+  return __builtin_cpu_supports("avx2");
+#endif
+}
+
+template<uint32_t Bytes>
+__m128i LoadSSE(uint8_t const* src) {
+  if constexpr (Bytes == 4u) {
+    int32_t bits;
+    std::memcpy(&bits, src, sizeof(bits));
+    return _mm_cvtsi32_si128(bits);
+  } else if constexpr (Bytes == 8u) {
+    return _mm_loadl_epi64(reinterpret_cast<__m128i const*>(src));
+  } else {
+    return _mm_loadu_si128(reinterpret_cast<__m128i const*>(src));
+  }
+}
+
+/* Widen the four low components of v to int32 and convert them to float. */
+template<ComponentType T>
+__m128 WidenSSE(__m128i v) {
+  if constexpr (T == ComponentType::F32) {
+    return _mm_castsi128_ps(v);
+  } else {
+#if defined(__SSE4_1__)
+    if constexpr (T == ComponentType::I8)  { v = _mm_cvtepi8_epi32(v); }
+    if constexpr (T == ComponentType::U8)  { v = _mm_cvtepu8_epi32(v); }
+    if constexpr (T == ComponentType::I16) { v = _mm_cvtepi16_epi32(v); }
+    if constexpr (T == ComponentType::U16) { v = _mm_cvtepu16_epi32(v); }
+#else
+    __m128i const zero = _mm_setzero_si128();
+    if constexpr (T == ComponentType::I8) {
+      v = _mm_unpacklo_epi8(v, v);
+      v = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 24);
+    }
+    if constexpr (T == ComponentType::U8) {
+      v = _mm_unpacklo_epi16(_mm_unpacklo_epi8(v, zero), zero);
+    }
+    if constexpr (T == ComponentType::I16) {
+      v = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+    }
+    if constexpr (T == ComponentType::U16) {
+      v = _mm_unpacklo_epi16(v, zero);
+    }
+#endif
+    return _mm_cvtepi32_ps(v);
+  }
+}
+
+template<uint32_t N>
+void StoreSSE(float* dst, __m128 v) {
+  if constexpr (N == 4u) {
+    _mm_storeu_ps(dst, v);
+  } else if constexpr (N == 3u) {
+    _mm_storel_pi(reinterpret_cast<__m64*>(dst), v);
+    _mm_store_ss(dst + 2, _mm_movehl_ps(v, v));
+  } else if constexpr (N == 2u) {
+    _mm_storel_pi(reinterpret_cast<__m64*>(dst), v);
+  } else {
+    _mm_store_ss(dst, v);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+struct SSEKernel {
+  template<ComponentType T, uint32_t N>
+  static void Run(Params const& p, size_t first) {
+    if constexpr (T == ComponentType::U32) {
+      ScalarKernel::Run<T, N>(p, first);
+    } else {
+      size_t const fast_count = FastCount(p, kLoadBytes<T, N>);
+      __m128 const scale = _mm_set1_ps(p.scale);
+      __m128 const min_value = _mm_set1_ps(p.min_value);
+
+      size_t i = first;
+      for (; i < fast_count; ++i) {
+        __m128 v = WidenSSE<T>(LoadSSE<kLoadBytes<T, N>>(SrcElement(p, i)));
+        if constexpr (T != ComponentType::F32) {
+          v = _mm_max_ps(_mm_mul_ps(v, scale), min_value);
+        }
+        StoreSSE<N>(DstElement(p, i), v);
+      }
+      ScalarKernel::Run<T, N>(p, i);
+    }
+  }
+};
+
+// ----------------------------------------------------------------------------
+
+/* Converts two integer elements per iteration in a single 256-bit register. */
+struct AVX2Kernel {
+  template<ComponentType T, uint32_t N>
+  AER_DECODER_TARGET_AVX2
+  static void Run(Params const& p, size_t first) {
+    if constexpr ((T == ComponentType::U32) || (T == ComponentType::F32)) {
+      SSEKernel::Run<T, N>(p, first);
+    } else {
+      size_t const fast_count = FastCount(p, kLoadBytes<T, N>);
+      __m256 const scale = _mm256_set1_ps(p.scale);
+      __m256 const min_value = _mm256_set1_ps(p.min_value);
+
+      size_t i = first;
+      for (; i + 1u < fast_count; i += 2u) {
+        __m128i const a = LoadSSE<kLoadBytes<T, N>>(SrcElement(p, i));
+        __m128i const b = LoadSSE<kLoadBytes<T, N>>(SrcElement(p, i + 1u));
+
+        __m256i wide;
+        if constexpr (T == ComponentType::I8)  { wide = _mm256_cvtepi8_epi32(_mm_unpacklo_epi32(a, b)); }
+        if constexpr (T == ComponentType::U8)  { wide = _mm256_cvtepu8_epi32(_mm_unpacklo_epi32(a, b)); }
+        if constexpr (T == ComponentType::I16) { wide = _mm256_cvtepi16_epi32(_mm_unpacklo_epi64(a, b)); }
+        if constexpr (T == ComponentType::U16) { wide = _mm256_cvtepu16_epi32(_mm_unpacklo_epi64(a, b)); }
+
+        __m256 const v = _mm256_max_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(wide), scale), min_value);
+        StoreSSE<N>(DstElement(p, i), _mm256_castps256_ps128(v));
+        StoreSSE<N>(DstElement(p, i + 1u), _mm256_extractf128_ps(v, 1));
+      }
+      SSEKernel::Run<T, N>(p, i);
+    }
+  }
+};
+
+#endif // AER_DECODER_X86
+
+// ----------------------------------------------------------------------------
+
+#if defined(AER_DECODER_NEON)
+
+template<uint32_t Bytes>
+uint64_t LoadBitsNEON(uint8_t const* src) {
+  uint64_t bits{0u};
+  std::memcpy(&bits, src, Bytes);
+  return bits;
+}
+
+template<ComponentType T, uint32_t N>
+float32x4_t LoadNEON(uint8_t const* src) {
+  if constexpr (T == ComponentType::F32) {
+    if constexpr (kLoadBytes<T, N> == 16u) {
+      return vld1q_f32(reinterpret_cast<float const*>(src));
+    } else {
+      return vcombine_f32(vcreate_f32(LoadBitsNEON<kLoadBytes<T, N>>(src)), vdup_n_f32(0.0f));
+    }
+  } else {
+    uint64_t const bits = LoadBitsNEON<kLoadBytes<T, N>>(src);
+    if constexpr (T == ComponentType::I8) {
+      return vcvtq_f32_s32(vmovl_s16(vget_low_s16(vmovl_s8(vcreate_s8(bits)))));
+    } else if constexpr (T == ComponentType::U8) {
+      return vcvtq_f32_u32(vmovl_u16(vget_low_u16(vmovl_u8(vcreate_u8(bits)))));
+    } else if constexpr (T == ComponentType::I16) {
+      return vcvtq_f32_s32(vmovl_s16(vcreate_s16(bits)));
+    } else {
+      return vcvtq_f32_u32(vmovl_u16(vcreate_u16(bits)));
+    }
+  }
+}
+
+template<uint32_t N>
+void StoreNEON(float* dst, float32x4_t v) {
+  if constexpr (N == 4u) {
+    vst1q_f32(dst, v);
+  } else if constexpr (N == 3u) {
+    vst1_f32(dst, vget_low_f32(v));
+    vst1q_lane_f32(dst + 2, v, 2);
+  } else if constexpr (N == 2u) {
+    vst1_f32(dst, vget_low_f32(v));
+  } else {
+    vst1q_lane_f32(dst, v, 0);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+struct NEONKernel {
+  template<ComponentType T, uint32_t N>
+  static void Run(Params const& p, size_t first) {
+    if constexpr (T == ComponentType::U32) {
+      ScalarKernel::Run<T, N>(p, first);
+    } else {
+      size_t const fast_count = FastCount(p, kLoadBytes<T, N>);
+      float32x4_t const min_value = vdupq_n_f32(p.min_value);
+
+      size_t i = first;
+      for (; i < fast_count; ++i) {
+        float32x4_t v = LoadNEON<T, N>(SrcElement(p, i));
+        if constexpr (T != ComponentType::F32) {
+          v = vmaxq_f32(vmulq_n_f32(v, p.scale), min_value);
+        }
+        StoreNEON<N>(DstElement(p, i), v);
+      }
+      ScalarKernel::Run<T, N>(p, i);
+    }
+  }
+};
+
+#endif // AER_DECODER_NEON
+
+// ----------------------------------------------------------------------------
+
+template<typename Kernel, ComponentType T>
+void DispatchComponents(Params const& p, uint32_t components) {
+  switch (components) {
+    case 1: Kernel::template Run<T, 1u>(p, 0u); break;
+    case 2: Kernel::template Run<T, 2u>(p, 0u); break;
+    case 3: Kernel::template Run<T, 3u>(p, 0u); break;
+    default: Kernel::template Run<T, 4u>(p, 0u); break;
+  }
+}
+
+template<typename Kernel>
+void Dispatch(Params const& p, ComponentType type, uint32_t components) {
+  switch (type) {
+    case ComponentType::I8:  DispatchComponents<Kernel, ComponentType::I8>(p, components);  break;
+    case ComponentType::U8:  DispatchComponents<Kernel, ComponentType::U8>(p, components);  break;
+    case ComponentType::I16: DispatchComponents<Kernel, ComponentType::I16>(p, components); break;
+    case ComponentType::U16: DispatchComponents<Kernel, ComponentType::U16>(p, components); break;
+    case ComponentType::U32: DispatchComponents<Kernel, ComponentType::U32>(p, components); break;
+    case ComponentType::F32: DispatchComponents<Kernel, ComponentType::F32>(p, components); break;
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+uint32_t ComponentSize(ComponentType type) {
+  switch (type) {
+    case ComponentType::I8:
+    case ComponentType::U8:
+      return 1u;
+    case ComponentType::I16:
+    case ComponentType::U16:
+      return 2u;
+    default:
+      return 4u;
+  }
+}
+
+float NormScale(ComponentType type) {
+  switch (type) {
+    case ComponentType::I8:  return ComponentTraits<ComponentType::I8>::kNormScale;
+    case ComponentType::U8:  return ComponentTraits<ComponentType::U8>::kNormScale;
+    case ComponentType::I16: return ComponentTraits<ComponentType::I16>::kNormScale;
+    case ComponentType::U16: return ComponentTraits<ComponentType::U16>::kNormScale;
+    case ComponentType::U32: return ComponentTraits<ComponentType::U32>::kNormScale;
+    default:                 return 1.0f;
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+/* Strided conversion of indices from 'first', used for tails and packed layouts. */
+template<typename SrcT, typename DstT>
+void ConvertIndicesScalar(uint8_t const* src, size_t stride, size_t first, size_t count, DstT* dst) {
+  for (size_t i = first; i < count; ++i) {
+    SrcT value;
+    std::memcpy(&value, src + i * stride, sizeof(value));
+    dst[i] = static_cast<DstT>(value);
+  }
+}
+
+/**
+ * Tightly packed conversions, each returns the number of leading indices
+ * converted, the remaining ones being left to the scalar path.
+ **/
+
+#if defined(AER_DECODER_X86)
+
+__m128i LoadU128(uint8_t const* src) {
+  return _mm_loadu_si128(reinterpret_cast<__m128i const*>(src));
+}
+
+template<typename T>
+void StoreU128(T* dst, __m128i v) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), v);
+}
+
+/* Pack two vectors of 32-bit values known to fit in 16-bit. */
+__m128i NarrowU32ToU16(__m128i a, __m128i b) {
+#if defined(__SSE4_1__)
+  return _mm_packus_epi32(a, b);
+#else
+  // (bias to the signed range so the signed saturation is lossless)
+  __m128i const bias32 = _mm_set1_epi32(0x8000);
+  __m128i const bias16 = _mm_set1_epi16(static_cast<int16_t>(0x8000));
+  return _mm_add_epi16(
+    _mm_packs_epi32(_mm_sub_epi32(a, bias32), _mm_sub_epi32(b, bias32)),
+    bias16
+  );
+#endif
+}
+
+size_t ConvertIndicesSSE(uint8_t const* src, ComponentType type, size_t count, uint32_t* dst) {
+  __m128i const zero = _mm_setzero_si128();
+  size_t i = 0u;
+  if (type == ComponentType::U16) {
+    for (; i + 8u <= count; i += 8u) {
+      __m128i const v = LoadU128(src + 2u * i);
+      StoreU128(dst + i,      _mm_unpacklo_epi16(v, zero));
+      StoreU128(dst + i + 4u, _mm_unpackhi_epi16(v, zero));
+    }
+  } else if (type == ComponentType::U8) {
+    for (; i + 16u <= count; i += 16u) {
+      __m128i const v = LoadU128(src + i);
+      __m128i const lo = _mm_unpacklo_epi8(v, zero);
+      __m128i const hi = _mm_unpackhi_epi8(v, zero);
+      StoreU128(dst + i,       _mm_unpacklo_epi16(lo, zero));
+      StoreU128(dst + i + 4u,  _mm_unpackhi_epi16(lo, zero));
+      StoreU128(dst + i + 8u,  _mm_unpacklo_epi16(hi, zero));
+      StoreU128(dst + i + 12u, _mm_unpackhi_epi16(hi, zero));
+    }
+  }
+  return i;
+}
+
+size_t ConvertIndicesSSE(uint8_t const* src, ComponentType type, size_t count, uint16_t* dst) {
+  __m128i const zero = _mm_setzero_si128();
+  size_t i = 0u;
+  if (type == ComponentType::U32) {
+    for (; i + 8u <= count; i += 8u) {
+      __m128i const a = LoadU128(src + 4u * i);
+      __m128i const b = LoadU128(src + 4u * i + 16u);
+      StoreU128(dst + i, NarrowU32ToU16(a, b));
+    }
+  } else if (type == ComponentType::U8) {
+    for (; i + 16u <= count; i += 16u) {
+      __m128i const v = LoadU128(src + i);
+      StoreU128(dst + i,      _mm_unpacklo_epi8(v, zero));
+      StoreU128(dst + i + 8u, _mm_unpackhi_epi8(v, zero));
+    }
+  }
+  return i;
+}
+
+AER_DECODER_TARGET_AVX2
+size_t ConvertIndicesAVX2(uint8_t const* src, ComponentType type, size_t count, uint32_t* dst) {
+  size_t i = 0u;
+  if (type == ComponentType::U16) {
+    for (; i + 16u <= count; i += 16u) {
+      __m256i const lo = _mm256_cvtepu16_epi32(LoadU128(src + 2u * i));
+      __m256i const hi = _mm256_cvtepu16_epi32(LoadU128(src + 2u * i + 16u));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), lo);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 8u), hi);
+    }
+  } else if (type == ComponentType::U8) {
+    for (; i + 16u <= count; i += 16u) {
+      __m128i const v = LoadU128(src + i);
+      __m256i const lo = _mm256_cvtepu8_epi32(v);
+      __m256i const hi = _mm256_cvtepu8_epi32(_mm_srli_si128(v, 8));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), lo);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 8u), hi);
+    }
+  }
+  return i;
+}
+
+AER_DECODER_TARGET_AVX2
+size_t ConvertIndicesAVX2(uint8_t const* src, ComponentType type, size_t count, uint16_t* dst) {
+  size_t i = 0u;
+  if (type == ComponentType::U32) {
+    for (; i + 16u <= count; i += 16u) {
+      __m256i const a = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src + 4u * i));
+      __m256i const b = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src + 4u * i + 32u));
+      // (packus works per 128-bit lane, reorder the 64-bit quarters afterwards)
+      __m256i const packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(a, b), 0xD8);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), packed);
+    }
+  } else if (type == ComponentType::U8) {
+    for (; i + 16u <= count; i += 16u) {
+      __m256i const v = _mm256_cvtepu8_epi16(LoadU128(src + i));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v);
+    }
+  }
+  return i;
+}
+
+#endif // AER_DECODER_X86
+
+#if defined(AER_DECODER_NEON)
+
+size_t ConvertIndicesNEON(uint8_t const* src, ComponentType type, size_t count, uint32_t* dst) {
+  size_t i = 0u;
+  if (type == ComponentType::U16) {
+    for (; i + 8u <= count; i += 8u) {
+      uint16x8_t const v = vreinterpretq_u16_u8(vld1q_u8(src + 2u * i));
+      vst1q_u32(dst + i,      vmovl_u16(vget_low_u16(v)));
+      vst1q_u32(dst + i + 4u, vmovl_u16(vget_high_u16(v)));
+    }
+  } else if (type == ComponentType::U8) {
+    for (; i + 16u <= count; i += 16u) {
+      uint8x16_t const v = vld1q_u8(src + i);
+      uint16x8_t const lo = vmovl_u8(vget_low_u8(v));
+      uint16x8_t const hi = vmovl_u8(vget_high_u8(v));
+      vst1q_u32(dst + i,       vmovl_u16(vget_low_u16(lo)));
+      vst1q_u32(dst + i + 4u,  vmovl_u16(vget_high_u16(lo)));
+      vst1q_u32(dst + i + 8u,  vmovl_u16(vget_low_u16(hi)));
+      vst1q_u32(dst + i + 12u, vmovl_u16(vget_high_u16(hi)));
+    }
+  }
+  return i;
+}
+
+size_t ConvertIndicesNEON(uint8_t const* src, ComponentType type, size_t count, uint16_t* dst) {
+  size_t i = 0u;
+  if (type == ComponentType::U32) {
+    for (; i + 8u <= count; i += 8u) {
+      uint32x4_t const a = vreinterpretq_u32_u8(vld1q_u8(src + 4u * i));
+      uint32x4_t const b = vreinterpretq_u32_u8(vld1q_u8(src + 4u * i + 16u));
+      vst1q_u16(dst + i, vcombine_u16(vmovn_u32(a), vmovn_u32(b)));
+    }
+  } else if (type == ComponentType::U8) {
+    for (; i + 16u <= count; i += 16u) {
+      uint8x16_t const v = vld1q_u8(src + i);
+      vst1q_u16(dst + i,      vmovl_u8(vget_low_u8(v)));
+      vst1q_u16(dst + i + 8u, vmovl_u8(vget_high_u8(v)));
+    }
+  }
+  return i;
+}
+
+#endif // AER_DECODER_NEON
+
+// ----------------------------------------------------------------------------
+
+template<typename DstT>
+bool DecodeIndicesGeneric(
+  uint8_t const* src,
+  ComponentType type,
+  size_t stride,
+  size_t count,
+  DstT* dst,
+  Backend backend
+) {
+  if (!src || !dst
+   || ((type != ComponentType::U8) && (type != ComponentType::U16) && (type != ComponentType::U32))) {
+    return false;
+  }
+
+  size_t const component_size = ComponentSize(type);
+  stride = (stride > 0u) ? stride : component_size;
+
+  bool const is_packed = (stride == component_size);
+  if (is_packed && (component_size == sizeof(DstT))) {
+    std::memcpy(dst, src, count * sizeof(DstT));
+    return true;
+  }
+
+  size_t first = 0u;
+  if (is_packed) {
+    switch (IsBackendSupported(backend) ? backend : Backend::Scalar) {
+#if defined(AER_DECODER_X86)
+      case Backend::AVX2:
+        first = ConvertIndicesAVX2(src, type, count, dst);
+      break;
+
+      case Backend::SSE:
+        first = ConvertIndicesSSE(src, type, count, dst);
+      break;
+#endif
+
+#if defined(AER_DECODER_NEON)
+      case Backend::NEON:
+        first = ConvertIndicesNEON(src, type, count, dst);
+      break;
+#endif
+
+      default:
+      break;
+    }
+  }
+
+  switch (type) {
+    case ComponentType::U8:
+      ConvertIndicesScalar<uint8_t>(src, stride, first, count, dst);
+    break;
+
+    case ComponentType::U16:
+      ConvertIndicesScalar<uint16_t>(src, stride, first, count, dst);
+    break;
+
+    default:
+      ConvertIndicesScalar<uint32_t>(src, stride, first, count, dst);
+    break;
+  }
+
+  return true;
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+namespace internal::accessor_decoder {
+
+bool IsBackendSupported(Backend backend) {
+  switch (backend) {
+    case Backend::Scalar:
+      return true;
+#if defined(AER_DECODER_X86)
+    case Backend::SSE:
+      return true;
+    case Backend::AVX2: {
+      static bool const kHasAVX2{ CpuHasAVX2() };
+      return kHasAVX2;
+    }
+#endif
+#if defined(AER_DECODER_NEON)
+    case Backend::NEON:
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+Backend BestBackend() {
+  for (auto backend : { Backend::AVX2, Backend::SSE, Backend::NEON }) {
+    if (IsBackendSupported(backend)) {
+      return backend;
+    }
+  }
+  return Backend::Scalar;
+}
+
+// ----------------------------------------------------------------------------
+
+char const* BackendName(Backend backend) {
+  switch (backend) {
+    case Backend::Scalar: return "scalar";
+    case Backend::SSE:    return "sse";
+    case Backend::AVX2:   return "avx2";
+    case Backend::NEON:   return "neon";
+  }
+  return "unknown";
+}
+
+// ----------------------------------------------------------------------------
+
+bool DecodeFloats(
+  uint8_t const* src,
+  Layout const& layout,
+  size_t count,
+  float* dst,
+  size_t dst_stride,
+  uint32_t dst_components,
+  Backend backend
+) {
+  if (!src || !dst
+   || (layout.components < 1u) || (layout.components > 4u)
+   || (dst_components < 1u)
+   || (layout.normalized && (layout.type == ComponentType::F32))) {
+    return false;
+  }
+  if (count == 0u) {
+    return true;
+  }
+
+  bool const is_signed = (layout.type == ComponentType::I8)
+                      || (layout.type == ComponentType::I16);
+
+  Params const params{
+    .src = src,
+    .src_stride = layout.stride,
+    .element_bytes = ComponentSize(layout.type) * layout.components,
+    .count = count,
+    .dst = dst,
+    .dst_stride = dst_stride,
+    .scale = layout.normalized ? NormScale(layout.type) : 1.0f,
+    .min_value = (layout.normalized && is_signed) ? -1.0f
+                                                  : std::numeric_limits<float>::lowest(),
+  };
+  uint32_t const components = std::min(layout.components, dst_components);
+
+  switch (IsBackendSupported(backend) ? backend : Backend::Scalar) {
+#if defined(AER_DECODER_X86)
+    case Backend::AVX2:
+      Dispatch<AVX2Kernel>(params, layout.type, components);
+    break;
+
+    case Backend::SSE:
+      Dispatch<SSEKernel>(params, layout.type, components);
+    break;
+#endif
+
+#if defined(AER_DECODER_NEON)
+    case Backend::NEON:
+      Dispatch<NEONKernel>(params, layout.type, components);
+    break;
+#endif
+
+    default:
+      Dispatch<ScalarKernel>(params, layout.type, components);
+    break;
+  }
+
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+bool DecodeIndices(
+  uint8_t const* src,
+  ComponentType type,
+  size_t stride,
+  size_t count,
+  uint32_t* dst,
+  Backend backend
+) {
+  return DecodeIndicesGeneric(src, type, stride, count, dst, backend);
+}
+
+// ----------------------------------------------------------------------------
+
+bool DecodeIndices(
+  uint8_t const* src,
+  ComponentType type,
+  size_t stride,
+  size_t count,
+  uint16_t* dst,
+  Backend backend
+) {
+  return DecodeIndicesGeneric(src, type, stride, count, dst, backend);
+}
+
+} // namespace internal::accessor_decoder
+
+/* -------------------------------------------------------------------------- */
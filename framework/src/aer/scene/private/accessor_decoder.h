@@ -0,0 +1,109 @@
+#ifndef AER_SCENE_PRIVATE_ACCESSOR_DECODER_H_
+#define AER_SCENE_PRIVATE_ACCESSOR_DECODER_H_
+
+/* -------------------------------------------------------------------------- */
+//
+//    accessor_decoder.h
+//
+//  Bulk conversion of strided vertex attributes to float, and of index
+//  buffers between 8, 16 and 32-bit, used in place of per-element accessor
+//  reads when restructuring glTF meshes.
+//
+//  Layouts are resolved once per attribute, then converted by a kernel
+//  specialized for the component type and count. Integer sources (normalized
+//  texcoords and colors, KHR_mesh_quantization positions and normals) are
+//  widened with SSE / AVX2 / NEON when available, and by a scalar kernel
+//  otherwise.
+//
+/* -------------------------------------------------------------------------- */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace internal::accessor_decoder {
+
+enum class ComponentType : uint8_t {
+  I8,
+  U8,
+  I16,
+  U16,
+  U32,
+  F32,
+};
+
+enum class Backend : uint8_t {
+  Scalar,
+  SSE,
+  AVX2,
+  NEON,
+};
+
+/* Description of a source attribute, as given by a glTF accessor. */
+struct Layout {
+  ComponentType type{ComponentType::F32};
+  uint32_t components{};  // [1, 4]
+  bool normalized{};
+  size_t stride{};        // bytes between two consecutive elements.
+};
+
+// ----------------------------------------------------------------------------
+
+/* Return true when the backend can run on this build and CPU. */
+bool IsBackendSupported(Backend backend);
+
+/* Return the fastest backend supported by the running CPU. */
+Backend BestBackend();
+
+/* Return a printable name for a backend. */
+char const* BackendName(Backend backend);
+
+/**
+ * Convert 'count' elements from 'src' to floats, following the glTF rules
+ * for normalized integers.
+ *
+ * The first min(layout.components, dst_components) components of each element
+ * are written at 'dst', advancing by 'dst_stride' bytes per element, other
+ * destination floats are left untouched.
+ *
+ * Unsupported backends fallback to the scalar one. Return false when the
+ * layout is not supported, in which case nothing is written.
+ **/
+bool DecodeFloats(
+  uint8_t const* src,
+  Layout const& layout,
+  size_t count,
+  float* dst,
+  size_t dst_stride,
+  uint32_t dst_components,
+  Backend backend = BestBackend()
+);
+
+/**
+ * Convert 'count' unsigned indices (U8, U16 or U32) to 32-bit, or to 16-bit
+ * when every value is known to fit.
+ *
+ * Return false for other component types.
+ **/
+bool DecodeIndices(
+  uint8_t const* src,
+  ComponentType type,
+  size_t stride,
+  size_t count,
+  uint32_t* dst,
+  Backend backend = BestBackend()
+);
+
+bool DecodeIndices(
+  uint8_t const* src,
+  ComponentType type,
+  size_t stride,
+  size_t count,
+  uint16_t* dst,
+  Backend backend = BestBackend()
+);
+
+} // namespace internal::accessor_decoder
+
+/* -------------------------------------------------------------------------- */
+
+#endif // AER_SCENE_PRIVATE_ACCESSOR_DECODER_H_
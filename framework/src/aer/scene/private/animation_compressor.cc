@@ -0,0 +1,509 @@
+#include "aer/scene/private/animation_compressor.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "aer/scene/animation.h"
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+using namespace internal::animation_compressor;
+using namespace internal::animation_kernels;
+
+using Channel = scene::Pose::Channel;
+using Track = scene::CompressedTracks::Track;
+using TrackType = scene::CompressedTracks::Type;
+
+// Key frames are stored as 16 bits sample indices.
+uint32_t constexpr kMaxSampleCount{ 65536u };
+
+float constexpr kUnorm16Scale{ 65535.0f };
+
+// Bound of the three smallest components of a unit quaternion, and their
+// quantization step on 15 bits (decoded as animation_kernels does).
+float constexpr kSmallestThreeRange{ 0.70710678f };
+float constexpr kSmallestThreeStep{ 2.0f * kSmallestThreeRange / 32767.0f };
+
+double constexpr kRadiansToDegrees{ 180.0 / M_PI };
+
+// Up to four components, the largest track value.
+using Value = std::array<float, 4u>;
+
+// ----------------------------------------------------------------------------
+
+constexpr uint32_t ComponentCount(TrackType const type) {
+  return (type == TrackType::Rotation) ? 4u
+       : (type == TrackType::Translation) ? 3u
+       : 1u
+       ;
+}
+
+/* First pose channel of a track, its components being consecutive channels. */
+constexpr uint32_t FirstChannel(TrackType const type) {
+  return (type == TrackType::Rotation) ? Channel::RotationX
+       : (type == TrackType::Translation) ? Channel::TranslationX
+       : Channel::Scale
+       ;
+}
+
+/* Number of quantized components per key. */
+constexpr uint32_t KeyComponentCount(TrackType const type) {
+  return (type == TrackType::Rotation) ? 3u : ComponentCount(type);
+}
+
+// ----------------------------------------------------------------------------
+
+void NormalizeQuaternion(Value& q) {
+  float const length{ std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]) };
+  if (length <= 0.0f) {
+    q = { 0.0f, 0.0f, 0.0f, 1.0f };
+    return;
+  }
+  float const inv_length{ 1.0f / length };
+  for (uint32_t c = 0u; c < 4u; ++c) {
+    q[c] *= inv_length;
+  }
+}
+
+/**
+ * Encode a unit quaternion as its three smallest components on 15 bits,
+ * the index of the largest one being stored in the top bits of the first two.
+ **/
+void EncodeRotation(Value const& q, uint16_t* dst) {
+  uint32_t largest{0u};
+  for (uint32_t c = 1u; c < 4u; ++c) {
+    if (std::abs(q[c]) > std::abs(q[largest])) {
+      largest = c;
+    }
+  }
+  // (q and -q being the same rotation, the largest component is made positive)
+  float const sign{ (q[largest] < 0.0f) ? -1.0f : 1.0f };
+
+  std::array<uint16_t, 3u> u{};
+  for (uint32_t c = 0u, k = 0u; c < 4u; ++c) {
+    if (c != largest) {
+      float const v{ (sign * q[c] + kSmallestThreeRange) / kSmallestThreeStep };
+      u[k++] = static_cast<uint16_t>(std::lround(std::clamp(v, 0.0f, 32767.0f)));
+    }
+  }
+  dst[0] = static_cast<uint16_t>(u[0] | ((largest >> 1u) << 15u));
+  dst[1] = static_cast<uint16_t>(u[1] | ((largest & 1u) << 15u));
+  dst[2] = u[2];
+}
+
+Value DecodeRotation(uint16_t const* src) {
+  uint32_t const largest{ static_cast<uint32_t>(((src[0] >> 15u) << 1u) | (src[1] >> 15u)) };
+
+  Value q{};
+  float sum{0.0f};
+  for (uint32_t c = 0u, k = 0u; c < 4u; ++c) {
+    if (c != largest) {
+      q[c] = static_cast<float>(src[k++] & 0x7FFFu) * kSmallestThreeStep - kSmallestThreeRange;
+      sum += q[c] * q[c];
+    }
+  }
+  q[largest] = std::sqrt(std::max(1.0f - sum, 0.0f));
+  return q;
+}
+
+// ----------------------------------------------------------------------------
+
+/* Encode 'n' components over their (min, step) range on 16 bits. */
+void EncodeRange(Value const& v, float const* range, uint32_t n, uint16_t* dst) {
+  for (uint32_t c = 0u; c < n; ++c) {
+    float const step{ range[n + c] };
+    float const u{ (step > 0.0f) ? (v[c] - range[c]) / step : 0.0f };
+    dst[c] = static_cast<uint16_t>(std::lround(std::clamp(u, 0.0f, kUnorm16Scale)));
+  }
+}
+
+Value DecodeRange(uint16_t const* src, float const* range, uint32_t n) {
+  Value v{};
+  for (uint32_t c = 0u; c < n; ++c) {
+    v[c] = range[c] + static_cast<float>(src[c]) * range[n + c];
+  }
+  return v;
+}
+
+// ----------------------------------------------------------------------------
+
+/* Interpolate two track values, rotations along the shortest path. */
+template<TrackType kType>
+Value Interpolate(Value const& a, Value const& b, float t) {
+  Value v{};
+  if constexpr (kType == TrackType::Rotation) {
+    float const d{ a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3] };
+    float const tb{ (d < 0.0f) ? -t : t };
+    for (uint32_t c = 0u; c < 4u; ++c) {
+      v[c] = (1.0f - t) * a[c] + tb * b[c];
+    }
+    NormalizeQuaternion(v);
+  } else {
+    for (uint32_t c = 0u; c < ComponentCount(kType); ++c) {
+      v[c] = a[c] + t * (b[c] - a[c]);
+    }
+  }
+  return v;
+}
+
+/**
+ * Distance between two track values, the angle between rotations in radians.
+ * (computed from their chord, as the acos of their dot product is too
+ * imprecise for small angles)
+ **/
+template<TrackType kType>
+float Distance(Value const& a, Value const& b) {
+  if constexpr (kType == TrackType::Rotation) {
+    double const d{
+      double(a[0]) * b[0] + double(a[1]) * b[1] + double(a[2]) * b[2] + double(a[3]) * b[3]
+    };
+    double const sign{ (d < 0.0) ? -1.0 : 1.0 };
+    double chord2{0.0};
+    for (uint32_t c = 0u; c < 4u; ++c) {
+      double const diff{ double(a[c]) - sign * double(b[c]) };
+      chord2 += diff * diff;
+    }
+    return static_cast<float>(4.0 * std::asin(std::min(0.5 * std::sqrt(chord2), 1.0)));
+  } else {
+    float distance{0.0f};
+    for (uint32_t c = 0u; c < ComponentCount(kType); ++c) {
+      distance = std::max(distance, std::abs(a[c] - b[c]));
+    }
+    return distance;
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+template<TrackType kType>
+Value DecodeKey(scene::CompressedTracks const& tracks, Track const& track, uint32_t key) {
+  uint16_t const* src{ tracks.data.data() + track.data_offset + KeyComponentCount(kType) * key };
+  if constexpr (kType == TrackType::Rotation) {
+    return DecodeRotation(src);
+  } else {
+    return DecodeRange(src, tracks.ranges.data() + track.range_offset, ComponentCount(kType));
+  }
+}
+
+/**
+ * Find the keys of an animated track surrounding the fractional sample index
+ * 'frame', return the first one and their interpolation weight in 't'.
+ **/
+uint32_t LocateKeys(scene::CompressedTracks const& tracks, Track const& track, float frame, float& t) {
+  uint16_t const* frames{ tracks.frames.data() + track.frame_offset };
+
+  // Last key at or before the frame, excluding the last key : kept keys are
+  // spread fairly evenly, so start from a proportional guess and walk to it.
+  uint32_t const sample{ static_cast<uint32_t>(frame) };
+  uint32_t const last{ track.key_count - 1u };
+  uint32_t k0{ std::min(sample * last / std::max<uint32_t>(frames[last], 1u), last - 1u) };
+  while ((k0 > 0u) && (frames[k0] > sample)) {
+    --k0;
+  }
+  while ((k0 + 1u < last) && (frames[k0 + 1u] <= sample)) {
+    ++k0;
+  }
+  float const span{ static_cast<float>(frames[k0 + 1u] - frames[k0]) };
+  t = std::clamp((frame - static_cast<float>(frames[k0])) / span, 0.0f, 1.0f);
+  return k0;
+}
+
+/* Value of an animated track at the fractional sample index 'frame'. */
+template<TrackType kType>
+Value SampleTrack(scene::CompressedTracks const& tracks, Track const& track, float frame) {
+  float t{};
+  uint32_t const k0{ LocateKeys(tracks, track, frame, t) };
+  return Interpolate<kType>(DecodeKey<kType>(tracks, track, k0), DecodeKey<kType>(tracks, track, k0 + 1u), t);
+}
+
+template<TrackType kType>
+void SampleTypedTracks(scene::CompressedTracks const& tracks, float frame, uint32_t joint_stride, float* pose) {
+  for (auto const& track : tracks.tracks[kType]) {
+    Value const v{ SampleTrack<kType>(tracks, track, frame) };
+    float* dst{ pose + FirstChannel(kType) * joint_stride + track.joint };
+    for (uint32_t c = 0u; c < ComponentCount(kType); ++c) {
+      dst[c * joint_stride] = v[c];
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+/* Per thread buffers of the rotation tracks keys, as structures of arrays. */
+struct RotationScratch {
+  std::vector<uint16_t> keys_a{};
+  std::vector<uint16_t> keys_b{};
+  std::vector<float> weights{};
+  std::vector<float> rotations{};
+};
+
+RotationScratch& GetRotationScratch() {
+  thread_local RotationScratch scratch{};
+  return scratch;
+}
+
+/**
+ * Gather the surrounding keys of every animated rotation track, then decode
+ * and interpolate them four tracks at a time.
+ **/
+void SampleRotationTracks(
+  scene::CompressedTracks const& tracks,
+  float frame,
+  uint32_t joint_stride,
+  float* pose,
+  Backend backend
+) {
+  auto const& rotation_tracks = tracks.tracks[TrackType::Rotation];
+  if (rotation_tracks.empty()) {
+    return;
+  }
+  uint32_t constexpr kKeySize{ KeyComponentCount(TrackType::Rotation) };
+  auto const track_count{ static_cast<uint32_t>(rotation_tracks.size()) };
+  uint32_t const count{ scene::Pose::JointStride(track_count) };
+
+  auto& scratch = GetRotationScratch();
+  scratch.keys_a.assign(kKeySize * count, 0u);
+  scratch.keys_b.assign(kKeySize * count, 0u);
+  scratch.weights.assign(count, 0.0f);
+  scratch.rotations.resize(4u * count);
+
+  for (uint32_t i = 0u; i < track_count; ++i) {
+    auto const& track = rotation_tracks[i];
+    uint32_t const k0{ LocateKeys(tracks, track, frame, scratch.weights[i]) };
+    uint16_t const* key{ tracks.data.data() + track.data_offset + kKeySize * k0 };
+    for (uint32_t c = 0u; c < kKeySize; ++c) {
+      scratch.keys_a[c * count + i] = key[c];
+      scratch.keys_b[c * count + i] = key[c + kKeySize];
+    }
+  }
+
+  InterpolateQuantizedRotations(
+    scratch.keys_a.data(), scratch.keys_b.data(), scratch.weights.data(), count, scratch.rotations.data(), backend
+  );
+
+  for (uint32_t i = 0u; i < track_count; ++i) {
+    float* dst{ pose + FirstChannel(TrackType::Rotation) * joint_stride + rotation_tracks[i].joint };
+    for (uint32_t c = 0u; c < 4u; ++c) {
+      dst[c * joint_stride] = scratch.rotations[c * count + i];
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+/**
+ * Compress the samples of a single joint track, either into the base pose
+ * when constant or as an animated track, and return its max error.
+ **/
+template<TrackType kType>
+float CompressTrack(
+  uint32_t const joint,
+  std::vector<Value> const& samples,
+  float const tolerance,
+  uint32_t const joint_stride,
+  scene::CompressedTracks& tracks,
+  Report& report
+) {
+  uint32_t constexpr n{ ComponentCount(kType) };
+  uint32_t const sample_count{ static_cast<uint32_t>(samples.size()) };
+
+  bool const constant{
+    std::all_of(samples.begin(), samples.end(), [&](Value const& v) {
+      return Distance<kType>(samples[0u], v) <= tolerance;
+    })
+  };
+  if (constant || (sample_count < 2u)) {
+    float* dst{ tracks.base_pose.data() + FirstChannel(kType) * joint_stride + joint };
+    for (uint32_t c = 0u; c < n; ++c) {
+      dst[c * joint_stride] = samples[0u][c];
+    }
+    report.constant_tracks += 1u;
+
+    float max_error{0.0f};
+    for (auto const& v : samples) {
+      max_error = std::max(max_error, Distance<kType>(samples[0u], v));
+    }
+    return max_error;
+  }
+
+  Track track{
+    .joint = joint,
+    .range_offset = static_cast<uint32_t>(tracks.ranges.size()),
+  };
+
+  // Quantization range, as (min, step) per component.
+  if constexpr (kType != TrackType::Rotation) {
+    Value lo{ samples[0u] };
+    Value hi{ samples[0u] };
+    for (auto const& v : samples) {
+      for (uint32_t c = 0u; c < n; ++c) {
+        lo[c] = std::min(lo[c], v[c]);
+        hi[c] = std::max(hi[c], v[c]);
+      }
+    }
+    tracks.ranges.insert(tracks.ranges.end(), lo.begin(), lo.begin() + n);
+    for (uint32_t c = 0u; c < n; ++c) {
+      tracks.ranges.push_back((hi[c] - lo[c]) / kUnorm16Scale);
+    }
+  }
+
+  // Quantize every sample, then keep the keys needed to interpolate the
+  // others within tolerance, growing each segment while it fits.
+  uint32_t constexpr key_size{ KeyComponentCount(kType) };
+  std::vector<uint16_t> encoded(key_size * sample_count);
+  std::vector<Value> decoded(sample_count);
+  for (uint32_t s = 0u; s < sample_count; ++s) {
+    uint16_t* key{ encoded.data() + key_size * s };
+    if constexpr (kType == TrackType::Rotation) {
+      EncodeRotation(samples[s], key);
+      decoded[s] = DecodeRotation(key);
+    } else {
+      float const* range{ tracks.ranges.data() + track.range_offset };
+      EncodeRange(samples[s], range, n, key);
+      decoded[s] = DecodeRange(key, range, n);
+    }
+  }
+
+  // (interpolated as SampleTrack does)
+  auto segment_fits{[&](uint32_t first, uint32_t last) {
+    float const span{ static_cast<float>(last - first) };
+    for (uint32_t s = first + 1u; s < last; ++s) {
+      Value const v{ Interpolate<kType>(decoded[first], decoded[last], static_cast<float>(s - first) / span) };
+      if (Distance<kType>(v, samples[s]) > tolerance) {
+        return false;
+      }
+    }
+    return true;
+  }};
+
+  std::vector<uint32_t> keys{ 0u };
+  for (uint32_t first = 0u; first + 1u < sample_count;) {
+    uint32_t last{ first + 1u };
+    while ((last + 1u < sample_count) && segment_fits(first, last + 1u)) {
+      ++last;
+    }
+    keys.push_back(last);
+    first = last;
+  }
+
+  track.key_count = static_cast<uint32_t>(keys.size());
+  track.frame_offset = static_cast<uint32_t>(tracks.frames.size());
+  track.data_offset = static_cast<uint32_t>(tracks.data.size());
+  for (auto const key : keys) {
+    tracks.frames.push_back(static_cast<uint16_t>(key));
+    auto const src{ encoded.begin() + key_size * key };
+    tracks.data.insert(tracks.data.end(), src, src + key_size);
+  }
+  tracks.tracks[kType].push_back(track);
+
+  report.animated_tracks += 1u;
+  report.raw_keys += sample_count;
+  report.kept_keys += track.key_count;
+
+  // Measure the error as sampled at runtime.
+  float max_error{0.0f};
+  for (uint32_t s = 0u; s < sample_count; ++s) {
+    Value const v{ SampleTrack<kType>(tracks, track, static_cast<float>(s)) };
+    max_error = std::max(max_error, Distance<kType>(v, samples[s]));
+  }
+  return max_error;
+}
+
+/* Gather the samples of a joint track from the clip channels. */
+template<TrackType kType>
+void GatherTrack(scene::AnimationClip const& clip, uint32_t const joint, std::vector<Value>& samples) {
+  samples.resize(clip.sample_count);
+  for (uint32_t s = 0u; s < clip.sample_count; ++s) {
+    float const* src{ clip.sample(s) + FirstChannel(kType) * clip.joint_stride + joint };
+    for (uint32_t c = 0u; c < ComponentCount(kType); ++c) {
+      samples[s][c] = src[c * clip.joint_stride];
+    }
+    if constexpr (kType == TrackType::Rotation) {
+      NormalizeQuaternion(samples[s]);
+    }
+  }
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+namespace internal::animation_compressor {
+
+bool CompressClip(
+  scene::AnimationClip& clip,
+  Settings const& settings,
+  Report* report,
+  bool const keep_samples
+) {
+  if (clip.is_compressed() || clip.samples.empty() || (clip.sample_count > kMaxSampleCount)) {
+    return false;
+  }
+
+  Report r{
+    .joint_count = clip.joint_count,
+    .sample_count = clip.sample_count,
+    .raw_bytes = clip.samples.size() * sizeof(float),
+  };
+
+  // The base pose starts as the first sample, keeping the padding lanes.
+  auto& tracks = clip.compressed;
+  tracks.base_pose.assign(clip.sample(0u), clip.sample(0u) + scene::Pose::kChannelCount * clip.joint_stride);
+
+  std::vector<Value> samples{};
+  for (uint32_t j = 0u; j < clip.joint_count; ++j) {
+    GatherTrack<TrackType::Rotation>(clip, j, samples);
+    float const rotation_error{ CompressTrack<TrackType::Rotation>(
+      j, samples, settings.rotation_tolerance, clip.joint_stride, tracks, r
+    ) };
+    r.max_rotation_error = std::max(r.max_rotation_error, static_cast<float>(rotation_error * kRadiansToDegrees));
+
+    GatherTrack<TrackType::Translation>(clip, j, samples);
+    r.max_translation_error = std::max(r.max_translation_error, CompressTrack<TrackType::Translation>(
+      j, samples, settings.translation_tolerance, clip.joint_stride, tracks, r
+    ));
+
+    GatherTrack<TrackType::Scale>(clip, j, samples);
+    r.max_scale_error = std::max(r.max_scale_error, CompressTrack<TrackType::Scale>(
+      j, samples, settings.scale_tolerance, clip.joint_stride, tracks, r
+    ));
+  }
+  for (auto& typed_tracks : tracks.tracks) {
+    typed_tracks.shrink_to_fit();
+  }
+  tracks.frames.shrink_to_fit();
+  tracks.data.shrink_to_fit();
+  tracks.ranges.shrink_to_fit();
+  r.compressed_bytes = tracks.bytesize();
+
+  if (!keep_samples) {
+    clip.samples.clear();
+    clip.samples.shrink_to_fit();
+  }
+  if (report) {
+    *report = r;
+  }
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+void SampleTracks(
+  scene::CompressedTracks const& tracks,
+  float const frame,
+  uint32_t const joint_stride,
+  float* pose,
+  Backend const backend
+) {
+  std::copy(tracks.base_pose.begin(), tracks.base_pose.end(), pose);
+  SampleRotationTracks(tracks, frame, joint_stride, pose, backend);
+  SampleTypedTracks<TrackType::Translation>(tracks, frame, joint_stride, pose);
+  SampleTypedTracks<TrackType::Scale>(tracks, frame, joint_stride, pose);
+}
+
+} // namespace internal::animation_compressor
+
+/* -------------------------------------------------------------------------- */
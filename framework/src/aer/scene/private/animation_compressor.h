@@ -0,0 +1,88 @@
+#ifndef AER_SCENE_PRIVATE_ANIMATION_COMPRESSOR_H_
+#define AER_SCENE_PRIVATE_ANIMATION_COMPRESSOR_H_
+
+/* -------------------------------------------------------------------------- */
+//
+//    animation_compressor.h
+//
+//  Compression of uniformly resampled clips into scene::CompressedTracks,
+//  one rotation, translation and scale track per joint :
+//
+//    * tracks within tolerance of their first sample are baked in a base pose,
+//    * rotations are quantized as smallest-three (2 bits index + 3 x 15 bits),
+//    * translations and scales are quantized to 16 bits over their range,
+//    * keys linearly interpolated within tolerance from their neighbours,
+//      once quantized, are removed.
+//
+//  Every sample is decoded back to measure the error introduced.
+//
+/* -------------------------------------------------------------------------- */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "aer/scene/private/animation_kernels.h"
+
+namespace scene {
+struct AnimationClip;
+struct CompressedTracks;
+}
+
+namespace internal::animation_compressor {
+
+struct Settings {
+  float rotation_tolerance{ 1.0e-3f };    // in radians.
+  float translation_tolerance{ 1.0e-4f }; // in joint space units.
+  float scale_tolerance{ 1.0e-4f };
+};
+
+/* Size and precision of a compressed clip. */
+struct Report {
+  uint32_t joint_count{};
+  uint32_t sample_count{};
+  uint32_t constant_tracks{};
+  uint32_t animated_tracks{};
+  uint64_t raw_keys{};            // samples of the animated tracks.
+  uint64_t kept_keys{};
+  uint64_t raw_bytes{};
+  uint64_t compressed_bytes{};
+  float max_rotation_error{};     // in degrees.
+  float max_translation_error{};
+  float max_scale_error{};
+};
+
+// ----------------------------------------------------------------------------
+
+/**
+ * Compress the samples of 'clip' into its compressed tracks, then release
+ * them unless 'keep_samples' is set.
+ *
+ * Return false when the clip is already compressed, or has too many samples
+ * to be indexed by 16 bits, in which case it is left as is.
+ **/
+bool CompressClip(
+  scene::AnimationClip& clip,
+  Settings const& settings = {},
+  Report* report = nullptr,
+  bool keep_samples = false
+);
+
+/**
+ * Sample the compressed tracks at the fractional sample index 'frame' into
+ * 'pose', holding Pose::kChannelCount channels of 'joint_stride' floats :
+ * the base pose is copied then the animated tracks are interpolated, the
+ * rotations by 'backend'.
+ **/
+void SampleTracks(
+  scene::CompressedTracks const& tracks,
+  float frame,
+  uint32_t joint_stride,
+  float* pose,
+  animation_kernels::Backend backend = animation_kernels::BestBackend()
+);
+
+} // namespace internal::animation_compressor
+
+/* -------------------------------------------------------------------------- */
+
+#endif // AER_SCENE_PRIVATE_ANIMATION_COMPRESSOR_H_
@@ -0,0 +1,777 @@
+#include "aer/scene/private/animation_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define AER_ANIMATION_SSE 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define AER_ANIMATION_NEON 1
+#include <arm_neon.h>
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+using namespace internal::animation_kernels;
+
+// Channels of a pose, as laid out by scene::Pose.
+uint32_t constexpr kRotationChannels{ 4u };
+uint32_t constexpr kChannelCount{ 8u };
+
+// Past this cosine slerp uses the nlerp weights, its sine vanishing.
+float constexpr kSlerpThreshold{ 0.9995f };
+
+// Smallest-three quantized rotations, components on 15 bits within +/- 1/sqrt(2).
+float constexpr kSmallestThreeRange{ 0.70710678f };
+float constexpr kSmallestThreeStep{ 2.0f * kSmallestThreeRange / 32767.0f };
+
+/* Weights of the rotations a and b, 'cos_angle' being their positive dot product. */
+void RotationWeights(
+  float const cos_angle,
+  float const t,
+  Interpolation const interpolation,
+  float& wa,
+  float& wb
+) {
+  if ((interpolation == Interpolation::NLerp) || (cos_angle > kSlerpThreshold)) {
+    wa = 1.0f - t;
+    wb = t;
+    return;
+  }
+  float const angle = std::acos(cos_angle);
+  float const inv_sin = 1.0f / std::sin(angle);
+  wa = std::sin((1.0f - t) * angle) * inv_sin;
+  wb = std::sin(t * angle) * inv_sin;
+}
+
+// ----------------------------------------------------------------------------
+
+/* Interpolate the rotations of joints [first, joint_stride). */
+void InterpolateRotationsScalar(
+  float const* a,
+  float const* b,
+  float const t,
+  uint32_t const joint_stride,
+  uint32_t const first,
+  float* dst,
+  Interpolation const interpolation
+) {
+  float const* ax = a;
+  float const* ay = a + joint_stride;
+  float const* az = a + 2u * joint_stride;
+  float const* aw = a + 3u * joint_stride;
+  float const* bx = b;
+  float const* by = b + joint_stride;
+  float const* bz = b + 2u * joint_stride;
+  float const* bw = b + 3u * joint_stride;
+
+  for (uint32_t j = first; j < joint_stride; ++j) {
+    float const dot = ax[j] * bx[j] + ay[j] * by[j] + az[j] * bz[j] + aw[j] * bw[j];
+    float wa, wb;
+    RotationWeights(std::abs(dot), t, interpolation, wa, wb);
+    wb = (dot < 0.0f) ? -wb : wb;
+
+    float const qx = wa * ax[j] + wb * bx[j];
+    float const qy = wa * ay[j] + wb * by[j];
+    float const qz = wa * az[j] + wb * bz[j];
+    float const qw = wa * aw[j] + wb * bw[j];
+    float const inv_length = 1.0f / std::sqrt(qx * qx + qy * qy + qz * qz + qw * qw);
+    dst[j]                     = qx * inv_length;
+    dst[j + joint_stride]      = qy * inv_length;
+    dst[j + 2u * joint_stride] = qz * inv_length;
+    dst[j + 3u * joint_stride] = qw * inv_length;
+  }
+}
+
+void AccumulateRotationsScalar(
+  float const* src,
+  float const weight,
+  uint32_t const joint_stride,
+  uint32_t const first,
+  float* dst
+) {
+  for (uint32_t j = first; j < joint_stride; ++j) {
+    float const dot = dst[j] * src[j]
+                    + dst[j + joint_stride] * src[j + joint_stride]
+                    + dst[j + 2u * joint_stride] * src[j + 2u * joint_stride]
+                    + dst[j + 3u * joint_stride] * src[j + 3u * joint_stride]
+                    ;
+    float const w = (dot < 0.0f) ? -weight : weight;
+    for (uint32_t c = 0u; c < kRotationChannels; ++c) {
+      dst[j + c * joint_stride] += w * src[j + c * joint_stride];
+    }
+  }
+}
+
+void NormalizeRotationsScalar(float* pose, uint32_t const joint_stride, uint32_t const first) {
+  for (uint32_t j = first; j < joint_stride; ++j) {
+    float const* q = pose + j;
+    float const length_squared = q[0] * q[0]
+                               + q[joint_stride] * q[joint_stride]
+                               + q[2u * joint_stride] * q[2u * joint_stride]
+                               + q[3u * joint_stride] * q[3u * joint_stride]
+                               ;
+    float const inv_length = 1.0f / std::sqrt(length_squared);
+    for (uint32_t c = 0u; c < kRotationChannels; ++c) {
+      pose[j + c * joint_stride] *= inv_length;
+    }
+  }
+}
+
+/* Decode the quantized rotation 'i' of three arrays of 'count' components. */
+void DecodeSmallestThree(uint16_t const* src, uint32_t const count, uint32_t const i, float q[4]) {
+  uint32_t const u0 = src[i];
+  uint32_t const u1 = src[i + count];
+  uint32_t const u2 = src[i + 2u * count];
+  uint32_t const largest = ((u0 >> 15u) << 1u) | (u1 >> 15u);
+
+  float const s0 = static_cast<float>(u0 & 0x7FFFu) * kSmallestThreeStep - kSmallestThreeRange;
+  float const s1 = static_cast<float>(u1 & 0x7FFFu) * kSmallestThreeStep - kSmallestThreeRange;
+  float const s2 = static_cast<float>(u2 & 0x7FFFu) * kSmallestThreeStep - kSmallestThreeRange;
+  float const l = std::sqrt(std::max(1.0f - (s0 * s0 + s1 * s1 + s2 * s2), 0.0f));
+
+  q[0] = (largest == 0u) ? l : s0;
+  q[1] = (largest == 0u) ? s0 : (largest == 1u) ? l : s1;
+  q[2] = (largest <= 1u) ? s1 : (largest == 2u) ? l : s2;
+  q[3] = (largest == 3u) ? l : s2;
+}
+
+void InterpolateQuantizedRotationsScalar(
+  uint16_t const* a,
+  uint16_t const* b,
+  float const* t,
+  uint32_t const count,
+  uint32_t const first,
+  float* dst
+) {
+  for (uint32_t i = first; i < count; ++i) {
+    float qa[4], qb[4];
+    DecodeSmallestThree(a, count, i, qa);
+    DecodeSmallestThree(b, count, i, qb);
+
+    float const dot = qa[0] * qb[0] + qa[1] * qb[1] + qa[2] * qb[2] + qa[3] * qb[3];
+    float const wa = 1.0f - t[i];
+    float const wb = (dot < 0.0f) ? -t[i] : t[i];
+
+    float q[4];
+    for (uint32_t c = 0u; c < kRotationChannels; ++c) {
+      q[c] = wa * qa[c] + wb * qb[c];
+    }
+    float const inv_length = 1.0f / std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    for (uint32_t c = 0u; c < kRotationChannels; ++c) {
+      dst[i + c * count] = q[c] * inv_length;
+    }
+  }
+}
+
+/* Translations and scales, interpolated or accumulated over [first, count). */
+void LerpScalar(float const* a, float const* b, float const t, uint32_t first, uint32_t count, float* dst) {
+  for (uint32_t i = first; i < count; ++i) {
+    dst[i] = a[i] + t * (b[i] - a[i]);
+  }
+}
+
+void AccumulateScalar(float const* src, float const weight, uint32_t first, uint32_t count, float* dst) {
+  for (uint32_t i = first; i < count; ++i) {
+    dst[i] += weight * src[i];
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+#if defined(AER_ANIMATION_SSE)
+
+/* Process 4 joints at a time, return the first one left to process. */
+uint32_t InterpolateRotationsSSE(
+  float const* a,
+  float const* b,
+  float const t,
+  uint32_t const joint_stride,
+  float* dst,
+  Interpolation const interpolation
+) {
+  __m128 const sign_mask = _mm_set1_ps(-0.0f);
+  __m128 const one = _mm_set1_ps(1.0f);
+  __m128 const nlerp_wa = _mm_set1_ps(1.0f - t);
+  __m128 const nlerp_wb = _mm_set1_ps(t);
+
+  uint32_t j = 0u;
+  for (; j + 4u <= joint_stride; j += 4u) {
+    __m128 av[4], bv[4];
+    for (uint32_t c = 0u; c < kRotationChannels; ++c) {
+      av[c] = _mm_loadu_ps(a + c * joint_stride + j);
+      bv[c] = _mm_loadu_ps(b + c * joint_stride + j);
+    }
+    __m128 dot = _mm_mul_ps(av[0], bv[0]);
+    dot = _mm_add_ps(dot, _mm_mul_ps(av[1], bv[1]));
+    dot = _mm_add_ps(dot, _mm_mul_ps(av[2], bv[2]));
+    dot = _mm_add_ps(dot, _mm_mul_ps(av[3], bv[3]));
+    __m128 const sign = _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), sign_mask);
+
+    __m128 wa = nlerp_wa;
+    __m128 wb = nlerp_wb;
+    if (interpolation == Interpolation::SLerp) {
+      alignas(16) float cos_angles[4u];
+      alignas(16) float was[4u];
+      alignas(16) float wbs[4u];
+      _mm_store_ps(cos_angles, _mm_andnot_ps(sign_mask, dot));
+      for (uint32_t k = 0u; k < 4u; ++k) {
+        RotationWeights(cos_angles[k], t, interpolation, was[k], wbs[k]);
+      }
+      wa = _mm_load_ps(was);
+      wb = _mm_load_ps(wbs);
+    }
+    wb = _mm_xor_ps(wb, sign);
+
+    __m128 q[4];
+    for (uint32_t c = 0u; c < kRotationChannels; ++c) {
+      q[c] = _mm_add_ps(_mm_mul_ps(wa, av[c]), _mm_mul_ps(wb, bv[c]));
+    }
+    __m128 length_squared = _mm_mul_ps(q[0], q[0]);
+    length_squared = _mm_add_ps(length_squared, _mm_mul_ps(q[1], q[1]));
+    length_squared = _mm_add_ps(length_squared, _mm_mul_ps(q[2], q[2]));
+    length_squared = _mm_add_ps(length_squared, _mm_mul_ps(q[3], q[3]));
+    __m128 const inv_length = _mm_div_ps(one, _mm_sqrt_ps(length_squared));
+
+    for (uint32_t c = 0u; c < kRotationChannels; ++c) {
+      _mm_storeu_ps(dst + c * joint_stride + j, _mm_mul_ps(q[c], inv_length));
+    }
+  }
+  return j;
+}
+
+uint32_t AccumulateRotationsSSE(float const* src, float const weight, uint32_t const joint_stride, float* dst) {
+  __m128 const sign_mask = _mm_set1_ps(-0.0f);
+  __m128 const w = _mm_set1_ps(weight);
+
+  uint32_t j = 0u;
+  for (; j + 4u <= joint_stride; j += 4u) {
+    __m128 sv[4], dv[4];
+    for (uint32_t c = 0u; c < kRotationChannels; ++c) {
+      sv[c] = _mm_loadu_ps(src + c * joint_stride + j);
+      dv[c] = _mm_loadu_ps(dst + c * joint_stride + j);
+    }
+    __m128 dot = _mm_mul_ps(dv[0], sv[0]);
+    dot = _mm_add_ps(dot, _mm_mul_ps(dv[1], sv[1]));
+    dot = _mm_add_ps(dot, _mm_mul_ps(dv[2], sv[2]));
+    dot = _mm_add_ps(dot, _mm_mul_ps(dv[3], sv[3]));
+    __m128 const signed_w = _mm_xor_ps(w, _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), sign_mask));
+
+    for (uint32_t c = 0u; c < kRotationChannels; ++c) {
+      _mm_storeu_ps(dst + c * joint_stride + j, _mm_add_ps(dv[c], _mm_mul_ps(signed_w, sv[c])));
+    }
+  }
+  return j;
+}
+
+uint32_t NormalizeRotationsSSE(float* pose, uint32_t const joint_stride) {
+  __m128 const one = _mm_set1_ps(1.0f);
+
+  uint32_t j = 0u;
+  for (; j + 4u <= joint_stride; j += 4u) {
+    __m128 q[4];
+    for (uint32_t c = 0u; c < kRotationChannels; ++c) {
+      q[c] = _mm_loadu_ps(pose + c * joint_stride + j);
+    }
+    __m128 length_squared = _mm_mul_ps(q[0], q[0]);
+    length_squared = _mm_add_ps(length_squared, _mm_mul_ps(q[1], q[1]));
+    length_squared = _mm_add_ps(length_squared, _mm_mul_ps(q[2], q[2]));
+    length_squared = _mm_add_ps(length_squared, _mm_mul_ps(q[3], q[3]));
+    __m128 const inv_length = _mm_div_ps(one, _mm_sqrt_ps(length_squared));
+
+    for (uint32_t c = 0u; c < kRotationChannels; ++c) {
+      _mm_storeu_ps(pose + c * joint_stride + j, _mm_mul_ps(q[c], inv_length));
+    }
+  }
+  return j;
+}
+
+void DecodeSmallestThreeSSE(uint16_t const* src, uint32_t const count, uint32_t const i, __m128 q[4]) {
+  __m128i const zero = _mm_setzero_si128();
+  __m128i const low_bits = _mm_set1_epi32(0x7FFF);
+  __m128 const one = _mm_set1_ps(1.0f);
+  __m128 const step = _mm_set1_ps(kSmallestThreeStep);
+  __m128 const range = _mm_set1_ps(kSmallestThreeRange);
+
+  __m128i u[3];
+  __m128 s[3];
+  for (uint32_t k = 0u; k < 3u; ++k) {
+    u[k] = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(src + k * count + i)), zero);
+    s[k] = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(u[k], low_bits)), step), range);
+  }
+  __m128i const largest = _mm_or_si128(
+    _mm_slli_epi32(_mm_srli_epi32(u[0], 15), 1),
+    _mm_srli_epi32(u[1], 15)
+  );
+
+  __m128 sum = _mm_mul_ps(s[0], s[0]);
+  sum = _mm_add_ps(sum, _mm_mul_ps(s[1], s[1]));
+  sum = _mm_add_ps(sum, _mm_mul_ps(s[2], s[2]));
+  __m128 const l = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(one, sum), _mm_setzero_ps()));
+
+  auto select{[](__m128 mask, __m128 x, __m128 y) {
+    return _mm_or_ps(_mm_and_ps(mask, x), _mm_andnot_ps(mask, y));
+  }};
+  __m128 const is0 = _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_set1_epi32(0)));
+  __m128 const is1 = _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_set1_epi32(1)));
+  __m128 const is2 = _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_set1_epi32(2)));
+  __m128 const is3 = _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_set1_epi32(3)));
+  q[0] = select(is0, l, s[0]);
+  q[1] = select(is0, s[0], select(is1, l, s[1]));
+  q[2] = select(_mm_or_ps(is0, is1), s[1], select(is2, l, s[2]));
+  q[3] = select(is3, l, s[2]);
+}
+
+uint32_t InterpolateQuantizedRotationsSSE(
+  uint16_t const* a,
+  uint16_t const* b,
+  float const* t,
+  uint32_t const count,
+  float* dst
+) {
+  __m128 const sign_mask = _mm_set1_ps(-0.0f);
+  __m128 const one = _mm_set1_ps(1.0f);
+
+  uint32_t i = 0u;
+  for (; i + 4u <= count; i += 4u) {
+    __m128 qa[4], qb[4];
+    DecodeSmallestThreeSSE(a, count, i, qa);
+    DecodeSmallestThreeSSE(b, count, i, qb);
+
+    __m128 dot = _mm_mul_ps(qa[0], qb[0]);
+    dot = _mm_add_ps(dot, _mm_mul_ps(qa[1], qb[1]));
+    dot = _mm_add_ps(dot, _mm_mul_ps(qa[2], qb[2]));
+    dot = _mm_add_ps(dot, _mm_mul_ps(qa[3], qb[3]));
+
+    __m128 const tv = _mm_loadu_ps(t + i);
+    __m128 const wa = _mm_sub_ps(one, tv);
+    __m128 const wb = _mm_xor_ps(tv, _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), sign_mask));
+
+    __m128 q[4];
+    for (uint32_t c = 0u; c < kRotationChannels; ++c) {
+      q[c] = _mm_add_ps(_mm_mul_ps(wa, qa[c]), _mm_mul_ps(wb, qb[c]));
+    }
+    __m128 length_squared = _mm_mul_ps(q[0], q[0]);
+    length_squared = _mm_add_ps(length_squared, _mm_mul_ps(q[1], q[1]));
+    length_squared = _mm_add_ps(length_squared, _mm_mul_ps(q[2], q[2]));
+    length_squared = _mm_add_ps(length_squared, _mm_mul_ps(q[3], q[3]));
+    __m128 const inv_length = _mm_div_ps(one, _mm_sqrt_ps(length_squared));
+
+    for (uint32_t c = 0u; c < kRotationChannels; ++c) {
+      _mm_storeu_ps(dst + c * count + i, _mm_mul_ps(q[c], inv_length));
+    }
+  }
+  return i;
+}
+
+uint32_t LerpSSE(float const* a, float const* b, float const t, uint32_t const count, float* dst) {
+  __m128 const tv = _mm_set1_ps(t);
+
+  uint32_t i = 0u;
+  for (; i + 4u <= count; i += 4u) {
+    __m128 const av = _mm_loadu_ps(a + i);
+    __m128 const bv = _mm_loadu_ps(b + i);
+    _mm_storeu_ps(dst + i, _mm_add_ps(av, _mm_mul_ps(tv, _mm_sub_ps(bv, av))));
+  }
+  return i;
+}
+
+uint32_t AccumulateSSE(float const* src, float const weight, uint32_t const count, float* dst) {
+  __m128 const w = _mm_set1_ps(weight);
+
+  uint32_t i = 0u;
+  for (; i + 4u <= count; i += 4u) {
+    _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(w, _mm_loadu_ps(src + i))));
+  }
+  return i;
+}
+
+#endif
+
+// ----------------------------------------------------------------------------
+
+#if defined(AER_ANIMATION_NEON)
+
+/* Process 4 joints at a time, return the first one left to process. */
+uint32_t InterpolateRotationsNEON(
+  float const* a,
+  float const* b,
+  float const t,
+  uint32_t const joint_stride,
+  float* dst,
+  Interpolation const interpolation
+) {
+  uint32x4_t const sign_mask = vdupq_n_u32(0x80000000u);
+  float32x4_t const one = vdupq_n_f32(1.0f);
+  float32x4_t const nlerp_wa = vdupq_n_f32(1.0f - t);
+  float32x4_t const nlerp_wb = vdupq_n_f32(t);
+
+  uint32_t j = 0u;
+  for (; j + 4u <= joint_stride; j += 4u) {
+    float32x4_t av[4], bv[4];
+    for (uint32_t c = 0u; c < kRotationChannels; ++c) {
+      av[c] = vld1q_f32(a + c * joint_stride + j);
+      bv[c] = vld1q_f32(b + c * joint_stride + j);
+    }
+    // (separate multiplies and adds, to match the scalar results)
+    float32x4_t dot = vmulq_f32(av[0], bv[0]);
+    dot = vaddq_f32(dot, vmulq_f32(av[1], bv[1]));
+    dot = vaddq_f32(dot, vmulq_f32(av[2], bv[2]));
+    dot = vaddq_f32(dot, vmulq_f32(av[3], bv[3]));
+    uint32x4_t const sign = vandq_u32(vcltq_f32(dot, vdupq_n_f32(0.0f)), sign_mask);
+
+    float32x4_t wa = nlerp_wa;
+    float32x4_t wb = nlerp_wb;
+    if (interpolation == Interpolation::SLerp) {
+      float cos_angles[4u];
+      float was[4u];
+      float wbs[4u];
+      vst1q_f32(cos_angles, vabsq_f32(dot));
+      for (uint32_t k = 0u; k < 4u; ++k) {
+        RotationWeights(cos_angles[k], t, interpolation, was[k], wbs[k]);
+      }
+      wa = vld1q_f32(was);
+      wb = vld1q_f32(wbs);
+    }
+    wb = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(wb), sign));
+
+    float32x4_t q[4];
+    for (uint32_t c = 0u; c < kRotationChannels; ++c) {
+      q[c] = vaddq_f32(vmulq_f32(wa, av[c]), vmulq_f32(wb, bv[c]));
+    }
+    float32x4_t length_squared = vmulq_f32(q[0], q[0]);
+    length_squared = vaddq_f32(length_squared, vmulq_f32(q[1], q[1]));
+    length_squared = vaddq_f32(length_squared, vmulq_f32(q[2], q[2]));
+    length_squared = vaddq_f32(length_squared, vmulq_f32(q[3], q[3]));
+    float32x4_t const inv_length = vdivq_f32(one, vsqrtq_f32(length_squared));
+
+    for (uint32_t c = 0u; c < kRotationChannels; ++c) {
+      vst1q_f32(dst + c * joint_stride + j, vmulq_f32(q[c], inv_length));
+    }
+  }
+  return j;
+}
+
+uint32_t AccumulateRotationsNEON(float const* src, float const weight, uint32_t const joint_stride, float* dst) {
+  uint32x4_t const sign_mask = vdupq_n_u32(0x80000000u);
+  uint32x4_t const w = vreinterpretq_u32_f32(vdupq_n_f32(weight));
+
+  uint32_t j = 0u;
+  for (; j + 4u <= joint_stride; j += 4u) {
+    float32x4_t sv[4], dv[4];
+    for (uint32_t c = 0u; c < kRotationChannels; ++c) {
+      sv[c] = vld1q_f32(src + c * joint_stride + j);
+      dv[c] = vld1q_f32(dst + c * joint_stride + j);
+    }
+    float32x4_t dot = vmulq_f32(dv[0], sv[0]);
+    dot = vaddq_f32(dot, vmulq_f32(dv[1], sv[1]));
+    dot = vaddq_f32(dot, vmulq_f32(dv[2], sv[2]));
+    dot = vaddq_f32(dot, vmulq_f32(dv[3], sv[3]));
+    float32x4_t const signed_w = vreinterpretq_f32_u32(
+      veorq_u32(w, vandq_u32(vcltq_f32(dot, vdupq_n_f32(0.0f)), sign_mask))
+    );
+
+    for (uint32_t c = 0u; c < kRotationChannels; ++c) {
+      vst1q_f32(dst + c * joint_stride + j, vaddq_f32(dv[c], vmulq_f32(signed_w, sv[c])));
+    }
+  }
+  return j;
+}
+
+uint32_t NormalizeRotationsNEON(float* pose, uint32_t const joint_stride) {
+  float32x4_t const one = vdupq_n_f32(1.0f);
+
+  uint32_t j = 0u;
+  for (; j + 4u <= joint_stride; j += 4u) {
+    float32x4_t q[4];
+    for (uint32_t c = 0u; c < kRotationChannels; ++c) {
+      q[c] = vld1q_f32(pose + c * joint_stride + j);
+    }
+    float32x4_t length_squared = vmulq_f32(q[0], q[0]);
+    length_squared = vaddq_f32(length_squared, vmulq_f32(q[1], q[1]));
+    length_squared = vaddq_f32(length_squared, vmulq_f32(q[2], q[2]));
+    length_squared = vaddq_f32(length_squared, vmulq_f32(q[3], q[3]));
+    float32x4_t const inv_length = vdivq_f32(one, vsqrtq_f32(length_squared));
+
+    for (uint32_t c = 0u; c < kRotationChannels; ++c) {
+      vst1q_f32(pose + c * joint_stride + j, vmulq_f32(q[c], inv_length));
+    }
+  }
+  return j;
+}
+
+void DecodeSmallestThreeNEON(uint16_t const* src, uint32_t const count, uint32_t const i, float32x4_t q[4]) {
+  uint32x4_t const low_bits = vdupq_n_u32(0x7FFFu);
+  float32x4_t const one = vdupq_n_f32(1.0f);
+  float32x4_t const step = vdupq_n_f32(kSmallestThreeStep);
+  float32x4_t const range = vdupq_n_f32(kSmallestThreeRange);
+
+  uint32x4_t u[3];
+  float32x4_t s[3];
+  for (uint32_t k = 0u; k < 3u; ++k) {
+    u[k] = vmovl_u16(vld1_u16(src + k * count + i));
+    s[k] = vsubq_f32(vmulq_f32(vcvtq_f32_u32(vandq_u32(u[k], low_bits)), step), range);
+  }
+  uint32x4_t const largest = vorrq_u32(vshlq_n_u32(vshrq_n_u32(u[0], 15), 1), vshrq_n_u32(u[1], 15));
+
+  float32x4_t sum = vmulq_f32(s[0], s[0]);
+  sum = vaddq_f32(sum, vmulq_f32(s[1], s[1]));
+  sum = vaddq_f32(sum, vmulq_f32(s[2], s[2]));
+  float32x4_t const l = vsqrtq_f32(vmaxq_f32(vsubq_f32(one, sum), vdupq_n_f32(0.0f)));
+
+  uint32x4_t const is0 = vceqq_u32(largest, vdupq_n_u32(0u));
+  uint32x4_t const is1 = vceqq_u32(largest, vdupq_n_u32(1u));
+  uint32x4_t const is2 = vceqq_u32(largest, vdupq_n_u32(2u));
+  uint32x4_t const is3 = vceqq_u32(largest, vdupq_n_u32(3u));
+  q[0] = vbslq_f32(is0, l, s[0]);
+  q[1] = vbslq_f32(is0, s[0], vbslq_f32(is1, l, s[1]));
+  q[2] = vbslq_f32(vorrq_u32(is0, is1), s[1], vbslq_f32(is2, l, s[2]));
+  q[3] = vbslq_f32(is3, l, s[2]);
+}
+
+uint32_t InterpolateQuantizedRotationsNEON(
+  uint16_t const* a,
+  uint16_t const* b,
+  float const* t,
+  uint32_t const count,
+  float* dst
+) {
+  uint32x4_t const sign_mask = vdupq_n_u32(0x80000000u);
+  float32x4_t const one = vdupq_n_f32(1.0f);
+
+  uint32_t i = 0u;
+  for (; i + 4u <= count; i += 4u) {
+    float32x4_t qa[4], qb[4];
+    DecodeSmallestThreeNEON(a, count, i, qa);
+    DecodeSmallestThreeNEON(b, count, i, qb);
+
+    float32x4_t dot = vmulq_f32(qa[0], qb[0]);
+    dot = vaddq_f32(dot, vmulq_f32(qa[1], qb[1]));
+    dot = vaddq_f32(dot, vmulq_f32(qa[2], qb[2]));
+    dot = vaddq_f32(dot, vmulq_f32(qa[3], qb[3]));
+
+    float32x4_t const tv = vld1q_f32(t + i);
+    float32x4_t const wa = vsubq_f32(one, tv);
+    float32x4_t const wb = vreinterpretq_f32_u32(
+      veorq_u32(vreinterpretq_u32_f32(tv), vandq_u32(vcltq_f32(dot, vdupq_n_f32(0.0f)), sign_mask))
+    );
+
+    float32x4_t q[4];
+    for (uint32_t c = 0u; c < kRotationChannels; ++c) {
+      q[c] = vaddq_f32(vmulq_f32(wa, qa[c]), vmulq_f32(wb, qb[c]));
+    }
+    float32x4_t length_squared = vmulq_f32(q[0], q[0]);
+    length_squared = vaddq_f32(length_squared, vmulq_f32(q[1], q[1]));
+    length_squared = vaddq_f32(length_squared, vmulq_f32(q[2], q[2]));
+    length_squared = vaddq_f32(length_squared, vmulq_f32(q[3], q[3]));
+    float32x4_t const inv_length = vdivq_f32(one, vsqrtq_f32(length_squared));
+
+    for (uint32_t c = 0u; c < kRotationChannels; ++c) {
+      vst1q_f32(dst + c * count + i, vmulq_f32(q[c], inv_length));
+    }
+  }
+  return i;
+}
+
+uint32_t LerpNEON(float const* a, float const* b, float const t, uint32_t const count, float* dst) {
+  float32x4_t const tv = vdupq_n_f32(t);
+
+  uint32_t i = 0u;
+  for (; i + 4u <= count; i += 4u) {
+    float32x4_t const av = vld1q_f32(a + i);
+    float32x4_t const bv = vld1q_f32(b + i);
+    vst1q_f32(dst + i, vaddq_f32(av, vmulq_f32(tv, vsubq_f32(bv, av))));
+  }
+  return i;
+}
+
+uint32_t AccumulateNEON(float const* src, float const weight, uint32_t const count, float* dst) {
+  float32x4_t const w = vdupq_n_f32(weight);
+
+  uint32_t i = 0u;
+  for (; i + 4u <= count; i += 4u) {
+    vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), vmulq_f32(w, vld1q_f32(src + i))));
+  }
+  return i;
+}
+
+#endif
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+namespace internal::animation_kernels {
+
+bool IsBackendSupported(Backend backend) {
+  switch (backend) {
+    case Backend::Scalar:
+      return true;
+#if defined(AER_ANIMATION_SSE)
+    case Backend::SSE:
+      return true;
+#endif
+#if defined(AER_ANIMATION_NEON)
+    case Backend::NEON:
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+Backend BestBackend() {
+  for (auto backend : { Backend::SSE, Backend::NEON }) {
+    if (IsBackendSupported(backend)) {
+      return backend;
+    }
+  }
+  return Backend::Scalar;
+}
+
+// ----------------------------------------------------------------------------
+
+char const* BackendName(Backend backend) {
+  switch (backend) {
+    case Backend::SSE:  return "sse2";
+    case Backend::NEON: return "neon";
+    default:            return "scalar";
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void InterpolatePoses(
+  float const* a,
+  float const* b,
+  float const t,
+  uint32_t const joint_stride,
+  float* dst,
+  Interpolation const interpolation,
+  Backend const backend
+) {
+  // Translations and scales channels follow the rotations ones.
+  uint32_t const rotation_size{ kRotationChannels * joint_stride };
+  uint32_t const linear_size{ (kChannelCount - kRotationChannels) * joint_stride };
+
+  uint32_t first_joint{0u};
+  uint32_t first_linear{0u};
+  switch (backend) {
+#if defined(AER_ANIMATION_SSE)
+    case Backend::SSE:
+      first_joint = InterpolateRotationsSSE(a, b, t, joint_stride, dst, interpolation);
+      first_linear = LerpSSE(a + rotation_size, b + rotation_size, t, linear_size, dst + rotation_size);
+    break;
+#endif
+
+#if defined(AER_ANIMATION_NEON)
+    case Backend::NEON:
+      first_joint = InterpolateRotationsNEON(a, b, t, joint_stride, dst, interpolation);
+      first_linear = LerpNEON(a + rotation_size, b + rotation_size, t, linear_size, dst + rotation_size);
+    break;
+#endif
+
+    default:
+    break;
+  }
+  InterpolateRotationsScalar(a, b, t, joint_stride, first_joint, dst, interpolation);
+  LerpScalar(a + rotation_size, b + rotation_size, t, first_linear, linear_size, dst + rotation_size);
+}
+
+// ----------------------------------------------------------------------------
+
+void AccumulatePose(
+  float const* src,
+  float const weight,
+  uint32_t const joint_stride,
+  float* dst,
+  Backend const backend
+) {
+  uint32_t const rotation_size{ kRotationChannels * joint_stride };
+  uint32_t const linear_size{ (kChannelCount - kRotationChannels) * joint_stride };
+
+  uint32_t first_joint{0u};
+  uint32_t first_linear{0u};
+  switch (backend) {
+#if defined(AER_ANIMATION_SSE)
+    case Backend::SSE:
+      first_joint = AccumulateRotationsSSE(src, weight, joint_stride, dst);
+      first_linear = AccumulateSSE(src + rotation_size, weight, linear_size, dst + rotation_size);
+    break;
+#endif
+
+#if defined(AER_ANIMATION_NEON)
+    case Backend::NEON:
+      first_joint = AccumulateRotationsNEON(src, weight, joint_stride, dst);
+      first_linear = AccumulateNEON(src + rotation_size, weight, linear_size, dst + rotation_size);
+    break;
+#endif
+
+    default:
+    break;
+  }
+  AccumulateRotationsScalar(src, weight, joint_stride, first_joint, dst);
+  AccumulateScalar(src + rotation_size, weight, first_linear, linear_size, dst + rotation_size);
+}
+
+// ----------------------------------------------------------------------------
+
+void NormalizeRotations(float* pose, uint32_t const joint_stride, Backend const backend) {
+  uint32_t first_joint{0u};
+  switch (backend) {
+#if defined(AER_ANIMATION_SSE)
+    case Backend::SSE:
+      first_joint = NormalizeRotationsSSE(pose, joint_stride);
+    break;
+#endif
+
+#if defined(AER_ANIMATION_NEON)
+    case Backend::NEON:
+      first_joint = NormalizeRotationsNEON(pose, joint_stride);
+    break;
+#endif
+
+    default:
+    break;
+  }
+  NormalizeRotationsScalar(pose, joint_stride, first_joint);
+}
+
+// ----------------------------------------------------------------------------
+
+void InterpolateQuantizedRotations(
+  uint16_t const* a,
+  uint16_t const* b,
+  float const* t,
+  uint32_t const count,
+  float* dst,
+  Backend const backend
+) {
+  uint32_t first{0u};
+  switch (backend) {
+#if defined(AER_ANIMATION_SSE)
+    case Backend::SSE:
+      first = InterpolateQuantizedRotationsSSE(a, b, t, count, dst);
+    break;
+#endif
+
+#if defined(AER_ANIMATION_NEON)
+    case Backend::NEON:
+      first = InterpolateQuantizedRotationsNEON(a, b, t, count, dst);
+    break;
+#endif
+
+    default:
+    break;
+  }
+  InterpolateQuantizedRotationsScalar(a, b, t, count, first, dst);
+}
+
+} // namespace internal::animation_kernels
+
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,97 @@
+#ifndef AER_SCENE_PRIVATE_ANIMATION_KERNELS_H_
+#define AER_SCENE_PRIVATE_ANIMATION_KERNELS_H_
+
+/* -------------------------------------------------------------------------- */
+//
+//    animation_kernels.h
+//
+//  Sampling and blending of skeleton poses stored as structure of arrays
+//  (see scene::Pose), four joints per SIMD register.
+//
+//  Rotations are interpolated along the shortest path, either normalized
+//  linearly (nlerp) or spherically (slerp, whose weights are computed per
+//  joint). Translations and scales are interpolated linearly.
+//
+/* -------------------------------------------------------------------------- */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace internal::animation_kernels {
+
+enum class Backend : uint8_t {
+  Scalar,
+  SSE,
+  NEON,
+};
+
+enum class Interpolation : uint8_t {
+  NLerp,
+  SLerp,
+};
+
+// ----------------------------------------------------------------------------
+
+/* Return true when the backend can run on this build and CPU. */
+bool IsBackendSupported(Backend backend);
+
+/* Return the fastest backend supported by the running CPU. */
+Backend BestBackend();
+
+/* Return a printable name for a backend. */
+char const* BackendName(Backend backend);
+
+/**
+ * Interpolate the poses 'a' and 'b' by 't' into 'dst', each holding
+ * Pose::kChannelCount channels of 'joint_stride' floats, a multiple of 4.
+ **/
+void InterpolatePoses(
+  float const* a,
+  float const* b,
+  float t,
+  uint32_t joint_stride,
+  float* dst,
+  Interpolation interpolation,
+  Backend backend = BestBackend()
+);
+
+/**
+ * Add 'weight' times the pose 'src' to 'dst', rotations being negated when
+ * not in the hemisphere of the accumulated ones.
+ **/
+void AccumulatePose(
+  float const* src,
+  float weight,
+  uint32_t joint_stride,
+  float* dst,
+  Backend backend = BestBackend()
+);
+
+/* Normalize the rotations of an accumulated pose. */
+void NormalizeRotations(
+  float* pose,
+  uint32_t joint_stride,
+  Backend backend = BestBackend()
+);
+
+/**
+ * Decode pairs of smallest-three quantized rotations (see
+ * animation_compressor.h) and nlerp them by per rotation weights 't'.
+ *
+ * 'a' and 'b' hold three arrays of 'count' quantized components, 'dst' four
+ * arrays of 'count' rotations, 'count' being a multiple of 4.
+ **/
+void InterpolateQuantizedRotations(
+  uint16_t const* a,
+  uint16_t const* b,
+  float const* t,
+  uint32_t count,
+  float* dst,
+  Backend backend = BestBackend()
+);
+
+} // namespace internal::animation_kernels
+
+/* -------------------------------------------------------------------------- */
+
+#endif // AER_SCENE_PRIVATE_ANIMATION_KERNELS_H_
@@ -0,0 +1,636 @@
+#include "aer/scene/private/baked_scene.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include "aer/core/utils.h"
+#include "aer/scene/vertex_internal.h"
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+using namespace internal::baked_scene;
+
+SamplerRecord ToSamplerRecord(scene::Sampler const& sampler) {
+  auto const& info = sampler.info;
+  return {
+    .use_default = sampler.use_default() ? 1u : 0u,
+    .mag_filter = static_cast<uint32_t>(info.magFilter),
+    .min_filter = static_cast<uint32_t>(info.minFilter),
+    .mipmap_mode = static_cast<uint32_t>(info.mipmapMode),
+    .address_mode_u = static_cast<uint32_t>(info.addressModeU),
+    .address_mode_v = static_cast<uint32_t>(info.addressModeV),
+    .address_mode_w = static_cast<uint32_t>(info.addressModeW),
+    .anisotropy_enable = static_cast<uint32_t>(info.anisotropyEnable),
+    .max_anisotropy = info.maxAnisotropy,
+    .min_lod = info.minLod,
+    .max_lod = info.maxLod,
+  };
+}
+
+// ----------------------------------------------------------------------------
+
+scene::Sampler FromSamplerRecord(SamplerRecord const& record) {
+  if (record.use_default) {
+    return {};
+  }
+  return VkSamplerCreateInfo{
+    .sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+    .magFilter = static_cast<VkFilter>(record.mag_filter),
+    .minFilter = static_cast<VkFilter>(record.min_filter),
+    .mipmapMode = static_cast<VkSamplerMipmapMode>(record.mipmap_mode),
+    .addressModeU = static_cast<VkSamplerAddressMode>(record.address_mode_u),
+    .addressModeV = static_cast<VkSamplerAddressMode>(record.address_mode_v),
+    .addressModeW = static_cast<VkSamplerAddressMode>(record.address_mode_w),
+    .anisotropyEnable = static_cast<VkBool32>(record.anisotropy_enable),
+    .maxAnisotropy = record.max_anisotropy,
+    .minLod = record.min_lod,
+    .maxLod = record.max_lod,
+  };
+}
+
+// ----------------------------------------------------------------------------
+
+/* Sequential writer keeping track of the file offsets. */
+class Writer {
+ public:
+  explicit Writer(std::string const& filename)
+    : file_(filename, std::ios::binary | std::ios::trunc)
+  {}
+
+  bool good() const {
+    return file_.good();
+  }
+
+  uint64_t tell() {
+    return static_cast<uint64_t>(file_.tellp());
+  }
+
+  void align(uint64_t alignment = kSectionAlignment) {
+    static constexpr std::array<char, kSectionAlignment> kZeros{};
+    uint64_t const pos = tell();
+    uint64_t const padding = utils::AlignTo(pos, alignment) - pos;
+    file_.write(kZeros.data(), static_cast<std::streamsize>(padding));
+  }
+
+  void write(void const* data, uint64_t size) {
+    file_.write(static_cast<char const*>(data), static_cast<std::streamsize>(size));
+  }
+
+  template<typename T>
+  Section write_table(std::vector<T> const& records) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    align();
+    Section const section{ .offset = tell(), .count = records.size() };
+    write(records.data(), records.size() * sizeof(T));
+    return section;
+  }
+
+  void write_at(uint64_t offset, void const* data, uint64_t size) {
+    file_.seekp(static_cast<std::streamoff>(offset));
+    write(data, size);
+  }
+
+ private:
+  std::ofstream file_;
+};
+
+// ----------------------------------------------------------------------------
+
+/* Bounds-checked view over the mapped tables. */
+class Reader {
+ public:
+  explicit Reader(utils::MappedFile const& file)
+    : file_(file)
+  {}
+
+  template<typename T>
+  bool table(Section const& section, std::span<T const>& out) const {
+    if ((section.offset % alignof(T)) != 0u
+     || (section.offset > file_.size())
+     || (section.count > (file_.size() - section.offset) / sizeof(T))) {
+      return false;
+    }
+    out = { reinterpret_cast<T const*>(file_.data() + section.offset), section.count };
+    return true;
+  }
+
+  bool blob(Section const& blob_section, BlobRange const& range, uint8_t const*& out) const {
+    if ((range.offset > blob_section.count)
+     || (range.size > blob_section.count - range.offset)) {
+      return false;
+    }
+    out = file_.data() + blob_section.offset + range.offset;
+    return true;
+  }
+
+ private:
+  utils::MappedFile const& file_;
+};
+
+// ----------------------------------------------------------------------------
+
+uint32_t RebaseTexture(uint32_t local_index, uint32_t texture_offset, uint32_t default_index) {
+  return (local_index == kInvalidIndexU32) ? default_index : texture_offset + local_index;
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+namespace internal::baked_scene {
+
+std::string GetBakedFilename(std::string_view source_filename) {
+  namespace fs = std::filesystem;
+
+  // (kept out of the assets directory, which can be read-only)
+  std::error_code ec{};
+  fs::path const cache_dir{ fs::temp_directory_path(ec) / kCacheDirectory };
+  if (ec || (!fs::create_directories(cache_dir, ec) && ec)) {
+    return {};
+  }
+
+  // Keyed by the absolute source path, as different directories can hold the same filename.
+  fs::path const source_path{ fs::absolute(fs::path(source_filename), ec) };
+  if (ec) {
+    return {};
+  }
+  size_t const key{ std::hash<std::string>{}(source_path.generic_string()) };
+
+  return (cache_dir / fmt::format("{}.{:016x}{}",
+    source_path.filename().string(), key, kFileExtension
+  )).string();
+}
+
+// ----------------------------------------------------------------------------
+
+bool IsUpToDate(std::string_view source_filename, std::string_view baked_filename) {
+  namespace fs = std::filesystem;
+  std::error_code ec_src{}, ec_baked{};
+  auto const src_time = fs::last_write_time(fs::path(source_filename), ec_src);
+  auto const baked_time = fs::last_write_time(fs::path(baked_filename), ec_baked);
+  return !ec_src && !ec_baked && (baked_time > src_time);
+}
+
+// ----------------------------------------------------------------------------
+
+bool IsBakeable(scene::HostResources const& R, ResourceOffsets const& offsets) {
+  if ((R.skeletons.size() > offsets.skeletons)
+   || (R.animations_map.size() > offsets.animations)) {
+    return false;
+  }
+  for (size_t i = offsets.meshes; i < R.meshes.size(); ++i) {
+    auto const& mesh = *R.meshes[i];
+    if ((mesh.skeleton_index != kInvalidIndexU32)
+     || mesh.has_attribute(Geometry::AttributeType::Joints)
+     || mesh.has_attribute(Geometry::AttributeType::Weights)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+bool Write(
+  std::string_view baked_filename,
+  scene::HostResources const& R,
+  ResourceOffsets const& offsets
+) {
+  if (!IsBakeable(R, offsets)) {
+    LOGW("[Baked] skeletons, animations and skins are not baked, scene not baked.");
+    return false;
+  }
+
+  /* Build the tables, blob offsets are relative to the blob section. */
+  std::vector<SamplerRecord> samplers{};
+  std::vector<ImageRecord> images{};
+  std::vector<TextureRecord> textures{};
+  auto texture_compression{ scene::ImageData::BlockCompression::None };
+  std::vector<MaterialRecord> materials{};
+  std::vector<MeshRecord> meshes{};
+  std::vector<PrimitiveRecord> primitives{};
+
+  uint64_t blob_size{0u};
+  auto reserve_blob{[&blob_size](uint64_t size) -> BlobRange {
+    BlobRange const range{ .offset = blob_size, .size = size };
+    blob_size = utils::AlignTo(blob_size + size, kSectionAlignment);
+    return range;
+  }};
+
+  for (size_t i = offsets.samplers; i < R.samplers.size(); ++i) {
+    samplers.push_back(ToSamplerRecord(R.samplers[i]));
+  }
+
+  for (size_t i = offsets.images; i < R.host_images.size(); ++i) {
+    auto const& img = R.host_images[i];
+    if (!img.getPixels()) {
+      LOGW("[Baked] image {} has no pixels, scene not baked.", i);
+      return false;
+    }
+    images.push_back({
+      .width = img.width,
+      .height = img.height,
+      .format = img.format,
+      .level_count = img.level_count,
+      .pixels = reserve_blob(img.getBytesize()),
+    });
+    if (img.isBlockCompressed()) {
+      texture_compression = R.texture_compression;
+    }
+  }
+
+  for (size_t i = offsets.textures; i < R.textures.size(); ++i) {
+    auto const& tex = R.textures[i];
+    textures.push_back({
+      .image_index = tex.host_image_index - offsets.images,
+      .sampler = ToSamplerRecord(tex.sampler),
+    });
+  }
+
+  auto local_texture{[&offsets](uint32_t index) {
+    return (index >= offsets.textures) ? index - offsets.textures : kInvalidIndexU32;
+  }};
+  for (size_t i = offsets.materials; i < R.material_proxies.size(); ++i) {
+    MaterialRecord record{};
+    record.proxy = R.material_proxies[i];
+    auto& bindings = record.proxy.bindings;
+    bindings.basecolor = local_texture(bindings.basecolor);
+    bindings.normal = local_texture(bindings.normal);
+    bindings.occlusion = local_texture(bindings.occlusion);
+    bindings.emissive = local_texture(bindings.emissive);
+    bindings.roughness_metallic = local_texture(bindings.roughness_metallic);
+    record.model = R.material_refs[i]->model;
+    record.alpha_mode = R.material_refs[i]->states.alpha_mode;
+    materials.push_back(record);
+  }
+
+  for (size_t i = offsets.meshes; i < R.meshes.size(); ++i) {
+    auto const& mesh = *R.meshes[i];
+
+    meshes.push_back({
+      .topology = static_cast<uint32_t>(mesh.get_topology()),
+      .index_format = static_cast<uint32_t>(mesh.get_index_format()),
+      .first_primitive = static_cast<uint32_t>(primitives.size()),
+      .primitive_count = mesh.get_primitive_count(),
+      .instance_count = mesh.instance_count,
+      .compact_vertices = mesh.has_compact_vertices() ? 1u : 0u,
+      .position_offset = { mesh.position_offset.x, mesh.position_offset.y, mesh.position_offset.z },
+      .position_scale = { mesh.position_scale.x, mesh.position_scale.y, mesh.position_scale.z },
+      .vertices = reserve_blob(mesh.get_vertices().size()),
+      .indices = reserve_blob(mesh.get_indices().size()),
+      .meshlets = reserve_blob(mesh.get_meshlets().size() * sizeof(Geometry::Meshlet)),
+      .lods = reserve_blob(mesh.get_lods().size() * sizeof(Geometry::LodLevel)),
+      .transforms = reserve_blob(mesh.instance_count * sizeof(mat4f)),
+    });
+
+    for (uint32_t prim_index = 0u; prim_index < mesh.get_primitive_count(); ++prim_index) {
+      auto const& prim = mesh.get_primitive(prim_index);
+      auto const* material_ref = (prim_index < mesh.submeshes.size()) ? mesh.submeshes[prim_index].material_ref
+                                                                      : nullptr;
+      primitives.push_back({
+        .topology = static_cast<uint32_t>(prim.topology),
+        .vertex_count = prim.vertexCount,
+        .index_count = prim.indexCount,
+        .material_index = material_ref ? material_ref->proxy_index - offsets.materials
+                                       : kInvalidIndexU32,
+        .index_format = static_cast<uint32_t>(prim.indexFormat),
+        .meshlet_offset = prim.meshletOffset,
+        .meshlet_count = prim.meshletCount,
+        .lod_offset = prim.lodOffset,
+        .lod_count = prim.lodCount,
+        .bounds_min = { prim.boundsMin[0], prim.boundsMin[1], prim.boundsMin[2] },
+        .bounds_max = { prim.boundsMax[0], prim.boundsMax[1], prim.boundsMax[2] },
+        .center = { prim.center[0], prim.center[1], prim.center[2] },
+        .radius = prim.radius,
+        .index_offset = prim.indexOffset,
+        .vertex_offset = prim.bufferOffsets.at(Geometry::AttributeType::Position),
+      });
+    }
+  }
+
+  /* Write to a temporary file first so an interrupted bake is never picked up. */
+  std::string const filename(baked_filename);
+  // (per thread, the same scene could be baked by concurrent loads)
+  std::string const tmp_filename{ fmt::format("{}.{}.tmp",
+    filename, std::hash<std::thread::id>{}(std::this_thread::get_id())
+  )};
+  {
+    Writer writer(tmp_filename);
+    if (!writer.good()) {
+      LOGW("[Baked] could not create \"{}\".", tmp_filename);
+      return false;
+    }
+
+    Header header{
+      .vertex_stride = sizeof(VertexInternal_t),
+      .material_proxy_size = sizeof(scene::MaterialProxy),
+      .meshlet_size = sizeof(Geometry::Meshlet),
+      .lod_size = sizeof(Geometry::LodLevel),
+      .optimize_meshes = R.optimize_meshes ? 1u : 0u,
+      .compact_vertices = R.compact_vertices ? 1u : 0u,
+      .force_32bits_indexing = scene::HostResources::kForce32BitsIndexing ? 1u : 0u,
+      .split_large_primitives = scene::HostResources::kSplitLargePrimitives ? 1u : 0u,
+      .build_meshlets = R.build_meshlets ? 1u : 0u,
+      .build_lods = R.build_lods ? 1u : 0u,
+      .texture_compression = texture_compression,
+      .host_mipmaps = (R.mipmap_generation == scene::HostResources::MipmapGeneration::Host) ? 1u : 0u,
+    };
+    writer.write(&header, sizeof(header));
+
+    header.samplers = writer.write_table(samplers);
+    header.images = writer.write_table(images);
+    header.textures = writer.write_table(textures);
+    header.materials = writer.write_table(materials);
+    header.meshes = writer.write_table(meshes);
+    header.primitives = writer.write_table(primitives);
+
+    writer.align();
+    header.blob = { .offset = writer.tell(), .count = blob_size };
+
+    auto write_blob{[&writer, &header](BlobRange const& range, void const* data) {
+      LOG_CHECK(writer.tell() == header.blob.offset + range.offset);
+      writer.write(data, range.size);
+      writer.align();
+    }};
+    for (size_t i = 0; i < images.size(); ++i) {
+      write_blob(images[i].pixels, R.host_images[offsets.images + i].getPixels());
+    }
+    // (instances transforms are contiguous and follow the meshes order)
+    size_t transform_index = offsets.transforms;
+    for (size_t i = 0; i < meshes.size(); ++i) {
+      auto const& mesh = *R.meshes[offsets.meshes + i];
+      write_blob(meshes[i].vertices, mesh.get_vertices().data());
+      write_blob(meshes[i].indices, mesh.get_indices().data());
+      write_blob(meshes[i].meshlets, mesh.get_meshlets().data());
+      write_blob(meshes[i].lods, mesh.get_lods().data());
+      write_blob(meshes[i].transforms, &R.transforms[transform_index]);
+      transform_index += mesh.instance_count;
+    }
+
+    writer.write_at(0u, &header, sizeof(header));
+
+    if (!writer.good()) {
+      LOGW("[Baked] failed to write \"{}\".", tmp_filename);
+      return false;
+    }
+  }
+
+  std::error_code ec{};
+  std::filesystem::rename(tmp_filename, filename, ec);
+  if (ec) {
+    LOGW("[Baked] failed to rename \"{}\" : {}", tmp_filename, ec.message());
+    std::filesystem::remove(tmp_filename, ec);
+    return false;
+  }
+
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+bool Read(
+  utils::MappedFile const& file,
+  scene::HostResources& R,
+  scene::MaterialProxy::TextureBinding const& default_bindings
+) {
+  if (!file.is_open() || (file.size() < sizeof(Header))) {
+    return false;
+  }
+
+  Header header{};
+  std::memcpy(&header, file.data(), sizeof(header));
+
+  if ((header.magic != kMagic)
+   || (header.version != kVersion)
+   || (header.vertex_stride != sizeof(VertexInternal_t))
+   || (header.material_proxy_size != sizeof(scene::MaterialProxy))
+   || (header.meshlet_size != sizeof(Geometry::Meshlet))
+   || (header.lod_size != sizeof(Geometry::LodLevel))) {
+    LOGW("[Baked] incompatible file version or layout.");
+    return false;
+  }
+  if (((header.optimize_meshes != 0u) != R.optimize_meshes)
+   || ((header.compact_vertices != 0u) != R.compact_vertices)
+   || ((header.force_32bits_indexing != 0u) != scene::HostResources::kForce32BitsIndexing)
+   || ((header.split_large_primitives != 0u) != scene::HostResources::kSplitLargePrimitives)) {
+    LOGW("[Baked] mesh processing differs from the requested one.");
+    return false;
+  }
+  if ((header.build_meshlets != 0u) != R.build_meshlets) {
+    LOGW("[Baked] meshlets differ from the requested ones.");
+    return false;
+  }
+  if ((header.build_lods != 0u) != R.build_lods) {
+    LOGW("[Baked] LOD levels differ from the requested ones.");
+    return false;
+  }
+  if ((header.texture_compression != scene::ImageData::BlockCompression::None)
+   && (header.texture_compression != R.texture_compression)) {
+    LOGW("[Baked] textures block compression differs from the requested one.");
+    return false;
+  }
+  if ((header.host_mipmaps != 0u) != (R.mipmap_generation == scene::HostResources::MipmapGeneration::Host)) {
+    LOGW("[Baked] mip chains differ from the requested ones.");
+    return false;
+  }
+
+  Reader const reader(file);
+
+  std::span<SamplerRecord const> samplers{};
+  std::span<ImageRecord const> images{};
+  std::span<TextureRecord const> textures{};
+  std::span<MaterialRecord const> materials{};
+  std::span<MeshRecord const> meshes{};
+  std::span<PrimitiveRecord const> primitives{};
+  std::span<uint8_t const> blob{};
+
+  if (!reader.table(header.samplers, samplers)
+   || !reader.table(header.images, images)
+   || !reader.table(header.textures, textures)
+   || !reader.table(header.materials, materials)
+   || !reader.table(header.meshes, meshes)
+   || !reader.table(header.primitives, primitives)
+   || !reader.table(header.blob, blob)) {
+    LOGW("[Baked] corrupted section table.");
+    return false;
+  }
+
+  /* Validate every record before touching the resources. */
+  for (auto const& t : textures) {
+    if (t.image_index >= images.size()) {
+      return false;
+    }
+  }
+  for (auto const& m : meshes) {
+    if ((m.compact_vertices != 0u) != R.compact_vertices) {
+      LOGW("[Baked] vertex layout differs from the requested one.");
+      return false;
+    }
+    uint8_t const* ptr{};
+    if ((m.first_primitive > primitives.size())
+     || (m.primitive_count > primitives.size() - m.first_primitive)
+     || (m.instance_count == 0u)
+     || (m.transforms.size != m.instance_count * sizeof(mat4f))
+     || !reader.blob(header.blob, m.vertices, ptr)
+     || !reader.blob(header.blob, m.indices, ptr)
+     || !reader.blob(header.blob, m.meshlets, ptr)
+     || !reader.blob(header.blob, m.lods, ptr)
+     || !reader.blob(header.blob, m.transforms, ptr)
+     || (m.meshlets.size % sizeof(Geometry::Meshlet)) != 0u
+     || (m.lods.size % sizeof(Geometry::LodLevel)) != 0u) {
+      return false;
+    }
+    uint64_t const meshlet_count = m.meshlets.size / sizeof(Geometry::Meshlet);
+    uint64_t const lod_count = m.lods.size / sizeof(Geometry::LodLevel);
+    for (auto const& p : primitives.subspan(m.first_primitive, m.primitive_count)) {
+      if ((p.meshlet_offset > meshlet_count) || (p.meshlet_count > meshlet_count - p.meshlet_offset)
+       || (p.lod_offset > lod_count) || (p.lod_count > lod_count - p.lod_offset)) {
+        return false;
+      }
+    }
+  }
+  for (auto const& p : primitives) {
+    if ((p.material_index != kInvalidIndexU32) && (p.material_index >= materials.size())) {
+      return false;
+    }
+    auto const index_format = static_cast<Geometry::IndexFormat>(p.index_format);
+    if ((index_format >= Geometry::IndexFormat::kCount) && (index_format != Geometry::IndexFormat::kUnknown)) {
+      return false;
+    }
+  }
+  for (auto const& img : images) {
+    uint8_t const* ptr{};
+    if ((img.format >= scene::ImageData::Format::kCount)
+     || (img.width <= 0) || (img.height <= 0)
+     || (img.level_count == 0u) || (img.level_count > 32u)) {
+      return false;
+    }
+    uint64_t const bytesize{
+      scene::ImageData::MipChainBytesize(img.format, img.width, img.height, img.level_count)
+    };
+    if ((img.pixels.size < bytesize)
+     || !reader.blob(header.blob, img.pixels, ptr)) {
+      return false;
+    }
+  }
+
+  auto const offsets = ResourceOffsets::From(R);
+
+  // Samplers.
+  R.samplers.reserve(R.samplers.size() + samplers.size());
+  for (auto const& record : samplers) {
+    R.samplers.push_back(FromSamplerRecord(record));
+  }
+
+  // Images, pointing straight into the mapping.
+  R.host_images.reserve(R.host_images.size() + images.size());
+  for (auto const& record : images) {
+    uint8_t const* pixels{};
+    reader.blob(header.blob, record.pixels, pixels);
+    R.host_images.emplace_back().setExternalPixels(
+      pixels, record.width, record.height, record.format, record.level_count
+    );
+  }
+
+  // Textures.
+  R.textures.reserve(R.textures.size() + textures.size());
+  for (auto const& record : textures) {
+    R.textures.emplace_back(offsets.images + record.image_index, FromSamplerRecord(record.sampler));
+  }
+
+  // Materials.
+  R.material_proxies.reserve(R.material_proxies.size() + materials.size());
+  R.material_refs.reserve(R.material_refs.size() + materials.size());
+  for (auto const& record : materials) {
+    scene::MaterialProxy proxy{ record.proxy };
+    auto& b = proxy.bindings;
+    b.basecolor = RebaseTexture(b.basecolor, offsets.textures, default_bindings.basecolor);
+    b.normal = RebaseTexture(b.normal, offsets.textures, default_bindings.normal);
+    b.occlusion = RebaseTexture(b.occlusion, offsets.textures, default_bindings.occlusion);
+    b.emissive = RebaseTexture(b.emissive, offsets.textures, default_bindings.emissive);
+    b.roughness_metallic = RebaseTexture(b.roughness_metallic, offsets.textures, default_bindings.roughness_metallic);
+
+    R.material_proxies.push_back(proxy);
+    R.material_refs.push_back( std::make_unique<scene::MaterialRef>(scene::MaterialRef{
+      .model = record.model,
+      .states = { .alpha_mode = record.alpha_mode },
+      .proxy_index = static_cast<uint32_t>(R.material_proxies.size() - 1u),
+    }) );
+  }
+
+  // Meshes.
+  R.meshes.reserve(R.meshes.size() + meshes.size());
+  R.transforms.reserve(R.transforms.size() + meshes.size());
+  for (auto const& record : meshes) {
+    uint8_t const* vertices{};
+    uint8_t const* indices{};
+    uint8_t const* meshlets{};
+    uint8_t const* lods{};
+    uint8_t const* transforms{};
+    reader.blob(header.blob, record.vertices, vertices);
+    reader.blob(header.blob, record.indices, indices);
+    reader.blob(header.blob, record.meshlets, meshlets);
+    reader.blob(header.blob, record.lods, lods);
+    reader.blob(header.blob, record.transforms, transforms);
+
+    auto mesh = std::make_unique<scene::Mesh>();
+    if (record.compact_vertices != 0u) {
+      mesh->set_attributes(VertexCompact_t::GetAttributeInfoMap());
+      mesh->position_offset = vec3(record.position_offset[0], record.position_offset[1], record.position_offset[2]);
+      mesh->position_scale = vec3(record.position_scale[0], record.position_scale[1], record.position_scale[2]);
+    } else {
+      mesh->set_attributes(VertexInternal_t::GetAttributeInfoMap());
+    }
+    mesh->set_topology(static_cast<Geometry::Topology>(record.topology));
+    mesh->set_index_format(static_cast<Geometry::IndexFormat>(record.index_format));
+    mesh->add_vertices_data({ reinterpret_cast<std::byte const*>(vertices), record.vertices.size });
+    mesh->add_indices_data({ reinterpret_cast<std::byte const*>(indices), record.indices.size });
+    mesh->submeshes.resize(record.primitive_count, {.parent = mesh.get()});
+    mesh->instance_count = record.instance_count;
+
+    for (uint32_t i = 0u; i < record.primitive_count; ++i) {
+      auto const& prim = primitives[record.first_primitive + i];
+      if (prim.material_index != kInvalidIndexU32) {
+        mesh->submeshes[i].material_ref = R.material_refs[offsets.materials + prim.material_index].get();
+      }
+      mesh->add_primitive({
+        .topology = static_cast<Geometry::Topology>(prim.topology),
+        .vertexCount = prim.vertex_count,
+        .indexCount = prim.index_count,
+        .indexOffset = prim.index_offset,
+        .indexFormat = static_cast<Geometry::IndexFormat>(prim.index_format),
+        .bufferOffsets = VertexInternal_t::GetAttributeOffsetMap(prim.vertex_offset),
+        .meshletOffset = prim.meshlet_offset,
+        .meshletCount = prim.meshlet_count,
+        .lodOffset = prim.lod_offset,
+        .lodCount = prim.lod_count,
+        .boundsMin = { prim.bounds_min[0], prim.bounds_min[1], prim.bounds_min[2] },
+        .boundsMax = { prim.bounds_max[0], prim.bounds_max[1], prim.bounds_max[2] },
+        .center = { prim.center[0], prim.center[1], prim.center[2] },
+        .radius = prim.radius,
+      });
+    }
+    if (record.meshlets.size > 0u) {
+      auto const* first_meshlet = reinterpret_cast<Geometry::Meshlet const*>(meshlets);
+      mesh->set_meshlets({ first_meshlet, first_meshlet + record.meshlets.size / sizeof(Geometry::Meshlet) });
+    }
+    if (record.lods.size > 0u) {
+      auto const* first_lod = reinterpret_cast<Geometry::LodLevel const*>(lods);
+      mesh->set_lods({ first_lod, first_lod + record.lods.size / sizeof(Geometry::LodLevel) });
+    }
+
+    auto const* instance_transforms = reinterpret_cast<mat4f const*>(transforms);
+    R.transforms.insert(R.transforms.end(), instance_transforms, instance_transforms + record.instance_count);
+    R.meshes.push_back(std::move(mesh));
+  }
+
+  return true;
+}
+
+} // namespace internal::baked_scene
+
+/* -------------------------------------------------------------------------- */
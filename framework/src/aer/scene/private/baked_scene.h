@@ -0,0 +1,218 @@
+#ifndef AER_SCENE_PRIVATE_BAKED_SCENE_H_
+#define AER_SCENE_PRIVATE_BAKED_SCENE_H_
+
+#include "aer/core/common.h"
+#include "aer/core/mapped_file.h"
+
+#include "aer/scene/host_resources.h"
+
+/* -------------------------------------------------------------------------- */
+//
+// Baked scene format.
+//
+// A flat binary snapshot of what the glTF loader produced, meant to be mapped
+// in memory and read back without any per-element parsing :
+//
+//    [Header][Samplers][Images][Textures][Materials][Meshes][Primitives][Blob]
+//
+// Every table is an array of POD records aligned to kSectionAlignment, indices
+// are local to the baked file and rebased when appended to HostResources.
+// Skeletons, animation clips and skinned meshes are not stored : such scenes
+// are never baked and always loaded from their source.
+// The blob holds the interleaved VertexInternal_t or VertexCompact_t vertices,
+// raw indices, meshlets, LOD levels, mesh instances transforms and decoded RGBA8
+// or transcoded block compressed pixels (with their mip levels), which are
+// referenced in place from the mapping.
+//
+/* -------------------------------------------------------------------------- */
+
+namespace internal::baked_scene {
+
+static constexpr uint32_t kMagic{ 0x42524541u }; // "AERB"
+static constexpr uint32_t kVersion{ 10u };
+
+static constexpr uint64_t kSectionAlignment{ 64u };
+
+static constexpr char const* kFileExtension{ ".aerb" };
+
+// Cache of the baked scenes, in the system temporary directory.
+static constexpr char const* kCacheDirectory{ "aer_baked_scenes" };
+
+// ----------------------------------------------------------------------------
+
+struct Section {
+  uint64_t offset{};
+  uint64_t count{};
+};
+
+struct BlobRange {
+  uint64_t offset{}; // relative to the blob section.
+  uint64_t size{};
+};
+
+struct Header {
+  uint32_t magic{kMagic};
+  uint32_t version{kVersion};
+
+  // Layout guards, the file is rejected when the host structures changed.
+  uint32_t vertex_stride{};
+  uint32_t material_proxy_size{};
+  uint32_t meshlet_size{};
+  uint32_t lod_size{};
+
+  // Mesh processing guards, the file is rejected when baked with other settings.
+  uint32_t optimize_meshes{};        // non-zero when primitives were reordered.
+  uint32_t compact_vertices{};       // non-zero for VertexCompact_t vertices.
+  uint32_t force_32bits_indexing{};  // non-zero when indices were widened.
+  uint32_t split_large_primitives{}; // non-zero when primitives were split for 16bit indices.
+  uint32_t build_meshlets{}; // non-zero when primitives were split in meshlets.
+  uint32_t build_lods{};     // non-zero when primitives were simplified in LOD levels.
+
+  // Block compression of the transcoded KTX2 images, None when there are none.
+  scene::ImageData::BlockCompression texture_compression{};
+  uint32_t host_mipmaps{};   // non-zero when mip chains were generated on the host.
+
+  Section samplers{};
+  Section images{};
+  Section textures{};
+  Section materials{};
+  Section meshes{};
+  Section primitives{};
+  Section blob{};
+};
+
+// ----------------------------------------------------------------------------
+
+struct SamplerRecord {
+  uint32_t use_default{};
+  uint32_t mag_filter{};
+  uint32_t min_filter{};
+  uint32_t mipmap_mode{};
+  uint32_t address_mode_u{};
+  uint32_t address_mode_v{};
+  uint32_t address_mode_w{};
+  uint32_t anisotropy_enable{};
+  float max_anisotropy{};
+  float min_lod{};
+  float max_lod{};
+  uint32_t _pad0{};
+};
+
+struct ImageRecord {
+  int32_t width{};
+  int32_t height{};
+  scene::ImageData::Format format{scene::ImageData::Format::RGBA8_UNORM};
+  uint32_t level_count{1u};
+  BlobRange pixels{}; // every level, tightly packed.
+};
+
+struct TextureRecord {
+  uint32_t image_index{};
+  uint32_t _pad0{};
+  SamplerRecord sampler{};
+};
+
+struct MaterialRecord {
+  // Texture bindings are local texture indices, kInvalidIndexU32 stands for
+  // the corresponding default binding.
+  scene::MaterialProxy proxy{};
+  scene::MaterialModel model{};
+  scene::MaterialStates::AlphaMode alpha_mode{};
+};
+
+struct MeshRecord {
+  uint32_t topology{};
+  uint32_t index_format{};
+  uint32_t first_primitive{};
+  uint32_t primitive_count{};
+  uint32_t instance_count{};
+  uint32_t compact_vertices{}; // non-zero for VertexCompact_t vertices.
+  float position_offset[3]{};
+  float position_scale[3]{};
+  BlobRange vertices{};
+  BlobRange indices{};
+  BlobRange meshlets{};   // Geometry::Meshlet, ranges are set per primitive.
+  BlobRange lods{};       // Geometry::LodLevel, ranges are set per primitive.
+  BlobRange transforms{}; // 'instance_count' world matrices.
+};
+
+struct PrimitiveRecord {
+  uint32_t topology{};
+  uint32_t vertex_count{};
+  uint32_t index_count{};
+  uint32_t material_index{kInvalidIndexU32}; // local.
+  uint32_t index_format{};
+  uint32_t meshlet_offset{};
+  uint32_t meshlet_count{};
+  uint32_t lod_offset{};
+  uint32_t lod_count{};
+  uint32_t _pad0{};
+  float bounds_min[3]{};
+  float bounds_max[3]{};
+  float center[3]{};
+  float radius{};
+  uint64_t index_offset{};
+  uint64_t vertex_offset{};
+};
+
+// ----------------------------------------------------------------------------
+
+/* Sizes of the HostResources containers before a file is appended to them. */
+struct ResourceOffsets {
+  uint32_t samplers{};
+  uint32_t images{};
+  uint32_t textures{};
+  uint32_t materials{};
+  uint32_t meshes{};
+  uint32_t transforms{};
+  uint32_t skeletons{};
+  uint32_t animations{};
+
+  static ResourceOffsets From(scene::HostResources const& R) {
+    return {
+      .samplers = static_cast<uint32_t>(R.samplers.size()),
+      .images = static_cast<uint32_t>(R.host_images.size()),
+      .textures = static_cast<uint32_t>(R.textures.size()),
+      .materials = static_cast<uint32_t>(R.material_proxies.size()),
+      .meshes = static_cast<uint32_t>(R.meshes.size()),
+      .transforms = static_cast<uint32_t>(R.transforms.size()),
+      .skeletons = static_cast<uint32_t>(R.skeletons.size()),
+      .animations = static_cast<uint32_t>(R.animations_map.size()),
+    };
+  }
+};
+
+/* -------------------------------------------------------------------------- */
+
+/* Return the cached baked filename of a source scene, empty when there is no cache directory. */
+std::string GetBakedFilename(std::string_view source_filename);
+
+/* Return true when the baked file exists and is newer than its source. */
+bool IsUpToDate(std::string_view source_filename, std::string_view baked_filename);
+
+/* True when the resources appended to R since 'offsets' can be baked (ie. are not animated). */
+bool IsBakeable(scene::HostResources const& R, ResourceOffsets const& offsets);
+
+/* Serialize the resources appended to R since 'offsets' into a baked file. */
+bool Write(
+  std::string_view baked_filename,
+  scene::HostResources const& R,
+  ResourceOffsets const& offsets
+);
+
+/**
+ * Append the baked file content to R.
+ * Pixels are referenced directly from the mapping, which must then outlive
+ * the host images.
+ **/
+bool Read(
+  utils::MappedFile const& file,
+  scene::HostResources& R,
+  scene::MaterialProxy::TextureBinding const& default_bindings
+);
+
+} // namespace internal::baked_scene
+
+/* -------------------------------------------------------------------------- */
+
+#endif // AER_SCENE_PRIVATE_BAKED_SCENE_H_
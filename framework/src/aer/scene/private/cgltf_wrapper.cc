@@ -171,6 +171,11 @@ VkSamplerCreateInfo ConvertSamplerInfo(cgltf_sampler const& sampler) {
     .maxAnisotropy = 16.0f,
   };
   info.minFilter = ConvertMinFilter(sampler.min_filter, info.mipmapMode);
+
+  // GL_NEAREST and GL_LINEAR minifications only sample the base level.
+  bool const use_mipmaps{ (sampler.min_filter != 9728) && (sampler.min_filter != 9729) };
+  info.maxLod = use_mipmaps ? VK_LOD_CLAMP_NONE : 0.25f;
+
   return info;
 }
 
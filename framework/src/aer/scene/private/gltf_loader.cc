@@ -1,11 +1,18 @@
 #define CGLTF_IMPLEMENTATION
 #define STB_IMAGE_IMPLEMENTATION
 
+#include <chrono>
 #include <string>
 
+#include "aer/core/job_system.h"
+#include "aer/scene/private/accessor_decoder.h"
+#include "aer/scene/private/animation_compressor.h"
 #include "aer/scene/private/gltf_loader.h"
+#include "aer/scene/private/vertex_quantizer.h"
 #include "aer/scene/vertex_internal.h"
 
+#include "meshoptimizer.h"
+
 #if defined(FRAMEWORK_HAS_DRACO) && VKPLAYGROUND_HAS_DRACO
 #include <draco/compression/decode.h>
 #include <draco/mesh/mesh.h>
@@ -43,6 +50,40 @@ scene::MaterialStates GetMaterialStates(cgltf_material const& mat) {
 
 // ----------------------------------------------------------------------------
 
+#if VKPLAYGROUND_HAS_DRACO
+/**
+ * Copy the decoded values of a Draco attribute into a member of every
+ * vertices, as PointAttribute::GetValue would one vertex at a time.
+ **/
+template<typename MemberPtr>
+void CopyDracoAttribute(
+  draco::PointAttribute const* attribute,
+  MemberPtr member,
+  std::vector<VertexInternal_t>& vertices
+) {
+  if (!attribute || vertices.empty()) {
+    return;
+  }
+  size_t constexpr kMemberSize{ sizeof(vertices[0].*member) };
+  size_t const stride{ attribute->byte_stride() };
+  size_t const count{ std::min<size_t>(vertices.size(), attribute->size()) };
+  uint8_t const* src{ attribute->GetAddress(draco::AttributeValueIndex(0u)) };
+
+  if (stride == kMemberSize) [[likely]] {
+    for (size_t i = 0u; i < count; ++i, src += kMemberSize) {
+      std::memcpy(&(vertices[i].*member), src, kMemberSize);
+    }
+  } else {
+    size_t const value_size{ std::min(stride, kMemberSize) };
+    for (size_t i = 0u; i < count; ++i, src += stride) {
+      std::memcpy(&(vertices[i].*member), src, value_size);
+    }
+  }
+}
+#endif
+
+// ----------------------------------------------------------------------------
+
 bool DecompressDracoPrimitive(cgltf_primitive const& prim, std::vector<VertexInternal_t>& vertices, std::vector<uint32_t>& indices) {
   if (!prim.has_draco_mesh_compression) {
     LOGE("Error: Primitive does not have draco compression.");
@@ -98,23 +139,13 @@ bool DecompressDracoPrimitive(cgltf_primitive const& prim, std::vector<VertexInt
   for (cgltf_size attrib_index = 0; attrib_index < draco.attributes_count; ++attrib_index) {
     cgltf_attribute const& attrib = draco.attributes[attrib_index];
 
-    draco::PointAttribute const* pt_attr = nullptr;
-
     switch (attrib.type) {
       case cgltf_attribute_type_position:
-        pt_attr = draco_mesh->GetNamedAttribute(draco::GeometryAttribute::POSITION);
-        for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
-          auto &vertex = vertices[vertex_index];
-          pt_attr->GetValue(draco::AttributeValueIndex(vertex_index), lina::ptr(vertex.position));
-        }
+        CopyDracoAttribute(draco_mesh->GetNamedAttribute(draco::GeometryAttribute::POSITION), &VertexInternal_t::position, vertices);
         break;
 
       case cgltf_attribute_type_normal:
-        pt_attr = draco_mesh->GetNamedAttribute(draco::GeometryAttribute::NORMAL);
-        for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
-          auto &vertex = vertices[vertex_index];
-          pt_attr->GetValue(draco::AttributeValueIndex(vertex_index), lina::ptr(vertex.normal));
-        }
+        CopyDracoAttribute(draco_mesh->GetNamedAttribute(draco::GeometryAttribute::NORMAL), &VertexInternal_t::normal, vertices);
         break;
 
       case cgltf_attribute_type_texcoord:
@@ -122,11 +153,7 @@ bool DecompressDracoPrimitive(cgltf_primitive const& prim, std::vector<VertexInt
           LOGW("MultiTexturing not supported (Draco)");
           continue;
         }
-        pt_attr = draco_mesh->GetNamedAttribute(draco::GeometryAttribute::TEX_COORD);
-        for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
-          auto &vertex = vertices[vertex_index];
-          pt_attr->GetValue(draco::AttributeValueIndex(vertex_index), lina::ptr(vertex.texcoord));
-        }
+        CopyDracoAttribute(draco_mesh->GetNamedAttribute(draco::GeometryAttribute::TEX_COORD), &VertexInternal_t::texcoord, vertices);
         break;
 
       default:
@@ -135,16 +162,13 @@ bool DecompressDracoPrimitive(cgltf_primitive const& prim, std::vector<VertexInt
     }
   }
 
-  // Indices.
+  // Indices, faces being stored contiguously as triplets of 32bit point indices.
   if (prim.indices) {
-    const int num_faces = draco_mesh->num_faces();
-    indices.reserve(num_faces * 3);
-
-    for (draco::FaceIndex face_index(0); face_index < num_faces; ++face_index) {
-      const draco::Mesh::Face& face = draco_mesh->face(face_index);
-      for (auto const& face_pt : face) {
-        indices.push_back(face_pt.value());
-      }
+    static_assert(sizeof(draco::Mesh::Face) == 3u * sizeof(uint32_t));
+    uint32_t const face_count = draco_mesh->num_faces();
+    indices.resize(3u * face_count);
+    if (face_count > 0u) {
+      std::memcpy(indices.data(), &draco_mesh->face(draco::FaceIndex(0u)), indices.size() * sizeof(uint32_t));
     }
   }
 #endif
@@ -154,6 +178,138 @@ bool DecompressDracoPrimitive(cgltf_primitive const& prim, std::vector<VertexInt
 
 // ----------------------------------------------------------------------------
 
+/* Decode a meshopt compressed buffer view into its 'data', allocated with cgltf. */
+bool DecodeMeshoptBufferView(cgltf_buffer_view& view, cgltf_memory_options const& memory) {
+  cgltf_meshopt_compression const& meshopt = view.meshopt_compression;
+  if (!meshopt.buffer || !meshopt.buffer->data) {
+    LOGE("[GLTF] Meshopt compressed buffer is missing.");
+    return false;
+  }
+  uint8_t const* src = static_cast<uint8_t const*>(meshopt.buffer->data) + meshopt.offset;
+
+  size_t const size = meshopt.count * meshopt.stride;
+  void* dst = memory.alloc_func(memory.user_data, std::max(size, size_t(1u)));
+  if (!dst) {
+    return false;
+  }
+
+  int result{-1};
+  switch (meshopt.mode) {
+    case cgltf_meshopt_compression_mode_attributes:
+      result = meshopt_decodeVertexBuffer(dst, meshopt.count, meshopt.stride, src, meshopt.size);
+    break;
+
+    case cgltf_meshopt_compression_mode_triangles:
+      result = meshopt_decodeIndexBuffer(dst, meshopt.count, meshopt.stride, src, meshopt.size);
+    break;
+
+    case cgltf_meshopt_compression_mode_indices:
+      result = meshopt_decodeIndexSequence(dst, meshopt.count, meshopt.stride, src, meshopt.size);
+    break;
+
+    default:
+    break;
+  }
+  if (result != 0) {
+    LOGE("[GLTF] Meshopt buffer view decoding failed ({}).", result);
+    memory.free_func(memory.user_data, dst);
+    return false;
+  }
+
+  switch (meshopt.filter) {
+    case cgltf_meshopt_compression_filter_octahedral:
+      meshopt_decodeFilterOct(dst, meshopt.count, meshopt.stride);
+    break;
+
+    case cgltf_meshopt_compression_filter_quaternion:
+      meshopt_decodeFilterQuat(dst, meshopt.count, meshopt.stride);
+    break;
+
+    case cgltf_meshopt_compression_filter_exponential:
+      meshopt_decodeFilterExp(dst, meshopt.count, meshopt.stride);
+    break;
+
+    default:
+    break;
+  }
+
+  view.data = dst;
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+/* Convert a whole accessor with the bulk decoder, return false when its layout is unsupported. */
+bool DecodeAccessorFloats(
+  cgltf_accessor const* accessor,
+  float* dst,
+  size_t dst_stride,
+  uint32_t dst_components
+) {
+  using namespace internal::accessor_decoder;
+
+  cgltf_buffer_view const* view = accessor->buffer_view;
+  if (accessor->is_sparse || !view) {
+    return false;
+  }
+
+  ComponentType type{};
+  switch (accessor->component_type) {
+    case cgltf_component_type_r_8:    type = ComponentType::I8;  break;
+    case cgltf_component_type_r_8u:   type = ComponentType::U8;  break;
+    case cgltf_component_type_r_16:   type = ComponentType::I16; break;
+    case cgltf_component_type_r_16u:  type = ComponentType::U16; break;
+    case cgltf_component_type_r_32u:  type = ComponentType::U32; break;
+    case cgltf_component_type_r_32f:  type = ComponentType::F32; break;
+    default:
+      return false;
+  }
+
+  // (meshopt compressed views are decoded into 'view->data')
+  uint8_t const* view_data = view->data ? static_cast<uint8_t const*>(view->data)
+                           : (view->buffer && view->buffer->data)
+                           ? static_cast<uint8_t const*>(view->buffer->data) + view->offset
+                           : nullptr;
+  if (!view_data) {
+    return false;
+  }
+
+  Layout const layout{
+    .type = type,
+    .components = static_cast<uint32_t>(cgltf_num_components(accessor->type)),
+    .normalized = static_cast<bool>(accessor->normalized),
+    .stride = accessor->stride,
+  };
+
+  return DecodeFloats(
+    view_data + accessor->offset, layout, accessor->count, dst, dst_stride, dst_components
+  );
+}
+
+// ----------------------------------------------------------------------------
+
+/* Read a float attribute for every vertices, in bulk when possible. */
+template<typename MemberPtr>
+void ReadVertexAttribute(
+  cgltf_accessor const* accessor,
+  MemberPtr member,
+  uint32_t components,
+  std::vector<VertexInternal_t>& vertices
+) {
+  if (vertices.empty()) {
+    return;
+  }
+  if (DecodeAccessorFloats(accessor, lina::ptr(vertices[0].*member), sizeof(VertexInternal_t), components)) {
+    return;
+  }
+  for (cgltf_size vertex_index = 0; vertex_index < vertices.size(); ++vertex_index) {
+    auto& vertex = vertices[vertex_index];
+    cgltf_accessor_read_float( accessor, vertex_index, lina::ptr(vertex.*member), components);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
 void ExtractPrimitiveVertices(cgltf_primitive const& prim, std::vector<VertexInternal_t>& vertices) {
   uint32_t const vertex_count = prim.attributes[0].data->count;
   vertices.resize(vertex_count);
@@ -167,40 +323,28 @@ void ExtractPrimitiveVertices(cgltf_primitive const& prim, std::vector<VertexInt
     if (attrib.type == cgltf_attribute_type_position) {
       LOG_CHECK(accessor->type == cgltf_type_vec3);
       // LOGD( "> loading positions." );
-      for (cgltf_size vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
-        auto& vertex = vertices[vertex_index];
-        cgltf_accessor_read_float( accessor, vertex_index, lina::ptr(vertex.position), 3);
-      }
+      ReadVertexAttribute(accessor, &VertexInternal_t::position, 3u, vertices);
     }
     // Normals.
     else if (attrib.type == cgltf_attribute_type_normal) {
       LOG_CHECK(accessor->type == cgltf_type_vec3);
       // LOGD( "> loading normals." );
-      for (cgltf_size vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
-        auto& vertex = vertices[vertex_index];
-        cgltf_accessor_read_float( accessor, vertex_index, lina::ptr(vertex.normal), 3);
-      }
+      ReadVertexAttribute(accessor, &VertexInternal_t::normal, 3u, vertices);
     }
     // Tangents
     else if (attrib.type == cgltf_attribute_type_tangent) {
       // LOG_CHECK(accessor->type == cgltf_type_vec4);
       // LOGD( "> loading tangents." );
-      for (cgltf_size vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
-        auto& vertex = vertices[vertex_index];
-        cgltf_accessor_read_float( accessor, vertex_index, lina::ptr(vertex.tangent), 4);
-        // vec3 t3 = vec3(linalg::mul(world_matrix, vec4(lina::to_vec3(tangent), 0.0f)));
-        // vertex.tangent = vec4(t3, vertex.tangent.w);
-      }
+      ReadVertexAttribute(accessor, &VertexInternal_t::tangent, 4u, vertices);
+      // vec3 t3 = vec3(linalg::mul(world_matrix, vec4(lina::to_vec3(tangent), 0.0f)));
+      // vertex.tangent = vec4(t3, vertex.tangent.w);
     }
     // Texcoords.
     else if (attrib.type == cgltf_attribute_type_texcoord) {
       LOG_CHECK(accessor->type == cgltf_type_vec2);
       if (attrib.index <= 0) {
         // LOGD( "> loading texture coordinates." );
-        for (cgltf_size vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
-          auto& vertex = vertices[vertex_index];
-          cgltf_accessor_read_float( accessor, vertex_index, lina::ptr(vertex.texcoord), 2);
-        }
+        ReadVertexAttribute(accessor, &VertexInternal_t::texcoord, 2u, vertices);
       }
     }
     // Joints.
@@ -235,12 +379,118 @@ void ExtractPrimitiveVertices(cgltf_primitive const& prim, std::vector<VertexInt
 //   };
 // }
 
+// ----------------------------------------------------------------------------
+
+/* Image sampled for a texture, preferring its KHR_texture_basisu source. */
+cgltf_image const* TextureImage(cgltf_texture const& texture) {
+  return (texture.has_basisu && texture.basisu_image) ? texture.basisu_image
+                                                      : texture.image
+                                                      ;
+}
+
+/* How the materials sample an image. */
+struct ImageUsage {
+  scene::ImageData::Channels channels{scene::ImageData::Channels::RGBA};
+  bool srgb{};
+};
+
+/**
+ * Usage of each image by the materials : images only used as normal maps
+ * need two channels, images only used as occlusion maps need one, and base
+ * color and emissive maps hold sRGB colors.
+ **/
+std::unordered_map<cgltf_image const*, ImageUsage> ImageUsages(cgltf_data const* data) {
+  enum Usage : uint32_t {
+    kNormal    = 1u << 0u,
+    kOcclusion = 1u << 1u,
+    kColor     = 1u << 2u,
+    kOther     = 1u << 3u,
+  };
+
+  std::unordered_map<cgltf_image const*, uint32_t> usages{};
+  auto use{[&usages](cgltf_texture_view const& view, uint32_t usage) {
+    if (view.texture) {
+      if (auto const* image = TextureImage(*view.texture); image) {
+        usages[image] |= usage;
+      }
+    }
+  }};
+  for (cgltf_size i = 0; i < data->materials_count; ++i) {
+    cgltf_material const& mat = data->materials[i];
+    use(mat.normal_texture, kNormal);
+    use(mat.occlusion_texture, kOcclusion);
+    use(mat.emissive_texture, kColor);
+    use(mat.pbr_metallic_roughness.base_color_texture, kColor);
+    use(mat.pbr_metallic_roughness.metallic_roughness_texture, kOther);
+  }
+
+  std::unordered_map<cgltf_image const*, ImageUsage> image_usages{};
+  for (auto const& [image, usage] : usages) {
+    image_usages[image] = {
+      .channels = (usage == kNormal)    ? scene::ImageData::Channels::RG
+                : (usage == kOcclusion) ? scene::ImageData::Channels::R
+                                        : scene::ImageData::Channels::RGBA
+                                        ,
+      .srgb = (usage & kColor) != 0u,
+    };
+  }
+  return image_usages;
+}
+
 } // namespace ""
 
 /* -------------------------------------------------------------------------- */
 
 namespace internal::gltf_loader {
 
+bool DecodeMeshoptBuffers(cgltf_data* data, bool const bParallel) {
+  std::vector<cgltf_buffer_view*> views{};
+  for (cgltf_size i = 0; i < data->buffer_views_count; ++i) {
+    cgltf_buffer_view& view = data->buffer_views[i];
+    if (view.has_meshopt_compression && !view.data) {
+      views.push_back(&view);
+    }
+  }
+  if (views.empty()) {
+    return true;
+  }
+
+  using Clock = std::chrono::steady_clock;
+  auto const start_time{ Clock::now() };
+
+  // (bytes rather than bools, as jobs write them concurrently)
+  std::vector<uint8_t> decoded(views.size(), 0u);
+  auto decode{[&](uint32_t i) {
+    decoded[i] = DecodeMeshoptBufferView(*views[i], data->memory) ? 1u : 0u;
+  }};
+  uint32_t const view_count = static_cast<uint32_t>(views.size());
+  if (bParallel) {
+    utils::ParallelFor(0u, view_count, decode);
+  } else {
+    for (uint32_t i = 0u; i < view_count; ++i) {
+      decode(i);
+    }
+  }
+
+  double const elapsed_ms{ std::chrono::duration<double, std::milli>(Clock::now() - start_time).count() };
+
+  size_t decoded_bytes{0u};
+  uint32_t decoded_count{0u};
+  for (uint32_t i = 0u; i < view_count; ++i) {
+    if (decoded[i]) {
+      decoded_bytes += views[i]->meshopt_compression.count * views[i]->meshopt_compression.stride;
+      ++decoded_count;
+    }
+  }
+  LOGI("[GLTF] {} meshopt buffer views decoded in {:.2f} ms ({:.2f} MB).",
+    decoded_count, elapsed_ms, decoded_bytes / (1024.0 * 1024.0)
+  );
+
+  return decoded_count == view_count;
+}
+
+// ----------------------------------------------------------------------------
+
 PointerToSamplerMap_t ExtractSamplers(
   cgltf_data const* data,
   std::vector<scene::Sampler>& samplers
@@ -264,6 +514,8 @@ PointerToSamplerMap_t ExtractSamplers(
 
 PointerToIndexMap_t ExtractImages(
   cgltf_data const* data,
+  scene::ImageData::BlockCompression const texture_compression,
+  bool const generate_mipmaps,
   std::vector<scene::ImageData>& images
 ) {
   PointerToIndexMap_t image_indices{};
@@ -271,6 +523,8 @@ PointerToIndexMap_t ExtractImages(
   uint32_t const index_offset = static_cast<uint32_t>(images.size());
   // images.reserve(images.size() + data->images_count);
 
+  auto const image_usages{ ImageUsages(data) };
+
   stbi_set_flip_vertically_on_load(false); //
   for (cgltf_size image_id = 0; image_id < data->images_count; ++image_id) {
     cgltf_image const& gl_image = data->images[image_id];
@@ -286,7 +540,24 @@ PointerToIndexMap_t ExtractImages(
 
     /* Image tasks should be retrieved outside this function via 'image->getLoadAsyncResult()' */
     images.emplace_back();
-    images.back().loadAsync(buffer_data, buffer_view->size);
+    auto const it = image_usages.find(&gl_image);
+    ImageUsage const usage{ (it != image_usages.end()) ? it->second : ImageUsage{} };
+    if (scene::ImageData::IsKTX2(buffer_data, static_cast<uint32_t>(buffer_view->size))) {
+      images.back().loadKTX2Async(
+        buffer_data,
+        static_cast<uint32_t>(buffer_view->size),
+        texture_compression,
+        usage.channels
+      );
+    } else {
+      using MipmapFilter = scene::ImageData::MipmapFilter;
+      images.back().loadAsync(
+        buffer_data,
+        buffer_view->size,
+        !generate_mipmaps ? MipmapFilter::None
+                          : usage.srgb ? MipmapFilter::sRGB : MipmapFilter::Linear
+      );
+    }
 
     uint32_t const image_index = index_offset + static_cast<uint32_t>(image_id);
     image_indices.try_emplace(&gl_image, image_index);
@@ -314,11 +585,12 @@ PointerToIndexMap_t ExtractTextures(
     if (gl_texture.sampler == nullptr) {
       LOGD("{} : empty sampler on glTF texture.", __FUNCTION__);
     }
-    LOG_CHECK(image_indices.contains(gl_texture.image));
+    cgltf_image const* image = TextureImage(gl_texture);
+    LOG_CHECK(image_indices.contains(image));
     LOG_CHECK(samplers_lut.contains(gl_texture.sampler));
 
     textures.emplace_back(
-      image_indices.at(gl_texture.image),
+      image_indices.at(image),
       samplers_lut.at(gl_texture.sampler)
     );
 
@@ -398,587 +670,1314 @@ PointerToIndexMap_t ExtractMaterials(
 
 // ----------------------------------------------------------------------------
 
+namespace {
+
+/* Rotation of an orthonormal 3x3 matrix, given by columns. */
+vec4f QuaternionFromBasis(vec3f const& x, vec3f const& y, vec3f const& z) {
+  float const trace = x.x + y.y + z.z;
+  vec4f q{};
+  if (trace > 0.0f) {
+    float const s = 0.5f / std::sqrt(trace + 1.0f);
+    q = vec4f((y.z - z.y) * s, (z.x - x.z) * s, (x.y - y.x) * s, 0.25f / s);
+  } else if ((x.x > y.y) && (x.x > z.z)) {
+    float const s = 2.0f * std::sqrt(1.0f + x.x - y.y - z.z);
+    q = vec4f(0.25f * s, (y.x + x.y) / s, (z.x + x.z) / s, (y.z - z.y) / s);
+  } else if (y.y > z.z) {
+    float const s = 2.0f * std::sqrt(1.0f + y.y - x.x - z.z);
+    q = vec4f((y.x + x.y) / s, 0.25f * s, (z.y + y.z) / s, (z.x - x.z) / s);
+  } else {
+    float const s = 2.0f * std::sqrt(1.0f + z.z - x.x - y.y);
+    q = vec4f((z.x + x.z) / s, (z.y + y.z) / s, 0.25f * s, (x.y - y.x) / s);
+  }
+  return linalg::normalize(q);
+}
+
+/* Local transform of a joint node, its scale being made uniform. */
+scene::Pose::Transform JointRestTransform(cgltf_node const& node) {
+  scene::Pose::Transform transform{};
+
+  if (node.has_matrix) {
+    mat4f local{};
+    cgltf_node_transform_local(&node, lina::ptr(local));
+    vec3f const x{ lina::to_vec3(local.x) };
+    vec3f const y{ lina::to_vec3(local.y) };
+    vec3f const z{ lina::to_vec3(local.z) };
+    float const scale = linalg::length(x);
+    transform.translation = lina::to_vec3(local.w);
+    transform.scale = scale;
+    transform.rotation = (scale > 0.0f) ? QuaternionFromBasis(x / scale, y / scale, z / scale)
+                                        : lina::qidentity<float>()
+                                        ;
+    return transform;
+  }
+
+  if (node.has_rotation) {
+    transform.rotation = vec4f(node.rotation[0], node.rotation[1], node.rotation[2], node.rotation[3]);
+  }
+  if (node.has_translation) {
+    transform.translation = vec3f(node.translation[0], node.translation[1], node.translation[2]);
+  }
+  if (node.has_scale) {
+    transform.scale = node.scale[0];
+  }
+  return transform;
+}
+
+} // namespace ""
+
+// ----------------------------------------------------------------------------
+
 PointerToIndexMap_t ExtractSkeletons(
   cgltf_data const* data,
   scene::ResourceBuffer<scene::Skeleton>& skeletons
 ) {
   PointerToIndexMap_t skeleton_indices{};
 
+  for (cgltf_size i = 0; i < data->skins_count; ++i) {
+    cgltf_skin const& skin = data->skins[i];
+    cgltf_size const joint_count = skin.joints_count;
+    if (joint_count == 0u) {
+      continue;
+    }
+
+    auto skeleton = std::make_unique<scene::Skeleton>(joint_count);
+
+    // LUT Map to find parent nodes index.
+    std::unordered_map<cgltf_node const*, int32_t> joint_indices(joint_count);
+    for (cgltf_size joint_index = 0; joint_index < joint_count; ++joint_index) {
+      joint_indices[skin.joints[joint_index]] = static_cast<int32_t>(joint_index);
+    }
+
+    // Fill skeleton basic data, parents being the closest joint ancestor.
+    for (cgltf_size joint_index = 0; joint_index < joint_count; ++joint_index) {
+      cgltf_node const* joint = skin.joints[joint_index];
+
+      std::string const joint_name = joint->name ? std::string(joint->name)
+                                                 : fmt::format("Skin_{}::Joint_{}", i, joint_index);
+      int32_t parent_index = -1;
+      for (cgltf_node const* node = joint->parent; node != nullptr; node = node->parent) {
+        if (auto it = joint_indices.find(node); it != joint_indices.end()) {
+          parent_index = it->second;
+          break;
+        }
+      }
+
+      skeleton->names[joint_index] = joint_name;
+      skeleton->parents[joint_index] = parent_index;
+      skeleton->index_map[joint_name] = static_cast<int32_t>(joint_index);
+      skeleton->rest_pose.set_joint(static_cast<uint32_t>(joint_index), JointRestTransform(*joint));
+    }
+
+    // Bind matrices, in the skin space.
+    auto& inverse_bind_matrices = skeleton->inverse_bind_matrices;
+    if (skin.inverse_bind_matrices) {
+      cgltf_accessor_unpack_floats(
+        skin.inverse_bind_matrices, lina::ptr(inverse_bind_matrices[0]), 16u * joint_count
+      );
+    } else {
+      std::fill(inverse_bind_matrices.begin(), inverse_bind_matrices.end(), mat4f(linalg::identity));
+    }
+    for (cgltf_size joint_index = 0; joint_index < joint_count; ++joint_index) {
+      skeleton->global_bind_matrices[joint_index] = linalg::inverse(inverse_bind_matrices[joint_index]);
+    }
+
+    if (!skeleton->sort_joints()) {
+      LOGW("[GLTF] skin {} joints hierarchy is not a tree.", i);
+      continue;
+    }
+
+    skeleton_indices[&skin] = static_cast<uint32_t>(skeletons.size());
+    skeletons.push_back(std::move(skeleton));
+  }
+
   return skeleton_indices;
 }
 
 // ----------------------------------------------------------------------------
 
-void ExtractMeshes(
-  cgltf_data const* data,
+namespace {
+
+// Largest vertex count addressable by 16bit indices.
+uint32_t constexpr kMaxVerticesPer16bitsPrimitive{ 1u << 16u };
+
+// Accepted ACMR increase when reordering triangles for overdraw.
+float constexpr kOverdrawThreshold{ 1.05f };
+
+/* Indices of a primitive, as stored in its accessor or decoded by Draco. */
+struct IndexSource {
+  uint8_t const* data{};
+  internal::accessor_decoder::ComponentType type{};
+  size_t stride{};
+  size_t count{};
+};
+
+// ----------------------------------------------------------------------------
+
+/* Draco primitive decoded ahead of its mesh extraction. */
+struct DracoPrimitive {
+  std::vector<VertexInternal_t> vertices{};
+  std::vector<uint32_t> indices{};
+  bool decoded{};
+};
+
+using DracoPrimitiveMap_t = std::unordered_map<cgltf_primitive const*, DracoPrimitive>;
+
+/**
+ * Decode every Draco primitive of the meshes, one job per primitive, and log
+ * the time spent.
+ **/
+DracoPrimitiveMap_t DecodeDracoPrimitives(std::vector<cgltf_mesh const*> const& meshes, bool const bParallel) {
+  DracoPrimitiveMap_t primitives{};
+  if constexpr (!kFrameworkHasDraco) {
+    return primitives;
+  }
+
+  // (slots are created upfront, so jobs only write to their own)
+  std::vector<std::pair<cgltf_primitive const*, DracoPrimitive*>> jobs{};
+  for (auto const* mesh : meshes) {
+    for (cgltf_size i = 0; i < mesh->primitives_count; ++i) {
+      cgltf_primitive const& prim = mesh->primitives[i];
+      if (prim.has_draco_mesh_compression && (prim.attributes_count > 0u)) {
+        auto const [it, inserted] = primitives.try_emplace(&prim);
+        if (inserted) {
+          jobs.emplace_back(&prim, &it->second);
+        }
+      }
+    }
+  }
+  if (jobs.empty()) {
+    return primitives;
+  }
+
+  using Clock = std::chrono::steady_clock;
+  auto const start_time{ Clock::now() };
+
+  auto decode{[&jobs](uint32_t i) {
+    auto& [prim, dst] = jobs[i];
+    dst->decoded = DecompressDracoPrimitive(*prim, dst->vertices, dst->indices);
+  }};
+  uint32_t const job_count = static_cast<uint32_t>(jobs.size());
+  if (bParallel) {
+    utils::ParallelFor(0u, job_count, decode);
+  } else {
+    for (uint32_t i = 0u; i < job_count; ++i) {
+      decode(i);
+    }
+  }
+
+  double const elapsed_ms{ std::chrono::duration<double, std::milli>(Clock::now() - start_time).count() };
+  LOGI("[GLTF] {} Draco primitives decoded in {:.2f} ms.", job_count, elapsed_ms);
+
+  return primitives;
+}
+
+// ----------------------------------------------------------------------------
+
+/* Locate the indices of an accessor, return false when unsupported. */
+bool GetIndexSource(cgltf_accessor const* accessor, IndexSource& source) {
+  using internal::accessor_decoder::ComponentType;
+
+  cgltf_buffer_view const* view = accessor->buffer_view;
+  if (accessor->is_sparse || !view) {
+    return false;
+  }
+
+  ComponentType type{};
+  switch (accessor->component_type) {
+    case cgltf_component_type_r_8u:   type = ComponentType::U8;  break;
+    case cgltf_component_type_r_16u:  type = ComponentType::U16; break;
+    case cgltf_component_type_r_32u:  type = ComponentType::U32; break;
+    default:
+      return false;
+  }
+
+  // (meshopt compressed views are decoded into 'view->data')
+  uint8_t const* view_data = view->data ? static_cast<uint8_t const*>(view->data)
+                           : (view->buffer && view->buffer->data)
+                           ? static_cast<uint8_t const*>(view->buffer->data) + view->offset
+                           : nullptr;
+  if (!view_data) {
+    return false;
+  }
+
+  size_t const index_size = cgltf_component_size(accessor->component_type);
+  source = {
+    .data = view_data + accessor->offset,
+    .type = type,
+    .stride = accessor->stride ? accessor->stride : index_size,
+    .count = accessor->count,
+  };
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+/* Append a primitive with its own vertices and indices to a restructured mesh. */
+void AddRestructuredPrimitive(
+  scene::Mesh& mesh,
+  std::span<VertexInternal_t const> vertices,
+  std::span<std::byte const> indices,
+  uint32_t index_count,
+  Geometry::IndexFormat index_format,
+  Geometry::Topology topology,
+  scene::MaterialRef const* material_ref
+) {
+  Geometry::Primitive primitive{
+    .topology = topology,
+    .vertexCount = static_cast<uint32_t>(vertices.size()),
+  };
+  if (!indices.empty()) {
+    primitive.indexCount = index_count;
+    primitive.indexOffset = mesh.add_indices_data(indices);
+    primitive.indexFormat = index_format;
+  }
+
+  /* Add the primitive interleaved attributes to the mesh, and retrieve its internal offset. */
+  uint64_t const attribs_buffer_offset = mesh.add_vertices_data(std::as_bytes(vertices));
+  primitive.bufferOffsets = VertexInternal_t::GetAttributeOffsetMap(attribs_buffer_offset);
+
+  mesh.add_primitive(primitive);
+  mesh.submeshes.push_back({ .parent = &mesh, .material_ref = material_ref });
+}
+
+// ----------------------------------------------------------------------------
+
+/**
+ * Split a triangle list in chunks of at most kMaxVerticesPer16bitsPrimitive
+ * vertices, calling emit(chunk_vertices, chunk_indices) for each of them.
+ *
+ * Triangles are kept in order, and vertices shared by several chunks are
+ * duplicated.
+ **/
+template<typename EmitFn>
+void SplitTriangleList(
+  std::span<VertexInternal_t const> vertices,
+  std::span<uint32_t const> indices,
+  EmitFn&& emit
+) {
+  // Source vertex index to chunk vertex index.
+  std::vector<uint32_t> remap(vertices.size(), kInvalidIndexU32);
+
+  std::vector<uint32_t> chunk_sources{};
+  std::vector<VertexInternal_t> chunk_vertices{};
+  std::vector<uint16_t> chunk_indices{};
+  chunk_sources.reserve(kMaxVerticesPer16bitsPrimitive);
+  chunk_vertices.reserve(kMaxVerticesPer16bitsPrimitive);
+
+  auto flush{[&] {
+    if (!chunk_indices.empty()) {
+      emit(std::span<VertexInternal_t const>(chunk_vertices), std::span<uint16_t const>(chunk_indices));
+    }
+    for (auto const src : chunk_sources) {
+      remap[src] = kInvalidIndexU32;
+    }
+    chunk_sources.clear();
+    chunk_vertices.clear();
+    chunk_indices.clear();
+  }};
+
+  size_t skipped_count{0u};
+  for (size_t i = 0u; i + 2u < indices.size(); i += 3u) {
+    uint32_t const triangle[3u]{ indices[i], indices[i + 1u], indices[i + 2u] };
+
+    if ((triangle[0u] >= vertices.size())
+     || (triangle[1u] >= vertices.size())
+     || (triangle[2u] >= vertices.size())) {
+      ++skipped_count;
+      continue;
+    }
+
+    // (conservative when a triangle references the same vertex twice)
+    size_t new_vertex_count{0u};
+    for (auto const index : triangle) {
+      new_vertex_count += (remap[index] == kInvalidIndexU32) ? 1u : 0u;
+    }
+    if (chunk_vertices.size() + new_vertex_count > kMaxVerticesPer16bitsPrimitive) {
+      flush();
+    }
+
+    for (auto const index : triangle) {
+      if (remap[index] == kInvalidIndexU32) {
+        remap[index] = static_cast<uint32_t>(chunk_vertices.size());
+        chunk_sources.push_back(index);
+        chunk_vertices.push_back(vertices[index]);
+      }
+      chunk_indices.push_back(static_cast<uint16_t>(remap[index]));
+    }
+  }
+  flush();
+
+  if (skipped_count > 0u) {
+    LOGW("[GLTF] {} triangles with out of range indices were skipped.", skipped_count);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+/**
+ * Optimize every primitive of the meshes for vertex cache, overdraw and
+ * vertex fetch, one job per primitive, and log the cache statistics.
+ **/
+void OptimizePrimitives(std::vector<std::unique_ptr<scene::Mesh>> const& meshes, bool const bParallel) {
+  struct Job {
+    scene::Mesh* mesh{};
+    uint32_t primitive_index{};
+    Geometry::CacheStatistics before{};
+    Geometry::CacheStatistics after{};
+    bool optimized{};
+  };
+
+  std::vector<Job> jobs{};
+  for (auto const& mesh : meshes) {
+    if (mesh) {
+      for (uint32_t i = 0u; i < mesh->get_primitive_count(); ++i) {
+        jobs.push_back({ .mesh = mesh.get(), .primitive_index = i });
+      }
+    }
+  }
+
+  using Clock = std::chrono::steady_clock;
+  auto const start_time{ Clock::now() };
+
+  auto optimize{[&jobs](uint32_t i) {
+    auto& job = jobs[i];
+    job.optimized = job.mesh->optimize_primitive(job.primitive_index, kOverdrawThreshold, &job.before, &job.after);
+  }};
+  uint32_t const job_count = static_cast<uint32_t>(jobs.size());
+  if (bParallel) {
+    utils::ParallelFor(0u, job_count, optimize);
+  } else {
+    for (uint32_t i = 0u; i < job_count; ++i) {
+      optimize(i);
+    }
+  }
+
+  double const elapsed_ms{ std::chrono::duration<double, std::milli>(Clock::now() - start_time).count() };
+
+  // ACMR are weighted by triangles, ATVR by vertices.
+  uint32_t optimized_count{0u};
+  double triangle_count{0.0};
+  double vertex_count{0.0};
+  double acmr_before{0.0}, acmr_after{0.0};
+  double atvr_before{0.0}, atvr_after{0.0};
+  for (auto const& job : jobs) {
+    if (!job.optimized) {
+      continue;
+    }
+    auto const& prim = job.mesh->get_primitive(job.primitive_index);
+    double const triangles = prim.indexCount / 3u;
+    double const vertices = prim.vertexCount;
+    acmr_before += job.before.acmr * triangles;
+    acmr_after += job.after.acmr * triangles;
+    atvr_before += job.before.atvr * vertices;
+    atvr_after += job.after.atvr * vertices;
+    triangle_count += triangles;
+    vertex_count += vertices;
+    ++optimized_count;
+  }
+
+  if (optimized_count > 0u) {
+    LOGI("[GLTF] {} primitives optimized in {:.2f} ms : ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}.",
+      optimized_count,
+      elapsed_ms,
+      acmr_before / triangle_count, acmr_after / triangle_count,
+      atvr_before / vertex_count, atvr_after / vertex_count
+    );
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+/**
+ * Split the meshes primitives into meshlets, one job per mesh, and log their
+ * count and average occupancy.
+ **/
+void BuildMeshlets(std::vector<std::unique_ptr<scene::Mesh>> const& meshes, bool const bParallel) {
+  using Clock = std::chrono::steady_clock;
+  auto const start_time{ Clock::now() };
+
+  auto build{[&meshes](uint32_t i) {
+    if (meshes[i]) {
+      meshes[i]->build_meshlets();
+    }
+  }};
+  uint32_t const mesh_count = static_cast<uint32_t>(meshes.size());
+  if (bParallel) {
+    utils::ParallelFor(0u, mesh_count, build);
+  } else {
+    for (uint32_t i = 0u; i < mesh_count; ++i) {
+      build(i);
+    }
+  }
+
+  double const elapsed_ms{ std::chrono::duration<double, std::milli>(Clock::now() - start_time).count() };
+
+  uint64_t meshlet_count{0u};
+  uint64_t triangle_count{0u};
+  for (auto const& mesh : meshes) {
+    if (!mesh) {
+      continue;
+    }
+    for (auto const& meshlet : mesh->get_meshlets()) {
+      triangle_count += meshlet.indexCount / 3u;
+    }
+    meshlet_count += mesh->get_meshlets().size();
+  }
+
+  if (meshlet_count > 0u) {
+    LOGI("[GLTF] {} meshlets built in {:.2f} ms : {:.1f} triangles per meshlet on average (max {}).",
+      meshlet_count,
+      elapsed_ms,
+      triangle_count / static_cast<double>(meshlet_count),
+      Geometry::kMeshletMaxTriangles
+    );
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+/**
+ * Simplify the meshes primitives into LOD chains, one job per mesh, and log
+ * how much the coarsest levels reduce the triangle count.
+ **/
+void BuildLods(std::vector<std::unique_ptr<scene::Mesh>> const& meshes, bool const bParallel) {
+  using Clock = std::chrono::steady_clock;
+  auto const start_time{ Clock::now() };
+
+  auto build{[&meshes](uint32_t i) {
+    if (meshes[i]) {
+      meshes[i]->build_lods();
+    }
+  }};
+  uint32_t const mesh_count = static_cast<uint32_t>(meshes.size());
+  if (bParallel) {
+    utils::ParallelFor(0u, mesh_count, build);
+  } else {
+    for (uint32_t i = 0u; i < mesh_count; ++i) {
+      build(i);
+    }
+  }
+
+  double const elapsed_ms{ std::chrono::duration<double, std::milli>(Clock::now() - start_time).count() };
+
+  uint64_t level_count{0u};
+  uint64_t triangle_count{0u};
+  uint64_t coarsest_triangle_count{0u};
+  for (auto const& mesh : meshes) {
+    if (!mesh) {
+      continue;
+    }
+    for (uint32_t i = 0u; i < mesh->get_primitive_count(); ++i) {
+      auto const lods = mesh->get_lods(i);
+      uint32_t const index_count = mesh->get_primitive(i).indexCount;
+      triangle_count += index_count / 3u;
+      coarsest_triangle_count += (lods.empty() ? index_count : lods.back().indexCount) / 3u;
+    }
+    level_count += mesh->get_lods().size();
+  }
+
+  if (level_count > 0u) {
+    LOGI("[GLTF] {} LOD levels built in {:.2f} ms : {} -> {} triangles at the coarsest levels.",
+      level_count,
+      elapsed_ms,
+      triangle_count,
+      coarsest_triangle_count
+    );
+  }
+}
+
+/**
+ * Convert the meshes vertices to the VertexCompact_t layout, one job per mesh,
+ * and log their size and precision.
+ **/
+void CompactMeshes(
+  std::vector<std::unique_ptr<scene::Mesh>> const& meshes,
+  std::vector<cgltf_mesh const*> const& source_meshes,
+  bool const bParallel
+) {
+  using internal::vertex_quantizer::Report;
+
+  std::vector<Report> reports(meshes.size());
+  std::vector<uint8_t> compacted(meshes.size(), 0u);
+
+  auto compact{[&](uint32_t i) {
+    if (meshes[i]) {
+      compacted[i] = internal::vertex_quantizer::CompactMeshVertices(*meshes[i], &reports[i]) ? 1u : 0u;
+    }
+  }};
+  uint32_t const mesh_count = static_cast<uint32_t>(meshes.size());
+  if (bParallel) {
+    utils::ParallelFor(0u, mesh_count, compact);
+  } else {
+    for (uint32_t i = 0u; i < mesh_count; ++i) {
+      compact(i);
+    }
+  }
+
+  double const kKilobyte{ 1024.0 };
+  uint64_t source_bytes{0u};
+  uint64_t compact_bytes{0u};
+  for (uint32_t i = 0u; i < mesh_count; ++i) {
+    if (!compacted[i]) {
+      continue;
+    }
+    auto const& r = reports[i];
+    char const* name = source_meshes[i]->name ? source_meshes[i]->name : "";
+    LOGI("[GLTF] mesh {} \"{}\" : {} vertices, {:.1f} -> {:.1f} KB, max error position {:.2e} ({:.4f}% of extent), normal {:.3f} deg, tangent {:.3f} deg, texcoord {:.2e}.",
+      i, name,
+      r.vertex_count,
+      r.source_bytes / kKilobyte, r.compact_bytes / kKilobyte,
+      r.max_position_error,
+      (r.max_position_extent > 0.0f) ? 100.0f * r.max_position_error / r.max_position_extent : 0.0f,
+      r.max_normal_error,
+      r.max_tangent_error,
+      r.max_texcoord_error
+    );
+    source_bytes += r.source_bytes;
+    compact_bytes += r.compact_bytes;
+  }
+
+  if (compact_bytes > 0u) {
+    LOGI("[GLTF] compact vertices : {:.2f} -> {:.2f} MB.",
+      source_bytes / (kKilobyte * kKilobyte),
+      compact_bytes / (kKilobyte * kKilobyte)
+    );
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+/**
+ * Append the world transforms of every instance of a mesh node : the node
+ * itself, or each of its EXT_mesh_gpu_instancing instances.
+ **/
+void AppendNodeInstanceTransforms(cgltf_node const& node, std::vector<mat4f>& transforms) {
+  mat4f world_matrix(linalg::identity);
+  cgltf_node_transform_world(&node, lina::ptr(world_matrix));
+
+  if (!node.has_mesh_gpu_instancing) [[likely]] {
+    transforms.push_back(world_matrix);
+    return;
+  }
+
+  cgltf_accessor const* translations{};
+  cgltf_accessor const* rotations{};
+  cgltf_accessor const* scales{};
+  for (cgltf_size i = 0; i < node.mesh_gpu_instancing.attributes_count; ++i) {
+    cgltf_attribute const& attribute = node.mesh_gpu_instancing.attributes[i];
+    if (!attribute.name || !attribute.data) {
+      continue;
+    }
+    std::string_view const name{ attribute.name };
+    if (name == "TRANSLATION") {
+      translations = attribute.data;
+    } else if (name == "ROTATION") {
+      rotations = attribute.data;
+    } else if (name == "SCALE") {
+      scales = attribute.data;
+    }
+  }
+
+  cgltf_size const instance_count = translations ? translations->count
+                                  : rotations ? rotations->count
+                                  : scales ? scales->count
+                                  : 0u;
+  if (instance_count == 0u) {
+    LOGW("[GLTF] EXT_mesh_gpu_instancing node without instances.");
+    return;
+  }
+
+  transforms.reserve(transforms.size() + instance_count);
+  for (cgltf_size i = 0; i < instance_count; ++i) {
+    vec3f translation(0.0f);
+    vec4f rotation = lina::qidentity<float>();
+    vec3f scale(1.0f);
+    if (translations && (i < translations->count)) {
+      cgltf_accessor_read_float(translations, i, lina::ptr(translation), 3u);
+    }
+    if (rotations && (i < rotations->count)) {
+      cgltf_accessor_read_float(rotations, i, lina::ptr(rotation), 4u);
+    }
+    if (scales && (i < scales->count)) {
+      cgltf_accessor_read_float(scales, i, lina::ptr(scale), 3u);
+    }
+    mat4f const local_matrix = linalg::mul(
+      linalg::mul(linalg::translation_matrix(translation), linalg::rotation_matrix(rotation)),
+      linalg::scaling_matrix(scale)
+    );
+    transforms.push_back(linalg::mul(world_matrix, local_matrix));
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+/* True when one of the primitive attributes is stored in a meshopt compressed view. */
+bool HasMeshoptAttributes(cgltf_primitive const& prim) {
+  for (cgltf_size i = 0; i < prim.attributes_count; ++i) {
+    cgltf_buffer_view const* view = prim.attributes[i].data->buffer_view;
+    if (view && view->has_meshopt_compression) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// ----------------------------------------------------------------------------
+
+/**
+ * Extract the geometry of a glTF mesh, return nullptr when the mesh was
+ * bypassed.
+ *
+ * Only reads shared data, so it can safely run concurrently on several meshes.
+ **/
+std::unique_ptr<scene::Mesh> ExtractMesh(
+  cgltf_mesh const& gltf_mesh,
   PointerToIndexMap_t const& materials_indices,
   scene::ResourceBuffer<scene::MaterialRef> const& material_refs,
-  PointerToIndexMap_t const& skeleton_indices,
-  scene::ResourceBuffer<scene::Skeleton>const& skeletons,
-  scene::ResourceBuffer<scene::Mesh>& meshes,
-  std::vector<mat4f>& meshes_transforms,
+  DracoPrimitiveMap_t const& draco_primitives,
   bool const bRestructureAttribs,
-  bool const bForce32bitsIndex
+  bool const bForce32bitsIndex,
+  bool const bSplitLargePrimitives
 ) {
-  /**
-   * Each Mesh hold its geometry,
-   * each primitive consist of a material and offset in the mesh geometry.
-   * We assume every primitives of a Mesh have the same topology / attributes
-   ***/
+  std::vector<uint32_t> valid_prim_indices{};
+  // uint32_t total_vertex_count{0u};
+
+  // -----------------
+  // A. Preprocess primitives.
+  for (cgltf_size prim_index = 0; prim_index < gltf_mesh.primitives_count; ++prim_index) {
+    cgltf_primitive const& prim = gltf_mesh.primitives[prim_index];
 
-  /* Preprocess meshes nodes. */
-  std::vector<uint32_t> meshNodeIndices{};
-  for (cgltf_size i = 0; i < data->nodes_count; ++i) {
-    cgltf_node const& node = data->nodes[i];
-    if (node.mesh) {
-      // mesh_count += node.mesh->primitives_count;
-      meshNodeIndices.push_back(i);
-      if (node.has_mesh_gpu_instancing) {
-        LOGW("[GLTF] GPU instancing not supported.");
+    if (prim.attributes_count <= 0u) {
+      LOGW("[GLTF] A primitive was missing attributes.");
+      continue;
+    }
+    if (prim.has_draco_mesh_compression && (!kFrameworkHasDraco || !bRestructureAttribs)) {
+      LOGW("[GLTF] Draco mesh compression is not supported.");
+      continue;
+    }
+    if (!bRestructureAttribs && HasMeshoptAttributes(prim)) {
+      LOGW("[GLTF] Meshopt compressed primitives require restructured attributes.");
+      continue;
+    }
+    if (prim.type != cgltf_primitive_type_triangles) {
+      LOGW("[GLTF] Non TRIANGLES primitives are not supported.");
+    }
+    if (prim.targets_count > 0) {
+      LOGW("[GLTF] Morph targets are not supported.");
+    }
+    bool is_sparse = false;
+    for (cgltf_size k = 0; k < prim.attributes_count; ++k) {
+      cgltf_attribute const& attribute = prim.attributes[k];
+      cgltf_accessor const* accessor = attribute.data;
+      if (accessor->is_sparse) {
+        LOGW("[GLTF] Sparse attributes are not supported.");
+        is_sparse = true;
+        break;
       }
     }
-  }
-  // meshes.reserve(meshNodeIndices.size());
+    if (is_sparse) {
+      continue;
+    }
 
-  // Parse each mesh nodes (for primitives & skeleton).
-  for (auto mesh_node_index : meshNodeIndices) {
-    cgltf_node const& node = data->nodes[mesh_node_index];
+    // total_vertex_count += prim.attributes[0].data->count;
+    valid_prim_indices.push_back(prim_index);
+  }
 
-    std::vector<uint32_t> valid_prim_indices{};
-    // uint32_t total_vertex_count{0u};
+  if (valid_prim_indices.empty()) {
+    LOGW("[GLTF] A Mesh was bypassed due to unsupported features.");
+    return nullptr;
+  }
 
-    // -----------------
-    // A. Preprocess primitives.
-    for (cgltf_size prim_index = 0; prim_index < node.mesh->primitives_count; ++prim_index) {
-      cgltf_primitive const& prim = node.mesh->primitives[prim_index];
+  // -----------------
+  // B. Create a new mesh.
+  auto mesh = std::make_unique<scene::Mesh>();
+
+  // -----------------
+  // C. Retrieve its vertex attributes and indices.
+  //
+  //      The first branch force the attributes into a specific interleaved format
+  //        allowing the engine to always assume the same layout.
+  //
+  //      The second take the attributes as is.
+  //
+  if (bRestructureAttribs) [[likely]] {
+    mesh->set_attributes(VertexInternal_t::GetAttributeInfoMap());
+
+    // XXX (Do not support different topology yet) XXX
+    mesh->set_topology(Geometry::Topology::TriangleList); // xxx
+
+    // Hold the interleaved attributes of the primitive being parsed.
+    std::vector<VertexInternal_t> vertices{};
+
+    // Index scratch buffers, reused across primitives.
+    std::vector<uint32_t> indices_u32{};
+    std::vector<uint16_t> indices_u16{};
+
+    bool has_32bits_indices{false};
+
+    /* Parse the primitives. */
+    for (size_t prim_index = 0u; prim_index < valid_prim_indices.size(); ++prim_index) {
+      uint32_t const valid_prim_index{ valid_prim_indices[prim_index] };
+      cgltf_primitive const& prim{ gltf_mesh.primitives[valid_prim_index] };
+      LOG_CHECK(prim.type == cgltf_primitive_type_triangles);
+
+      Geometry::Topology const topology{ ConvertTopology(prim) };
+
+      scene::MaterialRef const* material_ref = prim.material ? material_refs[materials_indices.at(prim.material)].get()
+                                                             : nullptr;
+
+      // Attributes & Indices.
+      std::span<VertexInternal_t const> vertices_span{};
+      IndexSource indices{};
+      if (prim.has_draco_mesh_compression) {
+        auto const it = draco_primitives.find(&prim);
+        if ((it == draco_primitives.end()) || !it->second.decoded) {
+          continue;
+        }
+        auto const& draco = it->second;
+        vertices_span = draco.vertices;
+        if (prim.indices) {
+          indices = {
+            .data = reinterpret_cast<uint8_t const*>(draco.indices.data()),
+            .type = internal::accessor_decoder::ComponentType::U32,
+            .stride = sizeof(uint32_t),
+            .count = draco.indices.size(),
+          };
+        }
+      } else {
+        ExtractPrimitiveVertices(prim, vertices);
+        vertices_span = vertices;
+        if (prim.indices && !GetIndexSource(prim.indices, indices)) {
+          LOGD("index format unsupported.");
+        }
+      }
 
-      if (prim.attributes_count <= 0u) {
-        LOGW("[GLTF] A primitive was missing attributes.");
+      if (!indices.data) {
+        AddRestructuredPrimitive(*mesh, vertices_span, {}, 0u, Geometry::IndexFormat::kUnknown, topology, material_ref);
         continue;
       }
-      if (prim.has_draco_mesh_compression && (!kFrameworkHasDraco || !bRestructureAttribs)) {
-        LOGW("[GLTF] Draco mesh compression is not supported.");
+
+      // Keep 16bit indices whenever the primitive vertices can be addressed with them.
+      if (!bForce32bitsIndex && (vertices_span.size() <= kMaxVerticesPer16bitsPrimitive)) [[likely]] {
+        std::span<std::byte const> bytes{};
+        if ((indices.type == internal::accessor_decoder::ComponentType::U16)
+         && (indices.stride == sizeof(uint16_t))) {
+          bytes = std::span(reinterpret_cast<std::byte const*>(indices.data), indices.count * sizeof(uint16_t));
+        } else {
+          indices_u16.resize(indices.count);
+          internal::accessor_decoder::DecodeIndices(
+            indices.data, indices.type, indices.stride, indices.count, indices_u16.data()
+          );
+          bytes = std::as_bytes(std::span(indices_u16));
+        }
+        AddRestructuredPrimitive(
+          *mesh, vertices_span, bytes, static_cast<uint32_t>(indices.count),
+          Geometry::IndexFormat::U16, topology, material_ref
+        );
         continue;
       }
-      if (prim.type != cgltf_primitive_type_triangles) {
-        LOGW("[GLTF] Non TRIANGLES primitives are not supported.");
-      }
-      if (prim.targets_count > 0) {
-        LOGW("[GLTF] Morph targets are not supported.");
-      }
-      bool is_sparse = false;
-      for (cgltf_size k = 0; k < prim.attributes_count; ++k) {
-        cgltf_attribute const& attribute = prim.attributes[k];
-        cgltf_accessor const* accessor = attribute.data;
-        if (accessor->is_sparse) {
-          LOGW("[GLTF] Sparse attributes are not supported.");
-          is_sparse = true;
-          break;
-        }
+
+      // Otherwise widen them to 32bit (used as is when already packed, as for Draco).
+      std::span<uint32_t const> indices_span{};
+      if ((indices.type == internal::accessor_decoder::ComponentType::U32)
+       && (indices.stride == sizeof(uint32_t))) {
+        indices_span = std::span(reinterpret_cast<uint32_t const*>(indices.data), indices.count);
+      } else {
+        indices_u32.resize(indices.count);
+        internal::accessor_decoder::DecodeIndices(
+          indices.data, indices.type, indices.stride, indices.count, indices_u32.data()
+        );
+        indices_span = indices_u32;
       }
-      if (is_sparse) {
+
+      if (!bForce32bitsIndex && bSplitLargePrimitives && (topology == Geometry::Topology::TriangleList)) {
+        SplitTriangleList(vertices_span, indices_span, [&](
+          std::span<VertexInternal_t const> chunk_vertices,
+          std::span<uint16_t const> chunk_indices
+        ) {
+          AddRestructuredPrimitive(
+            *mesh, chunk_vertices, std::as_bytes(chunk_indices), static_cast<uint32_t>(chunk_indices.size()),
+            Geometry::IndexFormat::U16, topology, material_ref
+          );
+        });
         continue;
       }
 
-      // total_vertex_count += prim.attributes[0].data->count;
-      valid_prim_indices.push_back(prim_index);
-    }
-
-    if (valid_prim_indices.empty()) {
-      LOGW("[GLTF] A Mesh was bypassed due to unsupported features.");
-      continue;
+      AddRestructuredPrimitive(
+        *mesh, vertices_span, std::as_bytes(indices_span), static_cast<uint32_t>(indices_span.size()),
+        Geometry::IndexFormat::U32, topology, material_ref
+      );
+      has_32bits_indices = true;
     }
 
-    // -----------------
-    // B. Create a new mesh.
-    auto mesh = std::make_unique<scene::Mesh>();
+    // Default format, for clients not looking at per primitive formats.
+    mesh->set_index_format(has_32bits_indices ? Geometry::IndexFormat::U32 : Geometry::IndexFormat::U16);
+  } else {
+    /* Utility function. */
+    auto isAccessorOffsetFlat{[](cgltf_accessor const* acc) -> bool {
+      size_t const kAccessorOffsetLimit = 2048;
+      return (acc->offset == 0) || (acc->offset >= kAccessorOffsetLimit);
+    }};
+
+    /* Setup the shared attributes from the first primitive.
+     * This assume all mesh primitives share the same layout.
+     */
     {
-      meshes_transforms.emplace_back(linalg::identity);
-      cgltf_node_transform_world(&node, lina::ptr(meshes_transforms.back()));
-      mesh->submeshes.resize(valid_prim_indices.size(), {.parent = mesh.get()});
-    }
-
-    // -----------------
-    // C. Retrieve its vertex attributes and indices.
-    //
-    //      The first branch force the attributes into a specific interleaved format
-    //        allowing the engine to always assume the same layout.
-    //
-    //      The second take the attributes as is.
-    //
-    if (bRestructureAttribs) [[likely]] {
-      mesh->set_attributes(VertexInternal_t::GetAttributeInfoMap());
-
-      // XXX (Do not support different topology yet) XXX
-      mesh->set_topology(Geometry::Topology::TriangleList); // xxx
-
-      // Hold the interleaved attributes of the mesh in the same interleaved buffer.
-      std::vector<VertexInternal_t> vertices{};
-
-      // Offset to the primitive attributes inside the mesh buffer.
-      uint64_t attribs_buffer_offset{0};
-
-      /* Parse the primitives. */
-      for (size_t prim_index = 0u; prim_index < valid_prim_indices.size(); ++prim_index) {
-        uint32_t const valid_prim_index{ valid_prim_indices[prim_index] };
-        cgltf_primitive const& prim{ node.mesh->primitives[valid_prim_index] };
-        LOG_CHECK(prim.type == cgltf_primitive_type_triangles);
-
-        Geometry::Primitive primitive{};
-        primitive.topology = ConvertTopology(prim);
-
-        if (prim.has_draco_mesh_compression) {
-          std::vector<uint32_t> indices{};
-
-          // Attributes & Indices.
-          if (!DecompressDracoPrimitive(prim, vertices, indices)) {
-            continue;
-          }
+      cgltf_primitive const& prim{ gltf_mesh.primitives[valid_prim_indices[0u]] };
 
-          if (prim.indices) {
-            mesh->set_index_format(Geometry::IndexFormat::U32);
-            primitive.indexCount = static_cast<uint32_t>(indices.size());
-            primitive.indexOffset = mesh->add_indices_data(std::as_bytes(std::span(indices)));
-          }
-        } else {
-          // Attributes.
-          ExtractPrimitiveVertices(prim, vertices);
-
-          // Indices.
-          if (prim.indices) {
-            cgltf_accessor const* accessor = prim.indices;
-
-            if (auto index_format = ConvertIndexFormat(accessor);
-                index_format != Geometry::IndexFormat::kUnknown)
-            {
-              primitive.indexCount = accessor->count;
-
-              cgltf_buffer_view const* buffer_view = accessor->buffer_view;
-              cgltf_buffer const* buffer = buffer_view->buffer;
-
-              size_t const index_size = cgltf_component_size(accessor->component_type);
-              size_t const stride = accessor->stride ? accessor->stride : index_size;
-              size_t const total_size = accessor->count * stride;
-
-              std::byte const* src = reinterpret_cast<std::byte const*>(buffer->data) +
-                                buffer_view->offset + accessor->offset;
-              std::vector<uint32_t> indices_u32{};
-
-              // [the same index format should be shared by the whole mesh.]
-              if (bForce32bitsIndex && (index_format != Geometry::IndexFormat::U32)) [[likely]] {
-                indices_u32.reserve(accessor->count);
-                for (size_t i = 0; i < accessor->count; ++i) {
-                  uint32_t val = 0;
-                  switch (accessor->component_type)
-                  {
-                    case cgltf_component_type_r_16u:
-                      val = *reinterpret_cast<uint16_t const*>(src + i * stride);
-                    break;
-
-                    case cgltf_component_type_r_8u:
-                      val = *reinterpret_cast<uint8_t const*>(src + i * stride);
-                    break;
-
-                    default:
-                      LOGE("Index 32bit convertion, unknown base format.");
-                    break;
-                  }
-                  indices_u32.push_back(val);
-                }
-                mesh->set_index_format(Geometry::IndexFormat::U32);
-                primitive.indexOffset = mesh->add_indices_data(
-                  std::as_bytes(std::span(indices_u32))
-                );
-              } else {
-                mesh->set_index_format(index_format);
-                primitive.indexOffset = mesh->add_indices_data(std::span(src, total_size));
-              }
-            } else {
-              LOGD("index format unsupported.");
-            }
-          }
-        }
+      mesh->set_topology(ConvertTopology(prim));
 
-        /* Add the primitive interleaved attributes to the mesh, and retrieve its internal offset. */
-        attribs_buffer_offset = mesh->add_vertices_data(std::as_bytes(std::span(vertices)));
-        primitive.vertexCount = static_cast<uint32_t>(vertices.size());
-        primitive.bufferOffsets = VertexInternal_t::GetAttributeOffsetMap(attribs_buffer_offset);
+      for (cgltf_size j = 0; j < prim.attributes_count; ++j) {
+        cgltf_attribute const& attribute = prim.attributes[j];
+        cgltf_accessor const* accessor = attribute.data;
 
-        // Material.
-        if (prim.material) {
-          uint32_t const material_index = materials_indices.at(prim.material);
-          // mesh->submeshes[prim_index].material_proxy_index = material_index;
-          mesh->submeshes[prim_index].material_ref = material_refs[ material_index ].get();
+        if (auto type = ConvertAttributeType(attribute); type != Geometry::AttributeType::kUnknown) {
+          size_t const accessorOffset{ isAccessorOffsetFlat(accessor) ? 0u : accessor->offset };
+          mesh->add_attribute(type, {
+            .format = ConvertAttributeFormat(accessor),
+            .offset = static_cast<uint32_t>(accessorOffset),
+            .stride = static_cast<uint32_t>(accessor->stride),
+          });
         }
-
-        mesh->add_primitive(primitive);
       }
-    } else {
-      /* Utility function. */
-      auto isAccessorOffsetFlat{[](cgltf_accessor const* acc) -> bool {
-        size_t const kAccessorOffsetLimit = 2048;
-        return (acc->offset == 0) || (acc->offset >= kAccessorOffsetLimit);
-      }};
+    }
 
-      /* Setup the shared attributes from the first primitive.
-       * This assume all mesh primitives share the same layout.
-       */
-      {
-        cgltf_primitive const& prim{ node.mesh->primitives[valid_prim_indices[0u]] };
-
-        mesh->set_topology(ConvertTopology(prim));
-
-        for (cgltf_size j = 0; j < prim.attributes_count; ++j) {
-          cgltf_attribute const& attribute = prim.attributes[j];
-          cgltf_accessor const* accessor = attribute.data;
-
-          if (auto type = ConvertAttributeType(attribute); type != Geometry::AttributeType::kUnknown) {
-            size_t const accessorOffset{ isAccessorOffsetFlat(accessor) ? 0u : accessor->offset };
-            mesh->add_attribute(type, {
-              .format = ConvertAttributeFormat(accessor),
-              .offset = static_cast<uint32_t>(accessorOffset),
-              .stride = static_cast<uint32_t>(accessor->stride),
-            });
-          }
-        }
-      }
+    mesh->submeshes.resize(valid_prim_indices.size(), {.parent = mesh.get()});
 
-      /* Parse the primitives. */
-      for (uint32_t prim_index = 0u; prim_index < valid_prim_indices.size(); ++prim_index) {
-        uint32_t const valid_prim_index = valid_prim_indices[prim_index];
-        cgltf_primitive const& prim{ node.mesh->primitives[valid_prim_index] };
-        LOG_CHECK(ConvertTopology(prim) == mesh->get_topology());
-
-        Geometry::Primitive primitive{};
-
-        /* Retrieve primitive attributes offsets, when relevant. */
-        std::map<cgltf_accessor const*, uint64_t> accessor_buffer_offsets{};
-
-        // Attributes.
-        for (cgltf_size attrib_index = 0; attrib_index < prim.attributes_count; ++attrib_index) {
-          cgltf_attribute const& attribute = prim.attributes[attrib_index];
-
-          if (auto type = ConvertAttributeType(attribute); type != Geometry::AttributeType::kUnknown) {
-            auto accessor = attribute.data;
-            auto buffer_view = accessor->buffer_view;
-
-            // (overwritten, but shared by all attributes as it's non-sparsed)
-            primitive.vertexCount = accessor->count;
-
-            uint64_t bufferOffset{};
-            if (isAccessorOffsetFlat(accessor)) {
-              bufferOffset = mesh->add_vertices_data(std::span<const std::byte>(
-                  reinterpret_cast<const std::byte*>(buffer_view->buffer->data), buffer_view->size
-                ).subspan(buffer_view->offset + accessor->offset)
-              );
-              accessor_buffer_offsets[accessor] = bufferOffset;
-            } else {
-              bufferOffset = accessor_buffer_offsets[accessor];
-            }
-            primitive.bufferOffsets[type] = bufferOffset;
-          }
-        }
+    /* Parse the primitives. */
+    for (uint32_t prim_index = 0u; prim_index < valid_prim_indices.size(); ++prim_index) {
+      uint32_t const valid_prim_index = valid_prim_indices[prim_index];
+      cgltf_primitive const& prim{ gltf_mesh.primitives[valid_prim_index] };
+      LOG_CHECK(ConvertTopology(prim) == mesh->get_topology());
 
-        // Indices.
-        if (prim.indices) {
-          cgltf_accessor const* accessor = prim.indices;
-          cgltf_buffer_view const* buffer_view = accessor->buffer_view;
-          cgltf_buffer const* buffer = buffer_view->buffer;
+      Geometry::Primitive primitive{};
+
+      /* Retrieve primitive attributes offsets, when relevant. */
+      std::map<cgltf_accessor const*, uint64_t> accessor_buffer_offsets{};
+
+      // Attributes.
+      for (cgltf_size attrib_index = 0; attrib_index < prim.attributes_count; ++attrib_index) {
+        cgltf_attribute const& attribute = prim.attributes[attrib_index];
+
+        if (auto type = ConvertAttributeType(attribute); type != Geometry::AttributeType::kUnknown) {
+          auto accessor = attribute.data;
+          auto buffer_view = accessor->buffer_view;
 
-          if (auto index_format = ConvertIndexFormat(accessor); index_format != Geometry::IndexFormat::kUnknown) {
-            mesh->set_index_format(index_format);
+          // (overwritten, but shared by all attributes as it's non-sparsed)
+          primitive.vertexCount = accessor->count;
 
-            primitive.indexCount = accessor->count;
-            primitive.indexOffset = mesh->add_indices_data(std::span<const std::byte>(
-                reinterpret_cast<const std::byte*>(buffer->data),
-                buffer_view->size
+          uint64_t bufferOffset{};
+          if (isAccessorOffsetFlat(accessor)) {
+            bufferOffset = mesh->add_vertices_data(std::span<const std::byte>(
+                reinterpret_cast<const std::byte*>(buffer_view->buffer->data), buffer_view->size
               ).subspan(buffer_view->offset + accessor->offset)
             );
+            accessor_buffer_offsets[accessor] = bufferOffset;
+          } else {
+            bufferOffset = accessor_buffer_offsets[accessor];
           }
+          primitive.bufferOffsets[type] = bufferOffset;
         }
+      }
 
-        // Material.
-        if (prim.material) {
-          uint32_t material_index = materials_indices.at(prim.material);
-          // mesh->submeshes[prim_index].material_proxy_index = material_index;
-          mesh->submeshes[prim_index].material_ref = material_refs[ material_index ].get();
+      // Indices.
+      if (prim.indices) {
+        cgltf_accessor const* accessor = prim.indices;
+        cgltf_buffer_view const* buffer_view = accessor->buffer_view;
+        cgltf_buffer const* buffer = buffer_view->buffer;
+
+        if (auto index_format = ConvertIndexFormat(accessor); index_format != Geometry::IndexFormat::kUnknown) {
+          mesh->set_index_format(index_format);
+
+          primitive.indexFormat = index_format;
+          primitive.indexCount = accessor->count;
+          primitive.indexOffset = mesh->add_indices_data(std::span<const std::byte>(
+              reinterpret_cast<const std::byte*>(buffer->data),
+              buffer_view->size
+            ).subspan(buffer_view->offset + accessor->offset)
+          );
         }
+      }
 
-        mesh->add_primitive(primitive);
+      // Material.
+      if (prim.material) {
+        uint32_t material_index = materials_indices.at(prim.material);
+        // mesh->submeshes[prim_index].material_proxy_index = material_index;
+        mesh->submeshes[prim_index].material_ref = material_refs[ material_index ].get();
       }
+
+      mesh->add_primitive(primitive);
     }
+  }
 
-#if 0
-    // -----------------
-    // D. (optionnal) Retrieve the mesh skeleton.
-    if (cgltf_skin const* skin = node.skin; skin) {
+  return mesh;
+}
 
-      cgltf_size const jointCount = skin->joints_count;
+} // namespace ""
 
-      auto skeleton = std::make_unique<scene::Skeleton>(jointCount);
+// ----------------------------------------------------------------------------
 
-      {
+void ExtractMeshes(
+  cgltf_data const* data,
+  PointerToIndexMap_t const& materials_indices,
+  scene::ResourceBuffer<scene::MaterialRef> const& material_refs,
+  PointerToIndexMap_t const& skeleton_indices,
+  scene::ResourceBuffer<scene::Skeleton>const& skeletons,
+  scene::ResourceBuffer<scene::Mesh>& meshes,
+  std::vector<mat4f>& meshes_transforms,
+  bool const bRestructureAttribs,
+  bool const bForce32bitsIndex,
+  bool const bSplitLargePrimitives,
+  bool const bOptimizeMeshes,
+  bool const bBuildMeshlets,
+  bool const bBuildLods,
+  bool const bCompactVertices,
+  bool const bParallel
+) {
+  /**
+   * Each Mesh hold its geometry,
+   * each primitive consist of a material and offset in the mesh geometry.
+   * We assume every primitives of a Mesh have the same topology / attributes
+   ***/
 
+  /* Group mesh nodes by the mesh they reference, so that each mesh geometry
+   * is extracted once and drawn once per node instance. */
+  std::vector<cgltf_mesh const*> unique_meshes{};
+  std::vector<std::vector<uint32_t>> mesh_nodes{};
+  {
+    std::unordered_map<cgltf_mesh const*, uint32_t> mesh_slots{};
+    for (cgltf_size i = 0; i < data->nodes_count; ++i) {
+      cgltf_node const& node = data->nodes[i];
+      if (!node.mesh) {
+        continue;
+      }
+      auto const [it, inserted] = mesh_slots.try_emplace(node.mesh, static_cast<uint32_t>(unique_meshes.size()));
+      if (inserted) {
+        unique_meshes.push_back(node.mesh);
+        mesh_nodes.emplace_back();
+      }
+      mesh_nodes[it->second].push_back(static_cast<uint32_t>(i));
+    }
+  }
 
-        // LUT Map to find parent nodes index.
-        std::unordered_map<cgltf_node const*, int32_t> joint_indices(jointCount);
-        for (cgltf_size jointIndex = 0; jointIndex < jointCount; ++jointIndex) {
-          cgltf_node const* joint = skin->joints[jointIndex];
-          joint_indices[joint] = static_cast<int32_t>(jointIndex);
-        }
+  // Parse each mesh (for primitives & skeleton) into per-mesh slots.
+  uint32_t const mesh_count = static_cast<uint32_t>(unique_meshes.size());
+  std::vector<std::unique_ptr<scene::Mesh>> extracted_meshes(mesh_count);
 
-        // Fill skeleton basic data (no matrices).
-        for (cgltf_size jointIndex = 0; jointIndex < jointCount; ++jointIndex) {
-          cgltf_node const* joint = skin->joints[jointIndex];
+  // Decode the Draco primitives of all meshes at once, as a scene often
+  // holds a few meshes made of many of them.
+  auto draco_primitives{
+    bRestructureAttribs ? DecodeDracoPrimitives(unique_meshes, bParallel) : DracoPrimitiveMap_t{}
+  };
 
-          std::string const jointName = joint->name ? joint->name
-                                                    : std::string(basename + "::Joint_" + std::to_string(jointIndex));
-          auto const& it = joint_indices.find(joint->parent);
-          int32_t const parentIndex = (it != joint_indices.end()) ? it->second : -1;
+  auto extract_mesh{[&](uint32_t i) {
+    extracted_meshes[i] = ExtractMesh(
+      *unique_meshes[i],
+      materials_indices,
+      material_refs,
+      draco_primitives,
+      bRestructureAttribs,
+      bForce32bitsIndex,
+      bSplitLargePrimitives
+    );
+    if (extracted_meshes[i]) {
+      extracted_meshes[i]->compute_bounds();
+    }
+  }};
 
-          skeleton->names[jointIndex] = jointName;
-          skeleton->parents[jointIndex] = parentIndex;
-          skeleton->index_map[jointName] = static_cast<int32_t>(jointIndex);
-        }
+  if (bParallel) {
+    utils::ParallelFor(0u, mesh_count, extract_mesh);
+  } else {
+    for (uint32_t i = 0u; i < mesh_count; ++i) {
+      extract_mesh(i);
+    }
+  }
+  draco_primitives.clear();
 
-        // Calculates global inverse bind matrices.
-        {
-          // Retrieve local matrices.
-          auto &matrices = skeleton->inverse_bind_matrices;
-          auto const bufferSize = (sizeof(matrices[0]) / sizeof(*lina::ptr(matrices[0]))) * matrices.size();
-          LOG_CHECK(bufferSize == (16 * jointCount));
-          cgltf_accessor_unpack_floats(skin->inverse_bind_matrices, lina::ptr(matrices[0]), bufferSize);
-
-          // Transform them to world space.
-          auto const inverse_world_matrix{linalg::inverse(mesh->world_matrix)};
-          skeleton->transformInverseBindMatrices(inverse_world_matrix);
-        }
+  if (bOptimizeMeshes && bRestructureAttribs) {
+    OptimizePrimitives(extracted_meshes, bParallel);
+  }
 
-        skeletons_map[skinName] = skeleton;
-      }
+  // (after the vertex fetch optimization, which remaps the vertices they reference)
+  if (bBuildLods && bRestructureAttribs) {
+    BuildLods(extracted_meshes, bParallel);
+  }
+
+  // (after the vertex cache optimization, whose triangle order they mostly keep)
+  if (bBuildMeshlets && bRestructureAttribs) {
+    BuildMeshlets(extracted_meshes, bParallel);
+  }
+
+  // (after the passes working on float positions)
+  if (bCompactVertices && bRestructureAttribs) {
+    CompactMeshes(extracted_meshes, unique_meshes, bParallel);
+  }
+
+  // Merge in first reference order, so mesh and transform indices do not
+  // depend on scheduling. Each mesh owns a contiguous range of instance transforms.
+  uint64_t saved_bytes{0u};
+  uint32_t saved_draws{0u};
+  uint32_t total_instances{0u};
 
-      mesh->skeleton = skeleton;
+  meshes.reserve(meshes.size() + mesh_count);
+  for (uint32_t i = 0u; i < mesh_count; ++i) {
+    auto& mesh = extracted_meshes[i];
+    if (!mesh) {
+      continue;
     }
-#endif
+
+    size_t const first_transform = meshes_transforms.size();
+    for (auto const node_index : mesh_nodes[i]) {
+      AppendNodeInstanceTransforms(data->nodes[node_index], meshes_transforms);
+
+      // (instances share the skeleton of the first skinned one)
+      cgltf_skin const* skin = data->nodes[node_index].skin;
+      if (skin && (mesh->skeleton_index == kInvalidIndexU32)) {
+        if (auto it = skeleton_indices.find(skin); it != skeleton_indices.end()) {
+          mesh->skeleton_index = it->second;
+        }
+      }
+    }
+    uint32_t const instance_count = static_cast<uint32_t>(meshes_transforms.size() - first_transform);
+    if (instance_count == 0u) {
+      continue;
+    }
+    mesh->instance_count = instance_count;
+
+    uint64_t const geometry_bytes = mesh->get_vertices().size() + mesh->get_indices().size();
+    saved_bytes += (instance_count - 1u) * geometry_bytes;
+    saved_draws += (instance_count - 1u) * static_cast<uint32_t>(mesh->submeshes.size());
+    total_instances += instance_count;
 
     meshes.push_back( std::move(mesh) );
   }
+
+  if (saved_draws > 0u) {
+    LOGI("[GLTF] {} instances share {} meshes : {:.2f} MB of geometry and {} draw calls saved.",
+      total_instances,
+      mesh_count,
+      saved_bytes / static_cast<double>(1024u * 1024u),
+      saved_draws
+    );
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+namespace {
+
+/* Index of the last key at or before 'time', from a previous search 'hint'. */
+cgltf_size FindKey(std::vector<float> const& times, float const time, cgltf_size hint) {
+  if ((hint >= times.size()) || (times[hint] > time)) {
+    hint = 0u;
+  }
+  while ((hint + 1u < times.size()) && (times[hint + 1u] <= time)) {
+    ++hint;
+  }
+  return hint;
+}
+
+vec4f NLerpShortest(vec4f const& a, vec4f b, float const t) {
+  if (linalg::dot(a, b) < 0.0f) {
+    b = -b;
+  }
+  return linalg::normalize(a + t * (b - a));
 }
 
 // ----------------------------------------------------------------------------
 
+/* Compress the samples of a clip, and log its size and precision. */
+void CompressAnimationClip(scene::AnimationClip& clip) {
+  internal::animation_compressor::Report r{};
+  if (!internal::animation_compressor::CompressClip(clip, {}, &r)) {
+    LOGW("[GLTF] animation \"{}\" could not be compressed.", clip.name);
+    return;
+  }
+  double const kKilobyte{ 1024.0 };
+  LOGI("[GLTF] animation \"{}\" : {} joints x {} samples, {:.1f} -> {:.1f} KB, {} constant / {} animated tracks, {} -> {} keys, max error rotation {:.3f} deg, translation {:.2e}, scale {:.2e}.",
+    clip.name,
+    r.joint_count, r.sample_count,
+    r.raw_bytes / kKilobyte, r.compressed_bytes / kKilobyte,
+    r.constant_tracks, r.animated_tracks,
+    r.raw_keys, r.kept_keys,
+    r.max_rotation_error,
+    r.max_translation_error,
+    r.max_scale_error
+  );
+}
+
+} // namespace ""
+
+// ----------------------------------------------------------------------------
+
 void ExtractAnimations(
   cgltf_data const* data,
   std::string const& basename,
-  scene::ResourceMap<scene::Skeleton>& skeletons_map,
-  scene::ResourceMap<scene::AnimationClip>& animations_map
+  PointerToIndexMap_t const& skeleton_indices,
+  scene::ResourceBuffer<scene::Skeleton>& skeletons,
+  scene::ResourceMap<scene::AnimationClip>& animations_map,
+  bool const bCompress
 ) {
+  using Channel = scene::Pose::Channel;
+
   if (!data || (data->animations_count == 0u)) {
     return;
   }
-  if (skeletons_map.empty()) {
-    LOGE("[GLTF] animations without skeleton are not supported.");
+  if (skeleton_indices.empty()) {
+    LOGW("[GLTF] animations without skeleton are not supported.");
     return;
   }
 
-  auto resolve_name = [&basename](char const* cstr, std::string_view suffix, size_t index) -> std::string {
-    return (cstr != nullptr) ? std::string(cstr)
-                             : basename + std::string(suffix) + std::to_string(index);
+  // LUT to find the skeleton and joint animated by a channel target node.
+  struct JointRef {
+    uint32_t skeleton_index{};
+    uint32_t joint_index{};
   };
-
-  // --------
-
-  // LUT to find skeleton via animations name.
-  std::unordered_map<std::string, std::string> animationName_to_SkeletonName;
+  std::unordered_map<cgltf_node const*, JointRef> joint_refs{};
   for (cgltf_size i = 0; i < data->skins_count; ++i) {
-    cgltf_skin* skin = &data->skins[i];
-    auto const skeletonName = resolve_name(skin->name, "::Skeleton_", i);
-    for (size_t j = 0; j < skin->joints_count; ++j) {
-      cgltf_node* joint_node = skin->joints[j];
-      for (size_t k = 0; k < data->animations_count; ++k) {
-        cgltf_animation const& animation = data->animations[k];
-        auto const clipName = resolve_name(animation.name, "::Animation_", k);
-        for (size_t l = 0; l < animation.channels_count; ++l) {
-          cgltf_animation_channel* channel = &animation.channels[l];
-          if (channel->target_node == joint_node) {
-            animationName_to_SkeletonName[clipName] = skeletonName;
-          }
-        }
+    cgltf_skin const& skin = data->skins[i];
+    if (auto it = skeleton_indices.find(&skin); it != skeleton_indices.end()) {
+      for (cgltf_size j = 0; j < skin.joints_count; ++j) {
+        joint_refs.try_emplace(skin.joints[j], JointRef{ it->second, static_cast<uint32_t>(j) });
       }
     }
   }
 
-  // --------
-
-  std::vector<float> inputs, outputs;
-  // animations_map.reserve(data->animations_count);
+  std::vector<float> inputs{};
+  std::vector<float> outputs{};
 
-  // Retrieve Animations.
   for (cgltf_size i = 0; i < data->animations_count; ++i) {
     cgltf_animation const& animation = data->animations[i];
-    LOG_CHECK(animation.samplers_count == animation.channels_count);
-
-    std::string const clipName = resolve_name(animation.name, "::Animation_", i);
-
-    // Find animation's skeleton.
-    scene::Skeleton* skeleton{nullptr};
-    if (auto skelname_it = animationName_to_SkeletonName.find(clipName); skelname_it != animationName_to_SkeletonName.end()) {
-      auto skelname = skelname_it->second;
-      if (auto skel_it = skeletons_map.find(skelname); skel_it != skeletons_map.end()) {
-        skeleton = skel_it->second.get(); //
-      }
-    }
-    if (nullptr == skeleton) {
-      if (auto it = skeletons_map.begin(); it != skeletons_map.end()) {
-        LOGW("[GLTF] used the first available skeleton found.");
-        skeleton = it->second.get(); //
-      } else {
-        LOGE("[GLTF] cannot find animation's skeleton.");
+    std::string const clip_name = (animation.name != nullptr) ? std::string(animation.name)
+                                                              : fmt::format("{}::Animation_{}", basename, i);
+
+    // The clip skeleton is the one of its first joint channel, and its
+    // duration the last key time. Clips are resampled uniformly with as
+    // many samples as their longest channel.
+    scene::Skeleton* skeleton{};
+    uint32_t skeleton_index{};
+    float clip_duration{0.0f};
+    cgltf_size sample_count{1u};
+    for (cgltf_size c = 0; c < animation.channels_count; ++c) {
+      auto const& channel = animation.channels[c];
+      auto const it = joint_refs.find(channel.target_node);
+      if (!channel.sampler || (it == joint_refs.end())) {
         continue;
       }
+      if (!skeleton) {
+        skeleton_index = it->second.skeleton_index;
+        skeleton = skeletons[skeleton_index].get();
+      }
+      cgltf_accessor const* input = channel.sampler->input;
+      if (input->count > 0u) {
+        float last_time{};
+        cgltf_accessor_read_float(input, input->count - 1u, &last_time, 1u);
+        clip_duration = std::max(clip_duration, last_time);
+        sample_count = std::max(sample_count, input->count);
+      }
     }
-
-    // Preprocess channels to detect max sample count, in case the exporter compressed them.
-    bool bResamplingNeededCheck = false;
-    cgltf_size sampleCount{animation.channels[0].sampler->output->count};
-    for (cgltf_size channel_id = 0; channel_id < animation.channels_count; ++channel_id) {
-      auto const& channel = animation.channels[channel_id];
-      auto const* sampler = channel.sampler;
-      auto const* input = sampler->input;
-
-      // We only support scalar sampling.
-      LOG_CHECK(input->type == cgltf_type_scalar);
-
-      // Check if the exporter have optimized animations by removing duplicate frames.
-      bResamplingNeededCheck = (sampleCount > 1) && (sampleCount != sampler->output->count);
-
-      inputs.resize(input->count);
-      cgltf_accessor_unpack_floats(input, inputs.data(), inputs.size());
-      sampleCount = std::max(sampleCount, sampler->output->count);
-    }
-    if (bResamplingNeededCheck) {
-      LOGW("[GLTF] Some animations will be resampled.");
+    if (!skeleton) {
+      LOGW("[GLTF] animation \"{}\" does not target any skeleton.", clip_name);
+      continue;
     }
 
-    // Create the animation clip.
     auto clip = std::make_unique<scene::AnimationClip>();
-    float const clipDuration = inputs.back();
-    clip->setup(clipName, sampleCount, clipDuration, skeleton->jointCount());
-
-    // Parse each channels (ie. transform per joint).
-    cgltf_accessor const* last_input_accessor{nullptr};
-    for (cgltf_size channel_id = 0; channel_id < animation.channels_count; ++channel_id) {
-      auto const& channel{ animation.channels[channel_id] };
-      auto const* sampler{ channel.sampler };
-      auto const* input{ sampler->input };
-      auto const* output{ sampler->output };
-
-      // Find target joint's index.
-      int32_t jointIndex = -1;
-      if (auto jointName = channel.target_node->name; jointName != nullptr) {
-        if (auto it = skeleton->index_map.find(jointName); it != skeleton->index_map.end()) {
-          jointIndex = it->second;
-        }
-      }
-      if (jointIndex < 0) {
-        LOGE("[GLTF] cannot find joint index in LUT.");
-        break;
+    clip->setup(clip_name, sample_count, clip_duration, skeleton->rest_pose);
+
+    bool has_skipped_channels{false};
+    for (cgltf_size c = 0; c < animation.channels_count; ++c) {
+      auto const& channel = animation.channels[c];
+      auto const it = joint_refs.find(channel.target_node);
+      if (!channel.sampler
+       || (it == joint_refs.end())
+       || (it->second.skeleton_index != skeleton_index)
+       || (channel.target_path == cgltf_animation_path_type_weights)
+       || (channel.target_path == cgltf_animation_path_type_invalid)) {
+        has_skipped_channels = true;
+        continue;
       }
+      uint32_t const joint_index = it->second.joint_index;
+      auto const* sampler = channel.sampler;
 
-      // Inputs (eg. time).
-      if (input != last_input_accessor) {
-        inputs.resize(input->count);
-        cgltf_accessor_unpack_floats(input, inputs.data(), inputs.size());
-        last_input_accessor = input;
+      inputs.resize(sampler->input->count);
+      cgltf_accessor_unpack_floats(sampler->input, inputs.data(), inputs.size());
+      if (inputs.empty()) {
+        continue;
       }
 
-      // Outputs (eg. rotation).
-      cgltf_size const output_ncomp{cgltf_num_components(output->type)};
-      outputs.resize(output_ncomp * output->count);
-      cgltf_accessor_unpack_floats(output, outputs.data(), outputs.size());
-
-      // Check if we need to resample outputs.
-      bool const bNeedResampling{(sampleCount > 1) && (sampleCount != output->count)};
-      cgltf_size frameStart{};
-      cgltf_size frameEnd{};
-      float lerpFactor{};
-
-      for (cgltf_size sid = 0; sid < sampleCount; ++sid) {
-        auto &pose = clip->poses[sid];
-        auto &joint = pose.joints[jointIndex];
-
-        // Calculate resampling parameters when needed.
-        if (bNeedResampling) [[unlikely]] {
-          // [optimization]
-          // Most of the time there would be only two frames, the first and the last,
-          // which would be identical and would not require any interpolation
-          // (just copying them to the whole range).
-
-          cgltf_size const src_sampleCount{ output->count };
-          float const dt = sid / static_cast<float>(sampleCount - 1);
-
-          frameStart = static_cast<int>(floor(dt * src_sampleCount));
-          frameEnd = static_cast<int>(ceil(dt * src_sampleCount));
-          frameStart = std::min(frameStart, src_sampleCount - 1);
-          frameEnd = std::min(frameEnd, src_sampleCount - 1);
-
-          float const start_time = inputs.at(frameStart);
-          float const diff_time = inputs.at(frameEnd) - start_time;
-          float const dst_time = dt * clipDuration;
-          lerpFactor = (diff_time > 0.0f) ? (dst_time - start_time) / diff_time : 0.0f;
-        }
+      cgltf_size const ncomp{ cgltf_num_components(sampler->output->type) };
+      outputs.resize(ncomp * sampler->output->count);
+      cgltf_accessor_unpack_floats(sampler->output, outputs.data(), outputs.size());
+
+      // Cubic spline keys store (in-tangent, value, out-tangent), only values are kept.
+      bool const cubic{ sampler->interpolation == cgltf_interpolation_type_cubic_spline };
+      bool const step{ sampler->interpolation == cgltf_interpolation_type_step };
+      auto key_value{[&](cgltf_size key) {
+        return outputs.data() + ncomp * (cubic ? 3u * key + 1u : key);
+      }};
 
-        switch(channel.target_path) {
+      cgltf_size key{0u};
+      bool has_nonuniform_scale{false};
+      for (uint32_t sid = 0u; sid < clip->sample_count; ++sid) {
+        float const time = (clip->sample_count > 1u) ? clip_duration * sid / (clip->sample_count - 1u)
+                                                     : 0.0f
+                                                     ;
+        key = FindKey(inputs, time, key);
+        cgltf_size const next_key{ std::min(key + 1u, inputs.size() - 1u) };
+        float const key_span = inputs[next_key] - inputs[key];
+        float const t = (step || (key_span <= 0.0f)) ? 0.0f
+                      : std::clamp((time - inputs[key]) / key_span, 0.0f, 1.0f)
+                      ;
+        float const* a = key_value(key);
+        float const* b = key_value(next_key);
+
+        switch (channel.target_path) {
           case cgltf_animation_path_type_translation:
-          {
-            vec3f const* v = reinterpret_cast<vec3f const*>(outputs.data());
-            joint.translation = bNeedResampling ? linalg::lerp(v[frameStart], v[frameEnd], lerpFactor)
-                                                : v[sid]
-                                                ;
-          }
+            clip->sample_channel(sid, Channel::TranslationX)[joint_index] = a[0] + t * (b[0] - a[0]);
+            clip->sample_channel(sid, Channel::TranslationY)[joint_index] = a[1] + t * (b[1] - a[1]);
+            clip->sample_channel(sid, Channel::TranslationZ)[joint_index] = a[2] + t * (b[2] - a[2]);
           break;
 
           case cgltf_animation_path_type_rotation:
           {
-            vec4f const* q = reinterpret_cast<vec4f const*>(outputs.data());
-            joint.rotation = bNeedResampling ? linalg::qnlerp(q[frameStart], q[frameEnd], lerpFactor)
-                                             : q[sid]
-                                             ;
+            vec4f const q{ NLerpShortest(vec4f(a[0], a[1], a[2], a[3]), vec4f(b[0], b[1], b[2], b[3]), t) };
+            clip->sample_channel(sid, Channel::RotationX)[joint_index] = q.x;
+            clip->sample_channel(sid, Channel::RotationY)[joint_index] = q.y;
+            clip->sample_channel(sid, Channel::RotationZ)[joint_index] = q.z;
+            clip->sample_channel(sid, Channel::RotationW)[joint_index] = q.w;
           }
           break;
 
           case cgltf_animation_path_type_scale:
           {
-            vec3f const* v = reinterpret_cast<vec3f const*>(outputs.data());
-            vec3f s = bNeedResampling ? linalg::lerp(v[frameStart], v[frameEnd], lerpFactor)
-                                      : v[sid]
-                                      ;
-
-            float const kTolerance = 1.0e-5f;
-            if (lina::almost_equal(s[0], s[1], kTolerance)
-             && lina::almost_equal(s[0], s[2], kTolerance)
-             && lina::almost_equal(s[1], s[2], kTolerance))
-            {
-              joint.scale = s[0];
-            }
-            else
-            {
-              LOGW("[GLTF] Non-uniform scale not supported for skinning.");
-            }
+            float const kTolerance = 1.0e-3f;
+            has_nonuniform_scale |= (std::abs(a[0] - a[1]) > kTolerance) || (std::abs(a[0] - a[2]) > kTolerance);
+            clip->sample_channel(sid, Channel::Scale)[joint_index] = a[0] + t * (b[0] - a[0]);
           }
           break;
 
-          case cgltf_animation_path_type_weights:
           default:
-            LOGW("[GLTF] Unsupported animation type.");
           break;
         }
       }
+      if (has_nonuniform_scale) {
+        LOGW("[GLTF] \"{}\" non-uniform scales are made uniform for skinning.", clip_name);
+      }
+    }
+    if (has_skipped_channels) {
+      LOGW("[GLTF] \"{}\" channels not targeting its skeleton joints are ignored.", clip_name);
     }
 
-    skeleton->clips.push_back(clip.get());
+    if (bCompress) {
+      CompressAnimationClip(*clip);
+    }
 
-    animations_map.try_emplace(clipName, std::move(clip));
+    auto* clip_ptr = clip.get();
+    if (animations_map.try_emplace(clip_name, std::move(clip)).second) {
+      skeleton->clips.push_back(clip_ptr);
+    } else {
+      LOGW("[GLTF] animation \"{}\" is defined twice, only the first is kept.", clip_name);
+    }
   }
 }
 
@@ -18,6 +18,18 @@ using PointerToSamplerMap_t = PointerMap_t<scene::Sampler>;
 
 /* -------------------------------------------------------------------------- */
 
+/**
+ * Decode the EXT_meshopt_compression buffer views into their 'data', freed
+ * by cgltf_free, one job per view when 'bParallel' is set.
+ *
+ * Must run after cgltf_load_buffers and before the extraction of the data
+ * they hold. Return false when a view failed to decode.
+ **/
+bool DecodeMeshoptBuffers(
+  cgltf_data* data,
+  bool const bParallel
+);
+
 PointerToSamplerMap_t ExtractSamplers(
   cgltf_data const* data,
   std::vector<scene::Sampler>& samplers
@@ -25,6 +37,8 @@ PointerToSamplerMap_t ExtractSamplers(
 
 PointerToIndexMap_t ExtractImages(
   cgltf_data const* data,
+  scene::ImageData::BlockCompression const texture_compression,
+  bool const generate_mipmaps,
   std::vector<scene::ImageData>& images
 );
 
@@ -57,14 +71,22 @@ void ExtractMeshes(
   scene::ResourceBuffer<scene::Mesh>& meshes,
   std::vector<mat4f>& transforms,
   bool const bRestructureAttribs,
-  bool const bForce32bitsIndex
+  bool const bForce32bitsIndex,
+  bool const bSplitLargePrimitives,
+  bool const bOptimizeMeshes,
+  bool const bBuildMeshlets,
+  bool const bBuildLods,
+  bool const bCompactVertices,
+  bool const bParallel
 );
 
 void ExtractAnimations(
   cgltf_data const* data,
   std::string const& basename,
-  scene::ResourceMap<scene::Skeleton>& skeletons_map,
-  scene::ResourceMap<scene::AnimationClip>& animations_map
+  PointerToIndexMap_t const& skeleton_indices,
+  scene::ResourceBuffer<scene::Skeleton>& skeletons,
+  scene::ResourceMap<scene::AnimationClip>& animations_map,
+  bool bCompress
 );
 
 } // namespace internal::gltf_loader
@@ -0,0 +1,266 @@
+#include "aer/scene/private/mipmap_generator.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define AER_MIPMAP_SSE 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define AER_MIPMAP_NEON 1
+#include <arm_neon.h>
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+using namespace internal::mipmap_generator;
+
+// Linear intensities are stored on 12 bits, enough to round trip every sRGB value.
+uint32_t constexpr kLinearBits{ 12u };
+uint32_t constexpr kLinearMax{ (1u << kLinearBits) - 1u };
+
+struct SrgbTables {
+  std::array<uint16_t, 256u> to_linear{};
+  std::array<uint8_t, kLinearMax + 1u> to_srgb{};
+
+  SrgbTables() {
+    for (uint32_t i = 0u; i < to_linear.size(); ++i) {
+      float const c = i / 255.0f;
+      float const linear = (c <= 0.04045f) ? c / 12.92f
+                                           : std::pow((c + 0.055f) / 1.055f, 2.4f)
+                                           ;
+      to_linear[i] = static_cast<uint16_t>(std::lround(linear * kLinearMax));
+    }
+    for (uint32_t i = 0u; i < to_srgb.size(); ++i) {
+      float const linear = static_cast<float>(i) / kLinearMax;
+      float const c = (linear <= 0.0031308f) ? linear * 12.92f
+                                             : 1.055f * std::pow(linear, 1.0f / 2.4f) - 0.055f
+                                             ;
+      to_srgb[i] = static_cast<uint8_t>(std::lround(std::clamp(c, 0.0f, 1.0f) * 255.0f));
+    }
+  }
+};
+
+SrgbTables const& GetSrgbTables() {
+  static SrgbTables const tables{};
+  return tables;
+}
+
+// ----------------------------------------------------------------------------
+
+/* Average the texels [first, dst_width) of a destination row from its two source rows. */
+void DownsampleRowScalar(
+  uint8_t const* row0,
+  uint8_t const* row1,
+  int32_t src_width,
+  int32_t first,
+  int32_t dst_width,
+  uint8_t* dst
+) {
+  for (int32_t x = first; x < dst_width; ++x) {
+    int32_t const x0 = 4 * (2 * x);
+    int32_t const x1 = 4 * std::min(2 * x + 1, src_width - 1);
+    for (int32_t c = 0; c < 4; ++c) {
+      uint32_t const sum = row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c];
+      dst[4 * x + c] = static_cast<uint8_t>((sum + 2u) >> 2u);
+    }
+  }
+}
+
+void DownsampleRowSrgb(
+  uint8_t const* row0,
+  uint8_t const* row1,
+  int32_t src_width,
+  int32_t dst_width,
+  uint8_t* dst
+) {
+  auto const& tables = GetSrgbTables();
+  for (int32_t x = 0; x < dst_width; ++x) {
+    int32_t const x0 = 4 * (2 * x);
+    int32_t const x1 = 4 * std::min(2 * x + 1, src_width - 1);
+    for (int32_t c = 0; c < 3; ++c) {
+      uint32_t const sum = tables.to_linear[row0[x0 + c]] + tables.to_linear[row0[x1 + c]]
+                         + tables.to_linear[row1[x0 + c]] + tables.to_linear[row1[x1 + c]]
+                         ;
+      dst[4 * x + c] = tables.to_srgb[(sum + 2u) >> 2u];
+    }
+    uint32_t const alpha = row0[x0 + 3] + row0[x1 + 3] + row1[x0 + 3] + row1[x1 + 3];
+    dst[4 * x + 3] = static_cast<uint8_t>((alpha + 2u) >> 2u);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+#if defined(AER_MIPMAP_SSE)
+
+/* Average 4 destination texels at a time, return the first one left to process. */
+int32_t DownsampleRowSSE(uint8_t const* row0, uint8_t const* row1, int32_t dst_width, uint8_t* dst) {
+  __m128i const zero = _mm_setzero_si128();
+  __m128i const bias = _mm_set1_epi16(2);
+
+  // Sum the two texels held by each half of 's' into its low half.
+  auto fold{[](__m128i s) {
+    return _mm_add_epi16(s, _mm_srli_si128(s, 8));
+  }};
+
+  int32_t x = 0;
+  for (; x + 4 <= dst_width; x += 4) {
+    auto const* a = reinterpret_cast<__m128i const*>(row0 + 8 * x);
+    auto const* b = reinterpret_cast<__m128i const*>(row1 + 8 * x);
+    __m128i const a0 = _mm_loadu_si128(a);
+    __m128i const a1 = _mm_loadu_si128(a + 1);
+    __m128i const b0 = _mm_loadu_si128(b);
+    __m128i const b1 = _mm_loadu_si128(b + 1);
+
+    // Vertical sums of the 8 source texels, widened to 16-bit, two per register.
+    __m128i const s0 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+    __m128i const s1 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+    __m128i const s2 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+    __m128i const s3 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+
+    __m128i const d01 = _mm_unpacklo_epi64(fold(s0), fold(s1));
+    __m128i const d23 = _mm_unpacklo_epi64(fold(s2), fold(s3));
+    __m128i const r01 = _mm_srli_epi16(_mm_add_epi16(d01, bias), 2);
+    __m128i const r23 = _mm_srli_epi16(_mm_add_epi16(d23, bias), 2);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4 * x), _mm_packus_epi16(r01, r23));
+  }
+  return x;
+}
+
+#endif
+
+#if defined(AER_MIPMAP_NEON)
+
+/* Average 4 destination texels at a time, return the first one left to process. */
+int32_t DownsampleRowNEON(uint8_t const* row0, uint8_t const* row1, int32_t dst_width, uint8_t* dst) {
+  // Sum the two texels held by each half of 's'.
+  auto fold{[](uint16x8_t s) {
+    return vadd_u16(vget_low_u16(s), vget_high_u16(s));
+  }};
+
+  int32_t x = 0;
+  for (; x + 4 <= dst_width; x += 4) {
+    uint8x16_t const a0 = vld1q_u8(row0 + 8 * x);
+    uint8x16_t const a1 = vld1q_u8(row0 + 8 * x + 16);
+    uint8x16_t const b0 = vld1q_u8(row1 + 8 * x);
+    uint8x16_t const b1 = vld1q_u8(row1 + 8 * x + 16);
+
+    // Vertical sums of the 8 source texels, widened to 16-bit, two per register.
+    uint16x8_t const s0 = vaddl_u8(vget_low_u8(a0), vget_low_u8(b0));
+    uint16x8_t const s1 = vaddl_u8(vget_high_u8(a0), vget_high_u8(b0));
+    uint16x8_t const s2 = vaddl_u8(vget_low_u8(a1), vget_low_u8(b1));
+    uint16x8_t const s3 = vaddl_u8(vget_high_u8(a1), vget_high_u8(b1));
+
+    uint16x8_t const d01 = vcombine_u16(fold(s0), fold(s1));
+    uint16x8_t const d23 = vcombine_u16(fold(s2), fold(s3));
+
+    // (rounding shift, ie. (sum + 2) >> 2)
+    vst1q_u8(dst + 4 * x, vcombine_u8(vrshrn_n_u16(d01, 2), vrshrn_n_u16(d23, 2)));
+  }
+  return x;
+}
+
+#endif
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+namespace internal::mipmap_generator {
+
+bool IsBackendSupported(Backend backend) {
+  switch (backend) {
+    case Backend::Scalar:
+      return true;
+#if defined(AER_MIPMAP_SSE)
+    case Backend::SSE:
+      return true;
+#endif
+#if defined(AER_MIPMAP_NEON)
+    case Backend::NEON:
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+Backend BestBackend() {
+  for (auto backend : { Backend::SSE, Backend::NEON }) {
+    if (IsBackendSupported(backend)) {
+      return backend;
+    }
+  }
+  return Backend::Scalar;
+}
+
+// ----------------------------------------------------------------------------
+
+char const* BackendName(Backend backend) {
+  switch (backend) {
+    case Backend::SSE:  return "sse2";
+    case Backend::NEON: return "neon";
+    default:            return "scalar";
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void Downsample(
+  uint8_t const* src,
+  int32_t const src_width,
+  int32_t const src_height,
+  uint8_t* dst,
+  ColorSpace const color_space,
+  Backend backend
+) {
+  int32_t const dst_width = std::max(src_width / 2, 1);
+  int32_t const dst_height = std::max(src_height / 2, 1);
+  size_t const src_pitch = 4u * static_cast<size_t>(src_width);
+  size_t const dst_pitch = 4u * static_cast<size_t>(dst_width);
+
+  // Vector kernels read both source texels of each destination one.
+  if (!IsBackendSupported(backend) || (src_width < 2)) {
+    backend = Backend::Scalar;
+  }
+
+  for (int32_t y = 0; y < dst_height; ++y) {
+    uint8_t const* row0 = src + src_pitch * static_cast<size_t>(2 * y);
+    uint8_t const* row1 = src + src_pitch * static_cast<size_t>(std::min(2 * y + 1, src_height - 1));
+    uint8_t* row_dst = dst + dst_pitch * static_cast<size_t>(y);
+
+    if (color_space == ColorSpace::sRGB) {
+      DownsampleRowSrgb(row0, row1, src_width, dst_width, row_dst);
+      continue;
+    }
+
+    int32_t first = 0;
+    switch (backend) {
+#if defined(AER_MIPMAP_SSE)
+      case Backend::SSE:
+        first = DownsampleRowSSE(row0, row1, dst_width, row_dst);
+      break;
+#endif
+
+#if defined(AER_MIPMAP_NEON)
+      case Backend::NEON:
+        first = DownsampleRowNEON(row0, row1, dst_width, row_dst);
+      break;
+#endif
+
+      default:
+      break;
+    }
+    DownsampleRowScalar(row0, row1, src_width, first, dst_width, row_dst);
+  }
+}
+
+} // namespace internal::mipmap_generator
+
+/* -------------------------------------------------------------------------- */
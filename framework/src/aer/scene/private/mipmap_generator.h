@@ -0,0 +1,64 @@
+#ifndef AER_SCENE_PRIVATE_MIPMAP_GENERATOR_H_
+#define AER_SCENE_PRIVATE_MIPMAP_GENERATOR_H_
+
+/* -------------------------------------------------------------------------- */
+//
+//    mipmap_generator.h
+//
+//  Host generation of RGBA8 mip chains, one level downsampled from the
+//  previous one with a 2x2 box filter.
+//
+//  Linear images are averaged with SSE2 / NEON when available, and by a
+//  scalar kernel otherwise. sRGB images are averaged in linear space through
+//  lookup tables, their alpha channel being kept linear.
+//
+/* -------------------------------------------------------------------------- */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace internal::mipmap_generator {
+
+enum class Backend : uint8_t {
+  Scalar,
+  SSE,
+  NEON,
+};
+
+enum class ColorSpace : uint8_t {
+  Linear,
+  sRGB,
+};
+
+// ----------------------------------------------------------------------------
+
+/* Return true when the backend can run on this build and CPU. */
+bool IsBackendSupported(Backend backend);
+
+/* Return the fastest backend supported by the running CPU. */
+Backend BestBackend();
+
+/* Return a printable name for a backend. */
+char const* BackendName(Backend backend);
+
+/**
+ * Downsample the RGBA8 'src' level of size 'src_width' x 'src_height' into
+ * 'dst', of size max(src_width / 2, 1) x max(src_height / 2, 1).
+ *
+ * Odd sizes drop their last row / column, a single texel wide side is
+ * averaged with itself. Unsupported backends fallback to the scalar one.
+ **/
+void Downsample(
+  uint8_t const* src,
+  int32_t src_width,
+  int32_t src_height,
+  uint8_t* dst,
+  ColorSpace color_space,
+  Backend backend = BestBackend()
+);
+
+} // namespace internal::mipmap_generator
+
+/* -------------------------------------------------------------------------- */
+
+#endif // AER_SCENE_PRIVATE_MIPMAP_GENERATOR_H_
@@ -0,0 +1,191 @@
+#include "aer/scene/private/vertex_quantizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <span>
+
+#include "meshoptimizer.h"
+
+#include "aer/scene/vertex_internal.h"
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+using namespace internal::vertex_quantizer;
+
+float constexpr kSnorm16Scale{ 32767.0f };
+
+// Bounds axis under this half size are considered flat.
+float constexpr kMinExtent{ 1.0e-8f };
+
+float constexpr kRadiansToDegrees{ 180.0f / static_cast<float>(M_PI) };
+
+// ----------------------------------------------------------------------------
+
+int16_t ToSnorm16(float v) {
+  return static_cast<int16_t>(meshopt_quantizeSnorm(v, 16));
+}
+
+float FromSnorm16(int32_t v) {
+  return std::max(static_cast<float>(v) / kSnorm16Scale, -1.0f);
+}
+
+uint32_t Pack2x16(uint32_t x, uint32_t y) {
+  return (x & 0xFFFFu) | ((y & 0xFFFFu) << 16u);
+}
+
+// ----------------------------------------------------------------------------
+
+vec3 OctahedralDecode(float x, float y) {
+  vec3 n(x, y, 1.0f - std::abs(x) - std::abs(y));
+  float const t = std::max(-n.z, 0.0f);
+  n.x += (n.x >= 0.0f) ? -t : t;
+  n.y += (n.y >= 0.0f) ? -t : t;
+  return linalg::normalize(n);
+}
+
+/**
+ * Encode a unit vector on the octahedron as two snorm16, keeping the rounding
+ * closest to the source direction, and return its decoded direction.
+ **/
+uint32_t PackOctahedral(vec3 const& n, vec3& decoded) {
+  float const inv_l1 = 1.0f / (std::abs(n.x) + std::abs(n.y) + std::abs(n.z));
+  float x = n.x * inv_l1;
+  float y = n.y * inv_l1;
+  if (n.z < 0.0f) {
+    float const ox = x;
+    x = (1.0f - std::abs(y)) * ((ox >= 0.0f) ? 1.0f : -1.0f);
+    y = (1.0f - std::abs(ox)) * ((y >= 0.0f) ? 1.0f : -1.0f);
+  }
+
+  float const fx = std::floor(x * kSnorm16Scale);
+  float const fy = std::floor(y * kSnorm16Scale);
+
+  int32_t best_x{}, best_y{};
+  float best_dot{ -2.0f };
+  for (float const qx : { fx, fx + 1.0f }) {
+    for (float const qy : { fy, fy + 1.0f }) {
+      auto const ix = static_cast<int32_t>(std::clamp(qx, -kSnorm16Scale, kSnorm16Scale));
+      auto const iy = static_cast<int32_t>(std::clamp(qy, -kSnorm16Scale, kSnorm16Scale));
+      vec3 const d{ OctahedralDecode(FromSnorm16(ix), FromSnorm16(iy)) };
+      if (float const dp = linalg::dot(d, n); dp > best_dot) {
+        best_dot = dp;
+        best_x = ix;
+        best_y = iy;
+        decoded = d;
+      }
+    }
+  }
+
+  return Pack2x16(static_cast<uint32_t>(best_x), static_cast<uint32_t>(best_y));
+}
+
+/* Pack a direction, and return its angular error in degrees, or zero for null vectors. */
+float PackDirection(vec3 const& v, uint32_t& packed) {
+  float const length = linalg::length(v);
+  if (length <= 0.0f) {
+    packed = 0u;
+    return 0.0f;
+  }
+  vec3 const n{ v / length };
+  vec3 decoded{};
+  packed = PackOctahedral(n, decoded);
+  return std::acos(std::clamp(linalg::dot(n, decoded), -1.0f, 1.0f)) * kRadiansToDegrees;
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+namespace internal::vertex_quantizer {
+
+bool CompactMeshVertices(scene::Mesh& mesh, Report* report) {
+  using AttributeType = Geometry::AttributeType;
+
+  if (!mesh.has_attribute(AttributeType::Position)
+   || (mesh.get_format(AttributeType::Position) != Geometry::AttributeFormat::RGB_F32)
+   || (mesh.get_stride(AttributeType::Position) != sizeof(VertexInternal_t))
+   || (mesh.get_vertices().size() % sizeof(VertexInternal_t)) != 0u) {
+    return false;
+  }
+
+  auto const& bytes = mesh.get_vertices();
+  size_t const vertex_count = bytes.size() / sizeof(VertexInternal_t);
+  if (vertex_count == 0u) {
+    return false;
+  }
+  std::span<VertexInternal_t const> const vertices(
+    reinterpret_cast<VertexInternal_t const*>(bytes.data()), vertex_count
+  );
+
+  /* Mesh bounds. */
+  vec3 bounds_min{ vertices[0u].position };
+  vec3 bounds_max{ vertices[0u].position };
+  for (auto const& v : vertices) {
+    bounds_min = linalg::min(bounds_min, v.position);
+    bounds_max = linalg::max(bounds_max, v.position);
+  }
+  vec3 const offset{ 0.5f * (bounds_max + bounds_min) };
+  vec3 scale{ 0.5f * (bounds_max - bounds_min) };
+  for (int i = 0; i < 3; ++i) {
+    scale[i] = (scale[i] > kMinExtent) ? scale[i] : 1.0f;
+  }
+  vec3 const inv_scale{ 1.0f / scale };
+
+  /* Encode, and decode back to measure the error. */
+  Report r{
+    .vertex_count = static_cast<uint32_t>(vertex_count),
+    .source_bytes = bytes.size(),
+    .compact_bytes = vertex_count * sizeof(VertexCompact_t),
+    .max_position_extent = linalg::maxelem(0.5f * (bounds_max - bounds_min)),
+  };
+
+  std::vector<std::byte> compact_bytes(vertex_count * sizeof(VertexCompact_t));
+  auto* compact = reinterpret_cast<VertexCompact_t*>(compact_bytes.data());
+
+  for (size_t i = 0u; i < vertex_count; ++i) {
+    auto const& src = vertices[i];
+    auto& dst = compact[i];
+
+    vec3 const p{ (src.position - offset) * inv_scale };
+    int16_t const qx = ToSnorm16(p.x);
+    int16_t const qy = ToSnorm16(p.y);
+    int16_t const qz = ToSnorm16(p.z);
+    int16_t const qw = ToSnorm16((src.tangent.w < 0.0f) ? -1.0f : 1.0f);
+    dst.position_xy = Pack2x16(static_cast<uint16_t>(qx), static_cast<uint16_t>(qy));
+    dst.position_zw = Pack2x16(static_cast<uint16_t>(qz), static_cast<uint16_t>(qw));
+
+    vec3 const decoded_position{
+      offset + scale * vec3(FromSnorm16(qx), FromSnorm16(qy), FromSnorm16(qz))
+    };
+    r.max_position_error = std::max(r.max_position_error, linalg::length(decoded_position - src.position));
+
+    r.max_normal_error = std::max(r.max_normal_error, PackDirection(src.normal, dst.normal));
+    r.max_tangent_error = std::max(r.max_tangent_error, PackDirection(src.tangent.xyz(), dst.tangent));
+
+    uint16_t const u = meshopt_quantizeHalf(src.texcoord.x);
+    uint16_t const v = meshopt_quantizeHalf(src.texcoord.y);
+    dst.texcoord = Pack2x16(u, v);
+    r.max_texcoord_error = std::max({
+      r.max_texcoord_error,
+      std::abs(meshopt_dequantizeHalf(u) - src.texcoord.x),
+      std::abs(meshopt_dequantizeHalf(v) - src.texcoord.y),
+    });
+  }
+
+  mesh.replace_vertices_data(std::move(compact_bytes), VertexCompact_t::GetAttributeInfoMap());
+  mesh.position_offset = offset;
+  mesh.position_scale = scale;
+
+  if (report) {
+    *report = r;
+  }
+
+  return true;
+}
+
+} // namespace internal::vertex_quantizer
+
+/* -------------------------------------------------------------------------- */
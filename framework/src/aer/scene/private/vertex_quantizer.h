@@ -0,0 +1,55 @@
+#ifndef AER_SCENE_PRIVATE_VERTEX_QUANTIZER_H_
+#define AER_SCENE_PRIVATE_VERTEX_QUANTIZER_H_
+
+/* -------------------------------------------------------------------------- */
+//
+//    vertex_quantizer.h
+//
+//  Conversion of restructured meshes from VertexInternal_t (64 bytes) to the
+//  quantized VertexCompact_t layout (20 bytes) :
+//
+//    * positions as snorm16 relative to the mesh bounds,
+//    * normals and tangents octahedral encoded as snorm16,
+//    * texcoords as half floats,
+//    * the tangent handedness in the position w component.
+//
+//  Each vertex is decoded back to measure the error introduced.
+//
+/* -------------------------------------------------------------------------- */
+
+#include <cstdint>
+
+namespace scene {
+struct Mesh;
+}
+
+namespace internal::vertex_quantizer {
+
+/* Size and precision of a compacted mesh. */
+struct Report {
+  uint32_t vertex_count{};
+  uint64_t source_bytes{};
+  uint64_t compact_bytes{};
+  float max_position_error{};     // in mesh space units.
+  float max_position_extent{};    // largest half size of the mesh bounds.
+  float max_normal_error{};       // in degrees.
+  float max_tangent_error{};      // in degrees.
+  float max_texcoord_error{};
+};
+
+// ----------------------------------------------------------------------------
+
+/**
+ * Convert the interleaved VertexInternal_t vertices of a mesh to
+ * VertexCompact_t, and set its positions dequantization.
+ *
+ * Return false when the mesh does not use the VertexInternal_t layout, in
+ * which case it is left as is.
+ **/
+bool CompactMeshVertices(scene::Mesh& mesh, Report* report = nullptr);
+
+} // namespace internal::vertex_quantizer
+
+/* -------------------------------------------------------------------------- */
+
+#endif // AER_SCENE_PRIVATE_VERTEX_QUANTIZER_H_
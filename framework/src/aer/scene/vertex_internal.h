@@ -4,6 +4,7 @@
 
 #include "aer/core/common.h"
 #include "aer/scene/geometry.h"
+#include "aer/scene/mesh.h"
 
 namespace material_shader_interop {
 #include "aer/shaders/material/interop.h"
@@ -82,3 +83,59 @@ struct VertexInternal_t : material_shader_interop::Vertex {
 };
 
 // ----------------------------------------------------------------------------
+
+//
+// Opt-in quantized alternative to VertexInternal_t, converted from it after
+// extraction (see HostResources::compact_vertices).
+// Positions are snorm16 relative to the mesh bounds, and dequantized with
+// Mesh::position_offset / position_scale.
+//
+struct VertexCompact_t : material_shader_interop::CompactVertex {
+  // uint position_xy;  snorm16 x2
+  // uint position_zw;  snorm16 x2, w = tangent handedness
+  // uint normal;       octahedral snorm16 x2
+  // uint tangent;      octahedral snorm16 x2
+  // uint texcoord;     half x2
+
+  static
+  Geometry::AttributeInfoMap GetAttributeInfoMap() {
+    return {
+      {
+        Geometry::AttributeType::Position,
+        {
+          .format = Geometry::AttributeFormat::RGBA_SNORM16,
+          .offset = offsetof(VertexCompact_t, position_xy),
+          .stride = sizeof(VertexCompact_t),
+        }
+      },
+      {
+        Geometry::AttributeType::Normal,
+        {
+          .format = Geometry::AttributeFormat::RG_SNORM16,
+          .offset = offsetof(VertexCompact_t, normal),
+          .stride = sizeof(VertexCompact_t),
+        }
+      },
+      {
+        Geometry::AttributeType::Tangent,
+        {
+          .format = Geometry::AttributeFormat::RG_SNORM16,
+          .offset = offsetof(VertexCompact_t, tangent),
+          .stride = sizeof(VertexCompact_t),
+        }
+      },
+      {
+        Geometry::AttributeType::Texcoord,
+        {
+          .format = Geometry::AttributeFormat::RG_F16,
+          .offset = offsetof(VertexCompact_t, texcoord),
+          .stride = sizeof(VertexCompact_t),
+        }
+      },
+    };
+  }
+};
+
+static_assert(sizeof(VertexCompact_t) == 20u);
+
+// ----------------------------------------------------------------------------
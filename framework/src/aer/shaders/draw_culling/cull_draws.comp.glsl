@@ -0,0 +1,151 @@
+#version 460
+#extension GL_GOOGLE_include_directive : require
+#extension GL_EXT_scalar_block_layout : require
+
+// ----------------------------------------------------------------------------
+//
+// Cull each draw record against the camera frustum, for every instance of its
+// mesh, select its LOD level from its projected error, and append the visible
+// ones to the indirect draw commands of their batch, with the per-draw data
+// fetched by the vertex shaders from gl_DrawID.
+//
+// ----------------------------------------------------------------------------
+
+#include <material/interop.h>
+#include <draw_culling/interop.h>
+
+// ----------------------------------------------------------------------------
+
+layout(scalar, binding = kDescriptorSetBinding_Records_StorageBuffer)
+readonly buffer RecordsSBO_ {
+  DrawRecord records[];
+};
+
+layout(scalar, binding = kDescriptorSetBinding_Transforms_StorageBuffer)
+readonly buffer TransformsSBO_ {
+  mat4 worldMatrices[];
+};
+
+layout(scalar, binding = kDescriptorSetBinding_DrawCommands_StorageBuffer)
+writeonly buffer DrawCommandsSBO_ {
+  DrawIndexedCommand drawCommands[];
+};
+
+layout(scalar, binding = kDescriptorSetBinding_DrawCounts_StorageBuffer)
+buffer DrawCountsSBO_ {
+  uint drawCounts[];
+};
+
+layout(scalar, binding = kDescriptorSetBinding_DrawData_StorageBuffer)
+writeonly buffer DrawDataSBO_ {
+  DrawData draws[];
+};
+
+layout(push_constant, scalar) uniform PushConstant_ {
+  PushConstant pushConstant;
+};
+
+// ----------------------------------------------------------------------------
+
+layout(
+  local_size_x = kCompute_CullDraws_kernelSize_x
+) in;
+
+// ----------------------------------------------------------------------------
+
+bool isVisible(in DrawRecord record, in mat4 worldMatrix) {
+  const mat3 basis = mat3(worldMatrix);
+
+  // World space box of the mesh space one.
+  const vec3 localCenter = 0.5 * (record.boundsMax.xyz + record.boundsMin.xyz);
+  const vec3 localExtent = 0.5 * (record.boundsMax.xyz - record.boundsMin.xyz);
+  const vec3 center = (worldMatrix * vec4(localCenter, 1.0)).xyz;
+  const vec3 extent = abs(basis[0]) * localExtent.x
+                    + abs(basis[1]) * localExtent.y
+                    + abs(basis[2]) * localExtent.z
+                    ;
+
+  for (uint i = 0u; i < kFrustumPlaneCount; ++i) {
+    const vec4 plane = pushConstant.frustumPlanes[i];
+    if (dot(plane.xyz, center) + plane.w + dot(abs(plane.xyz), extent) < 0.0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Coarsest level whose error projects under the pixel error, as Mesh::select_lods.
+uint selectLod(in DrawRecord record) {
+  if ((pushConstant.lodErrorScale < 0.0) || (record.lodCount == 0u)) {
+    return 0u;
+  }
+
+  // Smallest distance to the bounding sphere, in mesh space units.
+  float minDistance = 3.402823466e38;
+  for (uint i = 0u; i < record.instanceCount; ++i) {
+    const mat4 worldMatrix = worldMatrices[record.transformIndex + i];
+    const mat3 basis = mat3(worldMatrix);
+    const float scale = max(length(basis[0]), max(length(basis[1]), length(basis[2])));
+    const vec3 center = (worldMatrix * vec4(record.sphere.xyz, 1.0)).xyz;
+    const float distance = length(center - pushConstant.cameraPos) - record.sphere.w * scale;
+    minDistance = min(minDistance, max(distance, 0.0) / scale);
+  }
+
+  const float maxError = pushConstant.lodErrorScale * minDistance;
+  for (uint lod = record.lodCount; lod > 0u; --lod) {
+    if (record.lods[lod - 1u].error <= maxError) {
+      return lod;
+    }
+  }
+  return 0u;
+}
+
+// ----------------------------------------------------------------------------
+
+void main() {
+  const uint recordId = gl_GlobalInvocationID.x;
+
+  if (recordId >= pushConstant.recordCount) {
+    return;
+  }
+
+  const DrawRecord record = records[recordId];
+
+  // (unbounded records are always drawn)
+  bool visible = (record.boundsMin.w == 0.0);
+  for (uint i = 0u; (i < record.instanceCount) && !visible; ++i) {
+    visible = isVisible(record, worldMatrices[record.transformIndex + i]);
+  }
+
+  if (!visible) {
+    return;
+  }
+
+  uint firstIndex = record.firstIndex;
+  uint indexCount = record.indexCount;
+  const uint lod = selectLod(record);
+  if (lod > 0u) {
+    firstIndex = record.lods[lod - 1u].firstIndex;
+    indexCount = record.lods[lod - 1u].indexCount;
+  }
+
+  // (every instance is drawn as soon as one of them is visible)
+  const uint slot = record.batchOffset + atomicAdd(drawCounts[record.batchIndex], 1u);
+  drawCommands[slot] = DrawIndexedCommand(
+    indexCount,
+    record.instanceCount,
+    firstIndex,
+    record.vertexOffset,
+    0u
+  );
+  draws[slot] = DrawData(
+    record.transformIndex,
+    record.materialIndex,
+    record.compactVertices,
+    0u,
+    record.positionOffset.xyz, float[1](0.0),
+    record.positionScale.xyz, float[1](0.0)
+  );
+}
+
+// ----------------------------------------------------------------------------
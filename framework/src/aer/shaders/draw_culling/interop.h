@@ -0,0 +1,84 @@
+#ifndef SHADERS_DRAW_CULLING_INTEROP_H_
+#define SHADERS_DRAW_CULLING_INTEROP_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+#define UINT uint32_t
+#define INT int32_t
+#else
+#define UINT uint
+#define INT int
+#endif
+
+// ----------------------------------------------------------------------------
+
+const UINT kDescriptorSetBinding_Records_StorageBuffer      = 0;
+const UINT kDescriptorSetBinding_Transforms_StorageBuffer   = 1;
+const UINT kDescriptorSetBinding_DrawCommands_StorageBuffer = 2;
+const UINT kDescriptorSetBinding_DrawCounts_StorageBuffer   = 3;
+const UINT kDescriptorSetBinding_DrawData_StorageBuffer     = 4;
+
+// ----------------------------------------------------------------------------
+
+const UINT kCompute_CullDraws_kernelSize_x = 64u;
+
+// Side, near and far planes.
+const UINT kFrustumPlaneCount = 6u;
+
+// Coarser LOD levels selected on the device, submeshes with more stay on the host.
+const UINT kMaxLodLevels = 4u;
+
+// ----------------------------------------------------------------------------
+
+struct LodRange {
+  UINT firstIndex;
+  UINT indexCount;
+  float error;          // mesh space units.
+  UINT _pad0;
+};
+
+// One per submesh drawn by the device, static until the draw lists are rebuilt.
+struct DrawRecord {
+  vec4 boundsMin;       // xyz mesh space, w = 0 for an unbounded submesh.
+  vec4 boundsMax;       // xyz mesh space.
+  vec4 sphere;          // xyz center, w radius, in mesh space.
+  vec4 positionOffset;  // xyz compact positions dequantization.
+  vec4 positionScale;   // xyz
+  UINT indexCount;
+  UINT firstIndex;
+  INT vertexOffset;     // relative to the batch vertex buffer binding.
+  UINT transformIndex;  // first of the mesh instances transforms.
+  UINT instanceCount;
+  UINT materialIndex;
+  UINT compactVertices;
+  UINT batchIndex;      // batch slot in the draw counts buffer.
+  UINT batchOffset;     // first batch slot in the draw commands and data buffers.
+  UINT lodCount;
+  UINT _pad0[2];
+  LodRange lods[kMaxLodLevels];
+};
+
+// Matches VkDrawIndexedIndirectCommand.
+struct DrawIndexedCommand {
+  UINT indexCount;
+  UINT instanceCount;
+  UINT firstIndex;
+  INT vertexOffset;
+  UINT firstInstance;
+};
+
+// [116 bytes < 128 bytes]
+struct PushConstant {
+  vec4 frustumPlanes[kFrustumPlaneCount]; // world space, normalized.
+  vec3 cameraPos;
+  float lodErrorScale;  // pixel error over pixel scale, negative to draw the full details.
+  UINT recordCount;
+};
+
+// ----------------------------------------------------------------------------
+
+#undef INT
+#undef UINT
+
+#endif
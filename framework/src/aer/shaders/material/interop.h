@@ -16,6 +16,16 @@ struct Vertex {
   vec2 texcoord; float _pad2[2];
 };
 
+// Opt-in quantized alternative to Vertex, 20 bytes.
+// Positions are relative to the mesh bounds, dequantized per draw.
+struct CompactVertex {
+  uint position_xy;   // snorm16 x2
+  uint position_zw;   // snorm16 x2, w holds the tangent handedness.
+  uint normal;        // octahedral snorm16 x2
+  uint tangent;       // octahedral snorm16 x2
+  uint texcoord;      // half x2
+};
+
 // ----------------------------------------------------------------------------
 // -- Descriptor Sets --
 
@@ -32,6 +42,7 @@ const uint kDescriptorSet_Scene_Textures            = 1;
 const uint kDescriptorSet_Scene_IBL_Prefiltered     = 2;
 const uint kDescriptorSet_Scene_IBL_Irradiance      = 3;
 const uint kDescriptorSet_Scene_IBL_SpecularBRDF    = 4;
+const uint kDescriptorSet_Scene_DrawSBO             = 5;
 
 const uint kDescriptorSet_RayTracing = 3;
 const uint kDescriptorSet_RayTracing_TLAS           = 0;
@@ -55,6 +66,20 @@ struct TransformSBO {
   mat4 worldMatrix;
 };
 
+// Per-draw data of the GPU-driven draws, written by their culling pass and
+// fetched at the draw offset + gl_DrawID in place of the push constants.
+struct DrawData {
+  uint transform_index;
+  uint material_index;
+  uint compact_vertices;  // non-zero for CompactVertex inputs.
+  uint _pad0;
+  vec3 position_offset; float _pad1[1];
+  vec3 position_scale;  float _pad2[1];
+};
+
+// Draw offset of the draws using the push constants.
+const uint kInvalidDrawOffset = 0xFFFFFFFFu;
+
 // ----------------------------------------------------------------------------
 
 #endif
\ No newline at end of file
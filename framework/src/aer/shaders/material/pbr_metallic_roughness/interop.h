@@ -27,15 +27,18 @@ struct Material {
 // ---------------------------------------------------------------------------
 // Instance PushConstants.
 
-// [80 bytes < 128 bytes]
+// [40 bytes < 128 bytes]
 struct PushConstant {
   uint transform_index;
   uint material_index;
-  uint instance_index;
+  uint draw_offset;     // first DrawData of the GPU-driven draws, or kInvalidDrawOffset.
   uint dynamic_states;
+  vec3 position_offset; // compact positions dequantization.
+  vec3 position_scale;
 };
 
-const uint kIrradianceBit = 0x1 << 0; //
+const uint kIrradianceBit     = 0x1 << 0; //
+const uint kCompactVertexBit  = 0x1 << 1; // octahedral normal & tangent.
 
 // ---------------------------------------------------------------------------
 
@@ -57,6 +57,7 @@ layout(location = 0) in vec3 vPositionWS;
 layout(location = 1) in vec3 vNormalWS;
 layout(location = 2) in vec4 vTangentWS;
 layout(location = 3) in vec2 vTexcoord;
+layout(location = 4) flat in uint vMaterialIndex;
 
 layout(location = 0) out vec4 fragColor;
 
@@ -69,8 +70,10 @@ vec4 sample_DiffuseColor(in Material mat) {
 }
 
 vec3 sample_NormalMap(in Material mat) {
-  vec3 normal = texture(TEXTURE_ATLAS(mat.normal_texture_id), vTexcoord).rgb;
-  return normalize(normal * 2.0 - 1.0);
+  // Z is rebuilt from XY, as normal maps might be stored with two channels (BC5 / EAC_RG11).
+  const vec2 xy = texture(TEXTURE_ATLAS(mat.normal_texture_id), vTexcoord).rg * 2.0 - 1.0;
+  const float z = sqrt(max(1.0 - dot(xy, xy), 0.0));
+  return normalize(vec3(xy, z));
 }
 
 // ----------------------------------------------------------------------------
@@ -178,7 +181,7 @@ PBRMetallicRoughness_Material_t calculate_pbr_material_data(
 // ----------------------------------------------------------------------------
 
 void main() {
-  Material mat = materials[nonuniformEXT(pushConstant.material_index)];
+  Material mat = materials[nonuniformEXT(vMaterialIndex)];
 
   /* Diffuse. */
   const vec4 mainColor = sample_DiffuseColor(mat)
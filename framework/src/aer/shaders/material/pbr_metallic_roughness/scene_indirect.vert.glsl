@@ -0,0 +1,7 @@
+#version 460
+#extension GL_GOOGLE_include_directive : require
+
+// Per-draw data of the device culled draws, fetched at gl_DrawID
+// (requires the shaderDrawParameters feature).
+#define SCENE_INDIRECT_DRAW
+#include <material/pbr_metallic_roughness/scene_vertex.glsl>
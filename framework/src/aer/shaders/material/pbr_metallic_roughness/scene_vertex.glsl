@@ -0,0 +1,99 @@
+#ifndef SHADERS_MATERIAL_PBR_METALLIC_ROUGHNESS_SCENE_VERTEX_GLSL_
+#define SHADERS_MATERIAL_PBR_METALLIC_ROUGHNESS_SCENE_VERTEX_GLSL_
+
+// Vertex stage of the scene materials, included by its shader variants :
+//  - scene.vert.glsl, per-draw data from the push constants,
+//  - scene_indirect.vert.glsl, per-draw data of the device culled draws,
+//    fetched at gl_DrawID (SCENE_INDIRECT_DRAW).
+
+#extension GL_EXT_scalar_block_layout : require
+#extension GL_EXT_nonuniform_qualifier : require
+
+// ----------------------------------------------------------------------------
+
+#include <material/interop.h>
+#include <material/pbr_metallic_roughness/interop.h>
+#include <shared/maths.glsl>
+
+// ----------------------------------------------------------------------------
+
+layout(scalar, set = kDescriptorSet_Frame, binding = kDescriptorSet_Frame_FrameUBO)
+uniform FrameUBO_ {
+  FrameData uFrame;
+};
+
+layout(scalar, set = kDescriptorSet_Scene, binding = kDescriptorSet_Scene_TransformSBO)
+buffer TransformSBO_ {
+  TransformSBO transforms[];
+};
+
+layout(scalar, set = kDescriptorSet_Scene, binding = kDescriptorSet_Scene_DrawSBO)
+readonly buffer DrawSBO_ {
+  DrawData draws[];
+};
+
+layout(scalar, push_constant) uniform PushConstant_ {
+  PushConstant pushConstant;
+};
+
+// ----------------------------------------------------------------------------
+
+// CompactVertex attributes come as snorm, with the tangent handedness in inPosition.w.
+layout(location = kAttribLocation_Position) in vec4 inPosition;
+layout(location = kAttribLocation_Normal  ) in vec3 inNormal;
+layout(location = kAttribLocation_Texcoord) in vec2 inTexcoord;
+layout(location = kAttribLocation_Tangent)  in vec4 inTangent;
+
+layout(location = 0) out vec3 vPositionWS;
+layout(location = 1) out vec3 vNormalWS;
+layout(location = 2) out vec4 vTangentWS;
+layout(location = 3) out vec2 vTexcoord;
+layout(location = 4) flat out uint vMaterialIndex;
+
+// ----------------------------------------------------------------------------
+
+void main() {
+  // Per-draw data, from the push constants or the GPU culled draws.
+  uint transformIndex = pushConstant.transform_index;
+  uint materialIndex = pushConstant.material_index;
+  bool compactVertices = (pushConstant.dynamic_states & kCompactVertexBit) != 0;
+  vec3 positionOffset = pushConstant.position_offset;
+  vec3 positionScale = pushConstant.position_scale;
+#ifdef SCENE_INDIRECT_DRAW
+  {
+    const DrawData draw = draws[pushConstant.draw_offset + gl_DrawID];
+    transformIndex = draw.transform_index;
+    materialIndex = draw.material_index;
+    compactVertices = (draw.compact_vertices != 0);
+    positionOffset = draw.position_offset;
+    positionScale = draw.position_scale;
+  }
+#endif
+
+  // Instances transforms are contiguous to the first one.
+  TransformSBO transform = transforms[nonuniformEXT(transformIndex + gl_InstanceIndex)];
+  mat4 worldMatrix = transform.worldMatrix;
+  mat3 normalMatrix = mat3(worldMatrix);
+
+  vec3 position = positionOffset + positionScale * inPosition.xyz;
+  vec3 normal = inNormal;
+  vec4 tangent = inTangent;
+  if (compactVertices) {
+    normal = decodeOctahedral(inNormal.xy);
+    tangent = vec4(decodeOctahedral(inTangent.xy), inPosition.w);
+  }
+  vec4 worldPos = worldMatrix * vec4(position, 1.0);
+
+  // -------
+
+  gl_Position = uFrame.viewProjMatrix * worldPos;
+  vPositionWS = worldPos.xyz;
+  vNormalWS   = normalize(normalMatrix * normal);
+  vTangentWS  = vec4(normalize(normalMatrix * tangent.xyz), tangent.w);
+  vTexcoord   = inTexcoord.xy;
+  vMaterialIndex = materialIndex;
+}
+
+// ----------------------------------------------------------------------------
+
+#endif // SHADERS_MATERIAL_PBR_METALLIC_ROUGHNESS_SCENE_VERTEX_GLSL_
@@ -13,8 +13,10 @@ struct Material {
 struct PushConstant {
   uint transform_index;
   uint material_index;
-  uint instance_index;
+  uint draw_offset;     // first DrawData of the GPU-driven draws, or kInvalidDrawOffset.
   uint padding_[1];
+  vec3 position_offset; // compact positions dequantization.
+  vec3 position_scale;
 };
 
 // ---------------------------------------------------------------------------
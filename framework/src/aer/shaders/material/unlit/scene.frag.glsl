@@ -27,12 +27,13 @@ layout(push_constant, scalar) uniform PushConstant_ {
 // ----------------------------------------------------------------------------
 
 layout(location = 0) in vec3 vPositionWS;
+layout(location = 1) flat in uint vMaterialIndex;
 layout(location = 0) out vec4 fragColor;
 
 // ----------------------------------------------------------------------------
 
 void main() {
-  Material mat = materials[nonuniformEXT(pushConstant.material_index)];
+  Material mat = materials[nonuniformEXT(vMaterialIndex)];
   fragColor = mat.diffuse_factor;
 }
 
@@ -0,0 +1,101 @@
+#version 460
+#extension GL_GOOGLE_include_directive : require
+#extension GL_EXT_scalar_block_layout : require
+
+// ----------------------------------------------------------------------------
+//
+// Cull each meshlet against the camera frustum and its backface cone, for
+// every instance of its mesh, and append the visible ones to the indirect
+// draw commands of their submesh.
+//
+// ----------------------------------------------------------------------------
+
+#include <meshlet/interop.h>
+
+// ----------------------------------------------------------------------------
+
+layout(scalar, binding = kDescriptorSetBinding_Meshlets_StorageBuffer)
+readonly buffer MeshletsSBO_ {
+  Meshlet meshlets[];
+};
+
+layout(scalar, binding = kDescriptorSetBinding_Transforms_StorageBuffer)
+readonly buffer TransformsSBO_ {
+  mat4 worldMatrices[];
+};
+
+layout(scalar, binding = kDescriptorSetBinding_DrawCommands_StorageBuffer)
+writeonly buffer DrawCommandsSBO_ {
+  DrawIndexedCommand drawCommands[];
+};
+
+layout(scalar, binding = kDescriptorSetBinding_DrawCounts_StorageBuffer)
+buffer DrawCountsSBO_ {
+  uint drawCounts[];
+};
+
+layout(push_constant, scalar) uniform PushConstant_ {
+  PushConstant pushConstant;
+};
+
+// ----------------------------------------------------------------------------
+
+layout(
+  local_size_x = kCompute_CullMeshlets_kernelSize_x
+) in;
+
+// ----------------------------------------------------------------------------
+
+bool isVisible(in Meshlet meshlet, in mat4 worldMatrix) {
+  const mat3 basis = mat3(worldMatrix);
+  const float scale = max(length(basis[0]), max(length(basis[1]), length(basis[2])));
+
+  // Bounding sphere against the frustum side planes.
+  const vec3 center = (worldMatrix * vec4(meshlet.sphere.xyz, 1.0)).xyz;
+  const float radius = meshlet.sphere.w * scale;
+  for (uint i = 0u; i < kFrustumPlaneCount; ++i) {
+    const vec4 plane = pushConstant.frustumPlanes[i];
+    if (dot(plane.xyz, center) + plane.w < -radius) {
+      return false;
+    }
+  }
+
+  // Normal cone, assuming no mirroring transform.
+  const vec3 apex = (worldMatrix * vec4(meshlet.coneApex.xyz, 1.0)).xyz;
+  const vec3 axis = normalize(basis * meshlet.coneAxis.xyz);
+  const vec3 view = normalize(apex - pushConstant.cameraPos.xyz);
+  return dot(view, axis) < meshlet.coneApex.w;
+}
+
+// ----------------------------------------------------------------------------
+
+void main() {
+  const uint meshletId = gl_GlobalInvocationID.x;
+
+  if (meshletId >= pushConstant.meshletCount) {
+    return;
+  }
+
+  const Meshlet meshlet = meshlets[meshletId];
+
+  bool visible = false;
+  for (uint i = 0u; (i < meshlet.instanceCount) && !visible; ++i) {
+    visible = isVisible(meshlet, worldMatrices[meshlet.transformIndex + i]);
+  }
+
+  if (!visible) {
+    return;
+  }
+
+  // (every instance is drawn as soon as one of them sees the meshlet)
+  const uint slot = atomicAdd(drawCounts[meshlet.drawIndex], 1u);
+  drawCommands[meshlet.drawOffset + slot] = DrawIndexedCommand(
+    meshlet.indexCount,
+    meshlet.instanceCount,
+    meshlet.firstIndex,
+    0,
+    0u
+  );
+}
+
+// ----------------------------------------------------------------------------
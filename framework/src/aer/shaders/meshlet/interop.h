@@ -0,0 +1,66 @@
+#ifndef SHADERS_MESHLET_INTEROP_H_
+#define SHADERS_MESHLET_INTEROP_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+#define UINT uint32_t
+#define INT int32_t
+#else
+#define UINT uint
+#define INT int
+#endif
+
+// ----------------------------------------------------------------------------
+
+const UINT kDescriptorSetBinding_Meshlets_StorageBuffer     = 0;
+const UINT kDescriptorSetBinding_Transforms_StorageBuffer   = 1;
+const UINT kDescriptorSetBinding_DrawCommands_StorageBuffer = 2;
+const UINT kDescriptorSetBinding_DrawCounts_StorageBuffer   = 3;
+
+// ----------------------------------------------------------------------------
+
+const UINT kCompute_CullMeshlets_kernelSize_x = 64u;
+
+// Frustum side planes only, so that culling does not depend on the depth range.
+const UINT kFrustumPlaneCount = 4u;
+
+// Cone cutoff used to disable backface culling (eg. for double sided materials).
+const float kDisabledConeCutoff = 2.0f;
+
+// ----------------------------------------------------------------------------
+
+struct Meshlet {
+  vec4 sphere;          // xyz center, w radius, in mesh space.
+  vec4 coneApex;        // xyz apex, w cutoff.
+  vec4 coneAxis;        // xyz axis.
+  UINT firstIndex;      // relative to the submesh first index.
+  UINT indexCount;
+  UINT transformIndex;  // first of the mesh instances transforms.
+  UINT instanceCount;
+  UINT drawIndex;       // submesh slot in the draw counts buffer.
+  UINT drawOffset;      // first submesh slot in the draw commands buffer.
+  UINT _pad0[2];
+};
+
+// Matches VkDrawIndexedIndirectCommand.
+struct DrawIndexedCommand {
+  UINT indexCount;
+  UINT instanceCount;
+  UINT firstIndex;
+  INT vertexOffset;
+  UINT firstInstance;
+};
+
+struct PushConstant {
+  vec4 frustumPlanes[kFrustumPlaneCount]; // world space, normalized.
+  vec4 cameraPos;
+  UINT meshletCount;
+};
+
+// ----------------------------------------------------------------------------
+
+#undef INT
+#undef UINT
+
+#endif
@@ -352,4 +352,14 @@ vec3 decodeNormal(vec2 encoded) {
 
 // ----------------------------------------------------------------------------
 
+// Octahedral encoded unit vector, in [-1, 1]^2 (as used by CompactVertex).
+vec3 decodeOctahedral(vec2 e) {
+  vec3 n = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+  float t = max(-n.z, 0.0);
+  n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+  return normalize(n);
+}
+
+// ----------------------------------------------------------------------------
+
 #endif // SHADERS_SHARED_INC_MATHS_GLSL_
\ No newline at end of file
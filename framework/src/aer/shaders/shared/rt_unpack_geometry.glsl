@@ -3,11 +3,13 @@
 
 // ----------------------------------------------------------------------------
 
-// This should be include *AFTER* the ObjBuffers_t buffer reference.
+// This should be include *AFTER* the ObjBuffers_t buffer reference, and the
+// Vertices / CompactVertices / Indices buffer references.
 
 // ----------------------------------------------------------------------------
 
 #include <material/interop.h> //
+#include <shared/maths.glsl>
 
 struct Triangle_t {
   Vertex v0;
@@ -15,20 +17,50 @@ struct Triangle_t {
   Vertex v2;
 };
 
+// Indices buffers are read as uint words, 16bit ones being packed by pairs.
+uint fetch_index(in Indices indices, in bool is_16bit, uint i) {
+  if (is_16bit) {
+    const uint word = indices.u32[i >> 1];
+    return ((i & 1u) != 0u) ? (word >> 16u) : (word & 0xFFFFu);
+  }
+  return indices.u32[i];
+}
+
+// Compact positions are kept quantized, the instance transform dequantizing them,
+// so normals are scaled to stay orthogonal to the surface in that space.
+Vertex decode_compact_vertex(in CompactVertex c, in vec3 position_scale) {
+  const vec2 zw = unpackSnorm2x16(c.position_zw);
+
+  Vertex v;
+  v.position = vec3(unpackSnorm2x16(c.position_xy), zw.x);
+  v.normal   = decodeOctahedral(unpackSnorm2x16(c.normal)) * position_scale;
+  v.tangent  = vec4(decodeOctahedral(unpackSnorm2x16(c.tangent)) / position_scale, zw.y);
+  v.texcoord = unpackHalf2x16(c.texcoord);
+  return v;
+}
+
+Vertex fetch_vertex(in ObjBuffers_t obj, uint i) {
+  if (obj.compactVertex != 0u) {
+    return decode_compact_vertex(CompactVertices(obj.vertexAddr).v[i], obj.positionScale.xyz);
+  }
+  return Vertices(obj.vertexAddr).v[i];
+}
+
 Triangle_t unpack_triangle(uint instance_id, uint primitive_id) {
   ObjBuffers_t obj = ObjBuffers.addr[nonuniformEXT(instance_id)];
-  Vertices vertices = Vertices(obj.vertexAddr);
   Indices indices   = Indices(obj.indexAddr);
 
   const uint base_index = 3 * primitive_id;
 
-  const uint i0 = indices.u32[base_index + 0];
-  const uint i1 = indices.u32[base_index + 1];
-  const uint i2 = indices.u32[base_index + 2];
+  const bool is_16bit = (obj.index16bit != 0u);
+
+  const uint i0 = fetch_index(indices, is_16bit, base_index + 0);
+  const uint i1 = fetch_index(indices, is_16bit, base_index + 1);
+  const uint i2 = fetch_index(indices, is_16bit, base_index + 2);
 
-  Vertex v0 = vertices.v[i0];
-  Vertex v1 = vertices.v[i1];
-  Vertex v2 = vertices.v[i2];
+  Vertex v0 = fetch_vertex(obj, i0);
+  Vertex v1 = fetch_vertex(obj, i1);
+  Vertex v2 = fetch_vertex(obj, i2);
 
   Triangle_t tri;
   tri.v0 = v0;
@@ -0,0 +1,200 @@
+/* -------------------------------------------------------------------------- */
+//
+//    bench - accessor decode
+//
+//  Throughput of the bulk accessor decoder used when restructuring glTF
+//  vertices into VertexInternal_t, for common source layouts and for every
+//  backend available on this CPU, against per-vertex cgltf_accessor_read_float.
+//
+//  usage : bench_accessor_decode [vertex_count] [iterations]
+//
+/* -------------------------------------------------------------------------- */
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+extern "C" {
+#include <cgltf.h>
+}
+
+#include "aer/scene/private/accessor_decoder.h"
+#include "aer/scene/vertex_internal.h"
+
+#include "bench_utils.h"
+
+using namespace internal::accessor_decoder;
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+struct Case {
+  char const* name{};
+  Layout layout{};
+  size_t dst_offset{};
+  uint32_t dst_components{};
+};
+
+cgltf_component_type ToCgltf(ComponentType type) {
+  switch (type) {
+    case ComponentType::I8:   return cgltf_component_type_r_8;
+    case ComponentType::U8:   return cgltf_component_type_r_8u;
+    case ComponentType::I16:  return cgltf_component_type_r_16;
+    case ComponentType::U16:  return cgltf_component_type_r_16u;
+    case ComponentType::U32:  return cgltf_component_type_r_32u;
+    default:                  return cgltf_component_type_r_32f;
+  }
+}
+
+cgltf_type ToCgltf(uint32_t components) {
+  switch (components) {
+    case 1:   return cgltf_type_scalar;
+    case 2:   return cgltf_type_vec2;
+    case 3:   return cgltf_type_vec3;
+    default:  return cgltf_type_vec4;
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+uint32_t ComponentBytes(ComponentType type) {
+  switch (type) {
+    case ComponentType::I8:
+    case ComponentType::U8:
+      return 1u;
+    case ComponentType::I16:
+    case ComponentType::U16:
+      return 2u;
+    default:
+      return 4u;
+  }
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+int main(int argc, char *argv[]) {
+  size_t const vertex_count{
+    (argc > 1) ? static_cast<size_t>(std::atoll(argv[1])) : (1u << 20u)
+  };
+  uint32_t const iterations{
+    (argc > 2) ? static_cast<uint32_t>(std::atoi(argv[2])) : 20u
+  };
+
+  size_t const kPosition{ offsetof(VertexInternal_t, position) };
+  size_t const kNormal{ offsetof(VertexInternal_t, normal) };
+  size_t const kTangent{ offsetof(VertexInternal_t, tangent) };
+  size_t const kTexcoord{ offsetof(VertexInternal_t, texcoord) };
+
+  // Strides follow the glTF 4-bytes vertex attribute alignment rule.
+  std::vector<Case> const cases{
+    { "f32 vec3 (position)",      { ComponentType::F32, 3u, false, 12u }, kPosition, 3u },
+    { "f32 vec3 (normal)",        { ComponentType::F32, 3u, false, 12u }, kNormal,   3u },
+    { "f32 vec4 (tangent)",       { ComponentType::F32, 4u, false, 16u }, kTangent,  4u },
+    { "f32 vec2 (texcoord)",      { ComponentType::F32, 2u, false,  8u }, kTexcoord, 2u },
+    { "u8n vec2 (texcoord)",      { ComponentType::U8,  2u, true,   4u }, kTexcoord, 2u },
+    { "u16n vec2 (texcoord)",     { ComponentType::U16, 2u, true,   4u }, kTexcoord, 2u },
+    { "i16 vec3 (quant. pos.)",   { ComponentType::I16, 3u, false,  8u }, kPosition, 3u },
+    { "i16n vec3 (quant. pos.)",  { ComponentType::I16, 3u, true,   8u }, kPosition, 3u },
+    { "i8n vec3 (quant. normal)", { ComponentType::I8,  3u, true,   4u }, kNormal,   3u },
+    { "i16n vec4 (quant. tan.)",  { ComponentType::I16, 4u, true,   8u }, kTangent,  4u },
+  };
+
+  std::vector<Backend> backends{};
+  for (auto backend : { Backend::Scalar, Backend::SSE, Backend::AVX2, Backend::NEON }) {
+    if (IsBackendSupported(backend)) {
+      backends.push_back(backend);
+    }
+  }
+
+  std::vector<VertexInternal_t> vertices(vertex_count);
+  std::vector<VertexInternal_t> reference(vertex_count);
+  std::mt19937 rng{ 0x5eed };
+
+  std::printf("%zu vertices, %u iterations, best backend : %s\n",
+    vertex_count, iterations, BackendName(BestBackend())
+  );
+  std::printf("\n  %-26s %-8s %12s %14s\n", "layout", "backend", "median (ms)", "Mvertices/s");
+
+  for (auto const& c : cases) {
+    // Random source data, floats are kept finite.
+    size_t const element_bytes = ComponentBytes(c.layout.type) * c.layout.components;
+    std::vector<uint8_t> src((vertex_count - 1u) * c.layout.stride + element_bytes);
+    if (c.layout.type == ComponentType::F32) {
+      std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+      for (size_t i = 0u; i + sizeof(float) <= src.size(); i += sizeof(float)) {
+        float const value = dist(rng);
+        std::memcpy(src.data() + i, &value, sizeof(value));
+      }
+    } else {
+      for (auto& byte : src) {
+        byte = static_cast<uint8_t>(rng());
+      }
+    }
+
+    auto decode{[&](Backend backend, std::vector<VertexInternal_t>& dst) {
+      float* const dst_ptr = reinterpret_cast<float*>(
+        reinterpret_cast<uint8_t*>(dst.data()) + c.dst_offset
+      );
+      DecodeFloats(
+        src.data(), c.layout, vertex_count,
+        dst_ptr, sizeof(VertexInternal_t), c.dst_components,
+        backend
+      );
+    }};
+
+    decode(Backend::Scalar, reference);
+
+    // Baseline : one cgltf_accessor_read_float call per vertex.
+    {
+      cgltf_buffer buffer{};
+      buffer.size = src.size();
+      buffer.data = src.data();
+
+      cgltf_buffer_view view{};
+      view.buffer = &buffer;
+      view.size = src.size();
+      view.stride = c.layout.stride;
+
+      cgltf_accessor accessor{};
+      accessor.component_type = ToCgltf(c.layout.type);
+      accessor.normalized = c.layout.normalized;
+      accessor.type = ToCgltf(c.layout.components);
+      accessor.count = vertex_count;
+      accessor.stride = c.layout.stride;
+      accessor.buffer_view = &view;
+
+      auto const stats = bench::Measure(iterations, [&] {
+        for (size_t i = 0u; i < vertex_count; ++i) {
+          auto* dst = reinterpret_cast<float*>(
+            reinterpret_cast<uint8_t*>(&vertices[i]) + c.dst_offset
+          );
+          cgltf_accessor_read_float(&accessor, i, dst, c.dst_components);
+        }
+      });
+      double const mvps = static_cast<double>(vertex_count) / (stats.median_ms * 1.0e3);
+      std::printf("  %-26s %-8s %12.3f %14.1f\n", c.name, "cgltf", stats.median_ms, mvps);
+    }
+
+    for (auto backend : backends) {
+      auto const stats = bench::Measure(iterations, [&] { decode(backend, vertices); });
+      double const mvps = static_cast<double>(vertex_count) / (stats.median_ms * 1.0e3);
+
+      bool const match = (0 == std::memcmp(vertices.data(), reference.data(),
+                                           vertices.size() * sizeof(VertexInternal_t)));
+      std::printf("  %-26s %-8s %12.3f %14.1f%s\n",
+        c.name, BackendName(backend), stats.median_ms, mvps,
+        match ? "" : "  (mismatch)"
+      );
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/* -------------------------------------------------------------------------- */
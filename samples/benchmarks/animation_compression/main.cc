@@ -0,0 +1,218 @@
+/* -------------------------------------------------------------------------- */
+//
+//    bench - animation compression
+//
+//  Compress a set of procedural clips with different profiles (mostly still,
+//  smooth cycles, noisy capture, stepped keys) and report, per clip, the
+//  size and the max error against the raw resampled data, with the count of
+//  constant tracks and kept keys.
+//
+//  Then compare the cost of sampling poses at random times from the raw and
+//  the compressed clips. Errors are checked against the compression
+//  tolerances.
+//
+//  usage : bench_animation_compression [joint_count] [sample_count] [iterations]
+//
+/* -------------------------------------------------------------------------- */
+
+#include <cmath>
+#include <random>
+
+#include "aer/core/common.h"
+#include "aer/scene/animation_runtime.h"
+#include "aer/scene/private/animation_compressor.h"
+
+#include "bench_utils.h"
+
+using namespace internal::animation_compressor;
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+using Channel = scene::Pose::Channel;
+
+float constexpr kClipDuration{ 4.0f };
+
+// Poses sampled per timed iteration.
+uint32_t constexpr kSampledPoses{ 2048u };
+
+float constexpr kRadiansToDegrees{ 180.0f / lina::kPi };
+
+enum class Profile {
+  Still,    // a few animated joints, the others constant.
+  Cycle,    // every joint rotating smoothly, root translating.
+  Capture,  // smooth cycles with per sample noise.
+  Stepped,  // held poses switching every few samples.
+};
+
+char const* ProfileName(Profile profile) {
+  switch (profile) {
+    case Profile::Still:    return "still";
+    case Profile::Cycle:    return "cycle";
+    case Profile::Capture:  return "capture";
+    default:                return "stepped";
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+vec4f AxisAngle(vec3f const& axis, float angle) {
+  float const s{ std::sin(0.5f * angle) };
+  return vec4f(axis.x * s, axis.y * s, axis.z * s, std::cos(0.5f * angle));
+}
+
+/* Rest pose of a chain of joints, each one offset from its parent. */
+scene::Pose MakeRestPose(uint32_t joint_count) {
+  scene::Pose pose(joint_count);
+  for (uint32_t j = 0u; j < joint_count; ++j) {
+    pose.set_joint(j, { .translation = vec3f(0.0f, (j == 0u) ? 0.0f : 0.25f, 0.0f) });
+  }
+  return pose;
+}
+
+scene::AnimationClip MakeClip(scene::Pose const& rest_pose, uint32_t sample_count, Profile profile) {
+  std::mt19937 rng(static_cast<uint32_t>(profile) + 1u);
+  std::uniform_real_distribution<float> phase_dist(0.0f, 2.0f * lina::kPi);
+  std::uniform_real_distribution<float> amplitude_dist(0.1f, 1.2f);
+  std::normal_distribution<float> noise_dist(0.0f, 0.01f);
+
+  uint32_t const joint_count{ rest_pose.joint_count };
+  scene::AnimationClip clip{};
+  clip.setup(ProfileName(profile), sample_count, kClipDuration, rest_pose);
+
+  uint32_t constexpr kStepLength{ 8u };
+  for (uint32_t j = 0u; j < joint_count; ++j) {
+    bool const still{ (profile == Profile::Still) && (j % 8u != 0u) };
+    float const phase{ phase_dist(rng) };
+    float const amplitude{ amplitude_dist(rng) };
+    vec3f const axis{ linalg::normalize(vec3f(std::cos(phase), 1.0f, std::sin(phase))) };
+
+    for (uint32_t i = 0u; i < sample_count; ++i) {
+      uint32_t const s{ (profile == Profile::Stepped) ? i - (i % kStepLength) : i };
+      float const t{ 2.0f * lina::kPi * static_cast<float>(s) / std::max(sample_count - 1u, 1u) };
+      auto transform{ rest_pose.joint(j) };
+      if (!still) {
+        float angle{ amplitude * std::sin(t + phase) };
+        if (profile == Profile::Capture) {
+          angle += noise_dist(rng);
+        }
+        transform.rotation = AxisAngle(axis, angle);
+      }
+      if ((j == 0u) && (profile != Profile::Still)) {
+        transform.translation = vec3f(std::cos(t), 0.05f * std::sin(2.0f * t), std::sin(t));
+      }
+
+      auto* sample{ clip.sample(i) };
+      uint32_t const stride{ clip.joint_stride };
+      sample[Channel::RotationX * stride + j] = transform.rotation.x;
+      sample[Channel::RotationY * stride + j] = transform.rotation.y;
+      sample[Channel::RotationZ * stride + j] = transform.rotation.z;
+      sample[Channel::RotationW * stride + j] = transform.rotation.w;
+      sample[Channel::TranslationX * stride + j] = transform.translation.x;
+      sample[Channel::TranslationY * stride + j] = transform.translation.y;
+      sample[Channel::TranslationZ * stride + j] = transform.translation.z;
+      sample[Channel::Scale * stride + j] = transform.scale;
+    }
+  }
+  return clip;
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+int main(int argc, char *argv[]) {
+  uint32_t const joint_count{
+    (argc > 1) ? static_cast<uint32_t>(std::max(std::atoi(argv[1]), 1)) : 64u
+  };
+  uint32_t const sample_count{
+    (argc > 2) ? static_cast<uint32_t>(std::max(std::atoi(argv[2]), 2)) : 241u
+  };
+  uint32_t const iterations{
+    (argc > 3) ? static_cast<uint32_t>(std::atoi(argv[3])) : 10u
+  };
+
+  Logger::Initialize();
+
+  Settings const settings{};
+  auto const rest_pose{ MakeRestPose(joint_count) };
+
+  std::mt19937 rng(5u);
+  std::uniform_real_distribution<float> time_dist(0.0f, kClipDuration);
+  std::vector<float> times(kSampledPoses);
+  for (auto& time : times) {
+    time = time_dist(rng);
+  }
+
+  std::printf("\n%u joints, %u samples over %.1f s, tolerances %.3f deg / %.1e / %.1e\n",
+    joint_count, sample_count, kClipDuration,
+    settings.rotation_tolerance * kRadiansToDegrees,
+    settings.translation_tolerance,
+    settings.scale_tolerance
+  );
+
+  std::printf("\ncompression\n");
+  std::printf("  %-10s %10s %10s %7s %9s %9s %12s %12s %12s\n",
+    "clip", "raw (KB)", "comp (KB)", "ratio", "constant", "keys (%)", "rot (deg)", "translation", "scale"
+  );
+
+  uint32_t failures{0u};
+  std::vector<scene::AnimationClip> raw_clips{};
+  std::vector<scene::AnimationClip> compressed_clips{};
+  for (auto const profile : { Profile::Still, Profile::Cycle, Profile::Capture, Profile::Stepped }) {
+    raw_clips.push_back(MakeClip(rest_pose, sample_count, profile));
+    compressed_clips.push_back(raw_clips.back());
+
+    Report r{};
+    if (!CompressClip(compressed_clips.back(), settings, &r)) {
+      std::printf("  %-10s compression failed\n", ProfileName(profile));
+      ++failures;
+      continue;
+    }
+    double const kKilobyte{ 1024.0 };
+    std::printf("  %-10s %10.1f %10.1f %6.1fx %4u/%-4u %9.1f %12.4f %12.2e %12.2e\n",
+      ProfileName(profile),
+      r.raw_bytes / kKilobyte,
+      r.compressed_bytes / kKilobyte,
+      double(r.raw_bytes) / double(std::max(r.compressed_bytes, uint64_t(1u))),
+      r.constant_tracks, r.constant_tracks + r.animated_tracks,
+      (r.raw_keys > 0u) ? 100.0 * double(r.kept_keys) / double(r.raw_keys) : 0.0,
+      r.max_rotation_error,
+      r.max_translation_error,
+      r.max_scale_error
+    );
+
+    if ((r.max_rotation_error > settings.rotation_tolerance * kRadiansToDegrees)
+     || (r.max_translation_error > settings.translation_tolerance)
+     || (r.max_scale_error > settings.scale_tolerance)) {
+      ++failures;
+    }
+  }
+  std::printf("  %-10s %10s\n", "in bounds", (failures == 0u) ? "yes" : "NO");
+
+  /* Sampling cost. */
+  for (size_t i = 0u; i < raw_clips.size(); ++i) {
+    auto const title{ fmt::format("sampling \"{}\" ({} poses)", raw_clips[i].name, kSampledPoses) };
+    bench::PrintHeader(title.c_str());
+
+    scene::Pose pose(joint_count);
+    for (auto const* clip : { &raw_clips[i], &compressed_clips[i] }) {
+      auto const stats = bench::Measure(iterations, [&] {
+        for (auto const time : times) {
+          scene::SampleClip(*clip, time, pose);
+        }
+      });
+      auto const label{ fmt::format("{} ({:.0f} poses/ms)",
+        clip->is_compressed() ? "compressed" : "raw", kSampledPoses / stats.median_ms
+      ) };
+      bench::PrintStats(label.c_str(), stats);
+    }
+  }
+
+  Logger::Deinitialize();
+
+  return (failures == 0u) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,69 @@
+#ifndef SAMPLES_BENCHMARKS_BENCH_UTILS_H_
+#define SAMPLES_BENCHMARKS_BENCH_UTILS_H_
+
+/* -------------------------------------------------------------------------- */
+//
+//    bench_utils.h
+//
+//  Minimal timing helpers shared by the headless benchmarks.
+//
+/* -------------------------------------------------------------------------- */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+#include <vector>
+
+namespace bench {
+
+/* -------------------------------------------------------------------------- */
+
+struct Stats {
+  double min_ms{};
+  double median_ms{};
+  double mean_ms{};
+};
+
+// ----------------------------------------------------------------------------
+
+/* Time 'iterations' calls of fn, after 'warmup' untimed ones. */
+template<typename Fn>
+Stats Measure(uint32_t iterations, Fn&& fn, uint32_t warmup = 1u) {
+  using Clock = std::chrono::steady_clock;
+
+  for (uint32_t i = 0u; i < warmup; ++i) {
+    fn();
+  }
+
+  std::vector<double> samples(std::max(iterations, 1u));
+  for (auto& sample : samples) {
+    auto const start{ Clock::now() };
+    fn();
+    sample = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  }
+  std::sort(samples.begin(), samples.end());
+
+  return {
+    .min_ms = samples.front(),
+    .median_ms = samples[samples.size() / 2u],
+    .mean_ms = std::accumulate(samples.begin(), samples.end(), 0.0) / double(samples.size()),
+  };
+}
+
+// ----------------------------------------------------------------------------
+
+inline void PrintHeader(char const* title) {
+  std::printf("\n%s\n", title);
+  std::printf("  %-32s %12s %12s %12s\n", "case", "min (ms)", "median (ms)", "mean (ms)");
+}
+
+inline void PrintStats(char const* label, Stats const& s) {
+  std::printf("  %-32s %12.3f %12.3f %12.3f\n", label, s.min_ms, s.median_ms, s.mean_ms);
+}
+
+/* -------------------------------------------------------------------------- */
+
+} // namespace bench
+
+#endif // SAMPLES_BENCHMARKS_BENCH_UTILS_H_
@@ -0,0 +1,325 @@
+/* -------------------------------------------------------------------------- */
+//
+//    bench - draw lists
+//
+//  Order the submeshes of synthetic scenes of 1k, 10k and 100k submeshes for
+//  drawing, as done by GPUResources::update every frame.
+//
+//  Report the per-frame cost of binning them in std::map then sorting each bin
+//  by depth, as before, against the persistent DrawLists 64-bit keys with a
+//  static view, a moving view and when invalidated every frame. The keys
+//  radix sort is compared to std::ranges::sort, serially and on the job system.
+//
+//  Count the state changes recorded when drawing both orders, and check the
+//  radix sort against std::ranges::stable_sort.
+//
+//  usage : bench_draw_lists [iterations]
+//
+/* -------------------------------------------------------------------------- */
+
+#include <array>
+#include <cmath>
+#include <map>
+#include <random>
+
+#include "aer/core/common.h"
+#include "aer/core/job_system.h"
+#include "aer/renderer/draw_lists.h"
+
+#include "bench_utils.h"
+
+using scene::MaterialStates;
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+uint32_t constexpr kSubmeshesPerMesh{ 4u };
+uint32_t constexpr kMaterialCount{ 64u };
+uint32_t constexpr kFxCount{ 8u };
+
+// Half extent of the cube the meshes are scattered in.
+float constexpr kSceneExtent{ 500.0f };
+
+// Camera orbit step per frame, in radians.
+float constexpr kOrbitStep{ 0.01f };
+
+// Stand-ins for the MaterialFx, whose addresses are only used as bin keys.
+std::array<std::byte, kFxCount> sFxTags{};
+
+// ----------------------------------------------------------------------------
+
+struct Scene {
+  std::vector<std::unique_ptr<scene::MaterialRef>> material_refs{};
+  std::vector<std::unique_ptr<scene::Mesh>> meshes{};
+  std::vector<mat4f> transforms{};
+};
+
+Scene MakeScene(uint32_t submesh_count) {
+  std::mt19937 rng(submesh_count);
+  std::uniform_real_distribution<float> position(-kSceneExtent, kSceneExtent);
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+  Scene s{};
+
+  // 70% opaque, 20% masked and 10% blended materials.
+  for (uint32_t i = 0u; i < kMaterialCount; ++i) {
+    float const r{ unit(rng) };
+    auto matref = std::make_unique<scene::MaterialRef>();
+    matref->states.alpha_mode = (r < 0.7f) ? MaterialStates::AlphaMode::Opaque
+                              : (r < 0.9f) ? MaterialStates::AlphaMode::Mask
+                                           : MaterialStates::AlphaMode::Blend
+                                           ;
+    matref->proxy_index = i;
+    matref->material_index = i;
+    s.material_refs.push_back(std::move(matref));
+  }
+
+  uint32_t const mesh_count{ (submesh_count + kSubmeshesPerMesh - 1u) / kSubmeshesPerMesh };
+  s.meshes.reserve(mesh_count);
+  s.transforms.reserve(mesh_count);
+  for (uint32_t m = 0u; m < mesh_count; ++m) {
+    mat4f world{ linalg::identity };
+    world.w = vec4f(position(rng), position(rng), position(rng), 1.0f);
+    s.transforms.push_back(world);
+
+    auto mesh = std::make_unique<scene::Mesh>();
+    mesh->transform_index = m;
+    uint32_t const count{ std::min(kSubmeshesPerMesh, submesh_count - m * kSubmeshesPerMesh) };
+    mesh->submeshes.resize(count);
+    for (auto& submesh : mesh->submeshes) {
+      submesh.parent = mesh.get();
+      submesh.material_ref = s.material_refs[rng() % kMaterialCount].get();
+    }
+    s.meshes.push_back(std::move(mesh));
+  }
+
+  return s;
+}
+
+MaterialFx* ResolveFx(scene::MaterialRef const& matref) {
+  return reinterpret_cast<MaterialFx*>(&sFxTags[matref.material_index % kFxCount]);
+}
+
+/* Camera orbiting the scene center. */
+std::pair<vec3, vec3> OrbitView(uint32_t frame) {
+  float const angle{ kOrbitStep * static_cast<float>(frame) };
+  vec3 const eye{ 2.0f * kSceneExtent * std::cos(angle), 0.25f * kSceneExtent, 2.0f * kSceneExtent * std::sin(angle) };
+  return { eye, linalg::normalize(-eye) };
+}
+
+// ----------------------------------------------------------------------------
+
+struct StateChanges {
+  uint32_t pipeline_binds{};
+  uint32_t descriptor_set_binds{};
+  uint32_t push_constants{};
+};
+
+/* State changes of the draw items, as skipped by GPUResources::render. */
+StateChanges CountStateChanges(DrawLists const& draw_lists) {
+  StateChanges changes{};
+  auto const& pipelines = draw_lists.pipelines();
+  uint32_t bound_pipeline{ kInvalidIndexU32 };
+  MaterialFx const* bound_fx{};
+  scene::Mesh const* pushed_mesh{};
+  uint32_t pushed_material{ kInvalidIndexU32 };
+
+  for (auto const& item : draw_lists.items()) {
+    if (item.pipeline != bound_pipeline) {
+      if (pipelines[item.pipeline].fx != bound_fx) {
+        bound_fx = pipelines[item.pipeline].fx;
+        pushed_mesh = nullptr;
+        ++changes.descriptor_set_binds;
+      }
+      bound_pipeline = item.pipeline;
+      ++changes.pipeline_binds;
+    }
+    uint32_t const material_index{ item.submesh->material_ref->material_index };
+    if ((item.submesh->parent != pushed_mesh) || (material_index != pushed_material)) {
+      pushed_mesh = item.submesh->parent;
+      pushed_material = material_index;
+      ++changes.push_constants;
+    }
+  }
+  return changes;
+}
+
+void PrintStateChanges(char const* label, StateChanges const& changes) {
+  std::printf("  %-32s %12u %12u %12u\n",
+    label, changes.pipeline_binds, changes.descriptor_set_binds, changes.push_constants
+  );
+}
+
+// ----------------------------------------------------------------------------
+
+/* Per-frame binning as GPUResources::update did before DrawLists. */
+class MapDrawLists {
+ public:
+  using SubMesh = scene::Mesh::SubMesh;
+  using SubMeshBuffer = std::vector<SubMesh const*>;
+  using FxHashPair = std::pair<MaterialFx*, MaterialStates>;
+  using FxHashPairToSubmeshesMap = std::map<FxHashPair, SubMeshBuffer>;
+
+  void update(Scene const& s, vec3 const& eye, vec3 const& direction) {
+    lookups_ = {};
+    for (auto const& mesh : s.meshes) {
+      for (auto const& submesh : mesh->submeshes) {
+        if (auto matref = submesh.material_ref; matref) {
+          auto const alpha_mode = matref->states.alpha_mode;
+          auto hashpair = std::make_pair(ResolveFx(*matref), matref->states);
+          lookups_[static_cast<size_t>(alpha_mode)][hashpair].emplace_back(&submesh);
+        }
+      }
+    }
+
+    using SortKey = std::pair<float, size_t>;
+    std::vector<SortKey> sortkeys{};
+    SubMeshBuffer swap_buffer{};
+
+    auto sort_submeshes = [&](SubMeshBuffer &submeshes, auto comp) {
+      sortkeys = {};
+      sortkeys.reserve(submeshes.size());
+      for (size_t i = 0; i < submeshes.size(); ++i) {
+        mat4f const& world = s.transforms[submeshes[i]->parent->transform_index];
+        vec3 const v = eye - lina::to_vec3(world.w);
+        sortkeys.emplace_back(linalg::dot(direction, v), i);
+      }
+      std::ranges::sort(sortkeys, comp, &SortKey::first);
+      swap_buffer.resize(submeshes.size());
+      for (size_t i = 0; i < submeshes.size(); ++i) {
+        swap_buffer[i] = submeshes[sortkeys[i].second];
+      }
+      submeshes.swap(swap_buffer);
+    };
+
+    for (size_t mode = 0u; mode < lookups_.size(); ++mode) {
+      bool const blend{ mode == static_cast<size_t>(MaterialStates::AlphaMode::Blend) };
+      for (auto& [_, submeshes] : lookups_[mode]) {
+        blend ? sort_submeshes(submeshes, std::greater{})
+              : sort_submeshes(submeshes, std::less{});
+      }
+    }
+  }
+
+  /* One pipeline and descriptor sets bind per bin, one push constant per draw. */
+  StateChanges state_changes() const {
+    StateChanges changes{};
+    for (auto const& lookup : lookups_) {
+      for (auto const& [_, submeshes] : lookup) {
+        ++changes.pipeline_binds;
+        ++changes.descriptor_set_binds;
+        changes.push_constants += static_cast<uint32_t>(submeshes.size());
+      }
+    }
+    return changes;
+  }
+
+ private:
+  std::array<FxHashPairToSubmeshesMap, static_cast<size_t>(MaterialStates::AlphaMode::kCount)> lookups_{};
+};
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+int main(int argc, char *argv[]) {
+  uint32_t const iterations{
+    (argc > 1) ? static_cast<uint32_t>(std::atoi(argv[1])) : 50u
+  };
+
+  Logger::Initialize();
+  utils::JobSystem::Initialize();
+
+  uint32_t failures{0u};
+  for (uint32_t const submesh_count : { 1000u, 10000u, 100000u }) {
+    auto const s{ MakeScene(submesh_count) };
+
+    auto const title{ fmt::format("{} submeshes, {} materials over {} fx", submesh_count, kMaterialCount, kFxCount) };
+    bench::PrintHeader(title.c_str());
+
+    /* Rebuilt every frame, as before. */
+    MapDrawLists map_lists{};
+    {
+      uint32_t frame{0u};
+      auto const stats = bench::Measure(iterations, [&] {
+        auto const [eye, direction] = OrbitView(frame++);
+        map_lists.update(s, eye, direction);
+      });
+      bench::PrintStats("std::map rebuild, moving view", stats);
+    }
+
+    /* Persistent keys. */
+    DrawLists draw_lists{};
+    {
+      auto const [eye, direction] = OrbitView(0u);
+      auto const stats = bench::Measure(iterations, [&] {
+        draw_lists.update(s.meshes, ResolveFx, s.transforms, eye, direction);
+      });
+      bench::PrintStats("keys, static view", stats);
+    }
+    {
+      uint32_t frame{0u};
+      auto const stats = bench::Measure(iterations, [&] {
+        auto const [eye, direction] = OrbitView(frame++);
+        draw_lists.update(s.meshes, ResolveFx, s.transforms, eye, direction);
+      });
+      bench::PrintStats("keys, moving view", stats);
+    }
+    {
+      uint32_t frame{0u};
+      auto const stats = bench::Measure(iterations, [&] {
+        auto const [eye, direction] = OrbitView(frame++);
+        draw_lists.invalidate();
+        draw_lists.update(s.meshes, ResolveFx, s.transforms, eye, direction);
+      });
+      bench::PrintStats("keys, invalidated every frame", stats);
+    }
+
+    /* Sort of the same shuffled keys, copy included. */
+    {
+      auto shuffled{ draw_lists.items() };
+      std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(submesh_count));
+
+      std::vector<DrawLists::DrawItem> items{};
+      std::vector<DrawLists::DrawItem> scratch{};
+      bench::PrintStats("std::ranges::sort", bench::Measure(iterations, [&] {
+        items = shuffled;
+        std::ranges::sort(items, std::less{}, &DrawLists::DrawItem::key);
+      }));
+      bench::PrintStats("radix sort", bench::Measure(iterations, [&] {
+        items = shuffled;
+        DrawLists::RadixSort(items, scratch, false);
+      }));
+      auto const label{ fmt::format("radix sort, {} workers", utils::JobSystem::Get().worker_count()) };
+      bench::PrintStats(label.c_str(), bench::Measure(iterations, [&] {
+        items = shuffled;
+        DrawLists::RadixSort(items, scratch, true);
+      }));
+
+      // Both radix variants are stable.
+      auto reference{ shuffled };
+      std::ranges::stable_sort(reference, std::less{}, &DrawLists::DrawItem::key);
+      bool same{ true };
+      for (bool const parallel : { false, true }) {
+        items = shuffled;
+        DrawLists::RadixSort(items, scratch, parallel);
+        same = same && std::ranges::equal(items, reference, {}, &DrawLists::DrawItem::submesh, &DrawLists::DrawItem::submesh);
+      }
+      failures += same ? 0u : 1u;
+      std::printf("  %-32s %12s\n", "radix matches stable_sort", same ? "yes" : "NO");
+    }
+
+    /* State changes recorded for a frame. */
+    std::printf("  %-32s %12s %12s %12s\n", "state changes", "pipelines", "desc. sets", "push const.");
+    PrintStateChanges("std::map bins", map_lists.state_changes());
+    PrintStateChanges("sorted keys", CountStateChanges(draw_lists));
+  }
+
+  utils::JobSystem::Deinitialize();
+  Logger::Deinitialize();
+
+  return (failures == 0u) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* -------------------------------------------------------------------------- */
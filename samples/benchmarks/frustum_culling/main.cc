@@ -0,0 +1,239 @@
+/* -------------------------------------------------------------------------- */
+//
+//    bench - frustum culling
+//
+//  Cull synthetic scenes of 10k, 100k and 1M submeshes, scattered in a cube
+//  around a camera orbiting it, as done by GPUResources::update every frame.
+//
+//  The FrustumCulling SoA kernel, testing 8 boxes per iteration, is compared
+//  to a scalar test of array of structures boxes, serially and on the job
+//  system, then timed with the world boxes update from the mesh space bounds
+//  of the submeshes.
+//
+//  Check that both kernels agree, and report the visible and culled counts.
+//
+//  usage : bench_frustum_culling [iterations]
+//
+/* -------------------------------------------------------------------------- */
+
+#include <cmath>
+#include <random>
+
+#include "aer/core/common.h"
+#include "aer/core/job_system.h"
+#include "aer/renderer/frustum_culling.h"
+
+#include "bench_utils.h"
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+uint32_t constexpr kSubmeshesPerMesh{ 4u };
+
+// Half extent of the cube the meshes are scattered in.
+float constexpr kSceneExtent{ 500.0f };
+
+// Camera orbit step per frame, in radians.
+float constexpr kOrbitStep{ 0.01f };
+
+#if defined(__AVX__)
+char const* kKernelName{ "AVX" };
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1))
+char const* kKernelName{ "SSE" };
+#else
+char const* kKernelName{ "scalar" };
+#endif
+
+// ----------------------------------------------------------------------------
+
+struct Scene {
+  std::vector<std::unique_ptr<scene::Mesh>> meshes{};
+  std::vector<mat4f> transforms{};
+  std::vector<DrawLists::DrawItem> items{};
+};
+
+/* Meshes of kSubmeshesPerMesh primitives, of mesh space boxes up to 10 units wide. */
+Scene MakeScene(uint32_t submesh_count) {
+  std::mt19937 rng(submesh_count);
+  std::uniform_real_distribution<float> position(-kSceneExtent, kSceneExtent);
+  std::uniform_real_distribution<float> extent(0.5f, 5.0f);
+
+  Scene s{};
+
+  uint32_t const mesh_count{ (submesh_count + kSubmeshesPerMesh - 1u) / kSubmeshesPerMesh };
+  s.meshes.reserve(mesh_count);
+  s.transforms.reserve(mesh_count);
+  s.items.reserve(submesh_count);
+  for (uint32_t m = 0u; m < mesh_count; ++m) {
+    mat4f world{ linalg::identity };
+    world.w = vec4f(position(rng), position(rng), position(rng), 1.0f);
+    s.transforms.push_back(world);
+
+    auto mesh = std::make_unique<scene::Mesh>();
+    mesh->transform_index = m;
+    uint32_t const count{ std::min(kSubmeshesPerMesh, submesh_count - m * kSubmeshesPerMesh) };
+    for (uint32_t i = 0u; i < count; ++i) {
+      float const ex{ extent(rng) }, ey{ extent(rng) }, ez{ extent(rng) };
+      mesh->add_primitive({
+        .boundsMin = { -ex, -ey, -ez },
+        .boundsMax = { ex, ey, ez },
+        .radius = std::sqrt(ex * ex + ey * ey + ez * ez),
+      });
+    }
+    mesh->submeshes.resize(count, { .parent = mesh.get() });
+    for (auto const& submesh : mesh->submeshes) {
+      s.items.push_back({ .submesh = &submesh, .transform_index = m });
+    }
+    s.meshes.push_back(std::move(mesh));
+  }
+
+  return s;
+}
+
+/* View projection of a camera orbiting the scene center. */
+mat4 OrbitViewProj(uint32_t frame) {
+  float const angle{ kOrbitStep * static_cast<float>(frame) };
+  vec3 const eye{ 1.5f * kSceneExtent * std::cos(angle), 0.25f * kSceneExtent, 1.5f * kSceneExtent * std::sin(angle) };
+  mat4 const view{ linalg::lookat_matrix(eye, vec3(0.0f), vec3(0.0f, 1.0f, 0.0f)) };
+  mat4 const proj{ linalg::perspective_matrix(
+    lina::radians(60.0f), 16.0f / 9.0f, 0.1f, 4.0f * kSceneExtent, linalg::neg_z, linalg::zero_to_one
+  ) };
+  return linalg::mul(proj, view);
+}
+
+// ----------------------------------------------------------------------------
+
+/* Array of structures boxes, one plane test at a time. */
+struct Box {
+  vec3 center{};
+  vec3 extent{};
+};
+
+uint32_t CullScalar(
+  FrustumCulling::Frustum const& frustum,
+  std::vector<Box> const& boxes,
+  std::vector<uint8_t>& visibility
+) {
+  uint32_t visible_count{0u};
+  for (size_t i = 0u; i < boxes.size(); ++i) {
+    bool visible{ true };
+    for (auto const& plane : frustum.planes) {
+      vec3 const n{ lina::to_vec3(plane) };
+      float const d{ linalg::dot(n, boxes[i].center) + plane.w };
+      float const r{ linalg::dot(linalg::abs(n), boxes[i].extent) };
+      if (d + r < 0.0f) {
+        visible = false;
+        break;
+      }
+    }
+    visibility[i] = visible ? 1u : 0u;
+    visible_count += visible ? 1u : 0u;
+  }
+  return visible_count;
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+int main(int argc, char *argv[]) {
+  uint32_t const iterations{
+    (argc > 1) ? static_cast<uint32_t>(std::atoi(argv[1])) : 50u
+  };
+
+  Logger::Initialize();
+  utils::JobSystem::Initialize();
+
+  uint32_t const worker_count{ utils::JobSystem::Get().worker_count() };
+
+  uint32_t failures{0u};
+  for (uint32_t const submesh_count : { 10000u, 100000u, 1000000u }) {
+    auto const s{ MakeScene(submesh_count) };
+
+    auto const title{ fmt::format("{} submeshes, {} kernel", submesh_count, kKernelName) };
+    bench::PrintHeader(title.c_str());
+
+    // World boxes of the first frame, in both layouts.
+    FrustumCulling::Boxes boxes{};
+    boxes.resize(submesh_count);
+    std::vector<Box> aos_boxes(submesh_count);
+    for (uint32_t i = 0u; i < submesh_count; ++i) {
+      auto const& item = s.items[i];
+      auto const& prim = item.submesh->parent->get_primitive(
+        static_cast<uint32_t>(item.submesh - item.submesh->parent->submeshes.data())
+      );
+      auto& box = aos_boxes[i];
+      FrustumCulling::TransformBox(
+        s.transforms[item.transform_index],
+        vec3(prim.boundsMin[0], prim.boundsMin[1], prim.boundsMin[2]),
+        vec3(prim.boundsMax[0], prim.boundsMax[1], prim.boundsMax[2]),
+        box.center, box.extent
+      );
+      boxes.set(i, box.center, box.extent);
+    }
+
+    /* Plane tests only. */
+    std::vector<uint8_t> scalar_visibility(submesh_count);
+    std::vector<uint8_t> visibility(submesh_count);
+    {
+      uint32_t frame{0u};
+      bench::PrintStats("scalar AoS", bench::Measure(iterations, [&] {
+        auto const frustum{ FrustumCulling::ExtractFrustum(OrbitViewProj(frame++)) };
+        CullScalar(frustum, aos_boxes, scalar_visibility);
+      }));
+    }
+    {
+      uint32_t frame{0u};
+      bench::PrintStats("SoA batches", bench::Measure(iterations, [&] {
+        auto const frustum{ FrustumCulling::ExtractFrustum(OrbitViewProj(frame++)) };
+        FrustumCulling::CullBoxes(frustum, boxes, visibility, false);
+      }));
+    }
+    {
+      uint32_t frame{0u};
+      auto const label{ fmt::format("SoA batches, {} workers", worker_count) };
+      bench::PrintStats(label.c_str(), bench::Measure(iterations, [&] {
+        auto const frustum{ FrustumCulling::ExtractFrustum(OrbitViewProj(frame++)) };
+        FrustumCulling::CullBoxes(frustum, boxes, visibility, true);
+      }));
+    }
+
+    /* World boxes update then plane tests. */
+    FrustumCulling culling{};
+    for (bool const parallel : { false, true }) {
+      culling.parallel = parallel;
+      uint32_t frame{0u};
+      auto const label{
+        parallel ? fmt::format("update, {} workers", worker_count) : std::string("update")
+      };
+      bench::PrintStats(label.c_str(), bench::Measure(iterations, [&] {
+        culling.update(s.items, s.transforms, OrbitViewProj(frame++));
+      }));
+    }
+
+    // Both kernels agree on the first frame.
+    auto const frustum{ FrustumCulling::ExtractFrustum(OrbitViewProj(0u)) };
+    uint32_t const scalar_count{ CullScalar(frustum, aos_boxes, scalar_visibility) };
+    bool same{ true };
+    for (bool const parallel : { false, true }) {
+      uint32_t const count{ FrustumCulling::CullBoxes(frustum, boxes, visibility, parallel) };
+      same = same && (count == scalar_count) && (visibility == scalar_visibility);
+    }
+    culling.update(s.items, s.transforms, OrbitViewProj(0u));
+    same = same && (culling.visibility() == scalar_visibility);
+    failures += same ? 0u : 1u;
+
+    auto const& stats = culling.stats();
+    std::printf("  %-32s %12u\n", "visible", stats.visible_count);
+    std::printf("  %-32s %12u\n", "culled", stats.culled_count);
+    std::printf("  %-32s %12s\n", "SoA matches scalar", same ? "yes" : "NO");
+  }
+
+  utils::JobSystem::Deinitialize();
+  Logger::Deinitialize();
+
+  return (failures == 0u) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* -------------------------------------------------------------------------- */
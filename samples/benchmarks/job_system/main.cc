@@ -0,0 +1,57 @@
+/* -------------------------------------------------------------------------- */
+//
+//    bench - job system
+//
+//  Load a glTF scene repeatedly on the host, first with the legacy
+//  std::async tasks (one thread per task and per image), then with the
+//  work-stealing job system.
+//
+//  usage : bench_job_system [file.glb] [iterations]
+//
+/* -------------------------------------------------------------------------- */
+
+#include "aer/core/common.h"
+#include "aer/core/job_system.h"
+#include "aer/scene/host_resources.h"
+
+#include "bench_utils.h"
+
+/* -------------------------------------------------------------------------- */
+
+int main(int argc, char *argv[]) {
+  std::string const filename{
+    (argc > 1) ? argv[1] : ASSETS_DIR "models/DamagedHelmet.glb"
+  };
+  uint32_t const iterations{
+    (argc > 2) ? static_cast<uint32_t>(std::atoi(argv[2])) : 10u
+  };
+
+  Logger::Initialize();
+
+  auto load_scene{[&filename] {
+    scene::HostResources resources{};
+    resources.use_baked_scene = false; // (always go through the glTF path)
+    resources.setup();
+    if (!resources.load_file(filename)) {
+      LOG_FATAL("Failed to load \"{}\".", filename);
+    }
+  }};
+
+  bench::PrintHeader(filename.c_str());
+
+  // Without an initialized job system tasks fallback to std::async.
+  bench::PrintStats("std::async", bench::Measure(iterations, load_scene));
+
+  utils::JobSystem::Initialize();
+  {
+    auto const label{ fmt::format("job system ({} workers)", utils::JobSystem::Get().worker_count()) };
+    bench::PrintStats(label.c_str(), bench::Measure(iterations, load_scene));
+  }
+  utils::JobSystem::Deinitialize();
+
+  Logger::Deinitialize();
+
+  return EXIT_SUCCESS;
+}
+
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,361 @@
+/* -------------------------------------------------------------------------- */
+//
+//    bench - mesh compression
+//
+//  Generate a glTF scene of distinct wavy grid meshes, written uncompressed
+//  and with EXT_meshopt_compression, then compare their host load times and
+//  check the meshopt scene decodes to the same geometry.
+//
+//  Draco assets cannot be encoded here: pass a Draco compressed version of
+//  the uncompressed scene (eg. `gltf-transform draco in.gltf out.glb`) to add
+//  it to the comparison.
+//
+//  Post-load passes (optimization, LODs, meshlets, compaction) are disabled
+//  so the timings focus on decoding and extraction.
+//
+//  usage : bench_mesh_compression [grid_size] [mesh_count] [iterations] [draco_file]
+//
+/* -------------------------------------------------------------------------- */
+
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "aer/core/common.h"
+#include "aer/core/job_system.h"
+#include "aer/scene/host_resources.h"
+
+#include "meshoptimizer.h"
+
+#include "bench_utils.h"
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+struct Attribute {
+  std::vector<uint8_t> data{};
+  uint32_t stride{};
+  uint32_t count{};
+};
+
+struct GridMesh {
+  Attribute positions{};
+  Attribute normals{};
+  Attribute texcoords{};
+  Attribute indices{};
+};
+
+template<typename T>
+Attribute MakeAttribute(std::vector<T> const& values, uint32_t stride) {
+  Attribute attribute{ .stride = stride };
+  attribute.data.resize(values.size() * sizeof(T));
+  std::memcpy(attribute.data.data(), values.data(), attribute.data.size());
+  attribute.count = static_cast<uint32_t>(attribute.data.size() / stride);
+  return attribute;
+}
+
+/* Grid of 'grid_size' quads per side displaced by waves of a per mesh phase. */
+GridMesh MakeGridMesh(uint32_t grid_size, uint32_t mesh_index) {
+  uint32_t const side = grid_size + 1u;
+  float const phase = 0.37f * mesh_index;
+
+  std::vector<float> positions{};
+  std::vector<float> normals{};
+  std::vector<float> texcoords{};
+  for (uint32_t j = 0u; j < side; ++j) {
+    for (uint32_t i = 0u; i < side; ++i) {
+      float const u = static_cast<float>(i) / grid_size;
+      float const v = static_cast<float>(j) / grid_size;
+      float const a = 6.0f * u + phase;
+      float const b = 6.0f * v;
+      float const height = 0.1f * std::sin(a) * std::cos(b);
+      vec3f const normal{ linalg::normalize(vec3f(
+        -0.6f * std::cos(a) * std::cos(b), 1.0f, 0.6f * std::sin(a) * std::sin(b)
+      )) };
+      positions.insert(positions.end(), { u - 0.5f, height, v - 0.5f });
+      normals.insert(normals.end(), { normal.x, normal.y, normal.z });
+      texcoords.insert(texcoords.end(), { u, v });
+    }
+  }
+
+  std::vector<uint16_t> indices{};
+  for (uint32_t j = 0u; j < grid_size; ++j) {
+    for (uint32_t i = 0u; i < grid_size; ++i) {
+      auto const a = static_cast<uint16_t>(j * side + i);
+      auto const b = static_cast<uint16_t>(a + 1u);
+      auto const c = static_cast<uint16_t>(a + side);
+      auto const d = static_cast<uint16_t>(c + 1u);
+      indices.insert(indices.end(), { a, c, b, b, c, d });
+    }
+  }
+
+  return {
+    .positions = MakeAttribute(positions, 3u * sizeof(float)),
+    .normals = MakeAttribute(normals, 3u * sizeof(float)),
+    .texcoords = MakeAttribute(texcoords, 2u * sizeof(float)),
+    .indices = MakeAttribute(indices, sizeof(uint16_t)),
+  };
+}
+
+// ----------------------------------------------------------------------------
+
+/* Encode an attribute or a triangle list with meshopt. */
+std::vector<uint8_t> EncodeMeshopt(Attribute const& attribute, bool is_index) {
+  std::vector<uint8_t> encoded{};
+  if (is_index) {
+    std::vector<uint32_t> indices(attribute.count);
+    uint16_t const* src = reinterpret_cast<uint16_t const*>(attribute.data.data());
+    std::copy(src, src + attribute.count, indices.begin());
+    uint32_t const vertex_count = *std::max_element(indices.begin(), indices.end()) + 1u;
+    encoded.resize(meshopt_encodeIndexBufferBound(indices.size(), vertex_count));
+    encoded.resize(meshopt_encodeIndexBuffer(encoded.data(), encoded.size(), indices.data(), indices.size()));
+  } else {
+    encoded.resize(meshopt_encodeVertexBufferBound(attribute.count, attribute.stride));
+    encoded.resize(meshopt_encodeVertexBuffer(
+      encoded.data(), encoded.size(), attribute.data.data(), attribute.count, attribute.stride
+    ));
+  }
+  return encoded;
+}
+
+/* Write the scene as a .gltf with an external .bin, return the .gltf path and the .bin size. */
+std::pair<std::string, size_t> WriteScene(
+  std::filesystem::path const& directory,
+  std::vector<GridMesh> const& meshes,
+  bool use_meshopt
+) {
+  std::string const basename{ use_meshopt ? "aer_mesh_compression_meshopt" : "aer_mesh_compression_raw" };
+  std::string const bin_name{ basename + ".bin" };
+
+  /* Binary buffer, every view is 4-bytes aligned. */
+  std::vector<uint8_t> bin{};
+  auto append{[&bin](std::vector<uint8_t> const& data) -> std::pair<size_t, size_t> {
+    size_t const offset = bin.size();
+    bin.resize(offset + utils::AlignTo(data.size(), 4u));
+    std::memcpy(bin.data() + offset, data.data(), data.size());
+    return { offset, data.size() };
+  }};
+
+  // Meshopt views are laid out in the uncompressed fallback buffer, which holds no data.
+  size_t fallback_size{0u};
+
+  std::string views{};
+  std::string accessors{};
+  std::string gltf_meshes{};
+  std::string nodes{};
+  std::string scene_nodes{};
+  uint32_t view_index{0u};
+  for (size_t m = 0u; m < meshes.size(); ++m) {
+    auto const& mesh = meshes[m];
+    for (auto const* attribute : { &mesh.positions, &mesh.normals, &mesh.texcoords, &mesh.indices }) {
+      bool const is_index{ attribute == &mesh.indices };
+      std::string const stride{ is_index ? "" : fmt::format(R"(, "byteStride": {})", attribute->stride) };
+      if (use_meshopt) {
+        auto const [offset, size] = append(EncodeMeshopt(*attribute, is_index));
+        views += fmt::format(
+          R"({{ "buffer": 1, "byteOffset": {}, "byteLength": {}{}, "extensions": {{ "EXT_meshopt_compression": )"
+          R"({{ "buffer": 0, "byteOffset": {}, "byteLength": {}, "byteStride": {}, "count": {}, "mode": "{}" }} }} }},)",
+          fallback_size, attribute->data.size(), stride,
+          offset, size, attribute->stride, attribute->count, is_index ? "TRIANGLES" : "ATTRIBUTES"
+        );
+        fallback_size += utils::AlignTo(attribute->data.size(), 4u);
+      } else {
+        auto const [offset, size] = append(attribute->data);
+        views += fmt::format(R"({{ "buffer": 0, "byteOffset": {}, "byteLength": {}{} }},)", offset, size, stride);
+      }
+    }
+
+    uint32_t const v{ view_index };
+    accessors += fmt::format(
+      R"({{ "bufferView": {}, "componentType": 5126, "count": {}, "type": "VEC3", "min": [-0.5, -0.1, -0.5], "max": [0.5, 0.1, 0.5] }},)"
+      R"({{ "bufferView": {}, "componentType": 5126, "count": {}, "type": "VEC3" }},)"
+      R"({{ "bufferView": {}, "componentType": 5126, "count": {}, "type": "VEC2" }},)"
+      R"({{ "bufferView": {}, "componentType": 5123, "count": {}, "type": "SCALAR" }},)",
+      v, mesh.positions.count, v + 1u, mesh.normals.count, v + 2u, mesh.texcoords.count, v + 3u, mesh.indices.count
+    );
+    gltf_meshes += fmt::format(
+      R"({{ "primitives": [ {{ "attributes": {{ "POSITION": {}, "NORMAL": {}, "TEXCOORD_0": {} }}, "indices": {} }} ] }},)",
+      v, v + 1u, v + 2u, v + 3u
+    );
+    nodes += fmt::format(R"({{"mesh":{},"translation":[{},0,{}]}},)", m, 1.5f * (m % 16u), 1.5f * (m / 16u));
+    scene_nodes += fmt::format("{},", m);
+    view_index += 4u;
+  }
+  for (auto* list : { &views, &accessors, &gltf_meshes, &nodes, &scene_nodes }) {
+    list->pop_back();
+  }
+
+  std::string const buffers{ use_meshopt
+    ? fmt::format(
+        R"({{ "uri": "{}", "byteLength": {} }}, )"
+        R"({{ "byteLength": {}, "extensions": {{ "EXT_meshopt_compression": {{ "fallback": true }} }} }})",
+        bin_name, bin.size(), fallback_size
+      )
+    : fmt::format(R"({{ "uri": "{}", "byteLength": {} }})", bin_name, bin.size())
+  };
+  std::string const extensions{ use_meshopt
+    ? R"("extensionsUsed": [ "EXT_meshopt_compression" ], "extensionsRequired": [ "EXT_meshopt_compression" ],)"
+    : ""
+  };
+
+  std::string const json = fmt::format(R"({{
+  "asset": {{ "version": "2.0" }},
+  {}
+  "scene": 0,
+  "scenes": [ {{ "nodes": [ {} ] }} ],
+  "nodes": [ {} ],
+  "meshes": [ {} ],
+  "buffers": [ {} ],
+  "bufferViews": [ {} ],
+  "accessors": [ {} ]
+}})",
+    extensions, scene_nodes, nodes, gltf_meshes, buffers, views, accessors
+  );
+
+  std::ofstream(directory / bin_name, std::ios::binary).write(
+    reinterpret_cast<char const*>(bin.data()), static_cast<std::streamsize>(bin.size())
+  );
+  auto const gltf_path{ directory / (basename + ".gltf") };
+  std::ofstream(gltf_path) << json;
+
+  return { gltf_path.string(), bin.size() };
+}
+
+// ----------------------------------------------------------------------------
+
+/* Load a scene through the glTF path, without the post-load passes. */
+bool LoadScene(std::string const& filename, scene::HostResources& resources) {
+  resources.use_baked_scene = false;
+  resources.optimize_meshes = false;
+  resources.compact_vertices = false;
+  resources.build_meshlets = false;
+  resources.build_lods = false;
+  return resources.load_file(filename);
+}
+
+/* True when both scenes hold the same vertices and triangles, up to their rotation. */
+bool SameGeometry(scene::HostResources const& a, scene::HostResources const& b) {
+  if (a.meshes.size() != b.meshes.size()) {
+    return false;
+  }
+  for (size_t m = 0u; m < a.meshes.size(); ++m) {
+    auto const& va = a.meshes[m]->get_vertices();
+    auto const& vb = b.meshes[m]->get_vertices();
+    auto const& ia = a.meshes[m]->get_indices();
+    auto const& ib = b.meshes[m]->get_indices();
+    if ((va.size() != vb.size()) || (std::memcmp(va.data(), vb.data(), va.size()) != 0)) {
+      return false;
+    }
+    if (ia.size() != ib.size()) {
+      return false;
+    }
+    // (the meshopt index codec may rotate the vertices of a triangle)
+    size_t const index_size{ (a.meshes[m]->get_index_format() == Geometry::IndexFormat::U32) ? 4u : 2u };
+    auto index_at{[index_size](auto const& bytes, size_t i) -> uint32_t {
+      uint32_t index{0u};
+      std::memcpy(&index, bytes.data() + i * index_size, index_size);
+      return index;
+    }};
+    for (size_t t = 0u; t + 3u * index_size <= ia.size(); t += 3u * index_size) {
+      size_t const i{ t / index_size };
+      uint32_t const ta[3u]{ index_at(ia, i), index_at(ia, i + 1u), index_at(ia, i + 2u) };
+      uint32_t const tb[3u]{ index_at(ib, i), index_at(ib, i + 1u), index_at(ib, i + 2u) };
+      bool matched{false};
+      for (uint32_t r = 0u; r < 3u; ++r) {
+        matched |= (ta[0u] == tb[r]) && (ta[1u] == tb[(r + 1u) % 3u]) && (ta[2u] == tb[(r + 2u) % 3u]);
+      }
+      if (!matched) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+int main(int argc, char *argv[]) {
+  uint32_t const grid_size{
+    (argc > 1) ? std::clamp(static_cast<uint32_t>(std::atoi(argv[1])), 1u, 255u) : 128u
+  };
+  uint32_t const mesh_count{
+    (argc > 2) ? static_cast<uint32_t>(std::max(std::atoi(argv[2]), 1)) : 64u
+  };
+  uint32_t const iterations{
+    (argc > 3) ? static_cast<uint32_t>(std::atoi(argv[3])) : 10u
+  };
+  std::string const draco_filename{ (argc > 4) ? argv[4] : "" };
+
+  Logger::Initialize();
+  utils::JobSystem::Initialize();
+
+  // Keep the version decoded by every EXT_meshopt_compression loader.
+  meshopt_encodeVertexVersion(0);
+
+  std::vector<GridMesh> meshes{};
+  for (uint32_t m = 0u; m < mesh_count; ++m) {
+    meshes.push_back(MakeGridMesh(grid_size, m));
+  }
+
+  auto const directory{ std::filesystem::temp_directory_path() };
+  auto const [raw_filename, raw_size] = WriteScene(directory, meshes, false);
+  auto const [meshopt_filename, meshopt_size] = WriteScene(directory, meshes, true);
+
+  uint32_t const vertex_count{ (grid_size + 1u) * (grid_size + 1u) };
+  std::printf("\n%u meshes of %u vertices, %u triangles (uncompressed scene : %s)\n",
+    mesh_count, vertex_count, 2u * grid_size * grid_size, raw_filename.c_str()
+  );
+
+  double const kMegabyte{ 1024.0 * 1024.0 };
+  struct Variant {
+    char const* name{};
+    std::string filename{};
+    size_t size{};
+  };
+  std::vector<Variant> variants{
+    { "uncompressed", raw_filename, raw_size },
+    { "meshopt", meshopt_filename, meshopt_size },
+  };
+  if (!draco_filename.empty()) {
+    std::error_code ec{};
+    variants.push_back({ "draco", draco_filename, size_t(std::filesystem::file_size(draco_filename, ec)) });
+  }
+
+  bench::PrintHeader("host load");
+  for (auto const& variant : variants) {
+    auto const stats = bench::Measure(iterations, [&] {
+      scene::HostResources resources{};
+      if (!LoadScene(variant.filename, resources)) {
+        LOG_FATAL("Failed to load \"{}\".", variant.filename);
+      }
+    });
+    auto const label{ fmt::format("{} ({:.2f} MB)", variant.name, variant.size / kMegabyte) };
+    bench::PrintStats(label.c_str(), stats);
+  }
+
+  /* Meshopt keeps the exact vertex data. */
+  scene::HostResources raw_resources{};
+  scene::HostResources meshopt_resources{};
+  bool const loaded{ LoadScene(raw_filename, raw_resources) && LoadScene(meshopt_filename, meshopt_resources) };
+  bool const matches{ loaded && SameGeometry(raw_resources, meshopt_resources) };
+  std::printf("  %-32s %12s\n", "meshopt matches", matches ? "yes" : "NO");
+
+  if (!draco_filename.empty()) {
+    scene::HostResources draco_resources{};
+    LoadScene(draco_filename, draco_resources);
+    if (draco_resources.meshes.empty()) {
+      std::printf("  %-32s %12s\n", "draco meshes", "none (Draco decoding disabled ?)");
+    }
+  }
+
+  utils::JobSystem::Deinitialize();
+  Logger::Deinitialize();
+
+  return matches ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* -------------------------------------------------------------------------- */
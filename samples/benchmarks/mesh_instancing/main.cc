@@ -0,0 +1,221 @@
+/* -------------------------------------------------------------------------- */
+//
+//    bench - mesh instancing
+//
+//  Generate a stress glTF scene where a single grid mesh is referenced by
+//  many nodes, plus one EXT_mesh_gpu_instancing node, then load it on the
+//  host and report the geometry memory and draw calls saved by extracting
+//  shared meshes once and drawing them instanced.
+//
+//  usage : bench_mesh_instancing [node_count] [gpu_instance_count] [iterations]
+//
+/* -------------------------------------------------------------------------- */
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "aer/core/common.h"
+#include "aer/core/job_system.h"
+#include "aer/scene/host_resources.h"
+
+#include "bench_utils.h"
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+// Grid resolution of the shared mesh, in quads per side.
+uint32_t constexpr kGridSize{ 64u };
+
+// ----------------------------------------------------------------------------
+
+/* Write the stress scene as a .gltf with an external .bin, return the .gltf path. */
+std::string WriteStressScene(
+  std::filesystem::path const& directory,
+  uint32_t node_count,
+  uint32_t gpu_instance_count
+) {
+  uint32_t const side = kGridSize + 1u;
+  uint32_t const vertex_count = side * side;
+  uint32_t const index_count = 6u * kGridSize * kGridSize;
+
+  std::vector<float> positions{};
+  std::vector<float> normals{};
+  std::vector<float> texcoords{};
+  positions.reserve(3u * vertex_count);
+  normals.reserve(3u * vertex_count);
+  texcoords.reserve(2u * vertex_count);
+  for (uint32_t j = 0u; j < side; ++j) {
+    for (uint32_t i = 0u; i < side; ++i) {
+      float const u = static_cast<float>(i) / kGridSize;
+      float const v = static_cast<float>(j) / kGridSize;
+      positions.insert(positions.end(), { u - 0.5f, 0.0f, v - 0.5f });
+      normals.insert(normals.end(), { 0.0f, 1.0f, 0.0f });
+      texcoords.insert(texcoords.end(), { u, v });
+    }
+  }
+
+  std::vector<uint16_t> indices{};
+  indices.reserve(index_count);
+  for (uint32_t j = 0u; j < kGridSize; ++j) {
+    for (uint32_t i = 0u; i < kGridSize; ++i) {
+      auto const a = static_cast<uint16_t>(j * side + i);
+      auto const b = static_cast<uint16_t>(a + 1u);
+      auto const c = static_cast<uint16_t>(a + side);
+      auto const d = static_cast<uint16_t>(c + 1u);
+      indices.insert(indices.end(), { a, c, b, b, c, d });
+    }
+  }
+
+  std::vector<float> translations{};
+  translations.reserve(3u * gpu_instance_count);
+  for (uint32_t i = 0u; i < gpu_instance_count; ++i) {
+    translations.insert(translations.end(), { static_cast<float>(i % 64u), 1.0f, static_cast<float>(i / 64u) });
+  }
+
+  /* Binary buffer, every view is 4-bytes aligned. */
+  std::vector<uint8_t> bin{};
+  auto append{[&bin](auto const& data) -> std::pair<size_t, size_t> {
+    size_t const offset = bin.size();
+    size_t const size = data.size() * sizeof(data[0]);
+    bin.resize(offset + utils::AlignTo(size, 4u));
+    std::memcpy(bin.data() + offset, data.data(), size);
+    return { offset, size };
+  }};
+  auto const [pos_offset, pos_size] = append(positions);
+  auto const [nor_offset, nor_size] = append(normals);
+  auto const [uv_offset, uv_size] = append(texcoords);
+  auto const [idx_offset, idx_size] = append(indices);
+  auto const [tr_offset, tr_size] = append(translations);
+
+  /* Nodes, laid out on a grid. */
+  std::string nodes{};
+  std::string scene_nodes{};
+  for (uint32_t i = 0u; i < node_count; ++i) {
+    nodes += fmt::format(
+      R"({{"mesh":0,"translation":[{},0,{}]}},)", 1.5f * (i % 64u), 1.5f * (i / 64u)
+    );
+    scene_nodes += fmt::format("{},", i);
+  }
+  nodes += R"({"mesh":0,"extensions":{"EXT_mesh_gpu_instancing":{"attributes":{"TRANSLATION":4}}}})";
+  scene_nodes += fmt::format("{}", node_count);
+
+  std::string const bin_name{ "aer_mesh_instancing_stress.bin" };
+  std::string const json = fmt::format(R"({{
+  "asset": {{ "version": "2.0" }},
+  "extensionsUsed": [ "EXT_mesh_gpu_instancing" ],
+  "scene": 0,
+  "scenes": [ {{ "nodes": [ {} ] }} ],
+  "nodes": [ {} ],
+  "meshes": [ {{ "primitives": [ {{ "attributes": {{ "POSITION": 0, "NORMAL": 1, "TEXCOORD_0": 2 }}, "indices": 3 }} ] }} ],
+  "buffers": [ {{ "uri": "{}", "byteLength": {} }} ],
+  "bufferViews": [
+    {{ "buffer": 0, "byteOffset": {}, "byteLength": {} }},
+    {{ "buffer": 0, "byteOffset": {}, "byteLength": {} }},
+    {{ "buffer": 0, "byteOffset": {}, "byteLength": {} }},
+    {{ "buffer": 0, "byteOffset": {}, "byteLength": {} }},
+    {{ "buffer": 0, "byteOffset": {}, "byteLength": {} }}
+  ],
+  "accessors": [
+    {{ "bufferView": 0, "componentType": 5126, "count": {}, "type": "VEC3", "min": [-0.5, 0, -0.5], "max": [0.5, 0, 0.5] }},
+    {{ "bufferView": 1, "componentType": 5126, "count": {}, "type": "VEC3" }},
+    {{ "bufferView": 2, "componentType": 5126, "count": {}, "type": "VEC2" }},
+    {{ "bufferView": 3, "componentType": 5123, "count": {}, "type": "SCALAR" }},
+    {{ "bufferView": 4, "componentType": 5126, "count": {}, "type": "VEC3" }}
+  ]
+}})",
+    scene_nodes, nodes,
+    bin_name, bin.size(),
+    pos_offset, pos_size,
+    nor_offset, nor_size,
+    uv_offset, uv_size,
+    idx_offset, idx_size,
+    tr_offset, tr_size,
+    vertex_count, vertex_count, vertex_count, index_count, gpu_instance_count
+  );
+
+  std::ofstream(directory / bin_name, std::ios::binary).write(
+    reinterpret_cast<char const*>(bin.data()), static_cast<std::streamsize>(bin.size())
+  );
+  auto const gltf_path{ directory / "aer_mesh_instancing_stress.gltf" };
+  std::ofstream(gltf_path) << json;
+
+  return gltf_path.string();
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+int main(int argc, char *argv[]) {
+  uint32_t const node_count{
+    (argc > 1) ? static_cast<uint32_t>(std::atoi(argv[1])) : 2000u
+  };
+  uint32_t const gpu_instance_count{
+    (argc > 2) ? static_cast<uint32_t>(std::atoi(argv[2])) : 4096u
+  };
+  uint32_t const iterations{
+    (argc > 3) ? static_cast<uint32_t>(std::atoi(argv[3])) : 10u
+  };
+
+  Logger::Initialize();
+  utils::JobSystem::Initialize();
+
+  std::string const filename{
+    WriteStressScene(std::filesystem::temp_directory_path(), node_count, gpu_instance_count)
+  };
+
+  auto load_scene{[&filename](scene::HostResources& resources) {
+    resources.use_baked_scene = false; // (always go through the glTF path)
+    if (!resources.load_file(filename)) {
+      LOG_FATAL("Failed to load \"{}\".", filename);
+    }
+  }};
+
+  bench::PrintHeader(filename.c_str());
+  bench::PrintStats("host load", bench::Measure(iterations, [&] {
+    scene::HostResources resources{};
+    load_scene(resources);
+  }));
+
+  /* Compare against one extraction and one draw per instance. */
+  scene::HostResources resources{};
+  load_scene(resources);
+
+  uint64_t shared_bytes{0u};
+  uint64_t unshared_bytes{0u};
+  uint64_t instanced_draws{0u};
+  uint64_t unshared_draws{0u};
+  uint64_t instance_count{0u};
+  for (auto const& mesh : resources.meshes) {
+    uint64_t const geometry_bytes = mesh->get_vertices().size() + mesh->get_indices().size();
+    shared_bytes += geometry_bytes;
+    unshared_bytes += geometry_bytes * mesh->instance_count;
+    instanced_draws += mesh->submeshes.size();
+    unshared_draws += mesh->submeshes.size() * mesh->instance_count;
+    instance_count += mesh->instance_count;
+  }
+
+  double const kMegabyte{ 1024.0 * 1024.0 };
+  std::printf("\n  %-32s %14s %14s %14s\n", "", "per instance", "instanced", "saved");
+  std::printf("  %-32s %14llu %14llu\n", "extracted meshes",
+    static_cast<unsigned long long>(instance_count),
+    static_cast<unsigned long long>(resources.meshes.size())
+  );
+  std::printf("  %-32s %14.2f %14.2f %14.2f\n", "geometry (MB)",
+    unshared_bytes / kMegabyte, shared_bytes / kMegabyte, (unshared_bytes - shared_bytes) / kMegabyte
+  );
+  std::printf("  %-32s %14llu %14llu %14llu\n", "draw calls",
+    static_cast<unsigned long long>(unshared_draws),
+    static_cast<unsigned long long>(instanced_draws),
+    static_cast<unsigned long long>(unshared_draws - instanced_draws)
+  );
+
+  utils::JobSystem::Deinitialize();
+  Logger::Deinitialize();
+
+  return EXIT_SUCCESS;
+}
+
+/* -------------------------------------------------------------------------- */
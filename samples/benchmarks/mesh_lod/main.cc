@@ -0,0 +1,282 @@
+/* -------------------------------------------------------------------------- */
+//
+//    bench - mesh lod
+//
+//  Simplify a dense procedural rock into a LOD chain, scatter it over a
+//  large field of objects and fly a camera through it, selecting a LOD per
+//  object every frame from its projected screen-space error.
+//
+//  Report the triangles submitted per frame with LODs off and on for a few
+//  pixel error thresholds, and the per-frame selection cost.
+//
+//  usage : bench_mesh_lod [grid_size] [frame_count] [iterations]
+//
+/* -------------------------------------------------------------------------- */
+
+#include <array>
+#include <cmath>
+#include <random>
+
+#include "aer/core/common.h"
+#include "aer/scene/mesh.h"
+
+#include "bench_utils.h"
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+struct Vertex {
+  std::array<float, 3> position;
+  std::array<float, 3> normal;
+};
+
+// Rock tessellation, in rows of the UV sphere.
+uint32_t constexpr kRockResolution{ 96u };
+
+// Distance between two objects of the field.
+float constexpr kFieldSpacing{ 8.0f };
+
+// Camera height above the field, and vertical field of view.
+float constexpr kEyeHeight{ 3.0f };
+float constexpr kFieldOfViewY{ 60.0f };
+float constexpr kViewportHeight{ 1080.0f };
+
+// ----------------------------------------------------------------------------
+
+/* Bumpy UV sphere as an indexed triangle list with 32-bit indices. */
+void MakeRock(Geometry& geo, uint32_t resolution) {
+  uint32_t const rows = resolution;
+  uint32_t const cols = 2u * resolution;
+
+  std::vector<Vertex> vertices{};
+  vertices.reserve((rows + 1u) * (cols + 1u));
+  for (uint32_t j = 0u; j <= rows; ++j) {
+    float const theta = lina::kPi * static_cast<float>(j) / rows;
+    for (uint32_t i = 0u; i <= cols; ++i) {
+      float const phi = 2.0f * lina::kPi * static_cast<float>(i) / cols;
+      std::array<float, 3> const n{ std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi) };
+      float const r = 1.0f + 0.08f * std::sin(7.0f * theta) * std::sin(5.0f * phi)
+                           + 0.02f * std::sin(31.0f * theta) * std::sin(23.0f * phi);
+      vertices.push_back({ .position = { r * n[0], r * n[1], r * n[2] }, .normal = n });
+    }
+  }
+
+  std::vector<uint32_t> indices{};
+  indices.reserve(6u * rows * cols);
+  for (uint32_t j = 0u; j < rows; ++j) {
+    for (uint32_t i = 0u; i < cols; ++i) {
+      uint32_t const a = j * (cols + 1u) + i;
+      uint32_t const b = a + 1u;
+      uint32_t const c = a + cols + 1u;
+      uint32_t const d = c + 1u;
+      indices.insert(indices.end(), { a, b, c, b, d, c });
+    }
+  }
+
+  geo.set_topology(Geometry::Topology::TriangleList);
+  geo.set_index_format(Geometry::IndexFormat::U32);
+  geo.add_attribute(Geometry::AttributeType::Position, {
+    .format = Geometry::AttributeFormat::RGB_F32,
+    .offset = offsetof(Vertex, position),
+    .stride = sizeof(Vertex),
+  });
+  geo.add_attribute(Geometry::AttributeType::Normal, {
+    .format = Geometry::AttributeFormat::RGB_F32,
+    .offset = offsetof(Vertex, normal),
+    .stride = sizeof(Vertex),
+  });
+
+  uint64_t const vertex_offset = geo.add_vertices_data(std::as_bytes(std::span(vertices)));
+  uint64_t const index_offset = geo.add_indices_data(std::as_bytes(std::span(indices)));
+
+  geo.add_primitive({
+    .topology = Geometry::Topology::TriangleList,
+    .vertexCount = static_cast<uint32_t>(vertices.size()),
+    .indexCount = static_cast<uint32_t>(indices.size()),
+    .indexOffset = index_offset,
+    .bufferOffsets = {
+      { Geometry::AttributeType::Position, vertex_offset },
+      { Geometry::AttributeType::Normal, vertex_offset },
+    },
+  });
+}
+
+// ----------------------------------------------------------------------------
+
+/* Square field of randomly scaled rocks, one world matrix each. */
+std::vector<mat4> MakeField(uint32_t grid_size) {
+  std::mt19937 rng(11u);
+  std::uniform_real_distribution<float> scale_dist(0.5f, 2.5f);
+  std::uniform_real_distribution<float> jitter_dist(-0.3f, 0.3f);
+
+  std::vector<mat4> world_matrices{};
+  world_matrices.reserve(grid_size * grid_size);
+  for (uint32_t j = 0u; j < grid_size; ++j) {
+    for (uint32_t i = 0u; i < grid_size; ++i) {
+      float const scale = scale_dist(rng);
+      vec3 const position{
+        (i + jitter_dist(rng)) * kFieldSpacing,
+        0.0f,
+        (j + jitter_dist(rng)) * kFieldSpacing,
+      };
+      world_matrices.push_back(linalg::mul(
+        linalg::translation_matrix(position),
+        linalg::scaling_matrix(vec3(scale))
+      ));
+    }
+  }
+  return world_matrices;
+}
+
+/* Camera positions along a diagonal of the field. */
+std::vector<vec3> MakeFlythrough(uint32_t grid_size, uint32_t frame_count) {
+  float const extent = grid_size * kFieldSpacing;
+  std::vector<vec3> eyes(std::max(frame_count, 1u));
+  for (uint32_t i = 0u; i < eyes.size(); ++i) {
+    float const t = static_cast<float>(i) / std::max(frame_count - 1u, 1u);
+    eyes[i] = vec3(
+      (0.05f + 0.9f * t) * extent,
+      kEyeHeight,
+      (0.1f + 0.8f * t) * extent
+    );
+  }
+  return eyes;
+}
+
+// ----------------------------------------------------------------------------
+
+struct FlythroughResult {
+  uint64_t total_triangles{};
+  uint64_t min_triangles{};
+  uint64_t max_triangles{};
+  std::vector<uint64_t> lod_histogram{};
+};
+
+/* Select every object LOD for every camera position, each object being a single instance. */
+FlythroughResult Fly(
+  scene::Mesh& mesh,
+  std::vector<mat4> const& world_matrices,
+  std::vector<vec3> const& eyes,
+  float pixel_scale,
+  float pixel_error
+) {
+  FlythroughResult result{
+    .min_triangles = std::numeric_limits<uint64_t>::max(),
+    .lod_histogram = std::vector<uint64_t>(mesh.get_lods(0u).size() + 1u, 0u),
+  };
+  for (auto const& eye : eyes) {
+    uint64_t frame_triangles{0u};
+    for (auto const& world : world_matrices) {
+      frame_triangles += mesh.select_lods(std::span(&world, 1u), eye, pixel_scale, pixel_error);
+      ++result.lod_histogram[mesh.submeshes[0u].lod_index];
+    }
+    result.total_triangles += frame_triangles;
+    result.min_triangles = std::min(result.min_triangles, frame_triangles);
+    result.max_triangles = std::max(result.max_triangles, frame_triangles);
+  }
+  return result;
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+int main(int argc, char *argv[]) {
+  uint32_t const grid_size{
+    (argc > 1) ? static_cast<uint32_t>(std::atoi(argv[1])) : 32u
+  };
+  uint32_t const frame_count{
+    (argc > 2) ? static_cast<uint32_t>(std::atoi(argv[2])) : 240u
+  };
+  uint32_t const iterations{
+    (argc > 3) ? static_cast<uint32_t>(std::atoi(argv[3])) : 5u
+  };
+
+  Logger::Initialize();
+
+  scene::Mesh mesh{};
+  MakeRock(mesh, kRockResolution);
+
+  /* Build the LOD chain. */
+  bench::PrintHeader("lod build");
+  {
+    auto const stats = bench::Measure(iterations, [&mesh] {
+      scene::Mesh copy{ mesh };
+      copy.build_lods();
+    });
+    bench::PrintStats("build_lods", stats);
+  }
+  mesh.build_lods();
+  mesh.initialize_submesh_descriptors({
+    { Geometry::AttributeType::Position, 0u },
+    { Geometry::AttributeType::Normal, 1u },
+  });
+
+  auto const& prim = mesh.get_primitive(0u);
+  std::printf("\n  %-8s %12s %16s\n", "level", "triangles", "error (% radius)");
+  std::printf("  %-8u %12u %16.3f\n", 0u, prim.indexCount / 3u, 0.0f);
+  for (uint32_t i = 0u; i < mesh.get_lods(0u).size(); ++i) {
+    auto const& lod = mesh.get_lods(0u)[i];
+    std::printf("  %-8u %12u %16.3f\n", i + 1u, lod.indexCount / 3u, 100.0f * lod.error / prim.radius);
+  }
+
+  /* Fly through the field. */
+  auto const world_matrices{ MakeField(std::max(grid_size, 1u)) };
+  auto const eyes{ MakeFlythrough(std::max(grid_size, 1u), frame_count) };
+  float const pixel_scale{
+    0.5f * kViewportHeight / std::tan(0.5f * lina::radians(kFieldOfViewY))
+  };
+
+  std::printf("\nflythrough : %zu objects, %zu frames\n", world_matrices.size(), eyes.size());
+
+  struct Case {
+    char const* label;
+    float pixel_error;
+  };
+  std::array<Case, 4u> constexpr cases{{
+    { "lods off", -1.0f },
+    { "lods on (0.5 px)", 0.5f },
+    { "lods on (1 px)", 1.0f },
+    { "lods on (4 px)", 4.0f },
+  }};
+
+  std::vector<FlythroughResult> results{};
+  bench::PrintHeader("lod selection (per frame)");
+  for (auto const& c : cases) {
+    auto const stats = bench::Measure(iterations, [&] {
+      results.push_back(Fly(mesh, world_matrices, eyes, pixel_scale, c.pixel_error));
+    });
+    bench::PrintStats(c.label, {
+      .min_ms = stats.min_ms / eyes.size(),
+      .median_ms = stats.median_ms / eyes.size(),
+      .mean_ms = stats.mean_ms / eyes.size(),
+    });
+  }
+
+  // (every run of a case gives the same result, keep the last one)
+  uint32_t const runs = static_cast<uint32_t>(results.size() / cases.size());
+  double const reference = static_cast<double>(results[runs - 1u].total_triangles);
+
+  std::printf("\n  %-20s %14s %14s %14s %10s   %s\n",
+    "triangles / frame", "mean", "min", "max", "ratio", "objects per level"
+  );
+  for (uint32_t i = 0u; i < cases.size(); ++i) {
+    auto const& r = results[(i + 1u) * runs - 1u];
+    std::printf("  %-20s %14.0f %14llu %14llu %9.1f%%  ",
+      cases[i].label,
+      r.total_triangles / static_cast<double>(eyes.size()),
+      static_cast<unsigned long long>(r.min_triangles),
+      static_cast<unsigned long long>(r.max_triangles),
+      100.0 * r.total_triangles / reference
+    );
+    for (auto const count : r.lod_histogram) {
+      std::printf(" %5.1f%%", 100.0 * count / static_cast<double>(eyes.size() * world_matrices.size()));
+    }
+    std::printf("\n");
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/* -------------------------------------------------------------------------- */
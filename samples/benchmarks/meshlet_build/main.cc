@@ -0,0 +1,251 @@
+/* -------------------------------------------------------------------------- */
+//
+//    bench - meshlet build
+//
+//  Split a dense procedural mesh into meshlets on the host, validate them
+//  (triangles preserved, limits respected, spheres bounding their vertices,
+//  cones never culling a front facing triangle) and time the build.
+//
+//  No GPU is involved, the program fails when any check does not hold.
+//
+//  usage : bench_meshlet_build [resolution] [iterations]
+//
+/* -------------------------------------------------------------------------- */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <set>
+
+#include "aer/core/common.h"
+#include "aer/scene/geometry.h"
+
+#include "bench_utils.h"
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+struct Vertex {
+  std::array<float, 3> position;
+  std::array<float, 3> normal;
+};
+
+// Eye positions tested against each meshlet cone.
+uint32_t constexpr kConeEyeCount{ 64u };
+
+// Tolerance on the bounding spheres, relative to their radius.
+float constexpr kSphereEpsilon{ 1.0e-4f };
+
+// ----------------------------------------------------------------------------
+
+using Vec3 = std::array<float, 3>;
+
+Vec3 Sub(Vec3 const& a, Vec3 const& b) {
+  return { a[0] - b[0], a[1] - b[1], a[2] - b[2] };
+}
+
+Vec3 Cross(Vec3 const& a, Vec3 const& b) {
+  return { a[1]*b[2] - a[2]*b[1], a[2]*b[0] - a[0]*b[2], a[0]*b[1] - a[1]*b[0] };
+}
+
+float Dot(Vec3 const& a, Vec3 const& b) {
+  return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+}
+
+float Length(Vec3 const& a) {
+  return std::sqrt(Dot(a, a));
+}
+
+// ----------------------------------------------------------------------------
+
+/* Bumpy UV sphere as an indexed triangle list with 32-bit indices. */
+void MakeBumpySphere(Geometry& geo, uint32_t resolution) {
+  uint32_t const rows = resolution;
+  uint32_t const cols = 2u * resolution;
+
+  std::vector<Vertex> vertices{};
+  vertices.reserve((rows + 1u) * (cols + 1u));
+  for (uint32_t j = 0u; j <= rows; ++j) {
+    float const theta = lina::kPi * static_cast<float>(j) / rows;
+    for (uint32_t i = 0u; i <= cols; ++i) {
+      float const phi = 2.0f * lina::kPi * static_cast<float>(i) / cols;
+      Vec3 const n{ std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi) };
+      float const r = 1.0f + 0.05f * std::sin(12.0f * theta) * std::sin(9.0f * phi);
+      vertices.push_back({ .position = { r * n[0], r * n[1], r * n[2] }, .normal = n });
+    }
+  }
+
+  std::vector<uint32_t> indices{};
+  indices.reserve(6u * rows * cols);
+  for (uint32_t j = 0u; j < rows; ++j) {
+    for (uint32_t i = 0u; i < cols; ++i) {
+      uint32_t const a = j * (cols + 1u) + i;
+      uint32_t const b = a + 1u;
+      uint32_t const c = a + cols + 1u;
+      uint32_t const d = c + 1u;
+      // (counter-clockwise seen from outside)
+      indices.insert(indices.end(), { a, b, c, b, d, c });
+    }
+  }
+
+  geo.set_topology(Geometry::Topology::TriangleList);
+  geo.set_index_format(Geometry::IndexFormat::U32);
+  geo.add_attribute(Geometry::AttributeType::Position, {
+    .format = Geometry::AttributeFormat::RGB_F32,
+    .offset = offsetof(Vertex, position),
+    .stride = sizeof(Vertex),
+  });
+  geo.add_attribute(Geometry::AttributeType::Normal, {
+    .format = Geometry::AttributeFormat::RGB_F32,
+    .offset = offsetof(Vertex, normal),
+    .stride = sizeof(Vertex),
+  });
+
+  uint64_t const vertex_offset = geo.add_vertices_data(std::as_bytes(std::span(vertices)));
+  uint64_t const index_offset = geo.add_indices_data(std::as_bytes(std::span(indices)));
+
+  geo.add_primitive({
+    .topology = Geometry::Topology::TriangleList,
+    .vertexCount = static_cast<uint32_t>(vertices.size()),
+    .indexCount = static_cast<uint32_t>(indices.size()),
+    .indexOffset = index_offset,
+    .bufferOffsets = {
+      { Geometry::AttributeType::Position, vertex_offset },
+      { Geometry::AttributeType::Normal, vertex_offset },
+    },
+  });
+}
+
+// ----------------------------------------------------------------------------
+
+std::span<uint32_t const> Indices(Geometry const& geo) {
+  auto const& bytes = geo.get_indices();
+  auto const& prim = geo.get_primitive(0u);
+  return { reinterpret_cast<uint32_t const*>(bytes.data() + prim.indexOffset), prim.indexCount };
+}
+
+Vec3 Position(Geometry const& geo, uint32_t index) {
+  return reinterpret_cast<Vertex const*>(geo.get_vertices().data())[index].position;
+}
+
+/* Triangles rotated to start with their smallest index, keeping their winding. */
+std::multiset<std::array<uint32_t, 3>> CanonicalTriangles(std::span<uint32_t const> indices) {
+  std::multiset<std::array<uint32_t, 3>> triangles{};
+  for (size_t i = 0u; i + 2u < indices.size(); i += 3u) {
+    std::array<uint32_t, 3> t{ indices[i], indices[i + 1u], indices[i + 2u] };
+    std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+    triangles.insert(t);
+  }
+  return triangles;
+}
+
+// ----------------------------------------------------------------------------
+
+/* Return the number of failed checks. */
+uint32_t Validate(Geometry const& source, Geometry const& geo) {
+  uint32_t failures{0u};
+  auto check{[&failures](bool condition, char const* what) {
+    if (!condition) {
+      std::fprintf(stderr, "  check failed : %s\n", what);
+      ++failures;
+    }
+  }};
+
+  auto const& prim = geo.get_primitive(0u);
+  auto const meshlets = geo.get_meshlets(0u);
+  auto const indices = Indices(geo);
+
+  check(!meshlets.empty(), "meshlets were built");
+  check(CanonicalTriangles(Indices(source)) == CanonicalTriangles(indices), "triangles are preserved");
+
+  std::mt19937 rng(7u);
+  std::uniform_real_distribution<float> dist(-4.0f, 4.0f);
+
+  uint32_t expected_first_index{0u};
+  uint32_t culled_tests{0u};
+  for (auto const& m : meshlets) {
+    check(m.firstIndex == expected_first_index, "meshlets are contiguous index ranges");
+    check((m.indexCount % 3u) == 0u, "meshlets hold whole triangles");
+    check(m.indexCount / 3u <= Geometry::kMeshletMaxTriangles, "meshlet triangles limit");
+    expected_first_index = m.firstIndex + m.indexCount;
+
+    auto const range = indices.subspan(m.firstIndex, m.indexCount);
+    std::set<uint32_t> const unique_vertices(range.begin(), range.end());
+    check(unique_vertices.size() <= Geometry::kMeshletMaxVertices, "meshlet vertices limit");
+
+    Vec3 const center{ m.center[0], m.center[1], m.center[2] };
+    for (auto const v : unique_vertices) {
+      if (Length(Sub(Position(geo, v), center)) > m.radius * (1.0f + kSphereEpsilon)) {
+        check(false, "bounding sphere contains its vertices");
+        break;
+      }
+    }
+
+    // Any eye the cone reports as backfacing must not see a front facing triangle.
+    Vec3 const apex{ m.coneApex[0], m.coneApex[1], m.coneApex[2] };
+    Vec3 const axis{ m.coneAxis[0], m.coneAxis[1], m.coneAxis[2] };
+    for (uint32_t e = 0u; e < kConeEyeCount; ++e) {
+      Vec3 const eye{ dist(rng), dist(rng), dist(rng) };
+      Vec3 const view{ Sub(apex, eye) };
+      if (Dot(view, axis) < m.coneCutoff * Length(view)) {
+        continue;
+      }
+      ++culled_tests;
+      for (size_t t = 0u; t < range.size(); t += 3u) {
+        Vec3 const p0{ Position(geo, range[t]) };
+        Vec3 const normal{ Cross(Sub(Position(geo, range[t + 1u]), p0), Sub(Position(geo, range[t + 2u]), p0)) };
+        if (Dot(normal, Sub(eye, p0)) > 0.0f) {
+          check(false, "normal cone only culls backfacing triangles");
+          break;
+        }
+      }
+    }
+  }
+  check(expected_first_index == prim.indexCount, "meshlets cover the primitive");
+
+  std::printf("  %-32s %12u\n", "cone culled eye tests", culled_tests);
+
+  return failures;
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+int main(int argc, char *argv[]) {
+  uint32_t const resolution{
+    (argc > 1) ? static_cast<uint32_t>(std::atoi(argv[1])) : 256u
+  };
+  uint32_t const iterations{
+    (argc > 2) ? static_cast<uint32_t>(std::atoi(argv[2])) : 10u
+  };
+
+  Geometry source{};
+  MakeBumpySphere(source, std::max(resolution, 4u));
+
+  uint32_t const triangle_count = source.get_index_count() / 3u;
+  std::printf("\nbumpy sphere : %u vertices, %u triangles\n", source.get_vertex_count(), triangle_count);
+
+  bench::PrintHeader("meshlet build");
+  uint32_t meshlet_count{0u};
+  auto const stats = bench::Measure(iterations, [&] {
+    Geometry geo{ source };
+    meshlet_count = geo.build_meshlets();
+  });
+  bench::PrintStats("build_meshlets", stats);
+
+  std::printf("\n  %-32s %12u\n", "meshlets", meshlet_count);
+  std::printf("  %-32s %12.1f\n", "triangles per meshlet", triangle_count / static_cast<double>(meshlet_count));
+  std::printf("  %-32s %12.2f\n", "Mtriangles / s", triangle_count / (1.0e3 * stats.median_ms));
+
+  Geometry geo{ source };
+  geo.build_meshlets();
+  uint32_t const failures = Validate(source, geo);
+  std::printf("  %-32s %12s\n", "validation", (failures == 0u) ? "passed" : "FAILED");
+
+  return (failures == 0u) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,287 @@
+/* -------------------------------------------------------------------------- */
+//
+//    bench - mipmap generation
+//
+//  Generate the full mip chains of a set of procedural RGBA8 images, on the
+//  host (box filter per backend, linear and gamma-correct sRGB, serially and
+//  on the job system) and on the device (upload of the base levels then blit
+//  chain, against the upload of host generated chains).
+//
+//  Host backends are checked to produce the same levels. The device part is
+//  skipped when no Vulkan device can be created.
+//
+//  usage : bench_mipmap_generation [image_size] [image_count] [iterations]
+//
+/* -------------------------------------------------------------------------- */
+
+#include <array>
+#include <cstring>
+#include <random>
+
+#include "aer/core/common.h"
+#include "aer/core/job_system.h"
+#include "aer/platform/backend/context.h"
+#include "aer/scene/image_data.h"
+#include "aer/scene/private/mipmap_generator.h"
+
+#include "bench_utils.h"
+
+using namespace internal::mipmap_generator;
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+using MipmapFilter = scene::ImageData::MipmapFilter;
+
+/* Smooth gradients with per-texel noise, so every level differs. */
+std::vector<uint8_t> MakePixels(int32_t size, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int32_t> noise(-24, 24);
+
+  std::vector<uint8_t> pixels(4u * size_t(size) * size_t(size));
+  for (int32_t j = 0; j < size; ++j) {
+    for (int32_t i = 0; i < size; ++i) {
+      uint8_t* texel = pixels.data() + 4u * (size_t(j) * size_t(size) + size_t(i));
+      int32_t const base[4]{ (255 * i) / size, (255 * j) / size, (i ^ j) & 0xFF, 255 };
+      for (int32_t c = 0; c < 4; ++c) {
+        texel[c] = static_cast<uint8_t>(std::clamp(base[c] + noise(rng), 0, 255));
+      }
+    }
+  }
+  return pixels;
+}
+
+std::vector<scene::ImageData> MakeImages(std::vector<std::vector<uint8_t>> const& sources, int32_t size) {
+  std::vector<scene::ImageData> images(sources.size());
+  for (size_t i = 0u; i < sources.size(); ++i) {
+    auto* data = static_cast<uint8_t*>(malloc(sources[i].size()));
+    std::memcpy(data, sources[i].data(), sources[i].size());
+    images[i].width = size;
+    images[i].height = size;
+    images[i].channels = scene::ImageData::kDefaultNumChannels;
+    images[i].pixels.reset(data);
+  }
+  return images;
+}
+
+// ----------------------------------------------------------------------------
+
+/* Return the number of levels differing between the scalar and 'backend' chains. */
+uint32_t CompareBackends(std::vector<uint8_t> const& source, int32_t size, ColorSpace color_space, Backend backend) {
+  auto const levels{ scene::ImageData::MipChain(
+    scene::ImageData::Format::RGBA8_UNORM, size, size, scene::ImageData::FullLevelCount(size, size)
+  ) };
+  uint64_t const bytesize{ levels.back().offset + levels.back().bytesize };
+  std::vector<uint8_t> reference(bytesize);
+  std::vector<uint8_t> tested(bytesize);
+  std::memcpy(reference.data(), source.data(), levels[0u].bytesize);
+  std::memcpy(tested.data(), source.data(), levels[0u].bytesize);
+
+  uint32_t mismatches{0u};
+  for (size_t i = 1u; i < levels.size(); ++i) {
+    auto const& src = levels[i - 1u];
+    auto const& dst = levels[i];
+    Downsample(reference.data() + src.offset, src.width, src.height, reference.data() + dst.offset, color_space, Backend::Scalar);
+    Downsample(tested.data() + src.offset, src.width, src.height, tested.data() + dst.offset, color_space, backend);
+    if (std::memcmp(reference.data() + dst.offset, tested.data() + dst.offset, dst.bytesize) != 0) {
+      ++mismatches;
+    }
+  }
+  return mismatches;
+}
+
+// ----------------------------------------------------------------------------
+
+/* Upload every image with 'levels' levels, blitting the missing ones on the device. */
+void UploadToDevice(
+  Context const& context,
+  std::vector<scene::ImageData> const& images,
+  uint32_t level_count
+) {
+  auto const* allocator = context.allocator_ptr();
+
+  uint64_t staging_size{0u};
+  for (auto const& image : images) {
+    staging_size += image.getBytesize();
+  }
+  auto const staging_buffer{ allocator->create_staging_buffer(staging_size) };
+
+  std::vector<backend::Image> device_images{};
+  std::vector<std::vector<VkBufferImageCopy>> copies(images.size());
+  uint64_t staging_offset{0u};
+  for (size_t i = 0u; i < images.size(); ++i) {
+    auto const& image = images[i];
+    device_images.push_back(context.create_image_2d(
+      static_cast<uint32_t>(image.width),
+      static_cast<uint32_t>(image.height),
+      1u,
+      level_count,
+      VK_FORMAT_R8G8B8A8_UNORM,
+      VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+      "bench::MipmapImage"
+    ));
+    auto const levels{ image.getMipLevels() };
+    for (uint32_t level = 0u; level < levels.size(); ++level) {
+      allocator->write_buffer(staging_buffer, staging_offset, image.getPixels(), levels[level].offset, levels[level].bytesize);
+      copies[i].push_back({
+        .bufferOffset = staging_offset,
+        .imageSubresource = {
+          .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+          .mipLevel = level,
+          .layerCount = 1u,
+        },
+        .imageExtent = {
+          static_cast<uint32_t>(levels[level].width),
+          static_cast<uint32_t>(levels[level].height),
+          1u
+        },
+      });
+      staging_offset += levels[level].bytesize;
+    }
+  }
+
+  auto cmd{ context.create_transient_command_encoder(Context::TargetQueue::Main) };
+  cmd.transition_images_layout(device_images, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+  for (size_t i = 0u; i < device_images.size(); ++i) {
+    vkCmdCopyBufferToImage(
+      cmd.handle(),
+      staging_buffer.buffer,
+      device_images[i].image,
+      VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+      static_cast<uint32_t>(copies[i].size()),
+      copies[i].data()
+    );
+    if (images[i].level_count < level_count) {
+      cmd.generate_mipmaps(
+        device_images[i],
+        { static_cast<uint32_t>(images[i].width), static_cast<uint32_t>(images[i].height) },
+        level_count
+      );
+    }
+  }
+  context.finish_transient_command_encoder(cmd);
+
+  for (auto& image : device_images) {
+    allocator->destroy_image(&image);
+  }
+  allocator->clear_staging_buffers();
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+int main(int argc, char *argv[]) {
+  int32_t const image_size{
+    (argc > 1) ? std::max(std::atoi(argv[1]), 1) : 2048
+  };
+  uint32_t const image_count{
+    (argc > 2) ? static_cast<uint32_t>(std::max(std::atoi(argv[2]), 1)) : 16u
+  };
+  uint32_t const iterations{
+    (argc > 3) ? static_cast<uint32_t>(std::atoi(argv[3])) : 5u
+  };
+
+  Logger::Initialize();
+
+  std::vector<std::vector<uint8_t>> sources(image_count);
+  for (uint32_t i = 0u; i < image_count; ++i) {
+    sources[i] = MakePixels(image_size, i);
+  }
+  uint32_t const level_count{ scene::ImageData::FullLevelCount(image_size, image_size) };
+  double const base_mtexels{ image_count * double(image_size) * double(image_size) / 1.0e6 };
+
+  std::printf("\n%u images of %dx%d, %u levels\n", image_count, image_size, image_size, level_count);
+
+  /* Host kernels. */
+  uint32_t failures{0u};
+  for (auto const color_space : { ColorSpace::Linear, ColorSpace::sRGB }) {
+    bool const srgb{ color_space == ColorSpace::sRGB };
+    bench::PrintHeader(srgb ? "host downsample (srgb)" : "host downsample (linear)");
+    for (auto const backend : { Backend::Scalar, Backend::SSE, Backend::NEON }) {
+      if (!IsBackendSupported(backend)) {
+        continue;
+      }
+      auto images{ MakeImages(sources, image_size) };
+      auto const stats = bench::Measure(iterations, [&] {
+        for (auto const& image : images) {
+          auto const levels{ scene::ImageData::MipChain(
+            image.format, image_size, image_size, level_count
+          ) };
+          std::vector<uint8_t> chain(levels.back().offset + levels.back().bytesize);
+          std::memcpy(chain.data(), image.getPixels(), levels[0u].bytesize);
+          for (size_t i = 1u; i < levels.size(); ++i) {
+            Downsample(chain.data() + levels[i - 1u].offset, levels[i - 1u].width, levels[i - 1u].height,
+              chain.data() + levels[i].offset, color_space, backend
+            );
+          }
+        }
+      });
+      auto const label{ fmt::format("{} ({:.0f} Mtexels/s)", BackendName(backend), base_mtexels / (1.0e-3 * stats.median_ms)) };
+      bench::PrintStats(label.c_str(), stats);
+
+      if (backend != Backend::Scalar) {
+        failures += CompareBackends(sources[0u], image_size, color_space, backend);
+      }
+    }
+  }
+  std::printf("  %-32s %12s\n", "backends match", (failures == 0u) ? "yes" : "NO");
+
+  /* Host path, as run by the loader : one task per image on the job system. */
+  utils::JobSystem::Initialize();
+  bench::PrintHeader("host path (per image tasks)");
+  for (auto const filter : { MipmapFilter::Linear, MipmapFilter::sRGB }) {
+    bool const srgb{ filter == MipmapFilter::sRGB };
+    auto const serial = bench::Measure(iterations, [&] {
+      auto images{ MakeImages(sources, image_size) };
+      for (auto& image : images) {
+        image.generateMipmaps(filter);
+      }
+    });
+    bench::PrintStats(srgb ? "serial (srgb)" : "serial (linear)", serial);
+
+    auto const parallel = bench::Measure(iterations, [&] {
+      auto images{ MakeImages(sources, image_size) };
+      std::vector<utils::Task<bool>> tasks{};
+      for (auto& image : images) {
+        tasks.push_back(utils::RunTaskGeneric<bool>([&image, filter] {
+          return image.generateMipmaps(filter);
+        }));
+      }
+      for (auto& task : tasks) {
+        utils::WaitTask(task);
+      }
+    });
+    auto const label{ fmt::format("{} workers ({})", utils::JobSystem::Get().worker_count(), srgb ? "srgb" : "linear") };
+    bench::PrintStats(label.c_str(), parallel);
+  }
+  utils::JobSystem::Deinitialize();
+
+  /* Device path. */
+  Context context{};
+  if (!context.init("bench_mipmap_generation", {}, {}, nullptr)) {
+    std::printf("\nno Vulkan device, device path skipped.\n");
+  } else {
+    auto base_images{ MakeImages(sources, image_size) };
+    auto host_chains{ MakeImages(sources, image_size) };
+    for (auto& image : host_chains) {
+      image.generateMipmaps(MipmapFilter::Linear);
+    }
+
+    bench::PrintHeader("device upload (wall time)");
+    bench::PrintStats("base levels + blit chains", bench::Measure(iterations, [&] {
+      UploadToDevice(context, base_images, level_count);
+    }));
+    bench::PrintStats("host generated chains", bench::Measure(iterations, [&] {
+      UploadToDevice(context, host_chains, level_count);
+    }));
+    context.deinit();
+  }
+
+  Logger::Deinitialize();
+
+  return (failures == 0u) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* -------------------------------------------------------------------------- */
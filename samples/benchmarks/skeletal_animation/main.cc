@@ -0,0 +1,234 @@
+/* -------------------------------------------------------------------------- */
+//
+//    bench - skeletal animation
+//
+//  Evaluate a crowd of skeleton instances, each one blending two procedural
+//  clips, sampling them, propagating the joints along the hierarchy and
+//  computing the skinning matrices.
+//
+//  Report the skeletons evaluated per millisecond for each SIMD backend,
+//  nlerp and slerp rotations, serially and on the job system. Backends are
+//  checked to match the scalar skinning matrices.
+//
+//  usage : bench_skeletal_animation [joint_count] [instance_count] [iterations]
+//
+/* -------------------------------------------------------------------------- */
+
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+#include "aer/core/common.h"
+#include "aer/core/job_system.h"
+#include "aer/scene/animation_runtime.h"
+
+#include "bench_utils.h"
+
+using namespace internal::animation_kernels;
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+// Clips length, in seconds, and sampling rate.
+float constexpr kClipDuration{ 2.0f };
+uint32_t constexpr kClipSampleCount{ 61u };
+uint32_t constexpr kClipCount{ 3u };
+
+// Maximum difference tolerated between the backends skinning matrices.
+float constexpr kMatchTolerance{ 1.0e-4f };
+
+// ----------------------------------------------------------------------------
+
+vec4f AxisAngle(vec3f const& axis, float angle) {
+  float const s{ std::sin(0.5f * angle) };
+  return vec4f(axis.x * s, axis.y * s, axis.z * s, std::cos(0.5f * angle));
+}
+
+/* Random tree of joints, each one offset from its parent, in shuffled order. */
+scene::Skeleton MakeSkeleton(uint32_t joint_count) {
+  std::mt19937 rng(7u);
+  std::uniform_real_distribution<float> offset_dist(-0.5f, 0.5f);
+
+  // Parents are drawn among the previous joints, then indices are shuffled
+  // so the hierarchy order differs from the storage order.
+  std::vector<uint32_t> permutation(joint_count);
+  std::iota(permutation.begin(), permutation.end(), 0u);
+  std::shuffle(permutation.begin() + 1, permutation.end(), rng);
+
+  scene::Skeleton skeleton(joint_count);
+  for (uint32_t i = 0u; i < joint_count; ++i) {
+    uint32_t const j{ permutation[i] };
+    skeleton.names[j] = fmt::format("Joint_{}", j);
+    skeleton.index_map[skeleton.names[j]] = static_cast<int32_t>(j);
+    skeleton.parents[j] = (i == 0u) ? -1 : static_cast<int32_t>(
+      permutation[std::uniform_int_distribution<uint32_t>(i > 4u ? i - 4u : 0u, i - 1u)(rng)]
+    );
+    skeleton.rest_pose.set_joint(j, {
+      .translation = vec3f(offset_dist(rng), 1.0f, offset_dist(rng)),
+    });
+  }
+  skeleton.sort_joints();
+
+  // Bind pose as the rest pose.
+  scene::Animator const animator(scene::Animator::Settings{ .backend = Backend::Scalar, .parallel = false });
+  scene::SkeletonInstance instance{ .skeleton = &skeleton };
+  std::fill(skeleton.inverse_bind_matrices.begin(), skeleton.inverse_bind_matrices.end(), mat4f(linalg::identity));
+  animator.evaluate(instance);
+  for (uint32_t j = 0u; j < joint_count; ++j) {
+    skeleton.global_bind_matrices[j] = instance.skinning_matrices[j];
+    skeleton.inverse_bind_matrices[j] = linalg::inverse(instance.skinning_matrices[j]);
+  }
+
+  return skeleton;
+}
+
+/* Clip swinging every joint around a per clip axis, at per joint phases. */
+scene::AnimationClip MakeClip(scene::Skeleton const& skeleton, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> phase_dist(0.0f, 2.0f * lina::kPi);
+  std::uniform_real_distribution<float> amplitude_dist(0.2f, 1.4f);
+
+  uint32_t const joint_count{ skeleton.rest_pose.joint_count };
+  vec3f const axis{ linalg::normalize(vec3f(0.3f * seed, 1.0f, 0.5f)) };
+
+  scene::AnimationClip clip{};
+  clip.setup(fmt::format("Clip_{}", seed), kClipSampleCount, kClipDuration, skeleton.rest_pose);
+
+  scene::Pose pose{ skeleton.rest_pose };
+  for (uint32_t j = 0u; j < joint_count; ++j) {
+    float const phase{ phase_dist(rng) };
+    float const amplitude{ amplitude_dist(rng) };
+    for (uint32_t i = 0u; i < kClipSampleCount; ++i) {
+      float const t{ 2.0f * lina::kPi * static_cast<float>(i) / (kClipSampleCount - 1u) };
+      auto transform{ skeleton.rest_pose.joint(j) };
+      transform.rotation = AxisAngle(axis, amplitude * std::sin(t + phase));
+      transform.scale = 1.0f + 0.1f * std::sin(t + 2.0f * phase);
+      pose.set_joint(j, transform);
+      std::copy(pose.channels.begin(), pose.channels.end(), clip.sample(i));
+    }
+  }
+  return clip;
+}
+
+/* Instances blending two clips at random times and weights. */
+std::vector<scene::SkeletonInstance> MakeInstances(
+  scene::Skeleton const& skeleton,
+  std::vector<scene::AnimationClip> const& clips,
+  uint32_t instance_count
+) {
+  std::mt19937 rng(3u);
+  std::uniform_real_distribution<float> time_dist(0.0f, kClipDuration);
+  std::uniform_real_distribution<float> weight_dist(0.1f, 1.0f);
+
+  std::vector<scene::SkeletonInstance> instances(instance_count);
+  for (uint32_t i = 0u; i < instance_count; ++i) {
+    auto& instance = instances[i];
+    instance.skeleton = &skeleton;
+    instance.layer_count = 2u;
+    instance.layers[0u] = { .clip = &clips[i % clips.size()], .time = time_dist(rng), .weight = weight_dist(rng) };
+    instance.layers[1u] = { .clip = &clips[(i + 1u) % clips.size()], .time = time_dist(rng), .weight = weight_dist(rng) };
+  }
+  return instances;
+}
+
+// ----------------------------------------------------------------------------
+
+/* Return the largest difference between two instances skinning matrices. */
+float MaxDifference(
+  std::vector<scene::SkeletonInstance> const& a,
+  std::vector<scene::SkeletonInstance> const& b
+) {
+  float max_diff{0.0f};
+  for (size_t i = 0u; i < a.size(); ++i) {
+    for (size_t j = 0u; j < a[i].skinning_matrices.size(); ++j) {
+      float const* ma{ lina::ptr(a[i].skinning_matrices[j]) };
+      float const* mb{ lina::ptr(b[i].skinning_matrices[j]) };
+      for (uint32_t k = 0u; k < 16u; ++k) {
+        max_diff = std::max(max_diff, std::abs(ma[k] - mb[k]));
+      }
+    }
+  }
+  return max_diff;
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+int main(int argc, char *argv[]) {
+  uint32_t const joint_count{
+    (argc > 1) ? static_cast<uint32_t>(std::max(std::atoi(argv[1]), 1)) : 64u
+  };
+  uint32_t const instance_count{
+    (argc > 2) ? static_cast<uint32_t>(std::max(std::atoi(argv[2]), 1)) : 4096u
+  };
+  uint32_t const iterations{
+    (argc > 3) ? static_cast<uint32_t>(std::atoi(argv[3])) : 10u
+  };
+
+  Logger::Initialize();
+
+  auto const skeleton{ MakeSkeleton(joint_count) };
+  std::vector<scene::AnimationClip> clips{};
+  for (uint32_t i = 0u; i < kClipCount; ++i) {
+    clips.push_back(MakeClip(skeleton, i + 1u));
+  }
+
+  std::printf("\n%u instances of %u joints, blending 2 of %u clips\n", instance_count, joint_count, kClipCount);
+
+  auto evaluate_all{[&](
+    scene::Animator::Settings const& settings,
+    std::vector<scene::SkeletonInstance>& instances,
+    char const* label
+  ) {
+    scene::Animator const animator(settings);
+    auto const stats = bench::Measure(iterations, [&] {
+      animator.evaluate(instances);
+    });
+    auto const name{ fmt::format("{} ({:.1f} skel/ms)", label, instance_count / stats.median_ms) };
+    bench::PrintStats(name.c_str(), stats);
+  }};
+
+  /* Serial evaluation, per backend. */
+  uint32_t failures{0u};
+  for (auto const interpolation : { Interpolation::NLerp, Interpolation::SLerp }) {
+    bool const slerp{ interpolation == Interpolation::SLerp };
+    bench::PrintHeader(slerp ? "serial evaluation (slerp)" : "serial evaluation (nlerp)");
+
+    auto reference{ MakeInstances(skeleton, clips, instance_count) };
+    for (auto const backend : { Backend::Scalar, Backend::SSE, Backend::NEON }) {
+      if (!IsBackendSupported(backend)) {
+        continue;
+      }
+      auto instances{ MakeInstances(skeleton, clips, instance_count) };
+      evaluate_all({ .interpolation = interpolation, .backend = backend, .parallel = false }, instances, BackendName(backend));
+
+      if (backend == Backend::Scalar) {
+        reference = std::move(instances);
+      } else if (MaxDifference(reference, instances) > kMatchTolerance) {
+        ++failures;
+      }
+    }
+  }
+  std::printf("  %-32s %12s\n", "backends match", (failures == 0u) ? "yes" : "NO");
+
+  /* Instances split across the job system workers. */
+  utils::JobSystem::Initialize();
+  auto const worker_count{ utils::JobSystem::Get().worker_count() };
+  bench::PrintHeader("parallel evaluation");
+  for (auto const interpolation : { Interpolation::NLerp, Interpolation::SLerp }) {
+    bool const slerp{ interpolation == Interpolation::SLerp };
+    auto instances{ MakeInstances(skeleton, clips, instance_count) };
+    auto const label{ fmt::format("{} workers ({})", worker_count, slerp ? "slerp" : "nlerp") };
+    evaluate_all({ .interpolation = interpolation, .backend = BestBackend() }, instances, label.c_str());
+  }
+  utils::JobSystem::Deinitialize();
+
+  Logger::Deinitialize();
+
+  return (failures == 0u) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* -------------------------------------------------------------------------- */
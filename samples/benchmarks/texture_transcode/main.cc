@@ -0,0 +1,194 @@
+/* -------------------------------------------------------------------------- */
+//
+//    bench - texture transcode
+//
+//  Transcode KTX2 / Basis Universal images to every GPU block compression
+//  family (and to uncompressed RGBA8), first one image after the other then
+//  all images concurrently on the job system, as done when loading a scene.
+//
+//  Report the transcode throughput in input MB/s and output Mtexels/s, and
+//  the resident size of each family relative to RGBA8.
+//
+//  usage : bench_texture_transcode [file.ktx2 | directory] [iterations]
+//
+/* -------------------------------------------------------------------------- */
+
+#include <array>
+#include <filesystem>
+#include <memory>
+
+#include "aer/core/common.h"
+#include "aer/core/job_system.h"
+#include "aer/core/mapped_file.h"
+#include "aer/scene/image_data.h"
+
+#include "bench_utils.h"
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+using BlockCompression = scene::ImageData::BlockCompression;
+
+struct Target {
+  char const* label;
+  BlockCompression compression;
+};
+
+std::array<Target, 4u> constexpr kTargets{{
+  { "rgba8", BlockCompression::None },
+  { "bc", BlockCompression::BC },
+  { "astc", BlockCompression::ASTC },
+  { "etc2", BlockCompression::ETC2 },
+}};
+
+// ----------------------------------------------------------------------------
+
+/* KTX2 files at 'path', or found recursively under it when it is a directory. */
+std::vector<std::unique_ptr<utils::MappedFile>> OpenKTX2Files(std::filesystem::path const& path) {
+  std::vector<std::filesystem::path> paths{};
+  std::error_code ec{};
+  if (std::filesystem::is_directory(path, ec)) {
+    for (auto const& entry : std::filesystem::recursive_directory_iterator(path, ec)) {
+      if (entry.is_regular_file() && (entry.path().extension() == ".ktx2")) {
+        paths.push_back(entry.path());
+      }
+    }
+  } else {
+    paths.push_back(path);
+  }
+
+  std::vector<std::unique_ptr<utils::MappedFile>> files{};
+  for (auto const& p : paths) {
+    auto file = std::make_unique<utils::MappedFile>();
+    if (file->open(p.string())
+     && scene::ImageData::IsKTX2(file->data(), static_cast<uint32_t>(file->size()))) {
+      files.push_back(std::move(file));
+    } else {
+      std::fprintf(stderr, "  skipped \"%s\", not a KTX2 file.\n", p.string().c_str());
+    }
+  }
+  return files;
+}
+
+// ----------------------------------------------------------------------------
+
+struct TranscodeResult {
+  uint64_t texels{};
+  uint64_t bytesize{};
+  uint32_t failures{};
+};
+
+/* Transcode every file, serially or as concurrent tasks. */
+TranscodeResult Transcode(
+  std::vector<std::unique_ptr<utils::MappedFile>> const& files,
+  BlockCompression compression,
+  bool parallel
+) {
+  std::vector<scene::ImageData> images(files.size());
+  for (size_t i = 0u; i < files.size(); ++i) {
+    auto const* data = files[i]->data();
+    auto const size = static_cast<uint32_t>(files[i]->size());
+    if (parallel) {
+      images[i].loadKTX2Async(data, size, compression);
+    } else {
+      images[i].loadKTX2(data, size, compression);
+    }
+  }
+
+  TranscodeResult result{};
+  for (auto& image : images) {
+    if (!image.getPixels()) {
+      ++result.failures;
+      continue;
+    }
+    for (auto const& level : image.getMipLevels()) {
+      result.texels += uint64_t(level.width) * uint64_t(level.height);
+    }
+    result.bytesize += image.getBytesize();
+  }
+  return result;
+}
+
+} // namespace ""
+
+/* -------------------------------------------------------------------------- */
+
+int main(int argc, char *argv[]) {
+  std::filesystem::path const path{
+    (argc > 1) ? argv[1] : ASSETS_DIR "textures/"
+  };
+  uint32_t const iterations{
+    (argc > 2) ? static_cast<uint32_t>(std::atoi(argv[2])) : 5u
+  };
+
+  Logger::Initialize();
+
+  auto const files{ OpenKTX2Files(path) };
+  if (files.empty()) {
+    std::printf("\nno KTX2 file found at \"%s\".\n", path.string().c_str());
+    std::printf("usage : bench_texture_transcode [file.ktx2 | directory] [iterations]\n");
+    Logger::Deinitialize();
+    return EXIT_SUCCESS;
+  }
+
+  uint64_t input_bytesize{0u};
+  for (auto const& file : files) {
+    input_bytesize += file->size();
+  }
+  std::printf("\n%zu KTX2 files, %.2f MB\n", files.size(), input_bytesize / 1.0e6);
+
+  utils::JobSystem::Initialize();
+
+  struct Row {
+    char const* label;
+    TranscodeResult result;
+    bench::Stats serial;
+    bench::Stats parallel;
+  };
+  std::vector<Row> rows{};
+
+  for (auto const& target : kTargets) {
+    Row row{ .label = target.label };
+    bench::PrintHeader(target.label);
+    row.serial = bench::Measure(iterations, [&] {
+      row.result = Transcode(files, target.compression, false);
+    });
+    bench::PrintStats("serial", row.serial);
+    row.parallel = bench::Measure(iterations, [&] {
+      row.result = Transcode(files, target.compression, true);
+    });
+    auto const label{ fmt::format("job system ({} workers)", utils::JobSystem::Get().worker_count()) };
+    bench::PrintStats(label.c_str(), row.parallel);
+    rows.push_back(row);
+  }
+
+  utils::JobSystem::Deinitialize();
+
+  double const reference = static_cast<double>(rows.front().result.bytesize);
+
+  std::printf("\n  %-8s %12s %12s %14s %16s %12s\n",
+    "target", "MB/s", "MB/s (jobs)", "Mtexels/s", "Mtexels/s (jobs)", "size"
+  );
+  uint32_t failures{0u};
+  for (auto const& r : rows) {
+    std::printf("  %-8s %12.1f %12.1f %14.1f %16.1f %11.1f%%\n",
+      r.label,
+      input_bytesize / (1.0e3 * r.serial.median_ms),
+      input_bytesize / (1.0e3 * r.parallel.median_ms),
+      r.result.texels / (1.0e3 * r.serial.median_ms),
+      r.result.texels / (1.0e3 * r.parallel.median_ms),
+      100.0 * r.result.bytesize / reference
+    );
+    failures += r.result.failures;
+  }
+  if (failures > 0u) {
+    std::printf("\n  %u transcodes failed.\n", failures);
+  }
+
+  Logger::Deinitialize();
+
+  return (failures == 0u) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* -------------------------------------------------------------------------- */
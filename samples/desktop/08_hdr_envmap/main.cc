@@ -205,15 +205,20 @@ class SampleApp final : public Application {
   void draw_model(RenderPassEncoder const& pass, mat4 const& world_matrix) {
     for (auto const& mesh : scene_->meshes) {
       pass.set_primitive_topology(mesh->vk_primitive_topology());
-      push_constant_.model.worldMatrix = linalg::mul(
-        world_matrix,
-        mesh->world_matrix()
-      );
-      for (auto const& submesh : mesh->submeshes) {
-        auto material = scene_->material(*submesh.material_ref);
-        push_constant_.model.albedo_texture_index = material.bindings.basecolor;
-        pass.push_constant(push_constant_, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT); //
-        pass.draw(submesh.draw_descriptor, scene_->vertex_buffer, scene_->index_buffer);
+      for (uint32_t instance = 0u; instance < mesh->instance_count; ++instance) {
+        push_constant_.model.worldMatrix = linalg::mul(
+          world_matrix,
+          mesh->world_matrix(instance)
+        );
+        for (auto const& submesh : mesh->submeshes) {
+          auto material = scene_->material(*submesh.material_ref);
+          push_constant_.model.albedo_texture_index = material.bindings.basecolor;
+          pass.push_constant(push_constant_, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT); //
+          // (the world matrix is pushed per instance)
+          auto desc = submesh.draw_descriptor;
+          desc.instanceCount = 1u;
+          pass.draw(desc, scene_->vertex_buffer, scene_->index_buffer);
+        }
       }
     }
   }
@@ -145,18 +145,23 @@ class SceneFx final : public RenderTargetFx {
     for (auto const& mesh : scene_->meshes) {
       pass.set_primitive_topology(mesh->vk_primitive_topology());
 
-      push_constant_.model.worldMatrix = linalg::mul(
-        world_matrix_,
-        mesh->world_matrix()
-      );
-
-      for (auto const& submesh : mesh->submeshes) {
-        auto material = scene_->material(*submesh.material_ref);
-        push_constant_.model.albedo_texture_index = material.bindings.basecolor;
-        push_constant_.model.material_index = submesh.material_ref->material_index;
-        push_constant_.model.instance_index = instance_index++;
-        pushConstant(pass);
-        pass.draw(submesh.draw_descriptor, scene_->vertex_buffer, scene_->index_buffer);
+      for (uint32_t instance = 0u; instance < mesh->instance_count; ++instance) {
+        push_constant_.model.worldMatrix = linalg::mul(
+          world_matrix_,
+          mesh->world_matrix(instance)
+        );
+
+        for (auto const& submesh : mesh->submeshes) {
+          auto material = scene_->material(*submesh.material_ref);
+          push_constant_.model.albedo_texture_index = material.bindings.basecolor;
+          push_constant_.model.material_index = submesh.material_ref->material_index;
+          push_constant_.model.instance_index = instance_index++;
+          pushConstant(pass);
+          // (the world matrix is pushed per instance)
+          auto desc = submesh.draw_descriptor;
+          desc.instanceCount = 1u;
+          pass.draw(desc, scene_->vertex_buffer, scene_->index_buffer);
+        }
       }
     }
   }
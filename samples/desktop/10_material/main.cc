@@ -47,6 +47,9 @@ class SampleApp final : public Application {
       future_scene_ = renderer_.async_load_gltf(gtlf_filename);
     } else {
       scene_ = renderer_.load_gltf(gtlf_filename);
+      if (scene_) {
+        scene_->gpu_driven = true;
+      }
     }
 
     return true;
@@ -71,6 +74,9 @@ class SampleApp final : public Application {
     if (future_scene_.valid()
      && future_scene_.wait_for(0ms) == std::future_status::ready) {
       scene_ = future_scene_.get();
+      if (scene_) {
+        scene_->gpu_driven = true;
+      }
     }
     if (scene_) {
       scene_->update(camera_, renderer_.surface_size(), elapsed_time());
@@ -80,6 +86,11 @@ class SampleApp final : public Application {
   void draw() final {
     auto cmd = renderer_.begin_frame();
     {
+      // (no-op unless the scene was loaded with meshlets or draws from the device)
+      if (scene_) {
+        scene_->cull(cmd);
+      }
+
       auto pass = cmd.begin_rendering();
       {
         // SKYBOX.